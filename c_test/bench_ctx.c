@@ -0,0 +1,238 @@
+/* Micro-benchmarks for the cost of individual context functions.
+
+   Contrarily to microbench/, which measures calls going through the Python
+   interpreter, this file calls context functions directly in tight loops, so
+   that we can see the raw overhead of each ABI:
+
+     - bench_ctx_universal: compiled with HPY_UNIVERSAL_ABI and linked with
+       the sources of hpy.universal; it benchmarks both the universal ctx and
+       the debug ctx which wraps it.
+
+     - bench_ctx_cpython: the same source compiled for the CPython ABI, where
+       most API functions are static inline.
+
+   Each benchmark is an acutest test named "<ctx>/<function>", so you can run
+   a single one with e.g. ./bench_ctx_universal debug/HPy_Dup. The number of
+   iterations can be changed by setting HPY_BENCH_ITERATIONS.
+
+   Times are reported in nanoseconds per call (using CLOCK_MONOTONIC) and, if
+   the CPU has a cheap cycle counter, also in cycles per call.
+*/
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include "acutest.h" // https://github.com/mity/acutest
+#include "hpy.h"
+
+#ifdef HPY_UNIVERSAL_ABI
+#  include "api.h"         // for g_universal_ctx
+#  include "hpy_debug.h"
+PyMODINIT_FUNC PyInit_universal(void);
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#  define HAVE_CYCLE_COUNTER 1
+static inline uint64_t read_cycles(void) { return __rdtsc(); }
+#elif defined(__aarch64__)
+#  define HAVE_CYCLE_COUNTER 1
+static inline uint64_t read_cycles(void)
+{
+    uint64_t val;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(val));
+    return val;
+}
+#else
+#  define HAVE_CYCLE_COUNTER 0
+static inline uint64_t read_cycles(void) { return 0; }
+#endif
+
+static inline uint64_t read_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* ~~~ contexts ~~~ */
+
+typedef enum { CTX_CPYTHON, CTX_UNIVERSAL, CTX_DEBUG, CTX_DEBUG_LEAKS } ctx_kind;
+
+static const char *ctx_names[] = { "cpython", "universal", "debug",
+                                   "debug-leaks" };
+
+static HPyContext *get_ctx(ctx_kind kind)
+{
+    if (!Py_IsInitialized())
+        Py_Initialize();
+#ifdef HPY_UNIVERSAL_ABI
+    // PyInit_universal initializes the constants of g_universal_ctx
+    (void)PyInit_universal();
+    if (kind == CTX_DEBUG)
+        return hpy_debug_get_ctx(&g_universal_ctx);
+    if (kind == CTX_DEBUG_LEAKS)
+        return hpy_debug_get_ctx_level(&g_universal_ctx, HPY_DEBUG_LEVEL_LEAKS);
+    TEST_ASSERT(kind == CTX_UNIVERSAL);
+    return &g_universal_ctx;
+#else
+    TEST_ASSERT(kind == CTX_CPYTHON);
+    return _HPyGetContext();
+#endif
+}
+
+/* ~~~ harness ~~~ */
+
+#define N_ITEMS 8
+
+typedef int (*bench_fn)(HPyContext *ctx, long n);
+
+static long get_iterations(void)
+{
+    const char *s = getenv("HPY_BENCH_ITERATIONS");
+    long n = s ? atol(s) : 0;
+    return n > 0 ? n : 1000000;
+}
+
+/* Run fn once to warm up, then time it. Each call of fn does 'n' iterations
+   of 'calls_per_iter' context calls each. */
+static void run_bench(ctx_kind kind, const char *name, bench_fn fn,
+                      int calls_per_iter)
+{
+    HPyContext *ctx = get_ctx(kind);
+    TEST_ASSERT(ctx != NULL);
+    long n = get_iterations();
+    TEST_CHECK(fn(ctx, n / 10 + 1) == 0);
+
+    uint64_t t0 = read_ns();
+    uint64_t c0 = read_cycles();
+    int res = fn(ctx, n);
+    uint64_t c1 = read_cycles();
+    uint64_t t1 = read_ns();
+    TEST_CHECK(res == 0);
+    TEST_CHECK(!HPyErr_Occurred(ctx));
+
+    double calls = (double)n * calls_per_iter;
+    if (HAVE_CYCLE_COUNTER)
+        printf("\n    %-10s %-24s %8.2f ns/call %8.1f cycles/call\n",
+               ctx_names[kind], name, (t1 - t0) / calls, (c1 - c0) / calls);
+    else
+        printf("\n    %-10s %-24s %8.2f ns/call\n",
+               ctx_names[kind], name, (t1 - t0) / calls);
+}
+
+/* ~~~ benchmarks ~~~ */
+
+// HPy_Dup + HPy_Close
+static int bench_HPy_Dup(HPyContext *ctx, long n)
+{
+    for (long i = 0; i < n; i++) {
+        HPy h = HPy_Dup(ctx, ctx->h_None);
+        HPy_Close(ctx, h);
+    }
+    return 0;
+}
+
+// HPyLong_FromLong + HPy_Close; the values are outside the small ints cache
+static int bench_HPyLong_FromLong(HPyContext *ctx, long n)
+{
+    for (long i = 0; i < n; i++) {
+        HPy h = HPyLong_FromLong(ctx, i + 1000);
+        if (HPy_IsNull(h))
+            return -1;
+        HPy_Close(ctx, h);
+    }
+    return 0;
+}
+
+// HPyTracker_Add of N_ITEMS handles, then HPyTracker_Close
+static int bench_HPyTracker_Add(HPyContext *ctx, long n)
+{
+    for (long i = 0; i < n; i++) {
+        HPyTracker ht = HPyTracker_New(ctx, N_ITEMS);
+        if (HPy_IsNull(ht))
+            return -1;
+        for (int j = 0; j < N_ITEMS; j++) {
+            if (HPyTracker_Add(ctx, ht, HPy_Dup(ctx, ctx->h_None)) < 0)
+                return -1;
+        }
+        HPyTracker_Close(ctx, ht);
+    }
+    return 0;
+}
+
+// HPyTupleBuilder_Set of N_ITEMS items, then HPyTupleBuilder_Build
+static int bench_HPyTupleBuilder_Set(HPyContext *ctx, long n)
+{
+    for (long i = 0; i < n; i++) {
+        HPyTupleBuilder tb = HPyTupleBuilder_New(ctx, N_ITEMS);
+        for (int j = 0; j < N_ITEMS; j++)
+            HPyTupleBuilder_Set(ctx, tb, j, ctx->h_None);
+        HPy h = HPyTupleBuilder_Build(ctx, tb);
+        if (HPy_IsNull(h))
+            return -1;
+        HPy_Close(ctx, h);
+    }
+    return 0;
+}
+
+// HPyListBuilder_Set of N_ITEMS items, then HPyListBuilder_Build
+static int bench_HPyListBuilder_Set(HPyContext *ctx, long n)
+{
+    for (long i = 0; i < n; i++) {
+        HPyListBuilder lb = HPyListBuilder_New(ctx, N_ITEMS);
+        for (int j = 0; j < N_ITEMS; j++)
+            HPyListBuilder_Set(ctx, lb, j, ctx->h_None);
+        HPy h = HPyListBuilder_Build(ctx, lb);
+        if (HPy_IsNull(h))
+            return -1;
+        HPy_Close(ctx, h);
+    }
+    return 0;
+}
+
+/* Define one acutest entry point per (ctx, benchmark) pair. The number of
+   context calls done by each iteration is used to compute ns/call. */
+#define BENCH(KIND, NAME, CALLS_PER_ITER)                                 \
+    static void KIND##_##NAME(void)                                       \
+    {                                                                     \
+        run_bench(KIND, #NAME, bench_##NAME, CALLS_PER_ITER);             \
+    }
+
+#define ALL_BENCHES(KIND)                                                 \
+    BENCH(KIND, HPy_Dup, 2)                                               \
+    BENCH(KIND, HPyLong_FromLong, 2)                                      \
+    BENCH(KIND, HPyTracker_Add, 2 * N_ITEMS + 2)                          \
+    BENCH(KIND, HPyTupleBuilder_Set, N_ITEMS + 3)                         \
+    BENCH(KIND, HPyListBuilder_Set, N_ITEMS + 3)
+
+#define BENCH_ENTRY(KIND, PREFIX, NAME) { PREFIX "/" #NAME, KIND##_##NAME }
+
+#define ALL_ENTRIES(KIND, PREFIX)                                         \
+    BENCH_ENTRY(KIND, PREFIX, HPy_Dup),                                   \
+    BENCH_ENTRY(KIND, PREFIX, HPyLong_FromLong),                          \
+    BENCH_ENTRY(KIND, PREFIX, HPyTracker_Add),                            \
+    BENCH_ENTRY(KIND, PREFIX, HPyTupleBuilder_Set),                       \
+    BENCH_ENTRY(KIND, PREFIX, HPyListBuilder_Set)
+
+#ifdef HPY_UNIVERSAL_ABI
+ALL_BENCHES(CTX_UNIVERSAL)
+ALL_BENCHES(CTX_DEBUG)
+ALL_BENCHES(CTX_DEBUG_LEAKS)
+
+TEST_LIST = {
+    ALL_ENTRIES(CTX_UNIVERSAL, "universal"),
+    ALL_ENTRIES(CTX_DEBUG, "debug"),
+    ALL_ENTRIES(CTX_DEBUG_LEAKS, "debug-leaks"),
+    { NULL, NULL }
+};
+#else
+ALL_BENCHES(CTX_CPYTHON)
+
+TEST_LIST = {
+    ALL_ENTRIES(CTX_CPYTHON, "cpython"),
+    { NULL, NULL }
+};
+#endif
@@ -8,7 +8,7 @@
 #include "debug_internal.h"
 
 static UHPy new_DebugHandleObj(HPyContext *uctx, UHPy u_DebugHandleType,
-                               DebugHandle *handle);
+                               HPyDebugInfo *info, DebugHandle *handle);
 
 
 HPyDef_METH(new_generation, "new_generation", new_generation_impl, HPyFunc_NOARGS)
@@ -16,42 +16,73 @@ static UHPy new_generation_impl(HPyContext *uctx, UHPy self)
 {
     HPyContext *dctx = hpy_debug_get_ctx(uctx);
     HPyDebugInfo *info = get_info(dctx);
-    info->current_generation++;
-    return HPyLong_FromLong(uctx, info->current_generation);
+    DHLock_acquire(&info->lock);
+    long gen = ++info->current_generation;
+    DHLock_release(&info->lock);
+    return HPyLong_FromLong(uctx, gen);
 }
 
-static UHPy build_list_of_handles(HPyContext *uctx, UHPy u_self, DHQueue *q,
-                                  long gen)
+static UHPy build_list_of_handles(HPyContext *uctx, UHPy u_self,
+                                  HPyDebugInfo *info, DHQueue *q, long gen)
 {
     UHPy u_DebugHandleType = HPy_NULL;
     UHPy u_result = HPy_NULL;
     UHPy u_item = HPy_NULL;
+    DebugHandle **handles = NULL;
+    HPy_ssize_t n = 0;
 
     u_DebugHandleType = HPy_GetAttr_s(uctx, u_self, "DebugHandle");
     if (HPy_IsNull(u_DebugHandleType))
         goto error;
 
+    // take a snapshot of the queue while holding the lock, because creating
+    // the DebugHandle objects below might call back into the debug context.
+    // The DebugHandleObjects never dereference these pointers without
+    // checking that they are still alive, see find_handle
+    while (1) {
+        DHLock_acquire(&info->lock);
+        HPy_ssize_t size = q->size;
+        DHLock_release(&info->lock);
+        handles = (DebugHandle **)malloc((size + 1) * sizeof(DebugHandle *));
+        if (handles == NULL) {
+            HPyErr_NoMemory(uctx);
+            goto error;
+        }
+        DHLock_acquire(&info->lock);
+        if (q->size <= size)
+            break;
+        // the queue grew in the meantime, try again
+        DHLock_release(&info->lock);
+        free(handles);
+    }
+    DebugHandle *dh = q->head;
+    while(dh != NULL) {
+        if (dh->generation >= gen)
+            handles[n++] = dh;
+        dh = dh->next;
+    }
+    DHLock_release(&info->lock);
+
     u_result = HPyList_New(uctx, 0);
     if (HPy_IsNull(u_result))
         goto error;
 
-    DebugHandle *dh = q->head;
-    while(dh != NULL) {
-        if (dh->generation >= gen) {
-            UHPy u_item = new_DebugHandleObj(uctx, u_DebugHandleType, dh);
-            if (HPy_IsNull(u_item))
-                goto error;
-            if (HPyList_Append(uctx, u_result, u_item) == -1)
-                goto error;
-            HPy_Close(uctx, u_item);
-        }
-        dh = dh->next;
+    for (HPy_ssize_t i = 0; i < n; i++) {
+        u_item = new_DebugHandleObj(uctx, u_DebugHandleType, info, handles[i]);
+        if (HPy_IsNull(u_item))
+            goto error;
+        if (HPyList_Append(uctx, u_result, u_item) == -1)
+            goto error;
+        HPy_Close(uctx, u_item);
+        u_item = HPy_NULL;
     }
 
+    free(handles);
     HPy_Close(uctx, u_DebugHandleType);
     return u_result;
 
  error:
+    free(handles);
     HPy_Close(uctx, u_DebugHandleType);
     HPy_Close(uctx, u_result);
     HPy_Close(uctx, u_item);
@@ -71,7 +102,7 @@ static UHPy get_open_handles_impl(HPyContext *uctx, UHPy u_self, UHPy u_gen)
     if (HPyErr_Occurred(uctx))
         return HPy_NULL;
 
-    return build_list_of_handles(uctx, u_self, &info->open_handles, gen);
+    return build_list_of_handles(uctx, u_self, info, &info->open_handles, gen);
 }
 
 HPyDef_METH(get_closed_handles, "get_closed_handles", get_closed_handles_impl,
@@ -92,7 +123,7 @@ static UHPy get_closed_handles_impl(HPyContext *uctx, UHPy u_self, HPy *args, HP
         if (HPyErr_Occurred(uctx))
             return HPy_NULL;
     }
-    return build_list_of_handles(uctx, u_self, &info->closed_handles, gen);
+    return build_list_of_handles(uctx, u_self, info, &info->closed_handles, gen);
 }
 
 HPyDef_METH(get_closed_handles_queue_max_size, "get_closed_handles_queue_max_size",
@@ -115,7 +146,9 @@ static UHPy set_closed_handles_queue_max_size_impl(HPyContext *uctx, UHPy u_self
     HPy_ssize_t size = HPyLong_AsSize_t(uctx, u_size);
     if (HPyErr_Occurred(uctx))
         return HPy_NULL;
+    DHLock_acquire(&info->lock);
     info->closed_handles_queue_max_size = size;
+    DHLock_release(&info->lock);
     return HPy_Dup(uctx, uctx->h_None);
 }
 
@@ -139,7 +172,9 @@ static UHPy set_protected_raw_data_max_size_impl(HPyContext *uctx, UHPy u_self,
     HPy_ssize_t size = HPyLong_AsSize_t(uctx, u_size);
     if (HPyErr_Occurred(uctx))
         return HPy_NULL;
+    DHLock_acquire(&info->lock);
     info->protected_raw_data_max_size = size;
+    DHLock_release(&info->lock);
     return HPy_Dup(uctx, uctx->h_None);
 }
 
@@ -182,20 +217,50 @@ static UHPy set_on_invalid_handle_impl(HPyContext *uctx, UHPy u_self, UHPy u_arg
    DebugHandle. To make it easier to compare them, they expose the .id
    attribute, which is the address of the wrapped DebugHandle. Also,
    DebugHandleObjects compare equal if their .id is equal.
+
+   A DebugHandleObject does not keep its DebugHandle alive: the DebugHandle
+   can be reused for another handle, in which case the DebugHandleObject
+   shows the new one, or freed. So, the DebugHandle is dereferenced only
+   while holding info->lock, after checking with find_handle that it is
+   still in one of the queues. A DebugHandle which is no longer there is
+   reported as closed.
 */
 
 typedef struct {
     DebugHandle *handle;
+    HPyDebugInfo *info;
 } DebugHandleObject;
 
 HPyType_HELPERS(DebugHandleObject)
 
+// Return the DebugHandle wrapped by dh if it has not been freed, else NULL.
+// The caller must hold info->lock
+static DebugHandle *find_handle(DebugHandleObject *dh)
+{
+    DHQueue *queues[] = { &dh->info->open_handles, &dh->info->closed_handles };
+    for (int i = 0; i < 2; i++) {
+        for (DebugHandle *h = queues[i]->head; h != NULL; h = h->next) {
+            if (h == dh->handle)
+                return h;
+        }
+    }
+    return NULL;
+}
+
 HPyDef_GET(DebugHandle_obj, "obj", DebugHandle_obj_get,
            .doc="The object which the handle points to")
 static UHPy DebugHandle_obj_get(HPyContext *uctx, UHPy self, void *closure)
 {
     DebugHandleObject *dh = DebugHandleObject_AsStruct(uctx, self);
-    return HPy_Dup(uctx, dh->handle->uh);
+    UHPy uh_result = HPy_NULL;
+    DHLock_acquire(&dh->info->lock);
+    DebugHandle *handle = find_handle(dh);
+    if (handle != NULL)
+        uh_result = HPy_Dup(uctx, handle->uh);
+    DHLock_release(&dh->info->lock);
+    if (HPy_IsNull(uh_result))
+        return HPy_Dup(uctx, uctx->h_None);
+    return uh_result;
 }
 
 HPyDef_GET(DebugHandle_id, "id", DebugHandle_id_get,
@@ -211,7 +276,11 @@ HPyDef_GET(DebugHandle_is_closed, "is_closed", DebugHandle_is_closed_get,
 static UHPy DebugHandle_is_closed_get(HPyContext *uctx, UHPy self, void *closure)
 {
     DebugHandleObject *dh = DebugHandleObject_AsStruct(uctx, self);
-    return HPyBool_FromLong(uctx, dh->handle->is_closed);
+    DHLock_acquire(&dh->info->lock);
+    DebugHandle *handle = find_handle(dh);
+    bool is_closed = handle == NULL || handle->is_closed;
+    DHLock_release(&dh->info->lock);
+    return HPyBool_FromLong(uctx, is_closed);
 }
 
 HPyDef_GET(DebugHandle_raw_data_size, "raw_data_size", DebugHandle_raw_data_size_get,
@@ -219,11 +288,14 @@ HPyDef_GET(DebugHandle_raw_data_size, "raw_data_size", DebugHandle_raw_data_size
 static UHPy DebugHandle_raw_data_size_get(HPyContext *uctx, UHPy self, void *closure)
 {
     DebugHandleObject *dh = DebugHandleObject_AsStruct(uctx, self);
-    if (dh->handle->associated_data) {
-        return HPyLong_FromSsize_t(uctx, dh->handle->associated_data_size);
-    } else {
-        return HPyLong_FromLong(uctx, -1);
+    HPy_ssize_t size = -1;
+    DHLock_acquire(&dh->info->lock);
+    DebugHandle *handle = find_handle(dh);
+    if (handle != NULL && handle->associated_data) {
+        size = handle->associated_data_size;
     }
+    DHLock_release(&dh->info->lock);
+    return HPyLong_FromSsize_t(uctx, size);
 }
 
 HPyDef_SLOT(DebugHandle_cmp, DebugHandle_cmp_impl, HPy_tp_richcompare)
@@ -252,10 +324,18 @@ static UHPy DebugHandle_repr_impl(HPyContext *uctx, UHPy self)
     UHPy uh_fmt = HPy_NULL;
     UHPy uh_id = HPy_NULL;
     UHPy uh_args = HPy_NULL;
+    UHPy uh_obj = HPy_NULL;
     UHPy uh_result = HPy_NULL;
 
+    DHLock_acquire(&dh->info->lock);
+    DebugHandle *handle = find_handle(dh);
+    bool is_closed = handle == NULL || handle->is_closed;
+    if (!is_closed)
+        uh_obj = HPy_Dup(uctx, handle->uh);
+    DHLock_release(&dh->info->lock);
+
     const char *fmt = NULL;
-    if (dh->handle->is_closed)
+    if (is_closed)
         fmt = "<DebugHandle 0x%x CLOSED>";
     else
         fmt = "<DebugHandle 0x%x for %r>";
@@ -269,10 +349,10 @@ static UHPy DebugHandle_repr_impl(HPyContext *uctx, UHPy self)
     if (HPy_IsNull(uh_id))
         goto exit;
 
-    if (dh->handle->is_closed)
+    if (is_closed)
         uh_args = HPyTuple_FromArray(uctx, (UHPy[]){uh_id}, 1);
     else
-        uh_args = HPyTuple_FromArray(uctx, (UHPy[]){uh_id, dh->handle->uh}, 2);
+        uh_args = HPyTuple_FromArray(uctx, (UHPy[]){uh_id, uh_obj}, 2);
     if (HPy_IsNull(uh_args))
         goto exit;
 
@@ -282,6 +362,7 @@ static UHPy DebugHandle_repr_impl(HPyContext *uctx, UHPy self)
     HPy_Close(uctx, uh_fmt);
     HPy_Close(uctx, uh_id);
     HPy_Close(uctx, uh_args);
+    HPy_Close(uctx, uh_obj);
     return uh_result;
 }
 
@@ -292,7 +373,16 @@ static UHPy DebugHandle__force_close_impl(HPyContext *uctx, UHPy self)
 {
     DebugHandleObject *dh = DebugHandleObject_AsStruct(uctx, self);
     HPyContext *dctx = hpy_debug_get_ctx(uctx);
-    HPy_Close(dctx, as_DHPy(dh->handle));
+    // pin the handle, so that it stays alive until HPy_Close is done with it
+    DHLock_acquire(&dh->info->lock);
+    DebugHandle *handle = find_handle(dh);
+    if (handle != NULL)
+        DebugHandle_pin(dh->info, handle);
+    DHLock_release(&dh->info->lock);
+    if (handle != NULL) {
+        HPy_Close(dctx, as_DHPy(handle));
+        DebugHandle_unpin(dh->info, handle);
+    }
     return HPy_Dup(uctx, uctx->h_None);
 }
 
@@ -316,11 +406,14 @@ static HPyType_Spec DebugHandleType_spec = {
 
 
 static UHPy new_DebugHandleObj(HPyContext *uctx, UHPy u_DebugHandleType,
-                               DebugHandle *handle)
+                               HPyDebugInfo *info, DebugHandle *handle)
 {
     DebugHandleObject *dhobj;
     UHPy u_result = HPy_New(uctx, u_DebugHandleType, &dhobj);
+    if (HPy_IsNull(u_result))
+        return HPy_NULL;
     dhobj->handle = handle;
+    dhobj->info = info;
     return u_result;
 }
 
@@ -343,7 +436,8 @@ static HPyModuleDef moduledef = {
     .name = "hpy.debug._debug",
     .doc = "HPy debug mode",
     .size = -1,
-    .defines = module_defines
+    .defines = module_defines,
+    .gil_not_used = 1,
 };
 
 
@@ -354,10 +448,13 @@ static UHPy init__debug_impl(HPyContext *uctx)
     if (HPy_IsNull(m))
         return HPy_NULL;
 
-    UHPy h_DebugHandleType = HPyType_FromSpec(uctx, &DebugHandleType_spec, NULL);
-    if (HPy_IsNull(h_DebugHandleType))
+    HPyAttrDef attrs[] = {
+        HPyAttr_TYPE("DebugHandle", &DebugHandleType_spec, NULL),
+        {0}
+    };
+    if (HPy_SetAttrs(uctx, m, attrs) < 0) {
+        HPy_Close(uctx, m);
         return HPy_NULL;
-    HPy_SetAttr_s(uctx, m, "DebugHandle", h_DebugHandleType);
-    HPy_Close(uctx, h_DebugHandleType);
+    }
     return m;
 }
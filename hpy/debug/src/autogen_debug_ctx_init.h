@@ -29,6 +29,15 @@ size_t debug_ctx_Long_AsSize_t(HPyContext *dctx, DHPy h);
 HPy_ssize_t debug_ctx_Long_AsSsize_t(HPyContext *dctx, DHPy h);
 DHPy debug_ctx_Float_FromDouble(HPyContext *dctx, double v);
 double debug_ctx_Float_AsDouble(HPyContext *dctx, DHPy h);
+DHPy debug_ctx_Long_FromString(HPyContext *dctx, const char *str, HPy_ssize_t size, int base);
+DHPy debug_ctx_Float_FromString(HPyContext *dctx, const char *str, HPy_ssize_t size);
+HPy_ssize_t debug_ctx_Long_Format(HPyContext *dctx, DHPy h, char *buf, HPy_ssize_t size);
+HPy_ssize_t debug_ctx_Float_Format(HPyContext *dctx, DHPy h, char *buf, HPy_ssize_t size);
+DHPy debug_ctx_Long_FromByteArray(HPyContext *dctx, const unsigned char *bytes, size_t n, int little_endian, int is_signed);
+int debug_ctx_Long_AsByteArray(HPyContext *dctx, DHPy h, unsigned char *bytes, size_t n, int little_endian, int is_signed);
+DHPy debug_ctx_Long_FromLimbs(HPyContext *dctx, const uint64_t *limbs, size_t n, int is_signed);
+int debug_ctx_Long_AsLimbs(HPyContext *dctx, DHPy h, uint64_t *limbs, size_t n, int is_signed);
+HPy_ssize_t debug_ctx_Long_NumBits(HPyContext *dctx, DHPy h);
 DHPy debug_ctx_Bool_FromLong(HPyContext *dctx, long v);
 HPy_ssize_t debug_ctx_Length(HPyContext *dctx, DHPy h);
 int debug_ctx_Number_Check(HPyContext *dctx, DHPy h);
@@ -68,6 +77,7 @@ DHPy debug_ctx_InPlaceXor(HPyContext *dctx, DHPy h1, DHPy h2);
 DHPy debug_ctx_InPlaceOr(HPyContext *dctx, DHPy h1, DHPy h2);
 int debug_ctx_Callable_Check(HPyContext *dctx, DHPy h);
 DHPy debug_ctx_CallTupleDict(HPyContext *dctx, DHPy callable, DHPy args, DHPy kw);
+DHPy debug_ctx_CallMethodCached(HPyContext *dctx, DHPy obj, HPyAttrCache *cache, DHPy *args, HPy_ssize_t nargs);
 void debug_ctx_FatalError(HPyContext *dctx, const char *message);
 void debug_ctx_Err_SetString(HPyContext *dctx, DHPy h_type, const char *message);
 void debug_ctx_Err_SetObject(HPyContext *dctx, DHPy h_type, DHPy h_value);
@@ -85,10 +95,12 @@ DHPy debug_ctx_Type_FromSpec(HPyContext *dctx, HPyType_Spec *spec, HPyType_SpecP
 DHPy debug_ctx_Type_GenericNew(HPyContext *dctx, DHPy type, DHPy *args, HPy_ssize_t nargs, DHPy kw);
 DHPy debug_ctx_GetAttr(HPyContext *dctx, DHPy obj, DHPy name);
 DHPy debug_ctx_GetAttr_s(HPyContext *dctx, DHPy obj, const char *name);
+DHPy debug_ctx_GetAttrCached(HPyContext *dctx, DHPy obj, HPyAttrCache *cache);
 int debug_ctx_HasAttr(HPyContext *dctx, DHPy obj, DHPy name);
 int debug_ctx_HasAttr_s(HPyContext *dctx, DHPy obj, const char *name);
 int debug_ctx_SetAttr(HPyContext *dctx, DHPy obj, DHPy name, DHPy value);
 int debug_ctx_SetAttr_s(HPyContext *dctx, DHPy obj, const char *name, DHPy value);
+int debug_ctx_SetAttrs(HPyContext *dctx, DHPy obj, HPyAttrDef *defs);
 DHPy debug_ctx_GetItem(HPyContext *dctx, DHPy obj, DHPy key);
 DHPy debug_ctx_GetItem_i(HPyContext *dctx, DHPy obj, HPy_ssize_t idx);
 DHPy debug_ctx_GetItem_s(HPyContext *dctx, DHPy obj, const char *key);
@@ -96,12 +108,19 @@ int debug_ctx_Contains(HPyContext *dctx, DHPy container, DHPy key);
 int debug_ctx_SetItem(HPyContext *dctx, DHPy obj, DHPy key, DHPy value);
 int debug_ctx_SetItem_i(HPyContext *dctx, DHPy obj, HPy_ssize_t idx, DHPy value);
 int debug_ctx_SetItem_s(HPyContext *dctx, DHPy obj, const char *key, DHPy value);
+DHPy debug_ctx_GetSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end);
+int debug_ctx_SetSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end, DHPy value);
+int debug_ctx_DelSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end);
+DHPy debug_ctx_GetSliceView(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end);
 DHPy debug_ctx_Type(HPyContext *dctx, DHPy obj);
 int debug_ctx_TypeCheck(HPyContext *dctx, DHPy obj, DHPy type);
 int debug_ctx_Is(HPyContext *dctx, DHPy obj, DHPy other);
 void *debug_ctx_AsStruct(HPyContext *dctx, DHPy h);
 void *debug_ctx_AsStructLegacy(HPyContext *dctx, DHPy h);
 DHPy debug_ctx_New(HPyContext *dctx, DHPy h_type, void **data);
+void *debug_ctx_Type_GetData(HPyContext *dctx, DHPy type);
+HPy_ssize_t debug_ctx_SetDeallocBudget(HPyContext *dctx, HPy_ssize_t budget);
+int debug_ctx_DrainDeallocs(HPyContext *dctx);
 DHPy debug_ctx_Repr(HPyContext *dctx, DHPy obj);
 DHPy debug_ctx_Str(HPyContext *dctx, DHPy obj);
 DHPy debug_ctx_ASCII(HPyContext *dctx, DHPy obj);
@@ -116,40 +135,220 @@ char *debug_ctx_Bytes_AsString(HPyContext *dctx, DHPy h);
 char *debug_ctx_Bytes_AS_STRING(HPyContext *dctx, DHPy h);
 DHPy debug_ctx_Bytes_FromString(HPyContext *dctx, const char *v);
 DHPy debug_ctx_Bytes_FromStringAndSize(HPyContext *dctx, const char *v, HPy_ssize_t len);
+DHPy debug_ctx_Bytes_GetSlice(HPyContext *dctx, DHPy h, HPy_ssize_t start, HPy_ssize_t end);
 DHPy debug_ctx_Unicode_FromString(HPyContext *dctx, const char *utf8);
+DHPy debug_ctx_Unicode_FromStringAndSize(HPyContext *dctx, const char *utf8, HPy_ssize_t size);
 int debug_ctx_Unicode_Check(HPyContext *dctx, DHPy h);
 DHPy debug_ctx_Unicode_AsUTF8String(HPyContext *dctx, DHPy h);
 const char *debug_ctx_Unicode_AsUTF8AndSize(HPyContext *dctx, DHPy h, HPy_ssize_t *size);
 DHPy debug_ctx_Unicode_FromWideChar(HPyContext *dctx, const wchar_t *w, HPy_ssize_t size);
 DHPy debug_ctx_Unicode_DecodeFSDefault(HPyContext *dctx, const char *v);
 DHPy debug_ctx_Unicode_DecodeFSDefaultAndSize(HPyContext *dctx, const char *v, HPy_ssize_t size);
+DHPy debug_ctx_Unicode_Substring(HPyContext *dctx, DHPy h, HPy_ssize_t start, HPy_ssize_t end);
 int debug_ctx_List_Check(HPyContext *dctx, DHPy h);
 DHPy debug_ctx_List_New(HPyContext *dctx, HPy_ssize_t len);
 int debug_ctx_List_Append(HPyContext *dctx, DHPy h_list, DHPy h_item);
+int debug_ctx_List_AppendSteal(HPyContext *dctx, DHPy h_list, DHPy h_item);
+DHPy debug_ctx_List_GetSlice(HPyContext *dctx, DHPy h_list, HPy_ssize_t start, HPy_ssize_t end);
 int debug_ctx_Dict_Check(HPyContext *dctx, DHPy h);
 DHPy debug_ctx_Dict_New(HPyContext *dctx);
+int debug_ctx_Set_Check(HPyContext *dctx, DHPy h);
+int debug_ctx_FrozenSet_Check(HPyContext *dctx, DHPy h);
+DHPy debug_ctx_Set_New(HPyContext *dctx, HPy_ssize_t size_hint);
+int debug_ctx_Set_Add(HPyContext *dctx, DHPy h_set, DHPy h_item);
+int debug_ctx_Set_AddArray(HPyContext *dctx, DHPy h_set, DHPy items[], HPy_ssize_t n);
+int debug_ctx_Set_Contains(HPyContext *dctx, DHPy h_set, DHPy h_item);
 int debug_ctx_Tuple_Check(HPyContext *dctx, DHPy h);
 DHPy debug_ctx_Tuple_FromArray(HPyContext *dctx, DHPy items[], HPy_ssize_t n);
+DHPy debug_ctx_Tuple_GetSlice(HPyContext *dctx, DHPy h_tuple, HPy_ssize_t start, HPy_ssize_t end);
 DHPy debug_ctx_Import_ImportModule(HPyContext *dctx, const char *name);
 DHPy debug_ctx_FromPyObject(HPyContext *dctx, cpy_PyObject *obj);
 cpy_PyObject *debug_ctx_AsPyObject(HPyContext *dctx, DHPy h);
 void debug_ctx_CallRealFunctionFromTrampoline(HPyContext *dctx, HPyFunc_Signature sig, HPyCFunction func, void *args);
 HPyListBuilder debug_ctx_ListBuilder_New(HPyContext *dctx, HPy_ssize_t initial_size);
 void debug_ctx_ListBuilder_Set(HPyContext *dctx, HPyListBuilder builder, HPy_ssize_t index, DHPy h_item);
+void debug_ctx_ListBuilder_SetSteal(HPyContext *dctx, HPyListBuilder builder, HPy_ssize_t index, DHPy h_item);
 DHPy debug_ctx_ListBuilder_Build(HPyContext *dctx, HPyListBuilder builder);
 void debug_ctx_ListBuilder_Cancel(HPyContext *dctx, HPyListBuilder builder);
 HPyTupleBuilder debug_ctx_TupleBuilder_New(HPyContext *dctx, HPy_ssize_t initial_size);
 void debug_ctx_TupleBuilder_Set(HPyContext *dctx, HPyTupleBuilder builder, HPy_ssize_t index, DHPy h_item);
+void debug_ctx_TupleBuilder_SetSteal(HPyContext *dctx, HPyTupleBuilder builder, HPy_ssize_t index, DHPy h_item);
 DHPy debug_ctx_TupleBuilder_Build(HPyContext *dctx, HPyTupleBuilder builder);
 void debug_ctx_TupleBuilder_Cancel(HPyContext *dctx, HPyTupleBuilder builder);
+HPyFrozenSetBuilder debug_ctx_FrozenSetBuilder_New(HPyContext *dctx, HPy_ssize_t size_hint);
+int debug_ctx_FrozenSetBuilder_Add(HPyContext *dctx, HPyFrozenSetBuilder builder, DHPy h_item);
+DHPy debug_ctx_FrozenSetBuilder_Build(HPyContext *dctx, HPyFrozenSetBuilder builder);
+void debug_ctx_FrozenSetBuilder_Cancel(HPyContext *dctx, HPyFrozenSetBuilder builder);
 HPyTracker debug_ctx_Tracker_New(HPyContext *dctx, HPy_ssize_t size);
 int debug_ctx_Tracker_Add(HPyContext *dctx, HPyTracker ht, DHPy h);
 void debug_ctx_Tracker_ForgetAll(HPyContext *dctx, HPyTracker ht);
 void debug_ctx_Tracker_Close(HPyContext *dctx, HPyTracker ht);
+void *debug_ctx_Mem_Malloc(HPyContext *dctx, size_t size);
+void *debug_ctx_Mem_Calloc(HPyContext *dctx, size_t nelem, size_t elsize);
+void *debug_ctx_Mem_Realloc(HPyContext *dctx, void *ptr, size_t size);
+void debug_ctx_Mem_Free(HPyContext *dctx, void *ptr);
+void *debug_ctx_Mem_ScratchAlloc(HPyContext *dctx, size_t size);
 void debug_ctx_Field_Store(HPyContext *dctx, DHPy target_object, HPyField *target_field, DHPy h);
 DHPy debug_ctx_Field_Load(HPyContext *dctx, DHPy source_object, HPyField source_field);
+DHPy debug_ctx_Field_LoadAt(HPyContext *dctx, DHPy source_object, HPyField *source_field);
+void debug_ctx_Global_Store(HPyContext *dctx, HPyGlobal *global, DHPy h);
+DHPy debug_ctx_Global_Load(HPyContext *dctx, HPyGlobal global);
+DHPy debug_ctx_Global_LoadAt(HPyContext *dctx, HPyGlobal *global);
 void debug_ctx_Dump(HPyContext *dctx, DHPy h);
 
+DHPy debug_leaks_ctx_Module_Create(HPyContext *dctx, HPyModuleDef *def);
+DHPy debug_leaks_ctx_Dup(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_Long_FromLong(HPyContext *dctx, long value);
+DHPy debug_leaks_ctx_Long_FromUnsignedLong(HPyContext *dctx, unsigned long value);
+DHPy debug_leaks_ctx_Long_FromLongLong(HPyContext *dctx, long long v);
+DHPy debug_leaks_ctx_Long_FromUnsignedLongLong(HPyContext *dctx, unsigned long long v);
+DHPy debug_leaks_ctx_Long_FromSize_t(HPyContext *dctx, size_t value);
+DHPy debug_leaks_ctx_Long_FromSsize_t(HPyContext *dctx, HPy_ssize_t value);
+long debug_leaks_ctx_Long_AsLong(HPyContext *dctx, DHPy h);
+unsigned long debug_leaks_ctx_Long_AsUnsignedLong(HPyContext *dctx, DHPy h);
+unsigned long debug_leaks_ctx_Long_AsUnsignedLongMask(HPyContext *dctx, DHPy h);
+long long debug_leaks_ctx_Long_AsLongLong(HPyContext *dctx, DHPy h);
+unsigned long long debug_leaks_ctx_Long_AsUnsignedLongLong(HPyContext *dctx, DHPy h);
+unsigned long long debug_leaks_ctx_Long_AsUnsignedLongLongMask(HPyContext *dctx, DHPy h);
+size_t debug_leaks_ctx_Long_AsSize_t(HPyContext *dctx, DHPy h);
+HPy_ssize_t debug_leaks_ctx_Long_AsSsize_t(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_Float_FromDouble(HPyContext *dctx, double v);
+double debug_leaks_ctx_Float_AsDouble(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_Long_FromString(HPyContext *dctx, const char *str, HPy_ssize_t size, int base);
+DHPy debug_leaks_ctx_Float_FromString(HPyContext *dctx, const char *str, HPy_ssize_t size);
+HPy_ssize_t debug_leaks_ctx_Long_Format(HPyContext *dctx, DHPy h, char *buf, HPy_ssize_t size);
+HPy_ssize_t debug_leaks_ctx_Float_Format(HPyContext *dctx, DHPy h, char *buf, HPy_ssize_t size);
+DHPy debug_leaks_ctx_Long_FromByteArray(HPyContext *dctx, const unsigned char *bytes, size_t n, int little_endian, int is_signed);
+int debug_leaks_ctx_Long_AsByteArray(HPyContext *dctx, DHPy h, unsigned char *bytes, size_t n, int little_endian, int is_signed);
+DHPy debug_leaks_ctx_Long_FromLimbs(HPyContext *dctx, const uint64_t *limbs, size_t n, int is_signed);
+int debug_leaks_ctx_Long_AsLimbs(HPyContext *dctx, DHPy h, uint64_t *limbs, size_t n, int is_signed);
+HPy_ssize_t debug_leaks_ctx_Long_NumBits(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_Bool_FromLong(HPyContext *dctx, long v);
+HPy_ssize_t debug_leaks_ctx_Length(HPyContext *dctx, DHPy h);
+int debug_leaks_ctx_Number_Check(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_Add(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_Subtract(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_Multiply(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_MatrixMultiply(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_FloorDivide(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_TrueDivide(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_Remainder(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_Divmod(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_Power(HPyContext *dctx, DHPy h1, DHPy h2, DHPy h3);
+DHPy debug_leaks_ctx_Negative(HPyContext *dctx, DHPy h1);
+DHPy debug_leaks_ctx_Positive(HPyContext *dctx, DHPy h1);
+DHPy debug_leaks_ctx_Absolute(HPyContext *dctx, DHPy h1);
+DHPy debug_leaks_ctx_Invert(HPyContext *dctx, DHPy h1);
+DHPy debug_leaks_ctx_Lshift(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_Rshift(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_And(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_Xor(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_Or(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_Index(HPyContext *dctx, DHPy h1);
+DHPy debug_leaks_ctx_Long(HPyContext *dctx, DHPy h1);
+DHPy debug_leaks_ctx_Float(HPyContext *dctx, DHPy h1);
+DHPy debug_leaks_ctx_InPlaceAdd(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_InPlaceSubtract(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_InPlaceMultiply(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_InPlaceMatrixMultiply(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_InPlaceFloorDivide(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_InPlaceTrueDivide(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_InPlaceRemainder(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_InPlacePower(HPyContext *dctx, DHPy h1, DHPy h2, DHPy h3);
+DHPy debug_leaks_ctx_InPlaceLshift(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_InPlaceRshift(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_InPlaceAnd(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_InPlaceXor(HPyContext *dctx, DHPy h1, DHPy h2);
+DHPy debug_leaks_ctx_InPlaceOr(HPyContext *dctx, DHPy h1, DHPy h2);
+int debug_leaks_ctx_Callable_Check(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_CallTupleDict(HPyContext *dctx, DHPy callable, DHPy args, DHPy kw);
+void debug_leaks_ctx_Err_SetString(HPyContext *dctx, DHPy h_type, const char *message);
+void debug_leaks_ctx_Err_SetObject(HPyContext *dctx, DHPy h_type, DHPy h_value);
+DHPy debug_leaks_ctx_Err_SetFromErrnoWithFilename(HPyContext *dctx, DHPy h_type, const char *filename_fsencoded);
+DHPy debug_leaks_ctx_Err_SetFromErrnoWithFilenameObjects(HPyContext *dctx, DHPy h_type, DHPy filename1, DHPy filename2);
+int debug_leaks_ctx_Err_ExceptionMatches(HPyContext *dctx, DHPy exc);
+DHPy debug_leaks_ctx_Err_NoMemory(HPyContext *dctx);
+DHPy debug_leaks_ctx_Err_NewException(HPyContext *dctx, const char *name, DHPy base, DHPy dict);
+DHPy debug_leaks_ctx_Err_NewExceptionWithDoc(HPyContext *dctx, const char *name, const char *doc, DHPy base, DHPy dict);
+int debug_leaks_ctx_Err_WarnEx(HPyContext *dctx, DHPy category, const char *message, HPy_ssize_t stack_level);
+int debug_leaks_ctx_IsTrue(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_GetAttr(HPyContext *dctx, DHPy obj, DHPy name);
+DHPy debug_leaks_ctx_GetAttr_s(HPyContext *dctx, DHPy obj, const char *name);
+DHPy debug_leaks_ctx_GetAttrCached(HPyContext *dctx, DHPy obj, HPyAttrCache *cache);
+int debug_leaks_ctx_HasAttr(HPyContext *dctx, DHPy obj, DHPy name);
+int debug_leaks_ctx_HasAttr_s(HPyContext *dctx, DHPy obj, const char *name);
+int debug_leaks_ctx_SetAttr(HPyContext *dctx, DHPy obj, DHPy name, DHPy value);
+int debug_leaks_ctx_SetAttr_s(HPyContext *dctx, DHPy obj, const char *name, DHPy value);
+DHPy debug_leaks_ctx_GetItem(HPyContext *dctx, DHPy obj, DHPy key);
+DHPy debug_leaks_ctx_GetItem_i(HPyContext *dctx, DHPy obj, HPy_ssize_t idx);
+DHPy debug_leaks_ctx_GetItem_s(HPyContext *dctx, DHPy obj, const char *key);
+int debug_leaks_ctx_Contains(HPyContext *dctx, DHPy container, DHPy key);
+int debug_leaks_ctx_SetItem(HPyContext *dctx, DHPy obj, DHPy key, DHPy value);
+int debug_leaks_ctx_SetItem_i(HPyContext *dctx, DHPy obj, HPy_ssize_t idx, DHPy value);
+int debug_leaks_ctx_SetItem_s(HPyContext *dctx, DHPy obj, const char *key, DHPy value);
+DHPy debug_leaks_ctx_GetSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end);
+int debug_leaks_ctx_SetSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end, DHPy value);
+int debug_leaks_ctx_DelSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end);
+DHPy debug_leaks_ctx_GetSliceView(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end);
+DHPy debug_leaks_ctx_Type(HPyContext *dctx, DHPy obj);
+int debug_leaks_ctx_TypeCheck(HPyContext *dctx, DHPy obj, DHPy type);
+int debug_leaks_ctx_Is(HPyContext *dctx, DHPy obj, DHPy other);
+void *debug_leaks_ctx_AsStruct(HPyContext *dctx, DHPy h);
+void *debug_leaks_ctx_AsStructLegacy(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_New(HPyContext *dctx, DHPy h_type, void **data);
+void *debug_leaks_ctx_Type_GetData(HPyContext *dctx, DHPy type);
+DHPy debug_leaks_ctx_Repr(HPyContext *dctx, DHPy obj);
+DHPy debug_leaks_ctx_Str(HPyContext *dctx, DHPy obj);
+DHPy debug_leaks_ctx_ASCII(HPyContext *dctx, DHPy obj);
+DHPy debug_leaks_ctx_Bytes(HPyContext *dctx, DHPy obj);
+DHPy debug_leaks_ctx_RichCompare(HPyContext *dctx, DHPy v, DHPy w, int op);
+HPy_hash_t debug_leaks_ctx_Hash(HPyContext *dctx, DHPy obj);
+int debug_leaks_ctx_Bytes_Check(HPyContext *dctx, DHPy h);
+HPy_ssize_t debug_leaks_ctx_Bytes_Size(HPyContext *dctx, DHPy h);
+HPy_ssize_t debug_leaks_ctx_Bytes_GET_SIZE(HPyContext *dctx, DHPy h);
+char *debug_leaks_ctx_Bytes_AsString(HPyContext *dctx, DHPy h);
+char *debug_leaks_ctx_Bytes_AS_STRING(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_Bytes_FromString(HPyContext *dctx, const char *v);
+DHPy debug_leaks_ctx_Bytes_FromStringAndSize(HPyContext *dctx, const char *v, HPy_ssize_t len);
+DHPy debug_leaks_ctx_Bytes_GetSlice(HPyContext *dctx, DHPy h, HPy_ssize_t start, HPy_ssize_t end);
+DHPy debug_leaks_ctx_Unicode_FromString(HPyContext *dctx, const char *utf8);
+DHPy debug_leaks_ctx_Unicode_FromStringAndSize(HPyContext *dctx, const char *utf8, HPy_ssize_t size);
+int debug_leaks_ctx_Unicode_Check(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_Unicode_AsUTF8String(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_Unicode_FromWideChar(HPyContext *dctx, const wchar_t *w, HPy_ssize_t size);
+DHPy debug_leaks_ctx_Unicode_DecodeFSDefault(HPyContext *dctx, const char *v);
+DHPy debug_leaks_ctx_Unicode_DecodeFSDefaultAndSize(HPyContext *dctx, const char *v, HPy_ssize_t size);
+DHPy debug_leaks_ctx_Unicode_Substring(HPyContext *dctx, DHPy h, HPy_ssize_t start, HPy_ssize_t end);
+int debug_leaks_ctx_List_Check(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_List_New(HPyContext *dctx, HPy_ssize_t len);
+int debug_leaks_ctx_List_Append(HPyContext *dctx, DHPy h_list, DHPy h_item);
+DHPy debug_leaks_ctx_List_GetSlice(HPyContext *dctx, DHPy h_list, HPy_ssize_t start, HPy_ssize_t end);
+int debug_leaks_ctx_Dict_Check(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_Dict_New(HPyContext *dctx);
+int debug_leaks_ctx_Set_Check(HPyContext *dctx, DHPy h);
+int debug_leaks_ctx_FrozenSet_Check(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_Set_New(HPyContext *dctx, HPy_ssize_t size_hint);
+int debug_leaks_ctx_Set_Add(HPyContext *dctx, DHPy h_set, DHPy h_item);
+int debug_leaks_ctx_Set_Contains(HPyContext *dctx, DHPy h_set, DHPy h_item);
+int debug_leaks_ctx_Tuple_Check(HPyContext *dctx, DHPy h);
+DHPy debug_leaks_ctx_Tuple_GetSlice(HPyContext *dctx, DHPy h_tuple, HPy_ssize_t start, HPy_ssize_t end);
+DHPy debug_leaks_ctx_Import_ImportModule(HPyContext *dctx, const char *name);
+DHPy debug_leaks_ctx_FromPyObject(HPyContext *dctx, cpy_PyObject *obj);
+cpy_PyObject *debug_leaks_ctx_AsPyObject(HPyContext *dctx, DHPy h);
+void debug_leaks_ctx_ListBuilder_Set(HPyContext *dctx, HPyListBuilder builder, HPy_ssize_t index, DHPy h_item);
+DHPy debug_leaks_ctx_ListBuilder_Build(HPyContext *dctx, HPyListBuilder builder);
+void debug_leaks_ctx_TupleBuilder_Set(HPyContext *dctx, HPyTupleBuilder builder, HPy_ssize_t index, DHPy h_item);
+DHPy debug_leaks_ctx_TupleBuilder_Build(HPyContext *dctx, HPyTupleBuilder builder);
+int debug_leaks_ctx_FrozenSetBuilder_Add(HPyContext *dctx, HPyFrozenSetBuilder builder, DHPy h_item);
+DHPy debug_leaks_ctx_FrozenSetBuilder_Build(HPyContext *dctx, HPyFrozenSetBuilder builder);
+void debug_leaks_ctx_Field_Store(HPyContext *dctx, DHPy target_object, HPyField *target_field, DHPy h);
+DHPy debug_leaks_ctx_Field_Load(HPyContext *dctx, DHPy source_object, HPyField source_field);
+DHPy debug_leaks_ctx_Field_LoadAt(HPyContext *dctx, DHPy source_object, HPyField *source_field);
+void debug_leaks_ctx_Global_Store(HPyContext *dctx, HPyGlobal *global, DHPy h);
+DHPy debug_leaks_ctx_Global_Load(HPyContext *dctx, HPyGlobal global);
+DHPy debug_leaks_ctx_Global_LoadAt(HPyContext *dctx, HPyGlobal *global);
+void debug_leaks_ctx_Dump(HPyContext *dctx, DHPy h);
+
 static inline void debug_ctx_init_fields(HPyContext *dctx, HPyContext *uctx)
 {
     dctx->h_None = DHPy_open(dctx, uctx->h_None);
@@ -248,6 +447,15 @@ static inline void debug_ctx_init_fields(HPyContext *dctx, HPyContext *uctx)
     dctx->ctx_Long_AsSsize_t = &debug_ctx_Long_AsSsize_t;
     dctx->ctx_Float_FromDouble = &debug_ctx_Float_FromDouble;
     dctx->ctx_Float_AsDouble = &debug_ctx_Float_AsDouble;
+    dctx->ctx_Long_FromString = &debug_ctx_Long_FromString;
+    dctx->ctx_Float_FromString = &debug_ctx_Float_FromString;
+    dctx->ctx_Long_Format = &debug_ctx_Long_Format;
+    dctx->ctx_Float_Format = &debug_ctx_Float_Format;
+    dctx->ctx_Long_FromByteArray = &debug_ctx_Long_FromByteArray;
+    dctx->ctx_Long_AsByteArray = &debug_ctx_Long_AsByteArray;
+    dctx->ctx_Long_FromLimbs = &debug_ctx_Long_FromLimbs;
+    dctx->ctx_Long_AsLimbs = &debug_ctx_Long_AsLimbs;
+    dctx->ctx_Long_NumBits = &debug_ctx_Long_NumBits;
     dctx->ctx_Bool_FromLong = &debug_ctx_Bool_FromLong;
     dctx->ctx_Length = &debug_ctx_Length;
     dctx->ctx_Number_Check = &debug_ctx_Number_Check;
@@ -287,6 +495,7 @@ static inline void debug_ctx_init_fields(HPyContext *dctx, HPyContext *uctx)
     dctx->ctx_InPlaceOr = &debug_ctx_InPlaceOr;
     dctx->ctx_Callable_Check = &debug_ctx_Callable_Check;
     dctx->ctx_CallTupleDict = &debug_ctx_CallTupleDict;
+    dctx->ctx_CallMethodCached = &debug_ctx_CallMethodCached;
     dctx->ctx_FatalError = &debug_ctx_FatalError;
     dctx->ctx_Err_SetString = &debug_ctx_Err_SetString;
     dctx->ctx_Err_SetObject = &debug_ctx_Err_SetObject;
@@ -304,10 +513,12 @@ static inline void debug_ctx_init_fields(HPyContext *dctx, HPyContext *uctx)
     dctx->ctx_Type_GenericNew = &debug_ctx_Type_GenericNew;
     dctx->ctx_GetAttr = &debug_ctx_GetAttr;
     dctx->ctx_GetAttr_s = &debug_ctx_GetAttr_s;
+    dctx->ctx_GetAttrCached = &debug_ctx_GetAttrCached;
     dctx->ctx_HasAttr = &debug_ctx_HasAttr;
     dctx->ctx_HasAttr_s = &debug_ctx_HasAttr_s;
     dctx->ctx_SetAttr = &debug_ctx_SetAttr;
     dctx->ctx_SetAttr_s = &debug_ctx_SetAttr_s;
+    dctx->ctx_SetAttrs = &debug_ctx_SetAttrs;
     dctx->ctx_GetItem = &debug_ctx_GetItem;
     dctx->ctx_GetItem_i = &debug_ctx_GetItem_i;
     dctx->ctx_GetItem_s = &debug_ctx_GetItem_s;
@@ -315,12 +526,19 @@ static inline void debug_ctx_init_fields(HPyContext *dctx, HPyContext *uctx)
     dctx->ctx_SetItem = &debug_ctx_SetItem;
     dctx->ctx_SetItem_i = &debug_ctx_SetItem_i;
     dctx->ctx_SetItem_s = &debug_ctx_SetItem_s;
+    dctx->ctx_GetSlice = &debug_ctx_GetSlice;
+    dctx->ctx_SetSlice = &debug_ctx_SetSlice;
+    dctx->ctx_DelSlice = &debug_ctx_DelSlice;
+    dctx->ctx_GetSliceView = &debug_ctx_GetSliceView;
     dctx->ctx_Type = &debug_ctx_Type;
     dctx->ctx_TypeCheck = &debug_ctx_TypeCheck;
     dctx->ctx_Is = &debug_ctx_Is;
     dctx->ctx_AsStruct = &debug_ctx_AsStruct;
     dctx->ctx_AsStructLegacy = &debug_ctx_AsStructLegacy;
     dctx->ctx_New = &debug_ctx_New;
+    dctx->ctx_Type_GetData = &debug_ctx_Type_GetData;
+    dctx->ctx_SetDeallocBudget = &debug_ctx_SetDeallocBudget;
+    dctx->ctx_DrainDeallocs = &debug_ctx_DrainDeallocs;
     dctx->ctx_Repr = &debug_ctx_Repr;
     dctx->ctx_Str = &debug_ctx_Str;
     dctx->ctx_ASCII = &debug_ctx_ASCII;
@@ -335,37 +553,220 @@ static inline void debug_ctx_init_fields(HPyContext *dctx, HPyContext *uctx)
     dctx->ctx_Bytes_AS_STRING = &debug_ctx_Bytes_AS_STRING;
     dctx->ctx_Bytes_FromString = &debug_ctx_Bytes_FromString;
     dctx->ctx_Bytes_FromStringAndSize = &debug_ctx_Bytes_FromStringAndSize;
+    dctx->ctx_Bytes_GetSlice = &debug_ctx_Bytes_GetSlice;
     dctx->ctx_Unicode_FromString = &debug_ctx_Unicode_FromString;
+    dctx->ctx_Unicode_FromStringAndSize = &debug_ctx_Unicode_FromStringAndSize;
     dctx->ctx_Unicode_Check = &debug_ctx_Unicode_Check;
     dctx->ctx_Unicode_AsUTF8String = &debug_ctx_Unicode_AsUTF8String;
     dctx->ctx_Unicode_AsUTF8AndSize = &debug_ctx_Unicode_AsUTF8AndSize;
     dctx->ctx_Unicode_FromWideChar = &debug_ctx_Unicode_FromWideChar;
     dctx->ctx_Unicode_DecodeFSDefault = &debug_ctx_Unicode_DecodeFSDefault;
     dctx->ctx_Unicode_DecodeFSDefaultAndSize = &debug_ctx_Unicode_DecodeFSDefaultAndSize;
+    dctx->ctx_Unicode_Substring = &debug_ctx_Unicode_Substring;
     dctx->ctx_List_Check = &debug_ctx_List_Check;
     dctx->ctx_List_New = &debug_ctx_List_New;
     dctx->ctx_List_Append = &debug_ctx_List_Append;
+    dctx->ctx_List_AppendSteal = &debug_ctx_List_AppendSteal;
+    dctx->ctx_List_GetSlice = &debug_ctx_List_GetSlice;
     dctx->ctx_Dict_Check = &debug_ctx_Dict_Check;
     dctx->ctx_Dict_New = &debug_ctx_Dict_New;
+    dctx->ctx_Set_Check = &debug_ctx_Set_Check;
+    dctx->ctx_FrozenSet_Check = &debug_ctx_FrozenSet_Check;
+    dctx->ctx_Set_New = &debug_ctx_Set_New;
+    dctx->ctx_Set_Add = &debug_ctx_Set_Add;
+    dctx->ctx_Set_AddArray = &debug_ctx_Set_AddArray;
+    dctx->ctx_Set_Contains = &debug_ctx_Set_Contains;
     dctx->ctx_Tuple_Check = &debug_ctx_Tuple_Check;
     dctx->ctx_Tuple_FromArray = &debug_ctx_Tuple_FromArray;
+    dctx->ctx_Tuple_GetSlice = &debug_ctx_Tuple_GetSlice;
     dctx->ctx_Import_ImportModule = &debug_ctx_Import_ImportModule;
     dctx->ctx_FromPyObject = &debug_ctx_FromPyObject;
     dctx->ctx_AsPyObject = &debug_ctx_AsPyObject;
     dctx->ctx_CallRealFunctionFromTrampoline = &debug_ctx_CallRealFunctionFromTrampoline;
     dctx->ctx_ListBuilder_New = &debug_ctx_ListBuilder_New;
     dctx->ctx_ListBuilder_Set = &debug_ctx_ListBuilder_Set;
+    dctx->ctx_ListBuilder_SetSteal = &debug_ctx_ListBuilder_SetSteal;
     dctx->ctx_ListBuilder_Build = &debug_ctx_ListBuilder_Build;
     dctx->ctx_ListBuilder_Cancel = &debug_ctx_ListBuilder_Cancel;
     dctx->ctx_TupleBuilder_New = &debug_ctx_TupleBuilder_New;
     dctx->ctx_TupleBuilder_Set = &debug_ctx_TupleBuilder_Set;
+    dctx->ctx_TupleBuilder_SetSteal = &debug_ctx_TupleBuilder_SetSteal;
     dctx->ctx_TupleBuilder_Build = &debug_ctx_TupleBuilder_Build;
     dctx->ctx_TupleBuilder_Cancel = &debug_ctx_TupleBuilder_Cancel;
+    dctx->ctx_FrozenSetBuilder_New = &debug_ctx_FrozenSetBuilder_New;
+    dctx->ctx_FrozenSetBuilder_Add = &debug_ctx_FrozenSetBuilder_Add;
+    dctx->ctx_FrozenSetBuilder_Build = &debug_ctx_FrozenSetBuilder_Build;
+    dctx->ctx_FrozenSetBuilder_Cancel = &debug_ctx_FrozenSetBuilder_Cancel;
     dctx->ctx_Tracker_New = &debug_ctx_Tracker_New;
     dctx->ctx_Tracker_Add = &debug_ctx_Tracker_Add;
     dctx->ctx_Tracker_ForgetAll = &debug_ctx_Tracker_ForgetAll;
     dctx->ctx_Tracker_Close = &debug_ctx_Tracker_Close;
+    dctx->ctx_Mem_Malloc = &debug_ctx_Mem_Malloc;
+    dctx->ctx_Mem_Calloc = &debug_ctx_Mem_Calloc;
+    dctx->ctx_Mem_Realloc = &debug_ctx_Mem_Realloc;
+    dctx->ctx_Mem_Free = &debug_ctx_Mem_Free;
+    dctx->ctx_Mem_ScratchAlloc = &debug_ctx_Mem_ScratchAlloc;
     dctx->ctx_Field_Store = &debug_ctx_Field_Store;
     dctx->ctx_Field_Load = &debug_ctx_Field_Load;
+    dctx->ctx_Field_LoadAt = &debug_ctx_Field_LoadAt;
+    dctx->ctx_Global_Store = &debug_ctx_Global_Store;
+    dctx->ctx_Global_Load = &debug_ctx_Global_Load;
+    dctx->ctx_Global_LoadAt = &debug_ctx_Global_LoadAt;
     dctx->ctx_Dump = &debug_ctx_Dump;
 }
+
+static inline void debug_ctx_init_leaks_fields(HPyContext *dctx)
+{
+    dctx->ctx_Module_Create = &debug_leaks_ctx_Module_Create;
+    dctx->ctx_Dup = &debug_leaks_ctx_Dup;
+    dctx->ctx_Long_FromLong = &debug_leaks_ctx_Long_FromLong;
+    dctx->ctx_Long_FromUnsignedLong = &debug_leaks_ctx_Long_FromUnsignedLong;
+    dctx->ctx_Long_FromLongLong = &debug_leaks_ctx_Long_FromLongLong;
+    dctx->ctx_Long_FromUnsignedLongLong = &debug_leaks_ctx_Long_FromUnsignedLongLong;
+    dctx->ctx_Long_FromSize_t = &debug_leaks_ctx_Long_FromSize_t;
+    dctx->ctx_Long_FromSsize_t = &debug_leaks_ctx_Long_FromSsize_t;
+    dctx->ctx_Long_AsLong = &debug_leaks_ctx_Long_AsLong;
+    dctx->ctx_Long_AsUnsignedLong = &debug_leaks_ctx_Long_AsUnsignedLong;
+    dctx->ctx_Long_AsUnsignedLongMask = &debug_leaks_ctx_Long_AsUnsignedLongMask;
+    dctx->ctx_Long_AsLongLong = &debug_leaks_ctx_Long_AsLongLong;
+    dctx->ctx_Long_AsUnsignedLongLong = &debug_leaks_ctx_Long_AsUnsignedLongLong;
+    dctx->ctx_Long_AsUnsignedLongLongMask = &debug_leaks_ctx_Long_AsUnsignedLongLongMask;
+    dctx->ctx_Long_AsSize_t = &debug_leaks_ctx_Long_AsSize_t;
+    dctx->ctx_Long_AsSsize_t = &debug_leaks_ctx_Long_AsSsize_t;
+    dctx->ctx_Float_FromDouble = &debug_leaks_ctx_Float_FromDouble;
+    dctx->ctx_Float_AsDouble = &debug_leaks_ctx_Float_AsDouble;
+    dctx->ctx_Long_FromString = &debug_leaks_ctx_Long_FromString;
+    dctx->ctx_Float_FromString = &debug_leaks_ctx_Float_FromString;
+    dctx->ctx_Long_Format = &debug_leaks_ctx_Long_Format;
+    dctx->ctx_Float_Format = &debug_leaks_ctx_Float_Format;
+    dctx->ctx_Long_FromByteArray = &debug_leaks_ctx_Long_FromByteArray;
+    dctx->ctx_Long_AsByteArray = &debug_leaks_ctx_Long_AsByteArray;
+    dctx->ctx_Long_FromLimbs = &debug_leaks_ctx_Long_FromLimbs;
+    dctx->ctx_Long_AsLimbs = &debug_leaks_ctx_Long_AsLimbs;
+    dctx->ctx_Long_NumBits = &debug_leaks_ctx_Long_NumBits;
+    dctx->ctx_Bool_FromLong = &debug_leaks_ctx_Bool_FromLong;
+    dctx->ctx_Length = &debug_leaks_ctx_Length;
+    dctx->ctx_Number_Check = &debug_leaks_ctx_Number_Check;
+    dctx->ctx_Add = &debug_leaks_ctx_Add;
+    dctx->ctx_Subtract = &debug_leaks_ctx_Subtract;
+    dctx->ctx_Multiply = &debug_leaks_ctx_Multiply;
+    dctx->ctx_MatrixMultiply = &debug_leaks_ctx_MatrixMultiply;
+    dctx->ctx_FloorDivide = &debug_leaks_ctx_FloorDivide;
+    dctx->ctx_TrueDivide = &debug_leaks_ctx_TrueDivide;
+    dctx->ctx_Remainder = &debug_leaks_ctx_Remainder;
+    dctx->ctx_Divmod = &debug_leaks_ctx_Divmod;
+    dctx->ctx_Power = &debug_leaks_ctx_Power;
+    dctx->ctx_Negative = &debug_leaks_ctx_Negative;
+    dctx->ctx_Positive = &debug_leaks_ctx_Positive;
+    dctx->ctx_Absolute = &debug_leaks_ctx_Absolute;
+    dctx->ctx_Invert = &debug_leaks_ctx_Invert;
+    dctx->ctx_Lshift = &debug_leaks_ctx_Lshift;
+    dctx->ctx_Rshift = &debug_leaks_ctx_Rshift;
+    dctx->ctx_And = &debug_leaks_ctx_And;
+    dctx->ctx_Xor = &debug_leaks_ctx_Xor;
+    dctx->ctx_Or = &debug_leaks_ctx_Or;
+    dctx->ctx_Index = &debug_leaks_ctx_Index;
+    dctx->ctx_Long = &debug_leaks_ctx_Long;
+    dctx->ctx_Float = &debug_leaks_ctx_Float;
+    dctx->ctx_InPlaceAdd = &debug_leaks_ctx_InPlaceAdd;
+    dctx->ctx_InPlaceSubtract = &debug_leaks_ctx_InPlaceSubtract;
+    dctx->ctx_InPlaceMultiply = &debug_leaks_ctx_InPlaceMultiply;
+    dctx->ctx_InPlaceMatrixMultiply = &debug_leaks_ctx_InPlaceMatrixMultiply;
+    dctx->ctx_InPlaceFloorDivide = &debug_leaks_ctx_InPlaceFloorDivide;
+    dctx->ctx_InPlaceTrueDivide = &debug_leaks_ctx_InPlaceTrueDivide;
+    dctx->ctx_InPlaceRemainder = &debug_leaks_ctx_InPlaceRemainder;
+    dctx->ctx_InPlacePower = &debug_leaks_ctx_InPlacePower;
+    dctx->ctx_InPlaceLshift = &debug_leaks_ctx_InPlaceLshift;
+    dctx->ctx_InPlaceRshift = &debug_leaks_ctx_InPlaceRshift;
+    dctx->ctx_InPlaceAnd = &debug_leaks_ctx_InPlaceAnd;
+    dctx->ctx_InPlaceXor = &debug_leaks_ctx_InPlaceXor;
+    dctx->ctx_InPlaceOr = &debug_leaks_ctx_InPlaceOr;
+    dctx->ctx_Callable_Check = &debug_leaks_ctx_Callable_Check;
+    dctx->ctx_CallTupleDict = &debug_leaks_ctx_CallTupleDict;
+    dctx->ctx_Err_SetString = &debug_leaks_ctx_Err_SetString;
+    dctx->ctx_Err_SetObject = &debug_leaks_ctx_Err_SetObject;
+    dctx->ctx_Err_SetFromErrnoWithFilename = &debug_leaks_ctx_Err_SetFromErrnoWithFilename;
+    dctx->ctx_Err_SetFromErrnoWithFilenameObjects = &debug_leaks_ctx_Err_SetFromErrnoWithFilenameObjects;
+    dctx->ctx_Err_ExceptionMatches = &debug_leaks_ctx_Err_ExceptionMatches;
+    dctx->ctx_Err_NoMemory = &debug_leaks_ctx_Err_NoMemory;
+    dctx->ctx_Err_NewException = &debug_leaks_ctx_Err_NewException;
+    dctx->ctx_Err_NewExceptionWithDoc = &debug_leaks_ctx_Err_NewExceptionWithDoc;
+    dctx->ctx_Err_WarnEx = &debug_leaks_ctx_Err_WarnEx;
+    dctx->ctx_IsTrue = &debug_leaks_ctx_IsTrue;
+    dctx->ctx_GetAttr = &debug_leaks_ctx_GetAttr;
+    dctx->ctx_GetAttr_s = &debug_leaks_ctx_GetAttr_s;
+    dctx->ctx_GetAttrCached = &debug_leaks_ctx_GetAttrCached;
+    dctx->ctx_HasAttr = &debug_leaks_ctx_HasAttr;
+    dctx->ctx_HasAttr_s = &debug_leaks_ctx_HasAttr_s;
+    dctx->ctx_SetAttr = &debug_leaks_ctx_SetAttr;
+    dctx->ctx_SetAttr_s = &debug_leaks_ctx_SetAttr_s;
+    dctx->ctx_GetItem = &debug_leaks_ctx_GetItem;
+    dctx->ctx_GetItem_i = &debug_leaks_ctx_GetItem_i;
+    dctx->ctx_GetItem_s = &debug_leaks_ctx_GetItem_s;
+    dctx->ctx_Contains = &debug_leaks_ctx_Contains;
+    dctx->ctx_SetItem = &debug_leaks_ctx_SetItem;
+    dctx->ctx_SetItem_i = &debug_leaks_ctx_SetItem_i;
+    dctx->ctx_SetItem_s = &debug_leaks_ctx_SetItem_s;
+    dctx->ctx_GetSlice = &debug_leaks_ctx_GetSlice;
+    dctx->ctx_SetSlice = &debug_leaks_ctx_SetSlice;
+    dctx->ctx_DelSlice = &debug_leaks_ctx_DelSlice;
+    dctx->ctx_GetSliceView = &debug_leaks_ctx_GetSliceView;
+    dctx->ctx_Type = &debug_leaks_ctx_Type;
+    dctx->ctx_TypeCheck = &debug_leaks_ctx_TypeCheck;
+    dctx->ctx_Is = &debug_leaks_ctx_Is;
+    dctx->ctx_AsStruct = &debug_leaks_ctx_AsStruct;
+    dctx->ctx_AsStructLegacy = &debug_leaks_ctx_AsStructLegacy;
+    dctx->ctx_New = &debug_leaks_ctx_New;
+    dctx->ctx_Type_GetData = &debug_leaks_ctx_Type_GetData;
+    dctx->ctx_Repr = &debug_leaks_ctx_Repr;
+    dctx->ctx_Str = &debug_leaks_ctx_Str;
+    dctx->ctx_ASCII = &debug_leaks_ctx_ASCII;
+    dctx->ctx_Bytes = &debug_leaks_ctx_Bytes;
+    dctx->ctx_RichCompare = &debug_leaks_ctx_RichCompare;
+    dctx->ctx_Hash = &debug_leaks_ctx_Hash;
+    dctx->ctx_Bytes_Check = &debug_leaks_ctx_Bytes_Check;
+    dctx->ctx_Bytes_Size = &debug_leaks_ctx_Bytes_Size;
+    dctx->ctx_Bytes_GET_SIZE = &debug_leaks_ctx_Bytes_GET_SIZE;
+    dctx->ctx_Bytes_AsString = &debug_leaks_ctx_Bytes_AsString;
+    dctx->ctx_Bytes_AS_STRING = &debug_leaks_ctx_Bytes_AS_STRING;
+    dctx->ctx_Bytes_FromString = &debug_leaks_ctx_Bytes_FromString;
+    dctx->ctx_Bytes_FromStringAndSize = &debug_leaks_ctx_Bytes_FromStringAndSize;
+    dctx->ctx_Bytes_GetSlice = &debug_leaks_ctx_Bytes_GetSlice;
+    dctx->ctx_Unicode_FromString = &debug_leaks_ctx_Unicode_FromString;
+    dctx->ctx_Unicode_FromStringAndSize = &debug_leaks_ctx_Unicode_FromStringAndSize;
+    dctx->ctx_Unicode_Check = &debug_leaks_ctx_Unicode_Check;
+    dctx->ctx_Unicode_AsUTF8String = &debug_leaks_ctx_Unicode_AsUTF8String;
+    dctx->ctx_Unicode_FromWideChar = &debug_leaks_ctx_Unicode_FromWideChar;
+    dctx->ctx_Unicode_DecodeFSDefault = &debug_leaks_ctx_Unicode_DecodeFSDefault;
+    dctx->ctx_Unicode_DecodeFSDefaultAndSize = &debug_leaks_ctx_Unicode_DecodeFSDefaultAndSize;
+    dctx->ctx_Unicode_Substring = &debug_leaks_ctx_Unicode_Substring;
+    dctx->ctx_List_Check = &debug_leaks_ctx_List_Check;
+    dctx->ctx_List_New = &debug_leaks_ctx_List_New;
+    dctx->ctx_List_Append = &debug_leaks_ctx_List_Append;
+    dctx->ctx_List_GetSlice = &debug_leaks_ctx_List_GetSlice;
+    dctx->ctx_Dict_Check = &debug_leaks_ctx_Dict_Check;
+    dctx->ctx_Dict_New = &debug_leaks_ctx_Dict_New;
+    dctx->ctx_Set_Check = &debug_leaks_ctx_Set_Check;
+    dctx->ctx_FrozenSet_Check = &debug_leaks_ctx_FrozenSet_Check;
+    dctx->ctx_Set_New = &debug_leaks_ctx_Set_New;
+    dctx->ctx_Set_Add = &debug_leaks_ctx_Set_Add;
+    dctx->ctx_Set_Contains = &debug_leaks_ctx_Set_Contains;
+    dctx->ctx_Tuple_Check = &debug_leaks_ctx_Tuple_Check;
+    dctx->ctx_Tuple_GetSlice = &debug_leaks_ctx_Tuple_GetSlice;
+    dctx->ctx_Import_ImportModule = &debug_leaks_ctx_Import_ImportModule;
+    dctx->ctx_FromPyObject = &debug_leaks_ctx_FromPyObject;
+    dctx->ctx_AsPyObject = &debug_leaks_ctx_AsPyObject;
+    dctx->ctx_ListBuilder_Set = &debug_leaks_ctx_ListBuilder_Set;
+    dctx->ctx_ListBuilder_Build = &debug_leaks_ctx_ListBuilder_Build;
+    dctx->ctx_TupleBuilder_Set = &debug_leaks_ctx_TupleBuilder_Set;
+    dctx->ctx_TupleBuilder_Build = &debug_leaks_ctx_TupleBuilder_Build;
+    dctx->ctx_FrozenSetBuilder_Add = &debug_leaks_ctx_FrozenSetBuilder_Add;
+    dctx->ctx_FrozenSetBuilder_Build = &debug_leaks_ctx_FrozenSetBuilder_Build;
+    dctx->ctx_Field_Store = &debug_leaks_ctx_Field_Store;
+    dctx->ctx_Field_Load = &debug_leaks_ctx_Field_Load;
+    dctx->ctx_Field_LoadAt = &debug_leaks_ctx_Field_LoadAt;
+    dctx->ctx_Global_Store = &debug_leaks_ctx_Global_Store;
+    dctx->ctx_Global_Load = &debug_leaks_ctx_Global_Load;
+    dctx->ctx_Global_LoadAt = &debug_leaks_ctx_Global_LoadAt;
+    dctx->ctx_Dump = &debug_leaks_ctx_Dump;
+}
@@ -102,6 +102,51 @@ double debug_ctx_Float_AsDouble(HPyContext *dctx, DHPy h)
     return HPyFloat_AsDouble(get_info(dctx)->uctx, DHPy_unwrap(dctx, h));
 }
 
+DHPy debug_ctx_Long_FromString(HPyContext *dctx, const char *str, HPy_ssize_t size, int base)
+{
+    return DHPy_open(dctx, HPyLong_FromString(get_info(dctx)->uctx, str, size, base));
+}
+
+DHPy debug_ctx_Float_FromString(HPyContext *dctx, const char *str, HPy_ssize_t size)
+{
+    return DHPy_open(dctx, HPyFloat_FromString(get_info(dctx)->uctx, str, size));
+}
+
+HPy_ssize_t debug_ctx_Long_Format(HPyContext *dctx, DHPy h, char *buf, HPy_ssize_t size)
+{
+    return HPyLong_Format(get_info(dctx)->uctx, DHPy_unwrap(dctx, h), buf, size);
+}
+
+HPy_ssize_t debug_ctx_Float_Format(HPyContext *dctx, DHPy h, char *buf, HPy_ssize_t size)
+{
+    return HPyFloat_Format(get_info(dctx)->uctx, DHPy_unwrap(dctx, h), buf, size);
+}
+
+DHPy debug_ctx_Long_FromByteArray(HPyContext *dctx, const unsigned char *bytes, size_t n, int little_endian, int is_signed)
+{
+    return DHPy_open(dctx, HPyLong_FromByteArray(get_info(dctx)->uctx, bytes, n, little_endian, is_signed));
+}
+
+int debug_ctx_Long_AsByteArray(HPyContext *dctx, DHPy h, unsigned char *bytes, size_t n, int little_endian, int is_signed)
+{
+    return HPyLong_AsByteArray(get_info(dctx)->uctx, DHPy_unwrap(dctx, h), bytes, n, little_endian, is_signed);
+}
+
+DHPy debug_ctx_Long_FromLimbs(HPyContext *dctx, const uint64_t *limbs, size_t n, int is_signed)
+{
+    return DHPy_open(dctx, HPyLong_FromLimbs(get_info(dctx)->uctx, limbs, n, is_signed));
+}
+
+int debug_ctx_Long_AsLimbs(HPyContext *dctx, DHPy h, uint64_t *limbs, size_t n, int is_signed)
+{
+    return HPyLong_AsLimbs(get_info(dctx)->uctx, DHPy_unwrap(dctx, h), limbs, n, is_signed);
+}
+
+HPy_ssize_t debug_ctx_Long_NumBits(HPyContext *dctx, DHPy h)
+{
+    return HPyLong_NumBits(get_info(dctx)->uctx, DHPy_unwrap(dctx, h));
+}
+
 DHPy debug_ctx_Bool_FromLong(HPyContext *dctx, long v)
 {
     return DHPy_open(dctx, HPyBool_FromLong(get_info(dctx)->uctx, v));
@@ -372,6 +417,11 @@ DHPy debug_ctx_GetAttr_s(HPyContext *dctx, DHPy obj, const char *name)
     return DHPy_open(dctx, HPy_GetAttr_s(get_info(dctx)->uctx, DHPy_unwrap(dctx, obj), name));
 }
 
+DHPy debug_ctx_GetAttrCached(HPyContext *dctx, DHPy obj, HPyAttrCache *cache)
+{
+    return DHPy_open(dctx, HPy_GetAttrCached(get_info(dctx)->uctx, DHPy_unwrap(dctx, obj), cache));
+}
+
 int debug_ctx_HasAttr(HPyContext *dctx, DHPy obj, DHPy name)
 {
     return HPy_HasAttr(get_info(dctx)->uctx, DHPy_unwrap(dctx, obj), DHPy_unwrap(dctx, name));
@@ -427,6 +477,26 @@ int debug_ctx_SetItem_s(HPyContext *dctx, DHPy obj, const char *key, DHPy value)
     return HPy_SetItem_s(get_info(dctx)->uctx, DHPy_unwrap(dctx, obj), key, DHPy_unwrap(dctx, value));
 }
 
+DHPy debug_ctx_GetSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open(dctx, HPy_GetSlice(get_info(dctx)->uctx, DHPy_unwrap(dctx, obj), start, end));
+}
+
+int debug_ctx_SetSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end, DHPy value)
+{
+    return HPy_SetSlice(get_info(dctx)->uctx, DHPy_unwrap(dctx, obj), start, end, DHPy_unwrap(dctx, value));
+}
+
+int debug_ctx_DelSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return HPy_DelSlice(get_info(dctx)->uctx, DHPy_unwrap(dctx, obj), start, end);
+}
+
+DHPy debug_ctx_GetSliceView(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open(dctx, HPy_GetSliceView(get_info(dctx)->uctx, DHPy_unwrap(dctx, obj), start, end));
+}
+
 DHPy debug_ctx_Type(HPyContext *dctx, DHPy obj)
 {
     return DHPy_open(dctx, HPy_Type(get_info(dctx)->uctx, DHPy_unwrap(dctx, obj)));
@@ -457,6 +527,21 @@ DHPy debug_ctx_New(HPyContext *dctx, DHPy h_type, void **data)
     return DHPy_open(dctx, _HPy_New(get_info(dctx)->uctx, DHPy_unwrap(dctx, h_type), data));
 }
 
+void *debug_ctx_Type_GetData(HPyContext *dctx, DHPy type)
+{
+    return HPyType_GetData(get_info(dctx)->uctx, DHPy_unwrap(dctx, type));
+}
+
+HPy_ssize_t debug_ctx_SetDeallocBudget(HPyContext *dctx, HPy_ssize_t budget)
+{
+    return HPy_SetDeallocBudget(get_info(dctx)->uctx, budget);
+}
+
+int debug_ctx_DrainDeallocs(HPyContext *dctx)
+{
+    return HPy_DrainDeallocs(get_info(dctx)->uctx);
+}
+
 DHPy debug_ctx_Repr(HPyContext *dctx, DHPy obj)
 {
     return DHPy_open(dctx, HPy_Repr(get_info(dctx)->uctx, DHPy_unwrap(dctx, obj)));
@@ -482,11 +567,6 @@ DHPy debug_ctx_RichCompare(HPyContext *dctx, DHPy v, DHPy w, int op)
     return DHPy_open(dctx, HPy_RichCompare(get_info(dctx)->uctx, DHPy_unwrap(dctx, v), DHPy_unwrap(dctx, w), op));
 }
 
-int debug_ctx_RichCompareBool(HPyContext *dctx, DHPy v, DHPy w, int op)
-{
-    return HPy_RichCompareBool(get_info(dctx)->uctx, DHPy_unwrap(dctx, v), DHPy_unwrap(dctx, w), op);
-}
-
 HPy_hash_t debug_ctx_Hash(HPyContext *dctx, DHPy obj)
 {
     return HPy_Hash(get_info(dctx)->uctx, DHPy_unwrap(dctx, obj));
@@ -527,11 +607,21 @@ DHPy debug_ctx_Bytes_FromStringAndSize(HPyContext *dctx, const char *v, HPy_ssiz
     return DHPy_open(dctx, HPyBytes_FromStringAndSize(get_info(dctx)->uctx, v, len));
 }
 
+DHPy debug_ctx_Bytes_GetSlice(HPyContext *dctx, DHPy h, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open(dctx, HPyBytes_GetSlice(get_info(dctx)->uctx, DHPy_unwrap(dctx, h), start, end));
+}
+
 DHPy debug_ctx_Unicode_FromString(HPyContext *dctx, const char *utf8)
 {
     return DHPy_open(dctx, HPyUnicode_FromString(get_info(dctx)->uctx, utf8));
 }
 
+DHPy debug_ctx_Unicode_FromStringAndSize(HPyContext *dctx, const char *utf8, HPy_ssize_t size)
+{
+    return DHPy_open(dctx, HPyUnicode_FromStringAndSize(get_info(dctx)->uctx, utf8, size));
+}
+
 int debug_ctx_Unicode_Check(HPyContext *dctx, DHPy h)
 {
     return HPyUnicode_Check(get_info(dctx)->uctx, DHPy_unwrap(dctx, h));
@@ -557,6 +647,11 @@ DHPy debug_ctx_Unicode_DecodeFSDefaultAndSize(HPyContext *dctx, const char *v, H
     return DHPy_open(dctx, HPyUnicode_DecodeFSDefaultAndSize(get_info(dctx)->uctx, v, size));
 }
 
+DHPy debug_ctx_Unicode_Substring(HPyContext *dctx, DHPy h, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open(dctx, HPyUnicode_Substring(get_info(dctx)->uctx, DHPy_unwrap(dctx, h), start, end));
+}
+
 int debug_ctx_List_Check(HPyContext *dctx, DHPy h)
 {
     return HPyList_Check(get_info(dctx)->uctx, DHPy_unwrap(dctx, h));
@@ -572,6 +667,11 @@ int debug_ctx_List_Append(HPyContext *dctx, DHPy h_list, DHPy h_item)
     return HPyList_Append(get_info(dctx)->uctx, DHPy_unwrap(dctx, h_list), DHPy_unwrap(dctx, h_item));
 }
 
+DHPy debug_ctx_List_GetSlice(HPyContext *dctx, DHPy h_list, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open(dctx, HPyList_GetSlice(get_info(dctx)->uctx, DHPy_unwrap(dctx, h_list), start, end));
+}
+
 int debug_ctx_Dict_Check(HPyContext *dctx, DHPy h)
 {
     return HPyDict_Check(get_info(dctx)->uctx, DHPy_unwrap(dctx, h));
@@ -582,11 +682,41 @@ DHPy debug_ctx_Dict_New(HPyContext *dctx)
     return DHPy_open(dctx, HPyDict_New(get_info(dctx)->uctx));
 }
 
+int debug_ctx_Set_Check(HPyContext *dctx, DHPy h)
+{
+    return HPySet_Check(get_info(dctx)->uctx, DHPy_unwrap(dctx, h));
+}
+
+int debug_ctx_FrozenSet_Check(HPyContext *dctx, DHPy h)
+{
+    return HPyFrozenSet_Check(get_info(dctx)->uctx, DHPy_unwrap(dctx, h));
+}
+
+DHPy debug_ctx_Set_New(HPyContext *dctx, HPy_ssize_t size_hint)
+{
+    return DHPy_open(dctx, HPySet_New(get_info(dctx)->uctx, size_hint));
+}
+
+int debug_ctx_Set_Add(HPyContext *dctx, DHPy h_set, DHPy h_item)
+{
+    return HPySet_Add(get_info(dctx)->uctx, DHPy_unwrap(dctx, h_set), DHPy_unwrap(dctx, h_item));
+}
+
+int debug_ctx_Set_Contains(HPyContext *dctx, DHPy h_set, DHPy h_item)
+{
+    return HPySet_Contains(get_info(dctx)->uctx, DHPy_unwrap(dctx, h_set), DHPy_unwrap(dctx, h_item));
+}
+
 int debug_ctx_Tuple_Check(HPyContext *dctx, DHPy h)
 {
     return HPyTuple_Check(get_info(dctx)->uctx, DHPy_unwrap(dctx, h));
 }
 
+DHPy debug_ctx_Tuple_GetSlice(HPyContext *dctx, DHPy h_tuple, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open(dctx, HPyTuple_GetSlice(get_info(dctx)->uctx, DHPy_unwrap(dctx, h_tuple), start, end));
+}
+
 DHPy debug_ctx_Import_ImportModule(HPyContext *dctx, const char *name)
 {
     return DHPy_open(dctx, HPyImport_ImportModule(get_info(dctx)->uctx, name));
@@ -642,6 +772,51 @@ void debug_ctx_TupleBuilder_Cancel(HPyContext *dctx, HPyTupleBuilder builder)
     HPyTupleBuilder_Cancel(get_info(dctx)->uctx, builder);
 }
 
+HPyFrozenSetBuilder debug_ctx_FrozenSetBuilder_New(HPyContext *dctx, HPy_ssize_t size_hint)
+{
+    return HPyFrozenSetBuilder_New(get_info(dctx)->uctx, size_hint);
+}
+
+int debug_ctx_FrozenSetBuilder_Add(HPyContext *dctx, HPyFrozenSetBuilder builder, DHPy h_item)
+{
+    return HPyFrozenSetBuilder_Add(get_info(dctx)->uctx, builder, DHPy_unwrap(dctx, h_item));
+}
+
+DHPy debug_ctx_FrozenSetBuilder_Build(HPyContext *dctx, HPyFrozenSetBuilder builder)
+{
+    return DHPy_open(dctx, HPyFrozenSetBuilder_Build(get_info(dctx)->uctx, builder));
+}
+
+void debug_ctx_FrozenSetBuilder_Cancel(HPyContext *dctx, HPyFrozenSetBuilder builder)
+{
+    HPyFrozenSetBuilder_Cancel(get_info(dctx)->uctx, builder);
+}
+
+void *debug_ctx_Mem_Malloc(HPyContext *dctx, size_t size)
+{
+    return HPyMem_Malloc(get_info(dctx)->uctx, size);
+}
+
+void *debug_ctx_Mem_Calloc(HPyContext *dctx, size_t nelem, size_t elsize)
+{
+    return HPyMem_Calloc(get_info(dctx)->uctx, nelem, elsize);
+}
+
+void *debug_ctx_Mem_Realloc(HPyContext *dctx, void *ptr, size_t size)
+{
+    return HPyMem_Realloc(get_info(dctx)->uctx, ptr, size);
+}
+
+void debug_ctx_Mem_Free(HPyContext *dctx, void *ptr)
+{
+    HPyMem_Free(get_info(dctx)->uctx, ptr);
+}
+
+void *debug_ctx_Mem_ScratchAlloc(HPyContext *dctx, size_t size)
+{
+    return HPyMem_ScratchAlloc(get_info(dctx)->uctx, size);
+}
+
 void debug_ctx_Field_Store(HPyContext *dctx, DHPy target_object, HPyField *target_field, DHPy h)
 {
     HPyField_Store(get_info(dctx)->uctx, DHPy_unwrap(dctx, target_object), target_field, DHPy_unwrap(dctx, h));
@@ -652,8 +827,794 @@ DHPy debug_ctx_Field_Load(HPyContext *dctx, DHPy source_object, HPyField source_
     return DHPy_open(dctx, HPyField_Load(get_info(dctx)->uctx, DHPy_unwrap(dctx, source_object), source_field));
 }
 
+DHPy debug_ctx_Field_LoadAt(HPyContext *dctx, DHPy source_object, HPyField *source_field)
+{
+    return DHPy_open(dctx, _HPyField_LoadAt(get_info(dctx)->uctx, DHPy_unwrap(dctx, source_object), source_field));
+}
+
+void debug_ctx_Global_Store(HPyContext *dctx, HPyGlobal *global, DHPy h)
+{
+    HPyGlobal_Store(get_info(dctx)->uctx, global, DHPy_unwrap(dctx, h));
+}
+
+DHPy debug_ctx_Global_Load(HPyContext *dctx, HPyGlobal global)
+{
+    return DHPy_open(dctx, HPyGlobal_Load(get_info(dctx)->uctx, global));
+}
+
+DHPy debug_ctx_Global_LoadAt(HPyContext *dctx, HPyGlobal *global)
+{
+    return DHPy_open(dctx, _HPyGlobal_LoadAt(get_info(dctx)->uctx, global));
+}
+
 void debug_ctx_Dump(HPyContext *dctx, DHPy h)
 {
     _HPy_Dump(get_info(dctx)->uctx, DHPy_unwrap(dctx, h));
 }
 
+/* ~~~ wrappers for HPY_DEBUG_LEVEL_LEAKS ~~~
+
+   Like the ones above, but they do not check whether the handles
+   are still open, and they open new handles with DHPy_open_leaks.
+*/
+
+DHPy debug_leaks_ctx_Module_Create(HPyContext *dctx, HPyModuleDef *def)
+{
+    return DHPy_open_leaks(dctx, HPyModule_Create(get_info(dctx)->uctx, def));
+}
+
+DHPy debug_leaks_ctx_Dup(HPyContext *dctx, DHPy h)
+{
+    return DHPy_open_leaks(dctx, HPy_Dup(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h)));
+}
+
+DHPy debug_leaks_ctx_Long_FromLong(HPyContext *dctx, long value)
+{
+    return DHPy_open_leaks(dctx, HPyLong_FromLong(get_info(dctx)->uctx, value));
+}
+
+DHPy debug_leaks_ctx_Long_FromUnsignedLong(HPyContext *dctx, unsigned long value)
+{
+    return DHPy_open_leaks(dctx, HPyLong_FromUnsignedLong(get_info(dctx)->uctx, value));
+}
+
+DHPy debug_leaks_ctx_Long_FromLongLong(HPyContext *dctx, long long v)
+{
+    return DHPy_open_leaks(dctx, HPyLong_FromLongLong(get_info(dctx)->uctx, v));
+}
+
+DHPy debug_leaks_ctx_Long_FromUnsignedLongLong(HPyContext *dctx, unsigned long long v)
+{
+    return DHPy_open_leaks(dctx, HPyLong_FromUnsignedLongLong(get_info(dctx)->uctx, v));
+}
+
+DHPy debug_leaks_ctx_Long_FromSize_t(HPyContext *dctx, size_t value)
+{
+    return DHPy_open_leaks(dctx, HPyLong_FromSize_t(get_info(dctx)->uctx, value));
+}
+
+DHPy debug_leaks_ctx_Long_FromSsize_t(HPyContext *dctx, HPy_ssize_t value)
+{
+    return DHPy_open_leaks(dctx, HPyLong_FromSsize_t(get_info(dctx)->uctx, value));
+}
+
+long debug_leaks_ctx_Long_AsLong(HPyContext *dctx, DHPy h)
+{
+    return HPyLong_AsLong(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+unsigned long debug_leaks_ctx_Long_AsUnsignedLong(HPyContext *dctx, DHPy h)
+{
+    return HPyLong_AsUnsignedLong(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+unsigned long debug_leaks_ctx_Long_AsUnsignedLongMask(HPyContext *dctx, DHPy h)
+{
+    return HPyLong_AsUnsignedLongMask(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+long long debug_leaks_ctx_Long_AsLongLong(HPyContext *dctx, DHPy h)
+{
+    return HPyLong_AsLongLong(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+unsigned long long debug_leaks_ctx_Long_AsUnsignedLongLong(HPyContext *dctx, DHPy h)
+{
+    return HPyLong_AsUnsignedLongLong(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+unsigned long long debug_leaks_ctx_Long_AsUnsignedLongLongMask(HPyContext *dctx, DHPy h)
+{
+    return HPyLong_AsUnsignedLongLongMask(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+size_t debug_leaks_ctx_Long_AsSize_t(HPyContext *dctx, DHPy h)
+{
+    return HPyLong_AsSize_t(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+HPy_ssize_t debug_leaks_ctx_Long_AsSsize_t(HPyContext *dctx, DHPy h)
+{
+    return HPyLong_AsSsize_t(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_Float_FromDouble(HPyContext *dctx, double v)
+{
+    return DHPy_open_leaks(dctx, HPyFloat_FromDouble(get_info(dctx)->uctx, v));
+}
+
+double debug_leaks_ctx_Float_AsDouble(HPyContext *dctx, DHPy h)
+{
+    return HPyFloat_AsDouble(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_Long_FromString(HPyContext *dctx, const char *str, HPy_ssize_t size, int base)
+{
+    return DHPy_open_leaks(dctx, HPyLong_FromString(get_info(dctx)->uctx, str, size, base));
+}
+
+DHPy debug_leaks_ctx_Float_FromString(HPyContext *dctx, const char *str, HPy_ssize_t size)
+{
+    return DHPy_open_leaks(dctx, HPyFloat_FromString(get_info(dctx)->uctx, str, size));
+}
+
+HPy_ssize_t debug_leaks_ctx_Long_Format(HPyContext *dctx, DHPy h, char *buf, HPy_ssize_t size)
+{
+    return HPyLong_Format(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h), buf, size);
+}
+
+HPy_ssize_t debug_leaks_ctx_Float_Format(HPyContext *dctx, DHPy h, char *buf, HPy_ssize_t size)
+{
+    return HPyFloat_Format(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h), buf, size);
+}
+
+DHPy debug_leaks_ctx_Long_FromByteArray(HPyContext *dctx, const unsigned char *bytes, size_t n, int little_endian, int is_signed)
+{
+    return DHPy_open_leaks(dctx, HPyLong_FromByteArray(get_info(dctx)->uctx, bytes, n, little_endian, is_signed));
+}
+
+int debug_leaks_ctx_Long_AsByteArray(HPyContext *dctx, DHPy h, unsigned char *bytes, size_t n, int little_endian, int is_signed)
+{
+    return HPyLong_AsByteArray(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h), bytes, n, little_endian, is_signed);
+}
+
+DHPy debug_leaks_ctx_Long_FromLimbs(HPyContext *dctx, const uint64_t *limbs, size_t n, int is_signed)
+{
+    return DHPy_open_leaks(dctx, HPyLong_FromLimbs(get_info(dctx)->uctx, limbs, n, is_signed));
+}
+
+int debug_leaks_ctx_Long_AsLimbs(HPyContext *dctx, DHPy h, uint64_t *limbs, size_t n, int is_signed)
+{
+    return HPyLong_AsLimbs(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h), limbs, n, is_signed);
+}
+
+HPy_ssize_t debug_leaks_ctx_Long_NumBits(HPyContext *dctx, DHPy h)
+{
+    return HPyLong_NumBits(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_Bool_FromLong(HPyContext *dctx, long v)
+{
+    return DHPy_open_leaks(dctx, HPyBool_FromLong(get_info(dctx)->uctx, v));
+}
+
+HPy_ssize_t debug_leaks_ctx_Length(HPyContext *dctx, DHPy h)
+{
+    return HPy_Length(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+int debug_leaks_ctx_Number_Check(HPyContext *dctx, DHPy h)
+{
+    return HPyNumber_Check(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_Add(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_Add(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_Subtract(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_Subtract(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_Multiply(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_Multiply(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_MatrixMultiply(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_MatrixMultiply(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_FloorDivide(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_FloorDivide(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_TrueDivide(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_TrueDivide(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_Remainder(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_Remainder(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_Divmod(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_Divmod(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_Power(HPyContext *dctx, DHPy h1, DHPy h2, DHPy h3)
+{
+    return DHPy_open_leaks(dctx, HPy_Power(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2), DHPy_unwrap_nocheck(dctx, h3)));
+}
+
+DHPy debug_leaks_ctx_Negative(HPyContext *dctx, DHPy h1)
+{
+    return DHPy_open_leaks(dctx, HPy_Negative(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1)));
+}
+
+DHPy debug_leaks_ctx_Positive(HPyContext *dctx, DHPy h1)
+{
+    return DHPy_open_leaks(dctx, HPy_Positive(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1)));
+}
+
+DHPy debug_leaks_ctx_Absolute(HPyContext *dctx, DHPy h1)
+{
+    return DHPy_open_leaks(dctx, HPy_Absolute(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1)));
+}
+
+DHPy debug_leaks_ctx_Invert(HPyContext *dctx, DHPy h1)
+{
+    return DHPy_open_leaks(dctx, HPy_Invert(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1)));
+}
+
+DHPy debug_leaks_ctx_Lshift(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_Lshift(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_Rshift(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_Rshift(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_And(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_And(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_Xor(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_Xor(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_Or(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_Or(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_Index(HPyContext *dctx, DHPy h1)
+{
+    return DHPy_open_leaks(dctx, HPy_Index(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1)));
+}
+
+DHPy debug_leaks_ctx_Long(HPyContext *dctx, DHPy h1)
+{
+    return DHPy_open_leaks(dctx, HPy_Long(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1)));
+}
+
+DHPy debug_leaks_ctx_Float(HPyContext *dctx, DHPy h1)
+{
+    return DHPy_open_leaks(dctx, HPy_Float(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1)));
+}
+
+DHPy debug_leaks_ctx_InPlaceAdd(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceAdd(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_InPlaceSubtract(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceSubtract(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_InPlaceMultiply(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceMultiply(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_InPlaceMatrixMultiply(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceMatrixMultiply(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_InPlaceFloorDivide(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceFloorDivide(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_InPlaceTrueDivide(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceTrueDivide(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_InPlaceRemainder(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceRemainder(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_InPlacePower(HPyContext *dctx, DHPy h1, DHPy h2, DHPy h3)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlacePower(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2), DHPy_unwrap_nocheck(dctx, h3)));
+}
+
+DHPy debug_leaks_ctx_InPlaceLshift(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceLshift(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_InPlaceRshift(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceRshift(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_InPlaceAnd(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceAnd(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_InPlaceXor(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceXor(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+DHPy debug_leaks_ctx_InPlaceOr(HPyContext *dctx, DHPy h1, DHPy h2)
+{
+    return DHPy_open_leaks(dctx, HPy_InPlaceOr(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h1), DHPy_unwrap_nocheck(dctx, h2)));
+}
+
+int debug_leaks_ctx_Callable_Check(HPyContext *dctx, DHPy h)
+{
+    return HPyCallable_Check(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_CallTupleDict(HPyContext *dctx, DHPy callable, DHPy args, DHPy kw)
+{
+    return DHPy_open_leaks(dctx, HPy_CallTupleDict(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, callable), DHPy_unwrap_nocheck(dctx, args), DHPy_unwrap_nocheck(dctx, kw)));
+}
+
+void debug_leaks_ctx_Err_SetString(HPyContext *dctx, DHPy h_type, const char *message)
+{
+    HPyErr_SetString(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h_type), message);
+}
+
+void debug_leaks_ctx_Err_SetObject(HPyContext *dctx, DHPy h_type, DHPy h_value)
+{
+    HPyErr_SetObject(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h_type), DHPy_unwrap_nocheck(dctx, h_value));
+}
+
+DHPy debug_leaks_ctx_Err_SetFromErrnoWithFilename(HPyContext *dctx, DHPy h_type, const char *filename_fsencoded)
+{
+    return DHPy_open_leaks(dctx, HPyErr_SetFromErrnoWithFilename(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h_type), filename_fsencoded));
+}
+
+DHPy debug_leaks_ctx_Err_SetFromErrnoWithFilenameObjects(HPyContext *dctx, DHPy h_type, DHPy filename1, DHPy filename2)
+{
+    return DHPy_open_leaks(dctx, HPyErr_SetFromErrnoWithFilenameObjects(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h_type), DHPy_unwrap_nocheck(dctx, filename1), DHPy_unwrap_nocheck(dctx, filename2)));
+}
+
+int debug_leaks_ctx_Err_ExceptionMatches(HPyContext *dctx, DHPy exc)
+{
+    return HPyErr_ExceptionMatches(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, exc));
+}
+
+DHPy debug_leaks_ctx_Err_NoMemory(HPyContext *dctx)
+{
+    return DHPy_open_leaks(dctx, HPyErr_NoMemory(get_info(dctx)->uctx));
+}
+
+DHPy debug_leaks_ctx_Err_NewException(HPyContext *dctx, const char *name, DHPy base, DHPy dict)
+{
+    return DHPy_open_leaks(dctx, HPyErr_NewException(get_info(dctx)->uctx, name, DHPy_unwrap_nocheck(dctx, base), DHPy_unwrap_nocheck(dctx, dict)));
+}
+
+DHPy debug_leaks_ctx_Err_NewExceptionWithDoc(HPyContext *dctx, const char *name, const char *doc, DHPy base, DHPy dict)
+{
+    return DHPy_open_leaks(dctx, HPyErr_NewExceptionWithDoc(get_info(dctx)->uctx, name, doc, DHPy_unwrap_nocheck(dctx, base), DHPy_unwrap_nocheck(dctx, dict)));
+}
+
+int debug_leaks_ctx_Err_WarnEx(HPyContext *dctx, DHPy category, const char *message, HPy_ssize_t stack_level)
+{
+    return HPyErr_WarnEx(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, category), message, stack_level);
+}
+
+int debug_leaks_ctx_IsTrue(HPyContext *dctx, DHPy h)
+{
+    return HPy_IsTrue(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_GetAttr(HPyContext *dctx, DHPy obj, DHPy name)
+{
+    return DHPy_open_leaks(dctx, HPy_GetAttr(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), DHPy_unwrap_nocheck(dctx, name)));
+}
+
+DHPy debug_leaks_ctx_GetAttr_s(HPyContext *dctx, DHPy obj, const char *name)
+{
+    return DHPy_open_leaks(dctx, HPy_GetAttr_s(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), name));
+}
+
+DHPy debug_leaks_ctx_GetAttrCached(HPyContext *dctx, DHPy obj, HPyAttrCache *cache)
+{
+    return DHPy_open_leaks(dctx, HPy_GetAttrCached(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), cache));
+}
+
+int debug_leaks_ctx_HasAttr(HPyContext *dctx, DHPy obj, DHPy name)
+{
+    return HPy_HasAttr(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), DHPy_unwrap_nocheck(dctx, name));
+}
+
+int debug_leaks_ctx_HasAttr_s(HPyContext *dctx, DHPy obj, const char *name)
+{
+    return HPy_HasAttr_s(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), name);
+}
+
+int debug_leaks_ctx_SetAttr(HPyContext *dctx, DHPy obj, DHPy name, DHPy value)
+{
+    return HPy_SetAttr(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), DHPy_unwrap_nocheck(dctx, name), DHPy_unwrap_nocheck(dctx, value));
+}
+
+int debug_leaks_ctx_SetAttr_s(HPyContext *dctx, DHPy obj, const char *name, DHPy value)
+{
+    return HPy_SetAttr_s(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), name, DHPy_unwrap_nocheck(dctx, value));
+}
+
+DHPy debug_leaks_ctx_GetItem(HPyContext *dctx, DHPy obj, DHPy key)
+{
+    return DHPy_open_leaks(dctx, HPy_GetItem(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), DHPy_unwrap_nocheck(dctx, key)));
+}
+
+DHPy debug_leaks_ctx_GetItem_i(HPyContext *dctx, DHPy obj, HPy_ssize_t idx)
+{
+    return DHPy_open_leaks(dctx, HPy_GetItem_i(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), idx));
+}
+
+DHPy debug_leaks_ctx_GetItem_s(HPyContext *dctx, DHPy obj, const char *key)
+{
+    return DHPy_open_leaks(dctx, HPy_GetItem_s(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), key));
+}
+
+int debug_leaks_ctx_Contains(HPyContext *dctx, DHPy container, DHPy key)
+{
+    return HPy_Contains(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, container), DHPy_unwrap_nocheck(dctx, key));
+}
+
+int debug_leaks_ctx_SetItem(HPyContext *dctx, DHPy obj, DHPy key, DHPy value)
+{
+    return HPy_SetItem(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), DHPy_unwrap_nocheck(dctx, key), DHPy_unwrap_nocheck(dctx, value));
+}
+
+int debug_leaks_ctx_SetItem_i(HPyContext *dctx, DHPy obj, HPy_ssize_t idx, DHPy value)
+{
+    return HPy_SetItem_i(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), idx, DHPy_unwrap_nocheck(dctx, value));
+}
+
+int debug_leaks_ctx_SetItem_s(HPyContext *dctx, DHPy obj, const char *key, DHPy value)
+{
+    return HPy_SetItem_s(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), key, DHPy_unwrap_nocheck(dctx, value));
+}
+
+DHPy debug_leaks_ctx_GetSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open_leaks(dctx, HPy_GetSlice(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), start, end));
+}
+
+int debug_leaks_ctx_SetSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end, DHPy value)
+{
+    return HPy_SetSlice(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), start, end, DHPy_unwrap_nocheck(dctx, value));
+}
+
+int debug_leaks_ctx_DelSlice(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return HPy_DelSlice(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), start, end);
+}
+
+DHPy debug_leaks_ctx_GetSliceView(HPyContext *dctx, DHPy obj, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open_leaks(dctx, HPy_GetSliceView(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), start, end));
+}
+
+DHPy debug_leaks_ctx_Type(HPyContext *dctx, DHPy obj)
+{
+    return DHPy_open_leaks(dctx, HPy_Type(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj)));
+}
+
+int debug_leaks_ctx_TypeCheck(HPyContext *dctx, DHPy obj, DHPy type)
+{
+    return HPy_TypeCheck(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), DHPy_unwrap_nocheck(dctx, type));
+}
+
+int debug_leaks_ctx_Is(HPyContext *dctx, DHPy obj, DHPy other)
+{
+    return HPy_Is(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj), DHPy_unwrap_nocheck(dctx, other));
+}
+
+void *debug_leaks_ctx_AsStruct(HPyContext *dctx, DHPy h)
+{
+    return HPy_AsStruct(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+void *debug_leaks_ctx_AsStructLegacy(HPyContext *dctx, DHPy h)
+{
+    return HPy_AsStructLegacy(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_New(HPyContext *dctx, DHPy h_type, void **data)
+{
+    return DHPy_open_leaks(dctx, _HPy_New(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h_type), data));
+}
+
+void *debug_leaks_ctx_Type_GetData(HPyContext *dctx, DHPy type)
+{
+    return HPyType_GetData(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, type));
+}
+
+DHPy debug_leaks_ctx_Repr(HPyContext *dctx, DHPy obj)
+{
+    return DHPy_open_leaks(dctx, HPy_Repr(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj)));
+}
+
+DHPy debug_leaks_ctx_Str(HPyContext *dctx, DHPy obj)
+{
+    return DHPy_open_leaks(dctx, HPy_Str(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj)));
+}
+
+DHPy debug_leaks_ctx_ASCII(HPyContext *dctx, DHPy obj)
+{
+    return DHPy_open_leaks(dctx, HPy_ASCII(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj)));
+}
+
+DHPy debug_leaks_ctx_Bytes(HPyContext *dctx, DHPy obj)
+{
+    return DHPy_open_leaks(dctx, HPy_Bytes(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj)));
+}
+
+DHPy debug_leaks_ctx_RichCompare(HPyContext *dctx, DHPy v, DHPy w, int op)
+{
+    return DHPy_open_leaks(dctx, HPy_RichCompare(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, v), DHPy_unwrap_nocheck(dctx, w), op));
+}
+
+HPy_hash_t debug_leaks_ctx_Hash(HPyContext *dctx, DHPy obj)
+{
+    return HPy_Hash(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, obj));
+}
+
+int debug_leaks_ctx_Bytes_Check(HPyContext *dctx, DHPy h)
+{
+    return HPyBytes_Check(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+HPy_ssize_t debug_leaks_ctx_Bytes_Size(HPyContext *dctx, DHPy h)
+{
+    return HPyBytes_Size(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+HPy_ssize_t debug_leaks_ctx_Bytes_GET_SIZE(HPyContext *dctx, DHPy h)
+{
+    return HPyBytes_GET_SIZE(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+char *debug_leaks_ctx_Bytes_AsString(HPyContext *dctx, DHPy h)
+{
+    return HPyBytes_AsString(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+char *debug_leaks_ctx_Bytes_AS_STRING(HPyContext *dctx, DHPy h)
+{
+    return HPyBytes_AS_STRING(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_Bytes_FromString(HPyContext *dctx, const char *v)
+{
+    return DHPy_open_leaks(dctx, HPyBytes_FromString(get_info(dctx)->uctx, v));
+}
+
+DHPy debug_leaks_ctx_Bytes_FromStringAndSize(HPyContext *dctx, const char *v, HPy_ssize_t len)
+{
+    return DHPy_open_leaks(dctx, HPyBytes_FromStringAndSize(get_info(dctx)->uctx, v, len));
+}
+
+DHPy debug_leaks_ctx_Bytes_GetSlice(HPyContext *dctx, DHPy h, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open_leaks(dctx, HPyBytes_GetSlice(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h), start, end));
+}
+
+DHPy debug_leaks_ctx_Unicode_FromString(HPyContext *dctx, const char *utf8)
+{
+    return DHPy_open_leaks(dctx, HPyUnicode_FromString(get_info(dctx)->uctx, utf8));
+}
+
+DHPy debug_leaks_ctx_Unicode_FromStringAndSize(HPyContext *dctx, const char *utf8, HPy_ssize_t size)
+{
+    return DHPy_open_leaks(dctx, HPyUnicode_FromStringAndSize(get_info(dctx)->uctx, utf8, size));
+}
+
+int debug_leaks_ctx_Unicode_Check(HPyContext *dctx, DHPy h)
+{
+    return HPyUnicode_Check(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_Unicode_AsUTF8String(HPyContext *dctx, DHPy h)
+{
+    return DHPy_open_leaks(dctx, HPyUnicode_AsUTF8String(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h)));
+}
+
+DHPy debug_leaks_ctx_Unicode_FromWideChar(HPyContext *dctx, const wchar_t *w, HPy_ssize_t size)
+{
+    return DHPy_open_leaks(dctx, HPyUnicode_FromWideChar(get_info(dctx)->uctx, w, size));
+}
+
+DHPy debug_leaks_ctx_Unicode_DecodeFSDefault(HPyContext *dctx, const char *v)
+{
+    return DHPy_open_leaks(dctx, HPyUnicode_DecodeFSDefault(get_info(dctx)->uctx, v));
+}
+
+DHPy debug_leaks_ctx_Unicode_DecodeFSDefaultAndSize(HPyContext *dctx, const char *v, HPy_ssize_t size)
+{
+    return DHPy_open_leaks(dctx, HPyUnicode_DecodeFSDefaultAndSize(get_info(dctx)->uctx, v, size));
+}
+
+DHPy debug_leaks_ctx_Unicode_Substring(HPyContext *dctx, DHPy h, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open_leaks(dctx, HPyUnicode_Substring(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h), start, end));
+}
+
+int debug_leaks_ctx_List_Check(HPyContext *dctx, DHPy h)
+{
+    return HPyList_Check(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_List_New(HPyContext *dctx, HPy_ssize_t len)
+{
+    return DHPy_open_leaks(dctx, HPyList_New(get_info(dctx)->uctx, len));
+}
+
+int debug_leaks_ctx_List_Append(HPyContext *dctx, DHPy h_list, DHPy h_item)
+{
+    return HPyList_Append(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h_list), DHPy_unwrap_nocheck(dctx, h_item));
+}
+
+DHPy debug_leaks_ctx_List_GetSlice(HPyContext *dctx, DHPy h_list, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open_leaks(dctx, HPyList_GetSlice(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h_list), start, end));
+}
+
+int debug_leaks_ctx_Dict_Check(HPyContext *dctx, DHPy h)
+{
+    return HPyDict_Check(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_Dict_New(HPyContext *dctx)
+{
+    return DHPy_open_leaks(dctx, HPyDict_New(get_info(dctx)->uctx));
+}
+
+int debug_leaks_ctx_Set_Check(HPyContext *dctx, DHPy h)
+{
+    return HPySet_Check(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+int debug_leaks_ctx_FrozenSet_Check(HPyContext *dctx, DHPy h)
+{
+    return HPyFrozenSet_Check(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_Set_New(HPyContext *dctx, HPy_ssize_t size_hint)
+{
+    return DHPy_open_leaks(dctx, HPySet_New(get_info(dctx)->uctx, size_hint));
+}
+
+int debug_leaks_ctx_Set_Add(HPyContext *dctx, DHPy h_set, DHPy h_item)
+{
+    return HPySet_Add(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h_set), DHPy_unwrap_nocheck(dctx, h_item));
+}
+
+int debug_leaks_ctx_Set_Contains(HPyContext *dctx, DHPy h_set, DHPy h_item)
+{
+    return HPySet_Contains(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h_set), DHPy_unwrap_nocheck(dctx, h_item));
+}
+
+int debug_leaks_ctx_Tuple_Check(HPyContext *dctx, DHPy h)
+{
+    return HPyTuple_Check(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_Tuple_GetSlice(HPyContext *dctx, DHPy h_tuple, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return DHPy_open_leaks(dctx, HPyTuple_GetSlice(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h_tuple), start, end));
+}
+
+DHPy debug_leaks_ctx_Import_ImportModule(HPyContext *dctx, const char *name)
+{
+    return DHPy_open_leaks(dctx, HPyImport_ImportModule(get_info(dctx)->uctx, name));
+}
+
+DHPy debug_leaks_ctx_FromPyObject(HPyContext *dctx, cpy_PyObject *obj)
+{
+    return DHPy_open_leaks(dctx, HPy_FromPyObject(get_info(dctx)->uctx, obj));
+}
+
+cpy_PyObject *debug_leaks_ctx_AsPyObject(HPyContext *dctx, DHPy h)
+{
+    return HPy_AsPyObject(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
+void debug_leaks_ctx_ListBuilder_Set(HPyContext *dctx, HPyListBuilder builder, HPy_ssize_t index, DHPy h_item)
+{
+    HPyListBuilder_Set(get_info(dctx)->uctx, builder, index, DHPy_unwrap_nocheck(dctx, h_item));
+}
+
+DHPy debug_leaks_ctx_ListBuilder_Build(HPyContext *dctx, HPyListBuilder builder)
+{
+    return DHPy_open_leaks(dctx, HPyListBuilder_Build(get_info(dctx)->uctx, builder));
+}
+
+void debug_leaks_ctx_TupleBuilder_Set(HPyContext *dctx, HPyTupleBuilder builder, HPy_ssize_t index, DHPy h_item)
+{
+    HPyTupleBuilder_Set(get_info(dctx)->uctx, builder, index, DHPy_unwrap_nocheck(dctx, h_item));
+}
+
+DHPy debug_leaks_ctx_TupleBuilder_Build(HPyContext *dctx, HPyTupleBuilder builder)
+{
+    return DHPy_open_leaks(dctx, HPyTupleBuilder_Build(get_info(dctx)->uctx, builder));
+}
+
+int debug_leaks_ctx_FrozenSetBuilder_Add(HPyContext *dctx, HPyFrozenSetBuilder builder, DHPy h_item)
+{
+    return HPyFrozenSetBuilder_Add(get_info(dctx)->uctx, builder, DHPy_unwrap_nocheck(dctx, h_item));
+}
+
+DHPy debug_leaks_ctx_FrozenSetBuilder_Build(HPyContext *dctx, HPyFrozenSetBuilder builder)
+{
+    return DHPy_open_leaks(dctx, HPyFrozenSetBuilder_Build(get_info(dctx)->uctx, builder));
+}
+
+void debug_leaks_ctx_Field_Store(HPyContext *dctx, DHPy target_object, HPyField *target_field, DHPy h)
+{
+    HPyField_Store(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, target_object), target_field, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_Field_Load(HPyContext *dctx, DHPy source_object, HPyField source_field)
+{
+    return DHPy_open_leaks(dctx, HPyField_Load(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, source_object), source_field));
+}
+
+DHPy debug_leaks_ctx_Field_LoadAt(HPyContext *dctx, DHPy source_object, HPyField *source_field)
+{
+    return DHPy_open_leaks(dctx, _HPyField_LoadAt(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, source_object), source_field));
+}
+
+void debug_leaks_ctx_Global_Store(HPyContext *dctx, HPyGlobal *global, DHPy h)
+{
+    HPyGlobal_Store(get_info(dctx)->uctx, global, DHPy_unwrap_nocheck(dctx, h));
+}
+
+DHPy debug_leaks_ctx_Global_Load(HPyContext *dctx, HPyGlobal global)
+{
+    return DHPy_open_leaks(dctx, HPyGlobal_Load(get_info(dctx)->uctx, global));
+}
+
+DHPy debug_leaks_ctx_Global_LoadAt(HPyContext *dctx, HPyGlobal *global)
+{
+    return DHPy_open_leaks(dctx, _HPyGlobal_LoadAt(get_info(dctx)->uctx, global));
+}
+
+void debug_leaks_ctx_Dump(HPyContext *dctx, DHPy h)
+{
+    _HPy_Dump(get_info(dctx)->uctx, DHPy_unwrap_nocheck(dctx, h));
+}
+
@@ -13,21 +13,38 @@ static struct _HPyContext_s g_debug_ctx = {
     .ctx_version = 1,
 };
 
+// the context of HPY_DEBUG_LEVEL_LEAKS is a copy of g_debug_ctx with some
+// of the functions replaced, see hpy_debug_get_ctx_level
+static struct _HPyContext_s g_debug_ctx_leaks = {
+    ._private = NULL,
+};
+
+static const char *debug_unicode_as_utf8_and_size_nocopy(
+    HPyContext *dctx, DHPy h, HPy_ssize_t *size);
+
 // NOTE: at the moment this function assumes that uctx is always the
 // same. If/when we migrate to a system in which we can have multiple
 // independent contexts, this function should ensure to create a different
 // debug wrapper for each of them.
+//
+// The initialization is protected by g_init_lock, so that on free-threaded
+// builds two threads cannot initialize the same context at the same time.
+static DHLock g_init_lock = 0;
+
 int hpy_debug_ctx_init(HPyContext *dctx, HPyContext *uctx)
 {
+    DHLock_acquire(&g_init_lock);
     if (dctx->_private != NULL) {
         // already initialized
         assert(get_info(dctx)->uctx == uctx); // sanity check
+        DHLock_release(&g_init_lock);
         return 0;
     }
     // initialize debug_info
     // XXX: currently we never free this malloc
     HPyDebugInfo *info = malloc(sizeof(HPyDebugInfo));
     if (info == NULL) {
+        DHLock_release(&g_init_lock);
         HPyErr_NoMemory(uctx);
         return -1;
     }
@@ -40,8 +57,12 @@ int hpy_debug_ctx_init(HPyContext *dctx, HPyContext *uctx)
     info->protected_raw_data_size = 0;
     DHQueue_init(&info->open_handles);
     DHQueue_init(&info->closed_handles);
+    info->free_handles = NULL;
+    info->n_free_handles = 0;
+    info->lock = 0;
     dctx->_private = info;
     debug_ctx_init_fields(dctx, uctx);
+    DHLock_release(&g_init_lock);
     return 0;
 }
 
@@ -57,6 +78,32 @@ HPyContext * hpy_debug_get_ctx(HPyContext *uctx)
     return dctx;
 }
 
+HPyContext * hpy_debug_get_ctx_level(HPyContext *uctx, HPyDebugLevel level)
+{
+    HPyContext *dctx = hpy_debug_get_ctx(uctx);
+    if (dctx == NULL || level == HPY_DEBUG_LEVEL_FULL)
+        return dctx;
+    if (level != HPY_DEBUG_LEVEL_LEAKS) {
+        HPyErr_SetString(uctx, uctx->h_ValueError, "invalid HPy debug level");
+        return NULL;
+    }
+    HPyContext *ldctx = &g_debug_ctx_leaks;
+    DHLock_acquire(&g_init_lock);
+    if (ldctx->_private == NULL) {
+        // copying g_debug_ctx also shares its HPyDebugInfo and its handles
+        // to the constants, so they are not opened again
+        *ldctx = *dctx;
+        ldctx->name = "HPy Debug Mode ABI (leaks)";
+        ldctx->ctx_Unicode_AsUTF8AndSize = &debug_unicode_as_utf8_and_size_nocopy;
+        ldctx->ctx_Close = &debug_leaks_ctx_Close;
+        ldctx->ctx_CallRealFunctionFromTrampoline =
+            &debug_leaks_ctx_CallRealFunctionFromTrampoline;
+        debug_ctx_init_leaks_fields(ldctx);
+    }
+    DHLock_release(&g_init_lock);
+    return ldctx;
+}
+
 void hpy_debug_set_ctx(HPyContext *dctx)
 {
     g_debug_ctx = *dctx;
@@ -118,6 +165,42 @@ void debug_ctx_Close(HPyContext *dctx, DHPy dh)
     HPy_Close(get_info(dctx)->uctx, uh);
 }
 
+void debug_leaks_ctx_Close(HPyContext *dctx, DHPy dh)
+{
+    // closing a handle twice would close uh twice: it is still reported
+    UHPy uh = DHPy_unwrap(dctx, dh);
+    DHPy_close_leaks(dctx, dh);
+    HPy_Close(get_info(dctx)->uctx, uh);
+}
+
+/* The *Steal functions transfer the ownership of dh to the universal
+   function, which will close the underlying uh: so, we only close the debug
+   handle, and any later usage of dh is reported as usage of a closed handle.
+*/
+int debug_ctx_List_AppendSteal(HPyContext *dctx, DHPy dh_list, DHPy dh_item)
+{
+    UHPy uh_list = DHPy_unwrap(dctx, dh_list);
+    UHPy uh_item = DHPy_unwrap(dctx, dh_item);
+    DHPy_close(dctx, dh_item);
+    return HPyList_AppendSteal(get_info(dctx)->uctx, uh_list, uh_item);
+}
+
+void debug_ctx_ListBuilder_SetSteal(HPyContext *dctx, HPyListBuilder builder,
+                                    HPy_ssize_t index, DHPy dh_item)
+{
+    UHPy uh_item = DHPy_unwrap(dctx, dh_item);
+    DHPy_close(dctx, dh_item);
+    HPyListBuilder_SetSteal(get_info(dctx)->uctx, builder, index, uh_item);
+}
+
+void debug_ctx_TupleBuilder_SetSteal(HPyContext *dctx, HPyTupleBuilder builder,
+                                     HPy_ssize_t index, DHPy dh_item)
+{
+    UHPy uh_item = DHPy_unwrap(dctx, dh_item);
+    DHPy_close(dctx, dh_item);
+    HPyTupleBuilder_SetSteal(get_info(dctx)->uctx, builder, index, uh_item);
+}
+
 const char *debug_ctx_Unicode_AsUTF8AndSize(HPyContext *dctx, DHPy h, HPy_ssize_t *size)
 {
     const char *ptr = HPyUnicode_AsUTF8AndSize(get_info(dctx)->uctx, DHPy_unwrap(dctx, h), size);
@@ -129,6 +212,13 @@ const char *debug_ctx_Unicode_AsUTF8AndSize(HPyContext *dctx, DHPy h, HPy_ssize_
     return new_ptr;
 }
 
+/* HPY_DEBUG_LEVEL_LEAKS returns the buffer of the universal ctx as is */
+static const char *debug_unicode_as_utf8_and_size_nocopy(
+    HPyContext *dctx, DHPy h, HPy_ssize_t *size)
+{
+    return HPyUnicode_AsUTF8AndSize(get_info(dctx)->uctx, DHPy_unwrap(dctx, h), size);
+}
+
 DHPy debug_ctx_Tuple_FromArray(HPyContext *dctx, DHPy dh_items[], HPy_ssize_t n)
 {
     UHPy *uh_items = (UHPy *)alloca(n * sizeof(UHPy));
@@ -138,6 +228,23 @@ DHPy debug_ctx_Tuple_FromArray(HPyContext *dctx, DHPy dh_items[], HPy_ssize_t n)
     return DHPy_open(dctx, HPyTuple_FromArray(get_info(dctx)->uctx, uh_items, n));
 }
 
+int debug_ctx_Set_AddArray(HPyContext *dctx, DHPy dh_set, DHPy dh_items[],
+                           HPy_ssize_t n)
+{
+    // the set can be big: unwrap the items in chunks instead of using alloca
+    UHPy uh_set = DHPy_unwrap(dctx, dh_set);
+    UHPy uh_items[64];
+    for (HPy_ssize_t i = 0; i < n; i += 64) {
+        HPy_ssize_t chunk = n - i < 64 ? n - i : 64;
+        for (HPy_ssize_t j = 0; j < chunk; j++) {
+            uh_items[j] = DHPy_unwrap(dctx, dh_items[i + j]);
+        }
+        if (HPySet_AddArray(get_info(dctx)->uctx, uh_set, uh_items, chunk) < 0)
+            return -1;
+    }
+    return 0;
+}
+
 DHPy debug_ctx_Type_GenericNew(HPyContext *dctx, DHPy dh_type, DHPy *dh_args,
                                HPy_ssize_t nargs, DHPy dh_kw)
 {
@@ -151,6 +258,46 @@ DHPy debug_ctx_Type_GenericNew(HPyContext *dctx, DHPy dh_type, DHPy *dh_args,
                                               nargs, uh_kw));
 }
 
+DHPy debug_ctx_CallMethodCached(HPyContext *dctx, DHPy dh_obj, HPyAttrCache *cache,
+                                DHPy *dh_args, HPy_ssize_t nargs)
+{
+    UHPy uh_obj = DHPy_unwrap(dctx, dh_obj);
+    UHPy *uh_args = (UHPy *)alloca(nargs * sizeof(UHPy));
+    for(int i=0; i<nargs; i++) {
+        uh_args[i] = DHPy_unwrap(dctx, dh_args[i]);
+    }
+    return DHPy_open(dctx, HPy_CallMethodCached(get_info(dctx)->uctx, uh_obj, cache,
+                                                uh_args, nargs));
+}
+
+/* We cannot simply forward to the universal HPy_RichCompareBool: if the type
+   defines HPy_tp_richcompare_bool, it would call the impl with the universal
+   ctx, bypassing the debug mode. Instead, debug_richcompare_bool_fast calls
+   the impl with dctx if the type was created in debug mode, else we go
+   through HPy_RichCompare, which calls the impl via its trampoline. */
+int debug_ctx_RichCompareBool(HPyContext *dctx, DHPy v, DHPy w, int op)
+{
+    HPyContext *uctx = get_info(dctx)->uctx;
+    UHPy uh_v = DHPy_unwrap(dctx, v);
+    UHPy uh_w = DHPy_unwrap(dctx, w);
+    /* identity implies equality, like in PyObject_RichCompareBool */
+    if (HPy_Is(uctx, uh_v, uh_w)) {
+        if (op == HPy_EQ)
+            return 1;
+        else if (op == HPy_NE)
+            return 0;
+    }
+    int res;
+    if (debug_richcompare_bool_fast(dctx, v, w, op, &res))
+        return res;
+    UHPy uh_res = HPy_RichCompare(uctx, uh_v, uh_w, op);
+    if (HPy_IsNull(uh_res))
+        return -1;
+    res = HPy_IsTrue(uctx, uh_res);
+    HPy_Close(uctx, uh_res);
+    return res;
+}
+
 DHPy debug_ctx_Type_FromSpec(HPyContext *dctx, HPyType_Spec *spec, HPyType_SpecParam *dparams)
 {
     // dparams might contain some hidden DHPy: we need to manually unwrap them.
@@ -165,9 +312,46 @@ DHPy debug_ctx_Type_FromSpec(HPyContext *dctx, HPyType_Spec *spec, HPyType_SpecP
             uparams[i].kind = dparams[i].kind;
             uparams[i].object = DHPy_unwrap(dctx, dparams[i].object);
         }
-        return DHPy_open(dctx, HPyType_FromSpec(get_info(dctx)->uctx, spec, uparams));
+        return debug_type_from_spec_result(dctx,
+                   HPyType_FromSpec(get_info(dctx)->uctx, spec, uparams));
     }
-    return DHPy_open(dctx, HPyType_FromSpec(get_info(dctx)->uctx, spec, NULL));
+    return debug_type_from_spec_result(dctx,
+               HPyType_FromSpec(get_info(dctx)->uctx, spec, NULL));
+}
+
+/* Like debug_ctx_Type_FromSpec, defs might contain some hidden DHPy, either
+   as HPyAttr_Kind_Object values or inside the params of HPyAttr_Kind_Type.
+   Moreover, the types must be created by debug_ctx_Type_FromSpec, so that
+   their impls are known to expect DHPy. So we set the attributes one at a
+   time, passing the types to the universal HPy_SetAttrs as objects.
+*/
+int debug_ctx_SetAttrs(HPyContext *dctx, DHPy obj, HPyAttrDef *ddefs)
+{
+    HPyContext *uctx = get_info(dctx)->uctx;
+    UHPy uh_obj = DHPy_unwrap(dctx, obj);
+    for (HPyAttrDef *d = ddefs; d->kind != 0; d++) {
+        HPyAttrDef udefs[2] = { *d, {0} };
+        DHPy dh_type = HPy_NULL;
+        if (d->kind == HPyAttr_Kind_Object) {
+            udefs[0].object = DHPy_unwrap(dctx, d->object);
+        }
+        else if (d->kind == HPyAttr_Kind_Type) {
+            dh_type = debug_ctx_Type_FromSpec(dctx, d->type.spec,
+                                              d->type.params);
+            if (HPy_IsNull(dh_type))
+                return -1;
+            udefs[0].kind = HPyAttr_Kind_Object;
+            udefs[0].object = DHPy_unwrap(dctx, dh_type);
+        }
+        int res = HPy_SetAttrs(uctx, uh_obj, udefs);
+        // keep the interned name cached in the table of the extension
+        d->_name_obj = udefs[0]._name_obj;
+        if (!HPy_IsNull(dh_type))
+            DHPy_close(dctx, dh_type);
+        if (res < 0)
+            return -1;
+    }
+    return 0;
 }
 
 /* ~~~ debug mode implementation of HPyTracker ~~~
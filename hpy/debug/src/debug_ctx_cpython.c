@@ -23,20 +23,61 @@
 
 #include <Python.h>
 #include "debug_internal.h"
-#include "hpy/runtime/ctx_type.h" // for call_traverseproc_from_trampoline
+#include "hpy/runtime/ctx_type.h" // for call_traverseproc_from_trampoline,
+                                   // set_type_impl_context,
+                                   // richcmpbool_result_to_py and
+                                   // _HPy_GetStructsIfSameType
+#include "hpy/runtime/ctx_funcs.h" // for _HPyMem_ScratchEnter/Leave
 #include "handles.h" // for _py2h and _h2py
 #if defined(_MSC_VER)
 # include <malloc.h>   /* for alloca() */
 #endif
 
-static inline DHPy _py2dh(HPyContext *dctx, PyObject *obj)
+/* The trampolines are the hottest path of the debug mode, so each level has
+   its own copy of debug_call_real_function: the "leaks" argument of the
+   helpers below is always a constant, and the branches on it are resolved
+   at compile time. */
+#if defined(_MSC_VER)
+#  define DEBUG_ALWAYS_INLINE __forceinline
+#else
+#  define DEBUG_ALWAYS_INLINE inline __attribute__((always_inline))
+#endif
+
+static DEBUG_ALWAYS_INLINE DHPy _py2dh(HPyContext *dctx, PyObject *obj,
+                                       const bool leaks)
 {
+    if (leaks)
+        return DHPy_open_leaks(dctx, _py2h(obj));
     return DHPy_open(dctx, _py2h(obj));
 }
 
-static inline PyObject *_dh2py(HPyContext *dctx, DHPy dh)
+// NOTE: this is used only for the results of the functions, which are owned
+static DEBUG_ALWAYS_INLINE PyObject *_dh2py(HPyContext *dctx, DHPy dh,
+                                            const bool leaks)
+{
+    if (leaks)
+        return _h2py_steal(DHPy_unwrap_nocheck(dctx, dh));
+    return _h2py_steal(DHPy_unwrap(dctx, dh));
+}
+
+static DEBUG_ALWAYS_INLINE void _dh_close(HPyContext *dctx, DHPy dh,
+                                          const bool leaks)
+{
+    if (leaks)
+        DHPy_close_leaks(dctx, dh);
+    else
+        DHPy_close(dctx, dh);
+}
+
+// close the handle of an argument, checking that the function did not close
+// it, except at HPY_DEBUG_LEVEL_LEAKS
+static DEBUG_ALWAYS_INLINE void _dh_close_arg(HPyContext *dctx, DHPy dh,
+                                              const bool leaks)
 {
-    return _h2py(DHPy_unwrap(dctx, dh));
+    if (leaks)
+        DHPy_close_leaks(dctx, dh);
+    else
+        DHPy_close_and_check(dctx, dh);
 }
 
 static void _buffer_h2py(HPyContext *dctx, const HPy_buffer *src, Py_buffer *dest)
@@ -69,96 +110,96 @@ static void _buffer_py2h(HPyContext *dctx, const Py_buffer *src, HPy_buffer *des
     dest->internal = src->internal;
 }
 
-void debug_ctx_CallRealFunctionFromTrampoline(HPyContext *dctx,
-                                              HPyFunc_Signature sig,
-                                              void *func, void *args)
+static DEBUG_ALWAYS_INLINE void
+debug_call_real_function(HPyContext *dctx, HPyFunc_Signature sig,
+                         void *func, void *args, const bool leaks)
 {
     switch (sig) {
     case HPyFunc_NOARGS: {
         HPyFunc_noargs f = (HPyFunc_noargs)func;
         _HPyFunc_args_NOARGS *a = (_HPyFunc_args_NOARGS*)args;
-        DHPy dh_self = _py2dh(dctx, a->self);
+        DHPy dh_self = _py2dh(dctx, a->self, leaks);
         DHPy dh_result = f(dctx, dh_self);
-        DHPy_close_and_check(dctx, dh_self);
-        a->result = _dh2py(dctx, dh_result);
-        DHPy_close(dctx, dh_result);
+        _dh_close_arg(dctx, dh_self, leaks);
+        a->result = _dh2py(dctx, dh_result, leaks);
+        _dh_close(dctx, dh_result, leaks);
         return;
     }
     case HPyFunc_O: {
         HPyFunc_o f = (HPyFunc_o)func;
         _HPyFunc_args_O *a = (_HPyFunc_args_O*)args;
-        DHPy dh_self = _py2dh(dctx, a->self);
-        DHPy dh_arg = _py2dh(dctx, a->arg);
+        DHPy dh_self = _py2dh(dctx, a->self, leaks);
+        DHPy dh_arg = _py2dh(dctx, a->arg, leaks);
         DHPy dh_result = f(dctx, dh_self, dh_arg);
-        DHPy_close_and_check(dctx, dh_self);
-        DHPy_close_and_check(dctx, dh_arg);
-        a->result = _dh2py(dctx, dh_result);
-        DHPy_close(dctx, dh_result);
+        _dh_close_arg(dctx, dh_self, leaks);
+        _dh_close_arg(dctx, dh_arg, leaks);
+        a->result = _dh2py(dctx, dh_result, leaks);
+        _dh_close(dctx, dh_result, leaks);
         return;
     }
     case HPyFunc_VARARGS: {
         HPyFunc_varargs f = (HPyFunc_varargs)func;
         _HPyFunc_args_VARARGS *a = (_HPyFunc_args_VARARGS*)args;
-        DHPy dh_self = _py2dh(dctx, a->self);
+        DHPy dh_self = _py2dh(dctx, a->self, leaks);
         Py_ssize_t nargs = PyTuple_GET_SIZE(a->args);
         DHPy *dh_args = (DHPy *)alloca(nargs * sizeof(DHPy));
         for (Py_ssize_t i = 0; i < nargs; i++) {
-            dh_args[i] = _py2dh(dctx, PyTuple_GET_ITEM(a->args, i));
+            dh_args[i] = _py2dh(dctx, PyTuple_GET_ITEM(a->args, i), leaks);
         }
         DHPy dh_result = f(dctx, dh_self, dh_args, nargs);
-        DHPy_close_and_check(dctx, dh_self);
+        _dh_close_arg(dctx, dh_self, leaks);
         for (Py_ssize_t i = 0; i < nargs; i++) {
-            DHPy_close_and_check(dctx, dh_args[i]);
+            _dh_close_arg(dctx, dh_args[i], leaks);
         }
-        a->result = _dh2py(dctx, dh_result);
-        DHPy_close(dctx, dh_result);
+        a->result = _dh2py(dctx, dh_result, leaks);
+        _dh_close(dctx, dh_result, leaks);
         return;
     }
     case HPyFunc_KEYWORDS: {
         HPyFunc_keywords f = (HPyFunc_keywords)func;
         _HPyFunc_args_KEYWORDS *a = (_HPyFunc_args_KEYWORDS*)args;
-        DHPy dh_self = _py2dh(dctx, a->self);
+        DHPy dh_self = _py2dh(dctx, a->self, leaks);
         Py_ssize_t nargs = PyTuple_GET_SIZE(a->args);
         DHPy *dh_args = (DHPy *)alloca(nargs * sizeof(DHPy));
         for (Py_ssize_t i = 0; i < nargs; i++) {
-            dh_args[i] = _py2dh(dctx, PyTuple_GET_ITEM(a->args, i));
+            dh_args[i] = _py2dh(dctx, PyTuple_GET_ITEM(a->args, i), leaks);
         }
-        DHPy dh_kw = _py2dh(dctx, a->kw);
+        DHPy dh_kw = _py2dh(dctx, a->kw, leaks);
         DHPy dh_result = f(dctx, dh_self, dh_args, nargs, dh_kw);
-        DHPy_close_and_check(dctx, dh_self);
+        _dh_close_arg(dctx, dh_self, leaks);
         for (Py_ssize_t i = 0; i < nargs; i++) {
-            DHPy_close_and_check(dctx, dh_args[i]);
+            _dh_close_arg(dctx, dh_args[i], leaks);
         }
-        DHPy_close_and_check(dctx, dh_kw);
-        a->result = _dh2py(dctx, dh_result);
-        DHPy_close(dctx, dh_result);
+        _dh_close_arg(dctx, dh_kw, leaks);
+        a->result = _dh2py(dctx, dh_result, leaks);
+        _dh_close(dctx, dh_result, leaks);
         return;
     }
     case HPyFunc_INITPROC: {
         HPyFunc_initproc f = (HPyFunc_initproc)func;
         _HPyFunc_args_INITPROC *a = (_HPyFunc_args_INITPROC*)args;
-        DHPy dh_self = _py2dh(dctx, a->self);
+        DHPy dh_self = _py2dh(dctx, a->self, leaks);
         Py_ssize_t nargs = PyTuple_GET_SIZE(a->args);
         DHPy *dh_args = (DHPy *)alloca(nargs * sizeof(DHPy));
         for (Py_ssize_t i = 0; i < nargs; i++) {
-            dh_args[i] = _py2dh(dctx, PyTuple_GET_ITEM(a->args, i));
+            dh_args[i] = _py2dh(dctx, PyTuple_GET_ITEM(a->args, i), leaks);
         }
-        DHPy dh_kw = _py2dh(dctx, a->kw);
+        DHPy dh_kw = _py2dh(dctx, a->kw, leaks);
         a->result = f(dctx, dh_self, dh_args, nargs, dh_kw);
-        DHPy_close_and_check(dctx, dh_self);
+        _dh_close_arg(dctx, dh_self, leaks);
         for (Py_ssize_t i = 0; i < nargs; i++) {
-            DHPy_close_and_check(dctx, dh_args[i]);
+            _dh_close_arg(dctx, dh_args[i], leaks);
         }
-        DHPy_close_and_check(dctx, dh_kw);
+        _dh_close_arg(dctx, dh_kw, leaks);
         return;
     }
     case HPyFunc_GETBUFFERPROC: {
         HPyFunc_getbufferproc f = (HPyFunc_getbufferproc)func;
         _HPyFunc_args_GETBUFFERPROC *a = (_HPyFunc_args_GETBUFFERPROC*)args;
         HPy_buffer hbuf;
-        DHPy dh_self = _py2dh(dctx, a->self);
+        DHPy dh_self = _py2dh(dctx, a->self, leaks);
         a->result = f(dctx, dh_self, &hbuf, a->flags);
-        DHPy_close_and_check(dctx, dh_self);
+        _dh_close_arg(dctx, dh_self, leaks);
         if (a->result < 0) {
             a->view->obj = NULL;
             return;
@@ -172,9 +213,9 @@ void debug_ctx_CallRealFunctionFromTrampoline(HPyContext *dctx,
         _HPyFunc_args_RELEASEBUFFERPROC *a = (_HPyFunc_args_RELEASEBUFFERPROC*)args;
         HPy_buffer hbuf;
         _buffer_py2h(dctx, a->view, &hbuf);
-        DHPy dh_self = _py2dh(dctx, a->self);
+        DHPy dh_self = _py2dh(dctx, a->self, leaks);
         f(dctx, dh_self, &hbuf);
-        DHPy_close_and_check(dctx, dh_self);
+        _dh_close_arg(dctx, dh_self, leaks);
         // XXX: copy back from hbuf?
         HPy_Close(dctx, hbuf.obj);
         return;
@@ -186,8 +227,93 @@ void debug_ctx_CallRealFunctionFromTrampoline(HPyContext *dctx,
                                                       a->visit, a->arg);
         return;
     }
+    case HPyFunc_RICHCMPBOOLFUNC: {
+        HPyFunc_richcmpboolfunc f = (HPyFunc_richcmpboolfunc)func;
+        _HPyFunc_args_RICHCMPBOOLFUNC *a = (_HPyFunc_args_RICHCMPBOOLFUNC*)args;
+        DHPy dh_arg0 = _py2dh(dctx, a->arg0, leaks);
+        DHPy dh_arg1 = _py2dh(dctx, a->arg1, leaks);
+        int res = f(dctx, dh_arg0, dh_arg1, a->arg2);
+        _dh_close_arg(dctx, dh_arg0, leaks);
+        _dh_close_arg(dctx, dh_arg1, leaks);
+        a->result = richcmpbool_result_to_py(res);
+        return;
+    }
+    case HPyFunc_TYPEDBINARYFUNC: {
+        HPyFunc_binaryfunc f = (HPyFunc_binaryfunc)func;
+        _HPyFunc_args_TYPEDBINARYFUNC *a = (_HPyFunc_args_TYPEDBINARYFUNC*)args;
+        DHPy dh_arg0 = _py2dh(dctx, a->arg0, leaks);
+        DHPy dh_arg1 = _py2dh(dctx, a->arg1, leaks);
+        void *data0, *data1;
+        DHPy dh_result;
+        if (_HPy_GetStructsIfSameType(a->arg0, a->arg1, &data0, &data1))
+            dh_result = a->typed_impl(dctx, dh_arg0, data0, dh_arg1, data1);
+        else
+            dh_result = f(dctx, dh_arg0, dh_arg1);
+        _dh_close_arg(dctx, dh_arg0, leaks);
+        _dh_close_arg(dctx, dh_arg1, leaks);
+        a->result = _dh2py(dctx, dh_result, leaks);
+        _dh_close(dctx, dh_result, leaks);
+        return;
+    }
 #include "autogen_debug_ctx_call.i"
     default:
         Py_FatalError("Unsupported HPyFunc_Signature in debug_ctx_cpython.c");
     }
 }
+
+void debug_ctx_CallRealFunctionFromTrampoline(HPyContext *dctx,
+                                              HPyFunc_Signature sig,
+                                              void *func, void *args)
+{
+    void *scratch_mark = _HPyMem_ScratchEnter();
+    debug_call_real_function(dctx, sig, func, args, false);
+    _HPyMem_ScratchLeave(scratch_mark);
+    // tp_traverse runs in the middle of a GC collection: not a safe point
+    if (sig != HPyFunc_TRAVERSEPROC)
+        _HPyDealloc_SafePoint();
+}
+
+void debug_leaks_ctx_CallRealFunctionFromTrampoline(HPyContext *dctx,
+                                                    HPyFunc_Signature sig,
+                                                    HPyCFunction func,
+                                                    void *args)
+{
+    void *scratch_mark = _HPyMem_ScratchEnter();
+    debug_call_real_function(dctx, sig, (void *)func, args, true);
+    _HPyMem_ScratchLeave(scratch_mark);
+    if (sig != HPyFunc_TRAVERSEPROC)
+        _HPyDealloc_SafePoint();
+}
+
+/* The universal HPy_RichCompareBool calls the impl of
+   HPy_tp_richcompare_bool directly only if the type was created with its
+   ctx: record that the impls of this type expect the debug ctx instead. */
+DHPy debug_type_from_spec_result(HPyContext *dctx, UHPy uh_type)
+{
+    if (!HPy_IsNull(uh_type))
+        set_type_impl_context((PyTypeObject *)_h2py(uh_type), dctx);
+    return DHPy_open(dctx, uh_type);
+}
+
+bool debug_richcompare_bool_fast(HPyContext *dctx, DHPy v, DHPy w, int op,
+                                 int *result)
+{
+    PyObject *v_obj = _h2py(DHPy_unwrap(dctx, v));
+    PyObject *w_obj = _h2py(DHPy_unwrap(dctx, w));
+    PyTypeObject *tp = Py_TYPE(v_obj);
+    if (tp != Py_TYPE(w_obj))
+        return false;
+    bool is_tp_richcompare = false;
+    HPyFunc_richcmpboolfunc f = get_richcompare_bool_impl(tp, dctx,
+                                                    &is_tp_richcompare);
+    if (f == NULL)
+        return false;
+    int res = f(dctx, v, w, (HPy_RichCmpOp)op);
+    if (res == HPy_RICHCMP_NOTIMPLEMENTED) {
+        if (!is_tp_richcompare)
+            return false;
+        res = richcmpbool_notimplemented(v_obj, w_obj, op);
+    }
+    *result = res;
+    return true;
+}
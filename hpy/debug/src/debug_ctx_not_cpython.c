@@ -14,3 +14,22 @@ void debug_ctx_CallRealFunctionFromTrampoline(HPyContext *dctx,
                    "Something is very wrong! _HPy_CallRealFunctionFromTrampoline() "
                    "should be used only by the CPython version of hpy.universal");
 }
+
+void debug_leaks_ctx_CallRealFunctionFromTrampoline(HPyContext *dctx,
+                                                    HPyFunc_Signature sig,
+                                                    HPyCFunction func,
+                                                    void *args)
+{
+    debug_ctx_CallRealFunctionFromTrampoline(dctx, sig, (void *)func, args);
+}
+
+DHPy debug_type_from_spec_result(HPyContext *dctx, UHPy uh_type)
+{
+    return DHPy_open(dctx, uh_type);
+}
+
+bool debug_richcompare_bool_fast(HPyContext *dctx, DHPy v, DHPy w, int op,
+                                 int *result)
+{
+    return false;
+}
@@ -19,16 +19,59 @@ static void debug_handles_sanity_check(HPyDebugInfo *info)
 #endif
 }
 
-static void DebugHandle_free_raw_data(HPyDebugInfo *info, DebugHandle *handle, bool was_counted_in_limit) {
-    if (handle->associated_data) {
-        if (was_counted_in_limit) {
-            info->protected_raw_data_size -= handle->associated_data_size;
-        }
-        if (raw_data_free(handle->associated_data, handle->associated_data_size)) {
-            HPy_FatalError(info->uctx, "HPy could not free internally allocated memory.");
+// Detach the raw data from the handle and update the accounting of the
+// protected memory. The caller must hold info->lock, and must release the
+// memory with free_raw_data after releasing the lock.
+static void detach_raw_data(HPyDebugInfo *info, DebugHandle *handle,
+                            bool was_counted_in_limit,
+                            void **data, HPy_ssize_t *size)
+{
+    *data = handle->associated_data;
+    *size = handle->associated_data_size;
+    if (*data != NULL && was_counted_in_limit) {
+        info->protected_raw_data_size -= *size;
+    }
+    handle->associated_data = NULL;
+}
+
+static void free_raw_data(HPyDebugInfo *info, void *data, HPy_ssize_t size)
+{
+    if (data != NULL && raw_data_free(data, size)) {
+        HPy_FatalError(info->uctx, "HPy could not free internally allocated memory.");
+    }
+}
+
+static void free_handle(DebugHandle *handle)
+{
+    // this is not strictly necessary, but it increases the chances that you
+    // get a clear segfault if you use a freed handle
+    handle->uh = HPy_NULL;
+    free(handle);
+}
+
+// Initialize a recycled or freshly allocated handle and put it into
+// info->open_handles
+static DHPy open_handle(HPyDebugInfo *info, DebugHandle *handle, UHPy uh)
+{
+    if (handle == NULL) {
+        handle = malloc(sizeof(DebugHandle));
+        if (handle == NULL) {
+            return HPyErr_NoMemory(info->uctx);
         }
-        handle->associated_data = NULL;
+        handle->pin_count = 0;
     }
+    // a recycled handle might still be pinned by _debugmod.c, so we keep its
+    // pin_count
+    handle->uh = uh;
+    handle->is_closed = 0;
+    handle->associated_data = NULL;
+    handle->evicted = false;
+    DHLock_acquire(&info->lock);
+    handle->generation = info->current_generation;
+    DHQueue_append(&info->open_handles, handle);
+    debug_handles_sanity_check(info);
+    DHLock_release(&info->lock);
+    return as_DHPy(handle);
 }
 
 DHPy DHPy_open(HPyContext *dctx, UHPy uh)
@@ -41,23 +84,59 @@ DHPy DHPy_open(HPyContext *dctx, UHPy uh)
     // if the closed_handles queue is full, let's reuse one of those. Else,
     // malloc a new one
     DebugHandle *handle = NULL;
+    void *old_data = NULL;
+    HPy_ssize_t old_size = 0;
+    DHLock_acquire(&info->lock);
     if (info->closed_handles.size >= info->closed_handles_queue_max_size) {
         handle = DHQueue_popfront(&info->closed_handles);
-        DebugHandle_free_raw_data(info, handle, true);
-    }
-    else {
-        handle = malloc(sizeof(DebugHandle));
-        if (handle == NULL) {
-            return HPyErr_NoMemory(info->uctx);
+        if (handle->pin_count > 0) {
+            // it will be freed by DebugHandle_unpin
+            handle->evicted = true;
+            handle = NULL;
+        }
+        else {
+            detach_raw_data(info, handle, true, &old_data, &old_size);
         }
     }
-    handle->uh = uh;
-    handle->generation = info->current_generation;
-    handle->is_closed = 0;
-    handle->associated_data = NULL;
-    DHQueue_append(&info->open_handles, handle);
-    debug_handles_sanity_check(info);
-    return as_DHPy(handle);
+    DHLock_release(&info->lock);
+    free_raw_data(info, old_data, old_size);
+    return open_handle(info, handle, uh);
+}
+
+// The DHPy_open of HPY_DEBUG_LEVEL_LEAKS: see DHPy_close_leaks
+DHPy DHPy_open_leaks(HPyContext *dctx, UHPy uh)
+{
+    UHPy_sanity_check(uh);
+    if (HPy_IsNull(uh))
+        return HPy_NULL;
+    HPyDebugInfo *info = get_info(dctx);
+    DebugHandle *handle = NULL;
+    DHLock_acquire(&info->lock);
+    if (info->free_handles != NULL) {
+        // the handles in the free list have no raw data
+        handle = info->free_handles;
+        info->free_handles = handle->next;
+        info->n_free_handles--;
+    }
+    DHLock_release(&info->lock);
+    return open_handle(info, handle, uh);
+}
+
+void DebugHandle_unpin(HPyDebugInfo *info, DebugHandle *handle)
+{
+    void *data = NULL;
+    HPy_ssize_t size = 0;
+    DHLock_acquire(&info->lock);
+    assert(handle->pin_count > 0);
+    bool must_free = --handle->pin_count == 0 && handle->evicted;
+    if (must_free) {
+        detach_raw_data(info, handle, true, &data, &size);
+    }
+    DHLock_release(&info->lock);
+    if (must_free) {
+        free_raw_data(info, data, size);
+        free_handle(handle);
+    }
 }
 
 static void print_error(HPyContext *uctx, const char *message)
@@ -96,7 +175,8 @@ void DHPy_invalid_handle(HPyContext *dctx, DHPy dh)
 
 // DHPy_close, unlike debug_ctx_Close does not check the validity of the handle.
 // Use this in case you want to close only the debug handle like DHPy_close,
-// you but still want to check its validity
+// you but still want to check its validity. HPY_DEBUG_LEVEL_LEAKS does not
+// check the validity of the handles, so it uses DHPy_close_leaks instead.
 void DHPy_close_and_check(HPyContext *dctx, DHPy dh) {
     DHPy_unwrap(dctx, dh);
     DHPy_close(dctx, dh);
@@ -126,13 +206,26 @@ void DHPy_close(HPyContext *dctx, DHPy dh)
        install a hook which emits a warning and let the user to fix the
        problems one by one, without aborting the process.
     */
-    if (handle->is_closed)
+    DHLock_acquire(&info->lock);
+    if (handle->is_closed) {
+        DHLock_release(&info->lock);
         return;
+    }
 
     // move the handle from open_handles to closed_handles
     DHQueue_remove(&info->open_handles, handle);
     DHQueue_append(&info->closed_handles, handle);
     handle->is_closed = true;
+
+    // the memory to release or protect once we have released the lock
+    void *data_to_free = NULL;
+    HPy_ssize_t data_to_free_size = 0;
+    void *data_to_protect = NULL;
+    HPy_ssize_t data_to_protect_size = 0;
+    DebugHandle *oldest = NULL;
+    void *oldest_data = NULL;
+    HPy_ssize_t oldest_data_size = 0;
+
     if (handle->associated_data) {
         // So far all implementations of raw_data_protect keep the physical
         // memory (or at least are not guaranteed to release it), which leaks.
@@ -145,30 +238,82 @@ void DHPy_close(HPyContext *dctx, DHPy dh)
         HPy_ssize_t new_size = info->protected_raw_data_size + handle->associated_data_size;
         if (new_size > info->protected_raw_data_max_size) {
             // free it now
-            DebugHandle_free_raw_data(info, handle, false);
+            detach_raw_data(info, handle, false, &data_to_free, &data_to_free_size);
         } else {
-            // keep/leak it and make it protected from further reading
+            // keep/leak it and make it protected from further reading. The
+            // handle is pinned until it is protected, so that nobody frees
+            // the data in the meantime
             info->protected_raw_data_size = new_size;
-            raw_data_protect(handle->associated_data, handle->associated_data_size);
+            data_to_protect = handle->associated_data;
+            data_to_protect_size = handle->associated_data_size;
+            DebugHandle_pin(info, handle);
         }
     }
 
     if (info->closed_handles.size > info->closed_handles_queue_max_size) {
         // we have too many closed handles. Let's free the oldest one
-        DebugHandle *oldest = DHQueue_popfront(&info->closed_handles);
-        DHPy_free(dctx, as_DHPy(oldest));
+        oldest = DHQueue_popfront(&info->closed_handles);
+        if (oldest->pin_count > 0) {
+            // it will be freed by DebugHandle_unpin
+            oldest->evicted = true;
+            oldest = NULL;
+        }
+        else {
+            detach_raw_data(info, oldest, true, &oldest_data, &oldest_data_size);
+        }
     }
     debug_handles_sanity_check(info);
+    DHLock_release(&info->lock);
+
+    free_raw_data(info, data_to_free, data_to_free_size);
+    if (data_to_protect != NULL) {
+        raw_data_protect(data_to_protect, data_to_protect_size);
+        DebugHandle_unpin(info, handle);
+    }
+    if (oldest != NULL) {
+        free_raw_data(info, oldest_data, oldest_data_size);
+        free_handle(oldest);
+    }
 }
 
-void DHPy_free(HPyContext *dctx, DHPy dh)
+// The DHPy_close of HPY_DEBUG_LEVEL_LEAKS, which does not detect the usage
+// of closed handles: there is no point in keeping them in closed_handles, so
+// they are recycled through info->free_handles by DHPy_open_leaks.
+void DHPy_close_leaks(HPyContext *dctx, DHPy dh)
 {
     DHPy_sanity_check(dh);
-    DebugHandle *handle = as_DebugHandle(dh);
+    if (HPy_IsNull(dh))
+        return;
     HPyDebugInfo *info = get_info(dctx);
-    DebugHandle_free_raw_data(info, handle, true);
-    // this is not strictly necessary, but it increases the chances that you
-    // get a clear segfault if you use a freed handle
-    handle->uh = HPy_NULL;
-    free(handle);
+    DebugHandle *handle = as_DebugHandle(dh);
+    DHLock_acquire(&info->lock);
+    if (handle->is_closed) {
+        DHLock_release(&info->lock);
+        return;
+    }
+    if (handle->associated_data != NULL) {
+        // only the handles of HPY_DEBUG_LEVEL_FULL have raw data, e.g. one
+        // which was passed from a module which uses that level: release the
+        // data as usual
+        DHLock_release(&info->lock);
+        DHPy_close(dctx, dh);
+        return;
+    }
+    DHQueue_remove(&info->open_handles, handle);
+    handle->is_closed = true;
+    if (info->n_free_handles < info->closed_handles_queue_max_size) {
+        handle->prev = NULL;
+        handle->next = info->free_handles;
+        info->free_handles = handle;
+        info->n_free_handles++;
+        handle = NULL;
+    }
+    else if (handle->pin_count > 0) {
+        // it will be freed by DebugHandle_unpin
+        handle->evicted = true;
+        handle = NULL;
+    }
+    DHLock_release(&info->lock);
+    if (handle != NULL)
+        free_handle(handle);
 }
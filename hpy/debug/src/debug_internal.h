@@ -42,7 +42,7 @@
 
      - DHPy_close() moves a DHPy from info->open_handles to info->closed_handles
 
-     - if closed_handles is too big, the oldest DHPy is freed by DHPy_free()
+     - if closed_handles is too big, the oldest DHPy is freed
 
      - to allocate memory for a new DHPy, DHPy_open() does the following:
 
@@ -51,6 +51,13 @@
 
          * else, it malloc()s memory for a new DHPy
 
+   At HPY_DEBUG_LEVEL_LEAKS the usage of closed handles is not detected, so
+   there is no point in keeping them around: that level uses its own entry
+   points, DHPy_open_leaks() and DHPy_close_leaks(), which recycle the
+   handles through info->free_handles, a plain free list, and never look at
+   closed_handles. The wrappers which are shared by all the levels use
+   DHPy_open() and DHPy_close(), which work with the handles of any level.
+
 
    Each DebugHandle can have some "raw" data associated with it. It is a
    generic pointer to any data. The validity, or life-time, of such pointer
@@ -142,6 +149,9 @@ typedef struct DebugHandle {
     // the lifetime of the handle:
     void *associated_data;
     HPy_ssize_t associated_data_size;
+    // see DebugHandle_pin
+    int pin_count;
+    bool evicted;
     struct DebugHandle *prev;
     struct DebugHandle *next;
 } DebugHandle;
@@ -158,9 +168,29 @@ static inline DHPy as_DHPy(DebugHandle *handle) {
 DHPy DHPy_open(HPyContext *dctx, UHPy uh);
 void DHPy_close(HPyContext *dctx, DHPy dh);
 void DHPy_close_and_check(HPyContext *dctx, DHPy dh);
-void DHPy_free(HPyContext *dctx, DHPy dh);
+DHPy DHPy_open_leaks(HPyContext *dctx, UHPy uh);
+void DHPy_close_leaks(HPyContext *dctx, DHPy dh);
 void DHPy_invalid_handle(HPyContext *dctx, DHPy dh);
 
+/* Wrap the type returned by HPyType_FromSpec, after recording that its
+   impls expect DHPy. This and debug_richcompare_bool_fast are implemented in
+   debug_ctx_cpython.c and debug_ctx_not_cpython.c. */
+DHPy debug_type_from_spec_result(HPyContext *dctx, UHPy uh_type);
+
+/* The fast path of HPy_RichCompareBool for the types created in debug mode:
+   if it can be taken, store the result in *result and return true. */
+bool debug_richcompare_bool_fast(HPyContext *dctx, DHPy v, DHPy w, int op,
+                                 int *result);
+
+/* The replacements of the manually written debug_ctx_Close and
+   debug_ctx_CallRealFunctionFromTrampoline for HPY_DEBUG_LEVEL_LEAKS, which
+   use DHPy_open_leaks and DHPy_close_leaks. */
+void debug_leaks_ctx_Close(HPyContext *dctx, DHPy dh);
+void debug_leaks_ctx_CallRealFunctionFromTrampoline(HPyContext *dctx,
+                                                    HPyFunc_Signature sig,
+                                                    HPyCFunction func,
+                                                    void *args);
+
 static inline UHPy DHPy_unwrap(HPyContext *dctx, DHPy dh)
 {
     if (HPy_IsNull(dh))
@@ -171,6 +201,16 @@ static inline UHPy DHPy_unwrap(HPyContext *dctx, DHPy dh)
     return handle->uh;
 }
 
+/* Like DHPy_unwrap, but without checking that the handle is still open. This
+   is used by the wrappers of HPY_DEBUG_LEVEL_LEAKS, which detect only the
+   leaks: using a closed handle is not reported at that level. */
+static inline UHPy DHPy_unwrap_nocheck(HPyContext *dctx, DHPy dh)
+{
+    if (HPy_IsNull(dh))
+        return HPy_NULL;
+    return ((DebugHandle *)dh._i)->uh;
+}
+
 /* === DHQueue === */
 
 typedef struct {
@@ -185,6 +225,46 @@ DebugHandle *DHQueue_popfront(DHQueue *q);
 void DHQueue_remove(DHQueue *q, DebugHandle *h);
 void DHQueue_sanity_check(DHQueue *q);
 
+/* === DHLock ===
+
+   With the GIL, all the calls to the debug context are serialized. On
+   free-threaded builds of CPython, DHPy_open and DHPy_close can be called
+   concurrently from multiple threads, so the queues and the counters of
+   HPyDebugInfo must be protected by info->lock. This is enabled by
+   HPY_DEBUG_THREAD_SAFE, which setup.py defines when needed; otherwise the
+   lock is a no-op. The critical sections are very short and never call back
+   into Python: the system calls which release or protect the raw data
+   (raw_data_free, raw_data_protect) and malloc/free of the DebugHandles
+   happen after releasing the lock, so a simple spin lock is enough.
+*/
+
+#ifdef HPY_DEBUG_THREAD_SAFE
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+typedef volatile long DHLock;
+#    define _DHLock_try_acquire(l) (_InterlockedExchange((l), 1) == 0)
+#    define _DHLock_release(l) _InterlockedExchange((l), 0)
+#    define _DHLock_yield() ((void)0)
+#  else
+#    include <sched.h>
+typedef long DHLock;
+#    define _DHLock_try_acquire(l) (__atomic_exchange_n((l), 1, __ATOMIC_ACQUIRE) == 0)
+#    define _DHLock_release(l) __atomic_store_n((l), 0, __ATOMIC_RELEASE)
+#    define _DHLock_yield() sched_yield()
+#  endif
+static inline void DHLock_acquire(DHLock *l) {
+    while (!_DHLock_try_acquire(l))
+        _DHLock_yield();
+}
+static inline void DHLock_release(DHLock *l) {
+    _DHLock_release(l);
+}
+#else
+typedef long DHLock;
+static inline void DHLock_acquire(DHLock *l) { }
+static inline void DHLock_release(DHLock *l) { }
+#endif
+
 /* === HPyDebugInfo === */
 
 static const HPy_ssize_t DEFAULT_CLOSED_HANDLES_QUEUE_MAX_SIZE = 1024;
@@ -208,6 +288,9 @@ typedef struct {
     HPy_ssize_t protected_raw_data_size;
     DHQueue open_handles;
     DHQueue closed_handles;
+    DebugHandle *free_handles;          // linked by ->next, see above
+    HPy_ssize_t n_free_handles;         // at most closed_handles_queue_max_size
+    DHLock lock; // protects all the fields above, see DHLock
 } HPyDebugInfo;
 
 static inline HPyDebugInfo *get_info(HPyContext *dctx)
@@ -217,6 +300,19 @@ static inline HPyDebugInfo *get_info(HPyContext *dctx)
     return info;
 }
 
+/* A pinned DebugHandle is neither freed nor reused, even when it is evicted
+   from closed_handles: in that case it is only marked as "evicted" and it is
+   freed by the last DebugHandle_unpin. This is used by DHPy_close, which
+   protects the raw data after releasing the lock, and by _debugmod.c, which
+   operates on handles found in the queues. DebugHandle_pin must be called
+   while holding info->lock, DebugHandle_unpin acquires it. */
+static inline void DebugHandle_pin(HPyDebugInfo *info, DebugHandle *handle)
+{
+    handle->pin_count++;
+}
+
+void DebugHandle_unpin(HPyDebugInfo *info, DebugHandle *handle);
+
 
 void *raw_data_copy(const void* data, HPy_ssize_t size, bool write_protect);
 void raw_data_protect(void* data, HPy_ssize_t size);
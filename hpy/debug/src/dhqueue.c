@@ -1,7 +1,7 @@
 #include "debug_internal.h"
 
-// TODO: we need to make DHQueue thread-safe if we want to use the same
-// context in multiple threads
+// NOTE: DHQueue is not thread-safe by itself: the queues of HPyDebugInfo are
+// protected by info->lock
 void DHQueue_init(DHQueue *q) {
     q->head = NULL;
     q->tail = NULL;
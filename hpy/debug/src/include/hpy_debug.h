@@ -28,6 +28,29 @@ HPyContext * hpy_debug_get_ctx(HPyContext *uctx);
 int hpy_debug_ctx_init(HPyContext *dctx, HPyContext *uctx);
 void hpy_debug_set_ctx(HPyContext *dctx);
 
+/*
+  The debug mode can be used at different levels, which trade some of the
+  checks for speed:
+
+    - HPY_DEBUG_LEVEL_LEAKS: only track the open handles, to detect leaks.
+      The closed handles are recycled immediately, so their usage is NOT
+      detected, except for closing them twice before they are reused.
+
+    - HPY_DEBUG_LEVEL_FULL: also detect the usage of closed handles and
+      protect the raw data which is associated to the handles, e.g. the
+      buffer returned by HPyUnicode_AsUTF8AndSize. This is the level of
+      hpy_debug_get_ctx.
+
+  The contexts of all the levels share the same handles, so e.g. the leaks
+  are detected across all of them.
+*/
+typedef enum {
+    HPY_DEBUG_LEVEL_LEAKS = 1,
+    HPY_DEBUG_LEVEL_FULL = 2,
+} HPyDebugLevel;
+
+HPyContext * hpy_debug_get_ctx_level(HPyContext *uctx, HPyDebugLevel level);
+
 // convert between debug and universal handles. These are basically
 // the same as DHPy_open and DHPy_unwrap but with a different name
 // because this is the public-facing API and DHPy/UHPy are only internal
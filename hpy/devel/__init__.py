@@ -1,5 +1,6 @@
 import sys
 import os.path
+import copy
 import functools
 import re
 from pathlib import Path
@@ -42,6 +43,12 @@ class HPyDevel:
             self.src_dir.joinpath('argparse.c'),
             self.src_dir.joinpath('buildvalue.c'),
             self.src_dir.joinpath('helpers.c'),
+            self.src_dir.joinpath('structseq.c'),
+            self.src_dir.joinpath('structarray.c'),
+            self.src_dir.joinpath('listsort.c'),
+            self.src_dir.joinpath('hpymap.c'),
+            self.src_dir.joinpath('memo.c'),
+            self.src_dir.joinpath('strpool.c'),
         ]))
 
     def get_ctx_sources(self):
@@ -86,6 +93,10 @@ class HPyDevel:
             if resource.endswith(".hpy.so"):
                 log.info("stub file already created for %s", resource)
                 return
+            if _HPY_CPYTHON_TAG in os.path.basename(resource):
+                # the CPython ABI part of a fat build is loaded by the stub
+                # of the universal part
+                return
             orig_bdist_egg_write_stub(resource, pyfile)
 
         # replace build_ext subcommand
@@ -138,6 +149,50 @@ def __bootstrap__():
 __bootstrap__()
 """
 
+# the stub of a fat build (--hpy-abi=fat) first tries to load the CPython ABI
+# version of the module, if it was compiled for the running interpreter
+_HPY_FAT_MODULE_STUB_TEMPLATE = """
+# DO NOT EDIT THIS FILE!
+# This file is automatically generated by hpy
+
+def __bootstrap__():
+
+    import sys, os, pkg_resources
+    from importlib.machinery import EXTENSION_SUFFIXES
+    if {native_suffix!r} in EXTENSION_SUFFIXES:
+        native_filepath = pkg_resources.resource_filename(
+            __name__, {native_file!r})
+        if os.path.exists(native_filepath):
+            from importlib.machinery import ExtensionFileLoader
+            from importlib.util import spec_from_loader, module_from_spec
+            loader = ExtensionFileLoader(__name__, native_filepath)
+            spec = spec_from_loader(__name__, loader)
+            spec.origin = native_filepath
+            spec.has_location = True
+            m = module_from_spec(spec)
+            sys.modules[__name__] = m
+            loader.exec_module(m)
+            return
+
+    from hpy.universal import load
+    ext_filepath = pkg_resources.resource_filename(__name__, {ext_file!r})
+    m = load({module_name!r}, ext_filepath)
+    m.__file__ = ext_filepath
+    m.__loader__ = __loader__
+    m.__name__ = __name__
+    m.__package__ = __package__
+    m.__spec__ = __spec__
+    m.__spec__.origin = ext_filepath
+    sys.modules[__name__] = m
+
+__bootstrap__()
+"""
+
+# inserted after the module name in the file name of the CPython ABI part of
+# a fat build, e.g. foo.hpy-cpython.cpython-39-x86_64-linux-gnu.so: the file
+# cannot be imported directly, only through the stub.
+_HPY_CPYTHON_TAG = '.hpy-cpython'
+
 
 class HPyExtensionName(str):
     """ Wrapper around str to allow HPy extension modules to be identified.
@@ -160,6 +215,10 @@ class HPyExtensionName(str):
         return self.__class__(result)
 
 
+class HPyCPythonExtensionName(HPyExtensionName):
+    """ The name of the CPython ABI part of a fat build. """
+
+
 def is_hpy_extension(ext_name):
     """ Return True if the extension name is for an HPy extension. """
     return isinstance(ext_name, HPyExtensionName)
@@ -181,7 +240,7 @@ def remember_hpy_extension(f):
             )
         result = f(self, ext_name)
         if is_hpy_extension(ext_name):
-            result = HPyExtensionName(result)
+            result = ext_name.__class__(result)
         return result
     return wrapper
 
@@ -213,10 +272,28 @@ class build_hpy_ext_mixin:
         self.hpydevel = self.distribution.hpydevel
 
     def _finalize_hpy_ext(self, ext):
+        """ Add the HPy sources and flags to ext, and return the list of
+            extensions to build for it: in a fat build, the CPython ABI
+            part is a separate extension.
+        """
         if hasattr(ext, "hpy_abi"):
-            return
+            return [ext] + getattr(ext, "_hpy_fat_parts", [])
         ext.name = HPyExtensionName(ext.name)
-        ext.hpy_abi = self.distribution.hpy_abi
+        hpy_abi = self.distribution.hpy_abi
+        if hpy_abi == 'fat':
+            # the universal part is the main one, and its stub loads the
+            # CPython ABI part if it matches the running interpreter
+            cpy_ext = copy.deepcopy(ext)
+            cpy_ext.name = HPyCPythonExtensionName(ext.name)
+            self._add_hpy_sources(cpy_ext, 'cpython')
+            self._add_hpy_sources(ext, 'universal')
+            ext._hpy_fat_parts = [cpy_ext]
+            return [ext, cpy_ext]
+        self._add_hpy_sources(ext, hpy_abi)
+        return [ext]
+
+    def _add_hpy_sources(self, ext, hpy_abi):
+        ext.hpy_abi = hpy_abi
         ext.include_dirs += self.hpydevel.get_extra_include_dirs()
         ext.sources += self.hpydevel.get_extra_sources()
         ext.define_macros.append(('HPY', None))
@@ -228,7 +305,7 @@ class build_hpy_ext_mixin:
             ext._hpy_needs_stub = True
         else:
             raise DistutilsError('Unknown HPy ABI: %s. Valid values are: '
-                                 'cpython, universal' % ext.hpy_abi)
+                                 'cpython, universal, fat' % ext.hpy_abi)
 
     def finalize_options(self):
         self._extensions = self.distribution.ext_modules or []
@@ -236,9 +313,9 @@ class build_hpy_ext_mixin:
         # hpy extensions are misidentified as legacy C API extensions in the
         # case where only hpy extensions are present.
         self._only_hpy_extensions = not bool(self._extensions)
-        hpy_ext_modules = self.distribution.hpy_ext_modules or []
-        for ext in hpy_ext_modules:
-            self._finalize_hpy_ext(ext)
+        hpy_ext_modules = []
+        for ext in self.distribution.hpy_ext_modules or []:
+            hpy_ext_modules += self._finalize_hpy_ext(ext)
         self._extensions.extend(hpy_ext_modules)
         self._base_build_ext.finalize_options(self)
         for ext in hpy_ext_modules:
@@ -256,7 +333,15 @@ class build_hpy_ext_mixin:
     def get_ext_filename(self, ext_name):
         if not is_hpy_extension(ext_name):
             return self._base_build_ext.get_ext_filename(self, ext_name)
-        if self.distribution.hpy_abi == 'universal':
+        if isinstance(ext_name, HPyCPythonExtensionName):
+            ext_filename = self._base_build_ext.get_ext_filename(
+                self, ext_name)
+            head, tail = os.path.split(ext_filename)
+            mod_name = ext_name.split('.')[-1]
+            assert tail.startswith(mod_name)
+            tail = mod_name + _HPY_CPYTHON_TAG + tail[len(mod_name):]
+            ext_filename = os.path.join(head, tail)
+        elif self.distribution.hpy_abi in ('universal', 'fat'):
             ext_path = ext_name.split('.')
             ext_suffix = '.hpy.so'  # XXX Windows?
             ext_filename = os.path.join(*ext_path) + ext_suffix
@@ -265,9 +350,22 @@ class build_hpy_ext_mixin:
                 self, ext_name)
         return ext_filename
 
+    def build_extension(self, ext):
+        if not isinstance(ext.name, HPyCPythonExtensionName):
+            return self._base_build_ext.build_extension(self, ext)
+        # the CPython ABI part of a fat build is compiled from the same
+        # sources as the universal part, but with different macros: put its
+        # object files into a separate directory
+        build_temp = self.build_temp
+        self.build_temp = os.path.join(build_temp, 'hpy-cpython')
+        try:
+            return self._base_build_ext.build_extension(self, ext)
+        finally:
+            self.build_temp = build_temp
+
     def write_stub(self, output_dir, ext, compile=False):
         if (not hasattr(ext, "hpy_abi") or
-                self.distribution.hpy_abi != 'universal'):
+                ext.hpy_abi != 'universal'):
             return self._base_build_ext.write_stub(
                 self, output_dir, ext, compile=compile)
         pkgs = ext._full_name.split('.')
@@ -286,11 +384,19 @@ class build_hpy_ext_mixin:
 
         ext_file = os.path.basename(ext._file_name)
         module_name = ext_file.split(".")[0]
+        fat_parts = getattr(ext, "_hpy_fat_parts", [])
+        if fat_parts:
+            native_file = os.path.basename(fat_parts[0]._file_name)
+            native_suffix = native_file[len(module_name + _HPY_CPYTHON_TAG):]
+            stub = _HPY_FAT_MODULE_STUB_TEMPLATE.format(
+                ext_file=ext_file, module_name=module_name,
+                native_file=native_file, native_suffix=native_suffix)
+        else:
+            stub = _HPY_UNIVERSAL_MODULE_STUB_TEMPLATE.format(
+                ext_file=ext_file, module_name=module_name)
         if not self.dry_run:
             with open(stub_file, 'w') as f:
-                f.write(_HPY_UNIVERSAL_MODULE_STUB_TEMPLATE.format(
-                    ext_file=ext_file, module_name=module_name)
-                )
+                f.write(stub)
 
     def get_export_symbols(self, ext):
         """ Override .get_export_symbols to replace "PyInit_<module_name>"
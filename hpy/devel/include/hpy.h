@@ -107,8 +107,10 @@ extern "C" {
  */
 typedef struct _HPy_s { intptr_t _i; } HPy;
 typedef struct { intptr_t _i; } HPyField;
+typedef struct { intptr_t _i; } HPyGlobal;
 typedef struct { intptr_t _lst; } HPyListBuilder;
 typedef struct { intptr_t _tup; } HPyTupleBuilder;
+typedef struct { intptr_t _set; } HPyFrozenSetBuilder;
 typedef struct { intptr_t _i; } HPyTracker;
 
 
@@ -148,9 +150,16 @@ typedef struct _HPyContext_s HPyContext;
 #include "hpy/hpydef.h"
 #include "hpy/hpytype.h"
 #include "hpy/hpymodule.h"
+#include "hpy/hpyattr.h"
 #include "hpy/runtime/argparse.h"
 #include "hpy/runtime/buildvalue.h"
 #include "hpy/runtime/helpers.h"
+#include "hpy/runtime/structseq.h"
+#include "hpy/runtime/structarray.h"
+#include "hpy/runtime/listsort.h"
+#include "hpy/runtime/hpymap.h"
+#include "hpy/runtime/memo.h"
+#include "hpy/runtime/strpool.h"
 
 #ifdef HPY_UNIVERSAL_ABI
 #   include "hpy/universal/autogen_ctx.h"
@@ -164,6 +173,13 @@ typedef struct _HPyContext_s HPyContext;
 #   include "hpy/cpython/autogen_api_impl.h"
 #endif
 
+/* HPyField_Load and HPyGlobal_Load pass the address of the field to the
+   implementation, which needs it to synchronize with the stores on
+   free-threaded builds: see public_api.h */
+#define HPyField_Load(ctx, source_object, source_field) \
+    _HPyField_LoadAt((ctx), (source_object), &(source_field))
+#define HPyGlobal_Load(ctx, global) _HPyGlobal_LoadAt((ctx), &(global))
+
 #include "hpy/inline_helpers.h"
 
 #ifdef __cplusplus
@@ -32,6 +32,8 @@
 #define _HPyFunc_DECLARE_HPyFunc_REPRFUNC(SYM) static HPy SYM(HPyContext *ctx, HPy)
 #define _HPyFunc_DECLARE_HPyFunc_HASHFUNC(SYM) static HPy_hash_t SYM(HPyContext *ctx, HPy)
 #define _HPyFunc_DECLARE_HPyFunc_RICHCMPFUNC(SYM) static HPy SYM(HPyContext *ctx, HPy, HPy, HPy_RichCmpOp)
+#define _HPyFunc_DECLARE_HPyFunc_RICHCMPBOOLFUNC(SYM) static int SYM(HPyContext *ctx, HPy, HPy, HPy_RichCmpOp)
+#define _HPyFunc_DECLARE_HPyFunc_TYPEDBINARYFUNC(SYM) static HPy SYM(HPyContext *ctx, HPy, void *, HPy, void *)
 #define _HPyFunc_DECLARE_HPyFunc_GETITERFUNC(SYM) static HPy SYM(HPyContext *ctx, HPy)
 #define _HPyFunc_DECLARE_HPyFunc_ITERNEXTFUNC(SYM) static HPy SYM(HPyContext *ctx, HPy)
 #define _HPyFunc_DECLARE_HPyFunc_DESCRGETFUNC(SYM) static HPy SYM(HPyContext *ctx, HPy, HPy, HPy)
@@ -68,6 +70,8 @@ typedef int (*HPyFunc_setattrofunc)(HPyContext *ctx, HPy, HPy, HPy);
 typedef HPy (*HPyFunc_reprfunc)(HPyContext *ctx, HPy);
 typedef HPy_hash_t (*HPyFunc_hashfunc)(HPyContext *ctx, HPy);
 typedef HPy (*HPyFunc_richcmpfunc)(HPyContext *ctx, HPy, HPy, HPy_RichCmpOp);
+typedef int (*HPyFunc_richcmpboolfunc)(HPyContext *ctx, HPy, HPy, HPy_RichCmpOp);
+typedef HPy (*HPyFunc_typedbinaryfunc)(HPyContext *ctx, HPy, void *, HPy, void *);
 typedef HPy (*HPyFunc_getiterfunc)(HPyContext *ctx, HPy);
 typedef HPy (*HPyFunc_iternextfunc)(HPyContext *ctx, HPy);
 typedef HPy (*HPyFunc_descrgetfunc)(HPyContext *ctx, HPy, HPy, HPy);
@@ -380,6 +380,21 @@ HPyAPI_FUNC int HPy_SetItem(HPyContext *ctx, HPy obj, HPy key, HPy value)
     return PyObject_SetItem(_h2py(obj), _h2py(key), _h2py(value));
 }
 
+HPyAPI_FUNC HPy HPy_GetSlice(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return _py2h(PySequence_GetSlice(_h2py(obj), start, end));
+}
+
+HPyAPI_FUNC int HPy_SetSlice(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end, HPy value)
+{
+    return PySequence_SetSlice(_h2py(obj), start, end, _h2py(value));
+}
+
+HPyAPI_FUNC int HPy_DelSlice(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end)
+{
+    return PySequence_DelSlice(_h2py(obj), start, end);
+}
+
 HPyAPI_FUNC HPy HPy_Type(HPyContext *ctx, HPy obj)
 {
     return _py2h(PyObject_Type(_h2py(obj)));
@@ -410,11 +425,6 @@ HPyAPI_FUNC HPy HPy_RichCompare(HPyContext *ctx, HPy v, HPy w, int op)
     return _py2h(PyObject_RichCompare(_h2py(v), _h2py(w), op));
 }
 
-HPyAPI_FUNC int HPy_RichCompareBool(HPyContext *ctx, HPy v, HPy w, int op)
-{
-    return PyObject_RichCompareBool(_h2py(v), _h2py(w), op);
-}
-
 HPyAPI_FUNC HPy_hash_t HPy_Hash(HPyContext *ctx, HPy obj)
 {
     return PyObject_Hash(_h2py(obj));
@@ -455,6 +465,11 @@ HPyAPI_FUNC HPy HPyUnicode_FromString(HPyContext *ctx, const char *utf8)
     return _py2h(PyUnicode_FromString(utf8));
 }
 
+HPyAPI_FUNC HPy HPyUnicode_FromStringAndSize(HPyContext *ctx, const char *utf8, HPy_ssize_t size)
+{
+    return _py2h(PyUnicode_FromStringAndSize(utf8, size));
+}
+
 HPyAPI_FUNC int HPyUnicode_Check(HPyContext *ctx, HPy h)
 {
     return PyUnicode_Check(_h2py(h));
@@ -510,6 +525,26 @@ HPyAPI_FUNC HPy HPyDict_New(HPyContext *ctx)
     return _py2h(PyDict_New());
 }
 
+HPyAPI_FUNC int HPySet_Check(HPyContext *ctx, HPy h)
+{
+    return PySet_Check(_h2py(h));
+}
+
+HPyAPI_FUNC int HPyFrozenSet_Check(HPyContext *ctx, HPy h)
+{
+    return PyFrozenSet_Check(_h2py(h));
+}
+
+HPyAPI_FUNC int HPySet_Add(HPyContext *ctx, HPy h_set, HPy h_item)
+{
+    return PySet_Add(_h2py(h_set), _h2py(h_item));
+}
+
+HPyAPI_FUNC int HPySet_Contains(HPyContext *ctx, HPy h_set, HPy h_item)
+{
+    return PySet_Contains(_h2py(h_set), _h2py(h_item));
+}
+
 HPyAPI_FUNC int HPyTuple_Check(HPyContext *ctx, HPy h)
 {
     return PyTuple_Check(_h2py(h));
@@ -8,7 +8,11 @@ typedef HPy (*_HPyCFunction_NOARGS)(HPyContext*, HPy);
     SYM(PyObject *self, PyObject *noargs)                               \
     {                                                                   \
         _HPyCFunction_NOARGS func = (_HPyCFunction_NOARGS)IMPL; \
-        return _h2py(func(_HPyGetContext(), _py2h(self)));              \
+        void *scratch_mark = _HPyMem_ScratchEnter();                    \
+        HPy res = func(_HPyGetContext(), _py2h(self));                  \
+        _HPyMem_ScratchLeave(scratch_mark);                             \
+        _HPyDealloc_SafePoint();                                        \
+        return _h2py(res);                                              \
     }
 
 typedef HPy (*_HPyCFunction_O)(HPyContext*, HPy, HPy);
@@ -17,7 +21,11 @@ typedef HPy (*_HPyCFunction_O)(HPyContext*, HPy, HPy);
     SYM(PyObject *self, PyObject *arg)                                  \
     {                                                                   \
         _HPyCFunction_O func = (_HPyCFunction_O)IMPL; \
-        return _h2py(func(_HPyGetContext(), _py2h(self), _py2h(arg)));  \
+        void *scratch_mark = _HPyMem_ScratchEnter();                    \
+        HPy res = func(_HPyGetContext(), _py2h(self), _py2h(arg));      \
+        _HPyMem_ScratchLeave(scratch_mark);                             \
+        _HPyDealloc_SafePoint();                                        \
+        return _h2py(res);                                              \
     }
 
 typedef HPy (*_HPyCFunction_VARARGS)(HPyContext*, HPy, HPy *, HPy_ssize_t);
@@ -30,8 +38,11 @@ typedef HPy (*_HPyCFunction_VARARGS)(HPyContext*, HPy, HPy *, HPy_ssize_t);
         HPy *items = (HPy *)&PyTuple_GET_ITEM(args, 0);                 \
         Py_ssize_t nargs = PyTuple_GET_SIZE(args);                      \
         _HPyCFunction_VARARGS func = (_HPyCFunction_VARARGS)IMPL; \
-        return _h2py(func(_HPyGetContext(),                             \
-                                 _py2h(self), items, nargs));           \
+        void *scratch_mark = _HPyMem_ScratchEnter();                    \
+        HPy res = func(_HPyGetContext(), _py2h(self), items, nargs);    \
+        _HPyMem_ScratchLeave(scratch_mark);                             \
+        _HPyDealloc_SafePoint();                                        \
+        return _h2py(res);                                              \
     }
 
 typedef HPy (*_HPyCFunction_KEYWORDS)(HPyContext*, HPy, HPy *, HPy_ssize_t, HPy);
@@ -44,8 +55,12 @@ typedef HPy (*_HPyCFunction_KEYWORDS)(HPyContext*, HPy, HPy *, HPy_ssize_t, HPy)
         HPy *items = (HPy *)&PyTuple_GET_ITEM(args, 0);                 \
         Py_ssize_t nargs = PyTuple_GET_SIZE(args);                      \
         _HPyCFunction_KEYWORDS func = (_HPyCFunction_KEYWORDS)IMPL; \
-        return _h2py(func(_HPyGetContext(), _py2h(self),                \
-                                 items, nargs, _py2h(kw)));             \
+        void *scratch_mark = _HPyMem_ScratchEnter();                    \
+        HPy res = func(_HPyGetContext(), _py2h(self),                   \
+                       items, nargs, _py2h(kw));                        \
+        _HPyMem_ScratchLeave(scratch_mark);                             \
+        _HPyDealloc_SafePoint();                                        \
+        return _h2py(res);                                              \
     }
 
 typedef int (*_HPyCFunction_INITPROC)(HPyContext*, HPy, HPy *, HPy_ssize_t, HPy);
@@ -58,8 +73,12 @@ typedef int (*_HPyCFunction_INITPROC)(HPyContext*, HPy, HPy *, HPy_ssize_t, HPy)
         HPy *items = (HPy *)&PyTuple_GET_ITEM(args, 0);                 \
         Py_ssize_t nargs = PyTuple_GET_SIZE(args);                      \
         _HPyCFunction_INITPROC func = (_HPyCFunction_INITPROC)IMPL; \
-        return func(_HPyGetContext(), _py2h(self),                      \
-                    items, nargs, _py2h(kw));                           \
+        void *scratch_mark = _HPyMem_ScratchEnter();                    \
+        int res = func(_HPyGetContext(), _py2h(self),                   \
+                       items, nargs, _py2h(kw));                        \
+        _HPyMem_ScratchLeave(scratch_mark);                             \
+        _HPyDealloc_SafePoint();                                        \
+        return res;                                                     \
     }
 
 /* special case: the HPy_tp_destroy slot doesn't map to any CPython slot.
@@ -76,7 +95,41 @@ typedef HPy (*_HPyCFunction_RICHCMPFUNC)(HPyContext *, HPy, HPy, int);
     SYM(PyObject *self, PyObject *obj, int op)                             \
     {                                                                      \
         _HPyCFunction_RICHCMPFUNC func = (_HPyCFunction_RICHCMPFUNC)IMPL; \
-        return _h2py(func(_HPyGetContext(), _py2h(self), _py2h(obj), op)); \
+        void *scratch_mark = _HPyMem_ScratchEnter();                       \
+        HPy res = func(_HPyGetContext(), _py2h(self), _py2h(obj), op);     \
+        _HPyMem_ScratchLeave(scratch_mark);                                \
+        _HPyDealloc_SafePoint();                                           \
+        return _h2py(res);                                                 \
+    }
+
+typedef int (*_HPyCFunction_RICHCMPBOOLFUNC)(HPyContext *, HPy, HPy, int);
+#define _HPyFunc_TRAMPOLINE_HPyFunc_RICHCMPBOOLFUNC(SYM, IMPL)             \
+    static cpy_PyObject *                                                  \
+    SYM(PyObject *self, PyObject *obj, int op)                             \
+    {                                                                      \
+        _HPyCFunction_RICHCMPBOOLFUNC func = (_HPyCFunction_RICHCMPBOOLFUNC)IMPL; \
+        void *scratch_mark = _HPyMem_ScratchEnter();                       \
+        int res = func(_HPyGetContext(), _py2h(self), _py2h(obj), op);     \
+        _HPyMem_ScratchLeave(scratch_mark);                                \
+        _HPyDealloc_SafePoint();                                           \
+        return richcmpbool_result_to_py(res);                              \
+    }
+
+#define _HPyFunc_TYPED_BINOP_TRAMPOLINE(SYM, TYPED_IMPL, IMPL)             \
+    static PyObject *                                                      \
+    SYM(PyObject *arg0, PyObject *arg1)                                    \
+    {                                                                      \
+        void *data0, *data1;                                               \
+        void *scratch_mark = _HPyMem_ScratchEnter();                       \
+        HPy res;                                                           \
+        if (_HPy_GetStructsIfSameType(arg0, arg1, &data0, &data1))         \
+            res = TYPED_IMPL(_HPyGetContext(), _py2h(arg0), data0,         \
+                             _py2h(arg1), data1);                          \
+        else                                                               \
+            res = IMPL(_HPyGetContext(), _py2h(arg0), _py2h(arg1));        \
+        _HPyMem_ScratchLeave(scratch_mark);                                \
+        _HPyDealloc_SafePoint();                                           \
+        return _h2py(res);                                                 \
     }
 
 /* With the cpython ABI, Py_buffer and HPy_buffer are ABI-compatible.
@@ -87,7 +140,11 @@ typedef int (*_HPyCFunction_GETBUFFERPROC)(HPyContext *, HPy, HPy_buffer *, int)
     static int SYM(PyObject *arg0, Py_buffer *arg1, int arg2) \
     { \
         _HPyCFunction_GETBUFFERPROC func = (_HPyCFunction_GETBUFFERPROC)IMPL; \
-        return (func(_HPyGetContext(), _py2h(arg0), (HPy_buffer*)arg1, arg2)); \
+        void *scratch_mark = _HPyMem_ScratchEnter(); \
+        int res = func(_HPyGetContext(), _py2h(arg0), (HPy_buffer*)arg1, arg2); \
+        _HPyMem_ScratchLeave(scratch_mark); \
+        _HPyDealloc_SafePoint();            \
+        return res; \
     }
 
 typedef int (*_HPyCFunction_RELEASEBUFFERPROC)(HPyContext *, HPy, HPy_buffer *);
@@ -95,7 +152,10 @@ typedef int (*_HPyCFunction_RELEASEBUFFERPROC)(HPyContext *, HPy, HPy_buffer *);
     static void SYM(PyObject *arg0, Py_buffer *arg1) \
     { \
         _HPyCFunction_RELEASEBUFFERPROC func = (_HPyCFunction_RELEASEBUFFERPROC)IMPL; \
+        void *scratch_mark = _HPyMem_ScratchEnter(); \
         func(_HPyGetContext(), _py2h(arg0), (HPy_buffer*)arg1); \
+        _HPyMem_ScratchLeave(scratch_mark); \
+        _HPyDealloc_SafePoint();            \
         return; \
     }
 
@@ -4,6 +4,8 @@
 // XXX: turn these into static inline functions
 #define _h2py(h) ((PyObject*)h._i)
 #define _py2h(o) _hconv((intptr_t)o)
+// convert an owned handle into a new reference; see hpy.universal's handles.h
+#define _h2py_steal(h) _h2py(h)
 
 static inline HPyField _py2hf(PyObject *obj)
 {
@@ -17,6 +19,18 @@ static inline PyObject * _hf2py(HPyField hf)
     return _h2py(h);
 }
 
+/* On free-threaded builds of CPython (PEP 703) the lazy initialization of
+   _global_ctx can run concurrently in multiple threads, so it needs atomic
+   operations. With the GIL, plain loads and stores are enough. */
+#ifdef Py_GIL_DISABLED
+#  define _HPy_load_ptr_acquire(p) _Py_atomic_load_ptr_acquire(p)
+#  define _HPy_store_ptr_release(p, v) \
+       _Py_atomic_store_ptr_release((p), (void *)(v))
+#else
+#  define _HPy_load_ptr_acquire(p) ((const void *)*(p))
+#  define _HPy_store_ptr_release(p, v) (*(p) = (v))
+#endif
+
 // this should maybe autogenerated from public_api.h
 struct _HPyContext_s {
     const char *name;
@@ -108,8 +122,7 @@ static struct _HPyContext_s _global_ctx;
 
 HPyAPI_FUNC HPyContext * _HPyGetContext(void) {
     HPyContext *ctx = &_global_ctx;
-    if (!ctx->name) {
-        ctx->name = "HPy CPython ABI",
+    if (!_HPy_load_ptr_acquire(&ctx->name)) {
         /* Constants */
         ctx->h_None = _py2h(Py_None);
         ctx->h_True = _py2h(Py_True);
@@ -191,6 +204,8 @@ HPyAPI_FUNC HPyContext * _HPyGetContext(void) {
         ctx->h_UnicodeType = _py2h((PyObject *)&PyUnicode_Type);
         ctx->h_TupleType = _py2h((PyObject *)&PyTuple_Type);
         ctx->h_ListType = _py2h((PyObject *)&PyList_Type);
+        /* 'name' is set last: other threads which see it can use ctx */
+        _HPy_store_ptr_release(&ctx->name, "HPy CPython ABI");
     }
     return ctx;
 }
@@ -211,9 +226,18 @@ HPyAPI_FUNC void HPyField_Store(HPyContext *ctx, HPy target_obj,
                                 HPyField *target_field, HPy h)
 {
     PyObject *obj = _h2py(h);
-    Py_XDECREF(_hf2py(*target_field));
     Py_XINCREF(obj);
+#ifdef Py_GIL_DISABLED
+    PyMutex *lock = _HPyField_GetLock(target_field);
+    PyMutex_Lock(lock);
+    HPyField old = *target_field;
+    *target_field = _py2hf(obj);
+    PyMutex_Unlock(lock);
+#else
+    HPyField old = *target_field;
     *target_field = _py2hf(obj);
+#endif
+    Py_XDECREF(_hf2py(old));
 }
 
 HPyAPI_FUNC HPy HPyField_Load(HPyContext *ctx, HPy source_obj, HPyField source_field)
@@ -223,6 +247,61 @@ HPyAPI_FUNC HPy HPyField_Load(HPyContext *ctx, HPy source_obj, HPyField source_f
     return _py2h(obj);
 }
 
+HPyAPI_FUNC HPy _HPyField_LoadAt(HPyContext *ctx, HPy source_obj,
+                                 HPyField *source_field)
+{
+#ifdef Py_GIL_DISABLED
+    PyMutex *lock = _HPyField_GetLock(source_field);
+    PyMutex_Lock(lock);
+    PyObject *obj = _hf2py(*source_field);
+    Py_INCREF(obj);
+    PyMutex_Unlock(lock);
+#else
+    PyObject *obj = _hf2py(*source_field);
+    Py_INCREF(obj);
+#endif
+    return _py2h(obj);
+}
+
+HPyAPI_FUNC void HPyGlobal_Store(HPyContext *ctx, HPyGlobal *global, HPy h)
+{
+    PyObject *obj = _h2py(h);
+    Py_XINCREF(obj);
+#ifdef Py_GIL_DISABLED
+    PyMutex *lock = _HPyField_GetLock(global);
+    PyMutex_Lock(lock);
+    HPyGlobal old = *global;
+    global->_i = (intptr_t)obj;
+    PyMutex_Unlock(lock);
+#else
+    HPyGlobal old = *global;
+    global->_i = (intptr_t)obj;
+#endif
+    Py_XDECREF((PyObject *)old._i);
+}
+
+HPyAPI_FUNC HPy HPyGlobal_Load(HPyContext *ctx, HPyGlobal global)
+{
+    PyObject *obj = (PyObject *)global._i;
+    Py_XINCREF(obj);
+    return _py2h(obj);
+}
+
+HPyAPI_FUNC HPy _HPyGlobal_LoadAt(HPyContext *ctx, HPyGlobal *global)
+{
+#ifdef Py_GIL_DISABLED
+    PyMutex *lock = _HPyField_GetLock(global);
+    PyMutex_Lock(lock);
+    PyObject *obj = (PyObject *)global->_i;
+    Py_XINCREF(obj);
+    PyMutex_Unlock(lock);
+#else
+    PyObject *obj = (PyObject *)global->_i;
+    Py_XINCREF(obj);
+#endif
+    return _py2h(obj);
+}
+
 HPyAPI_FUNC HPy HPy_FromPyObject(HPyContext *ctx, PyObject *obj)
 {
     Py_XINCREF(obj);
@@ -261,6 +340,76 @@ HPyAPI_FUNC HPy HPyType_GenericNew(HPyContext *ctx, HPy type, HPy *args, HPy_ssi
     return ctx_Type_GenericNew(ctx, type, args, nargs, kw);
 }
 
+HPyAPI_FUNC HPy HPyLong_FromString(HPyContext *ctx, const char *str,
+                                   HPy_ssize_t size, int base)
+{
+    return ctx_Long_FromString(ctx, str, size, base);
+}
+
+HPyAPI_FUNC HPy HPyFloat_FromString(HPyContext *ctx, const char *str,
+                                    HPy_ssize_t size)
+{
+    return ctx_Float_FromString(ctx, str, size);
+}
+
+HPyAPI_FUNC HPy_ssize_t HPyLong_Format(HPyContext *ctx, HPy h, char *buf,
+                                       HPy_ssize_t size)
+{
+    return ctx_Long_Format(ctx, h, buf, size);
+}
+
+HPyAPI_FUNC HPy_ssize_t HPyFloat_Format(HPyContext *ctx, HPy h, char *buf,
+                                        HPy_ssize_t size)
+{
+    return ctx_Float_Format(ctx, h, buf, size);
+}
+
+HPyAPI_FUNC HPy HPyLong_FromByteArray(HPyContext *ctx,
+                                      const unsigned char *bytes, size_t n,
+                                      int little_endian, int is_signed)
+{
+    return ctx_Long_FromByteArray(ctx, bytes, n, little_endian, is_signed);
+}
+
+HPyAPI_FUNC int HPyLong_AsByteArray(HPyContext *ctx, HPy h,
+                                    unsigned char *bytes, size_t n,
+                                    int little_endian, int is_signed)
+{
+    return ctx_Long_AsByteArray(ctx, h, bytes, n, little_endian, is_signed);
+}
+
+HPyAPI_FUNC HPy HPyLong_FromLimbs(HPyContext *ctx, const uint64_t *limbs,
+                                  size_t n, int is_signed)
+{
+    return ctx_Long_FromLimbs(ctx, limbs, n, is_signed);
+}
+
+HPyAPI_FUNC int HPyLong_AsLimbs(HPyContext *ctx, HPy h, uint64_t *limbs,
+                                size_t n, int is_signed)
+{
+    return ctx_Long_AsLimbs(ctx, h, limbs, n, is_signed);
+}
+
+HPyAPI_FUNC HPy_ssize_t HPyLong_NumBits(HPyContext *ctx, HPy h)
+{
+    return ctx_Long_NumBits(ctx, h);
+}
+
+HPyAPI_FUNC void *HPyType_GetData(HPyContext *ctx, HPy type)
+{
+    return ctx_Type_GetData(ctx, type);
+}
+
+HPyAPI_FUNC HPy_ssize_t HPy_SetDeallocBudget(HPyContext *ctx, HPy_ssize_t budget)
+{
+    return ctx_SetDeallocBudget(ctx, budget);
+}
+
+HPyAPI_FUNC int HPy_DrainDeallocs(HPyContext *ctx)
+{
+    return ctx_DrainDeallocs(ctx);
+}
+
 HPyAPI_FUNC void* HPy_AsStruct(HPyContext *ctx, HPy h)
 {
     return ctx_AsStruct(ctx, h);
@@ -291,6 +440,32 @@ HPyAPI_FUNC int HPy_Is(HPyContext *ctx, HPy h_obj, HPy h_other)
     return ctx_Is(ctx, h_obj, h_other);
 }
 
+HPyAPI_FUNC int HPy_RichCompareBool(HPyContext *ctx, HPy v, HPy w, int op)
+{
+    return ctx_RichCompareBool(ctx, v, w, op);
+}
+
+HPyAPI_FUNC int HPy_SetAttrs(HPyContext *ctx, HPy h_obj, HPyAttrDef *defs)
+{
+    return ctx_SetAttrs(ctx, h_obj, defs);
+}
+
+HPyAPI_FUNC HPy HPy_GetAttrCached(HPyContext *ctx, HPy h_obj, HPyAttrCache *cache)
+{
+    return ctx_GetAttrCached(ctx, h_obj, cache);
+}
+
+HPyAPI_FUNC HPy HPy_CallMethodCached(HPyContext *ctx, HPy h_obj, HPyAttrCache *cache,
+                                     HPy *args, HPy_ssize_t nargs)
+{
+    return ctx_CallMethodCached(ctx, h_obj, cache, args, nargs);
+}
+
+HPyAPI_FUNC int HPyList_AppendSteal(HPyContext *ctx, HPy h_list, HPy h_item)
+{
+    return ctx_List_AppendSteal(ctx, h_list, h_item);
+}
+
 HPyAPI_FUNC HPyListBuilder HPyListBuilder_New(HPyContext *ctx, HPy_ssize_t initial_size)
 {
     return ctx_ListBuilder_New(ctx, initial_size);
@@ -302,6 +477,12 @@ HPyAPI_FUNC void HPyListBuilder_Set(HPyContext *ctx, HPyListBuilder builder,
     ctx_ListBuilder_Set(ctx, builder, index, h_item);
 }
 
+HPyAPI_FUNC void HPyListBuilder_SetSteal(HPyContext *ctx, HPyListBuilder builder,
+                   HPy_ssize_t index, HPy h_item)
+{
+    ctx_ListBuilder_SetSteal(ctx, builder, index, h_item);
+}
+
 HPyAPI_FUNC HPy HPyListBuilder_Build(HPyContext *ctx, HPyListBuilder builder)
 {
     return ctx_ListBuilder_Build(ctx, builder);
@@ -323,6 +504,12 @@ HPyAPI_FUNC void HPyTupleBuilder_Set(HPyContext *ctx, HPyTupleBuilder builder,
     ctx_TupleBuilder_Set(ctx, builder, index, h_item);
 }
 
+HPyAPI_FUNC void HPyTupleBuilder_SetSteal(HPyContext *ctx, HPyTupleBuilder builder,
+                    HPy_ssize_t index, HPy h_item)
+{
+    ctx_TupleBuilder_SetSteal(ctx, builder, index, h_item);
+}
+
 HPyAPI_FUNC HPy HPyTupleBuilder_Build(HPyContext *ctx, HPyTupleBuilder builder)
 {
     return ctx_TupleBuilder_Build(ctx, builder);
@@ -333,6 +520,42 @@ HPyAPI_FUNC void HPyTupleBuilder_Cancel(HPyContext *ctx, HPyTupleBuilder builder
     ctx_TupleBuilder_Cancel(ctx, builder);
 }
 
+HPyAPI_FUNC HPy HPySet_New(HPyContext *ctx, HPy_ssize_t size_hint)
+{
+    return ctx_Set_New(ctx, size_hint);
+}
+
+HPyAPI_FUNC int HPySet_AddArray(HPyContext *ctx, HPy h_set, HPy items[],
+                                HPy_ssize_t n)
+{
+    return ctx_Set_AddArray(ctx, h_set, items, n);
+}
+
+HPyAPI_FUNC HPyFrozenSetBuilder HPyFrozenSetBuilder_New(HPyContext *ctx,
+                                                        HPy_ssize_t size_hint)
+{
+    return ctx_FrozenSetBuilder_New(ctx, size_hint);
+}
+
+HPyAPI_FUNC int HPyFrozenSetBuilder_Add(HPyContext *ctx,
+                                        HPyFrozenSetBuilder builder,
+                                        HPy h_item)
+{
+    return ctx_FrozenSetBuilder_Add(ctx, builder, h_item);
+}
+
+HPyAPI_FUNC HPy HPyFrozenSetBuilder_Build(HPyContext *ctx,
+                                          HPyFrozenSetBuilder builder)
+{
+    return ctx_FrozenSetBuilder_Build(ctx, builder);
+}
+
+HPyAPI_FUNC void HPyFrozenSetBuilder_Cancel(HPyContext *ctx,
+                                            HPyFrozenSetBuilder builder)
+{
+    ctx_FrozenSetBuilder_Cancel(ctx, builder);
+}
+
 HPyAPI_FUNC HPy HPyTuple_FromArray(HPyContext *ctx, HPy items[], HPy_ssize_t n)
 {
     return ctx_Tuple_FromArray(ctx, items, n);
@@ -358,6 +581,31 @@ HPyAPI_FUNC void HPyTracker_Close(HPyContext *ctx, HPyTracker ht)
     ctx_Tracker_Close(ctx, ht);
 }
 
+HPyAPI_FUNC void *HPyMem_Malloc(HPyContext *ctx, size_t size)
+{
+    return ctx_Mem_Malloc(ctx, size);
+}
+
+HPyAPI_FUNC void *HPyMem_Calloc(HPyContext *ctx, size_t nelem, size_t elsize)
+{
+    return ctx_Mem_Calloc(ctx, nelem, elsize);
+}
+
+HPyAPI_FUNC void *HPyMem_Realloc(HPyContext *ctx, void *ptr, size_t size)
+{
+    return ctx_Mem_Realloc(ctx, ptr, size);
+}
+
+HPyAPI_FUNC void HPyMem_Free(HPyContext *ctx, void *ptr)
+{
+    ctx_Mem_Free(ctx, ptr);
+}
+
+HPyAPI_FUNC void *HPyMem_ScratchAlloc(HPyContext *ctx, size_t size)
+{
+    return ctx_Mem_ScratchAlloc(ctx, size);
+}
+
 HPyAPI_FUNC HPy HPy_GetItem_i(HPyContext *ctx, HPy obj, HPy_ssize_t idx) {
     return ctx_GetItem_i(ctx, obj, idx);
 }
@@ -374,6 +622,26 @@ HPyAPI_FUNC int HPy_SetItem_s(HPyContext *ctx, HPy obj, const char *key, HPy val
     return ctx_SetItem_s(ctx, obj, key, value);
 }
 
+HPyAPI_FUNC HPy HPy_GetSliceView(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end) {
+    return ctx_GetSliceView(ctx, obj, start, end);
+}
+
+HPyAPI_FUNC HPy HPyList_GetSlice(HPyContext *ctx, HPy h_list, HPy_ssize_t start, HPy_ssize_t end) {
+    return ctx_List_GetSlice(ctx, h_list, start, end);
+}
+
+HPyAPI_FUNC HPy HPyTuple_GetSlice(HPyContext *ctx, HPy h_tuple, HPy_ssize_t start, HPy_ssize_t end) {
+    return ctx_Tuple_GetSlice(ctx, h_tuple, start, end);
+}
+
+HPyAPI_FUNC HPy HPyBytes_GetSlice(HPyContext *ctx, HPy h, HPy_ssize_t start, HPy_ssize_t end) {
+    return ctx_Bytes_GetSlice(ctx, h, start, end);
+}
+
+HPyAPI_FUNC HPy HPyUnicode_Substring(HPyContext *ctx, HPy h, HPy_ssize_t start, HPy_ssize_t end) {
+    return ctx_Unicode_Substring(ctx, h, start, end);
+}
+
 HPyAPI_FUNC HPy HPyBytes_FromStringAndSize(HPyContext *ctx, const char *v, HPy_ssize_t len) {
     return ctx_Bytes_FromStringAndSize(ctx, v, len);
 }
@@ -0,0 +1,98 @@
+#ifndef HPY_UNIVERSAL_HPYATTR_H
+#define HPY_UNIVERSAL_HPYATTR_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "hpy/hpytype.h"
+
+/* A table of attributes which can be set in bulk by HPy_SetAttrs. It is
+   typically used at module init time, to populate a module with constants
+   and types:
+
+       static HPyAttrDef module_attrs[] = {
+           HPyAttr_LONG("MAX_SIZE", 4096),
+           HPyAttr_DOUBLE("PI", 3.14159),
+           HPyAttr_STRING("VERSION", "1.0"),
+           HPyAttr_TYPE("Point", &Point_spec, NULL),
+           {0}
+       };
+
+       if (HPy_SetAttrs(ctx, m, module_attrs) < 0)
+           ...
+
+   The table is terminated by an entry whose kind is 0. Attribute names are
+   interned, and so are the values of HPyAttr_Kind_String. Like for
+   HPyAttrCache, the interned names are cached in the table and never
+   released, so that setting the same table again does not need to intern
+   them: the table should be static.
+*/
+
+typedef enum {
+    HPyAttr_Kind_Object = 1,    // an existing handle, which is NOT closed
+    HPyAttr_Kind_Long = 2,
+    HPyAttr_Kind_Double = 3,
+    HPyAttr_Kind_String = 4,    // a UTF-8 encoded C string
+    HPyAttr_Kind_Type = 5,      // created with HPyType_FromSpec
+} HPyAttrDef_Kind;
+
+typedef struct {
+    HPyAttrDef_Kind kind;
+    const char *name;
+    union {
+        HPy object;
+        long l;
+        double d;
+        const char *s;
+        struct {
+            HPyType_Spec *spec;
+            HPyType_SpecParam *params;
+        } type;
+    };
+    void *_name_obj;    // private: the interned name
+} HPyAttrDef;
+
+#define HPyAttr_OBJECT(NAME, H) \
+    { .kind = HPyAttr_Kind_Object, .name = (NAME), .object = (H) }
+
+#define HPyAttr_LONG(NAME, VALUE) \
+    { .kind = HPyAttr_Kind_Long, .name = (NAME), .l = (VALUE) }
+
+#define HPyAttr_DOUBLE(NAME, VALUE) \
+    { .kind = HPyAttr_Kind_Double, .name = (NAME), .d = (VALUE) }
+
+#define HPyAttr_STRING(NAME, VALUE) \
+    { .kind = HPyAttr_Kind_String, .name = (NAME), .s = (VALUE) }
+
+#define HPyAttr_TYPE(NAME, SPEC, PARAMS) \
+    { .kind = HPyAttr_Kind_Type, .name = (NAME), .type = { (SPEC), (PARAMS) } }
+
+/* An inline cache for looking up the attribute NAME, to be used with
+   HPy_GetAttrCached and HPy_CallMethodCached. It is meant to be declared
+   statically at the call site, so that every call site remembers the
+   result of the lookup on the type of the last object it has seen:
+
+       static HPyAttrCache visit_cache = HPyAttrCache_INIT("visit");
+       ...
+       HPy res = HPy_CallMethodCached(ctx, visitor, &visit_cache, args, 1);
+
+   All the fields except 'name' are private to the implementation. On
+   CPython, the cache is keyed by the version tag of the type, so it is
+   invalidated automatically whenever the type or one of its bases is
+   modified.
+*/
+typedef struct {
+    const char *name;
+    void *_name_obj;
+    void *_type;
+    void *_descr;
+    unsigned int _version;
+    int _kind;
+} HPyAttrCache;
+
+#define HPyAttrCache_INIT(NAME) { (NAME), NULL, NULL, NULL, 0, 0 }
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* HPY_UNIVERSAL_HPYATTR_H */
@@ -132,6 +132,37 @@ typedef struct {
     };
 
 
+/* ~~~ HPyDef_SLOT_TYPED_BINOP ~~~
+
+   Like HPyDef_SLOT, but only for the binary number slots such as HPy_nb_add.
+   If both operands are instances of exactly the same HPy type, TYPED_IMPL is
+   called and directly receives the structs of both operands (as returned by
+   HPy_AsStruct or HPy_AsStructLegacy), so that it does not need to do
+   HPy_TypeCheck and *_AsStruct on its own:
+
+       static HPy TYPED_IMPL(HPyContext *ctx, HPy a, void *a_data,
+                             HPy b, void *b_data);
+
+   In all the other cases, the generic IMPL is called as a normal
+   HPyFunc_BINARYFUNC.
+*/
+#define HPyDef_SLOT_TYPED_BINOP(SYM, TYPED_IMPL, IMPL, SLOT)                 \
+    enum { SYM##_slot = SLOT };                                         \
+    typedef char SYM##_slot_must_be_a_binaryfunc[                       \
+        HPySlot_SIG(SLOT) == HPyFunc_BINARYFUNC ? 1 : -1];              \
+    HPyFunc_DECLARE(IMPL, HPyFunc_BINARYFUNC);                          \
+    HPyFunc_DECLARE(TYPED_IMPL, HPyFunc_TYPEDBINARYFUNC);               \
+    _HPyFunc_TYPED_BINOP_TRAMPOLINE(SYM##_trampoline, TYPED_IMPL, IMPL); \
+    HPyDef SYM = {                                                      \
+        .kind = HPyDef_Kind_Slot,                                       \
+        .slot = {                                                       \
+            .slot = SLOT,                                               \
+            .impl = (HPyCFunction)IMPL,                                 \
+            .cpy_trampoline = (cpy_PyCFunction)SYM##_trampoline         \
+        }                                                               \
+    };
+
+
 #define HPyDef_METH(SYM, NAME, IMPL, SIG, ...)                          \
     HPyFunc_DECLARE(IMPL, SIG);                                         \
     HPyFunc_TRAMPOLINE(SYM##_trampoline, IMPL, SIG);             \
@@ -39,6 +39,8 @@ typedef enum {
     HPyFunc_OBJOBJPROC,
     HPyFunc_TRAVERSEPROC,
     HPyFunc_DESTRUCTOR,
+    HPyFunc_RICHCMPBOOLFUNC,
+    HPyFunc_TYPEDBINARYFUNC,
 
 } HPyFunc_Signature;
 
@@ -88,6 +90,18 @@ typedef struct {
     void *internal;
 } HPy_buffer;
 
+/* The flags passed to HPy_bf_getbuffer: they have the same values as the
+   PyBUF_* flags of CPython. */
+#define HPyBUF_SIMPLE 0
+#define HPyBUF_WRITABLE 0x0001
+#define HPyBUF_FORMAT 0x0004
+#define HPyBUF_ND 0x0008
+#define HPyBUF_STRIDES (0x0010 | HPyBUF_ND)
+#define HPyBUF_C_CONTIGUOUS (0x0020 | HPyBUF_STRIDES)
+#define HPyBUF_F_CONTIGUOUS (0x0040 | HPyBUF_STRIDES)
+#define HPyBUF_ANY_CONTIGUOUS (0x0080 | HPyBUF_STRIDES)
+#define HPyBUF_INDIRECT (0x0100 | HPyBUF_STRIDES)
+
 typedef int (*HPyFunc_visitproc)(HPyField *, void *);
 
 /* COPIED AND ADAPTED FROM CPython.
@@ -19,6 +19,12 @@ typedef struct {
     HPy_ssize_t size;
     cpy_PyMethodDef *legacy_methods;
     HPyDef **defines;   /* points to an array of 'HPyDef *' */
+    /* Set to 1 if the module can run without the GIL. On free-threaded
+       builds of CPython, importing a module which does not set it
+       re-enables the GIL (like Py_mod_gil). Ignored elsewhere.
+       NOTE: adding this field changed the layout of the struct, so
+       universal modules compiled before it must be recompiled. */
+    int gil_not_used;
 } HPyModuleDef;
 
 
@@ -44,7 +50,11 @@ typedef struct {
     PyMODINIT_FUNC                                             \
     PyInit_##modname(void)                                     \
     {                                                          \
-        return _h2py(init_##modname##_impl(_HPyGetContext())); \
+        void *scratch_mark = _HPyMem_ScratchEnter();           \
+        HPy h_mod = init_##modname##_impl(_HPyGetContext());   \
+        _HPyMem_ScratchLeave(scratch_mark);                    \
+        _HPyDealloc_SafePoint();                               \
+        return _h2py(h_mod);                                   \
     }
 
 #endif // HPY_UNIVERSAL_ABI
@@ -17,6 +17,7 @@ typedef struct {
     void *legacy_slots; // PyType_Slot *
     HPyDef **defines;   /* points to an array of 'HPyDef *' */
     const char* doc;    /* UTF-8 doc string or NULL */
+    void *data;         /* opaque pointer returned by HPyType_GetData */
 } HPyType_Spec;
 
 typedef enum {
@@ -24,6 +24,22 @@
 
 #define HPyTuple_Pack(ctx, n, ...) (HPyTuple_FromArray(ctx, (HPy[]){ __VA_ARGS__ }, n))
 
+/* ~~~ HPy_RETURN_NONE & co. ~~~
+
+   the equivalent of Py_RETURN_NONE, Py_RETURN_TRUE and Py_RETURN_FALSE.
+   The constants of the ctx are immortal in the universal ABI, so the
+   HPy_Dup is just a check of ctx->immortal_handle_mask and the function
+   does not need to call into the ctx to return them.
+*/
+
+#define HPy_RETURN_NONE(ctx) return HPy_Dup(ctx, (ctx)->h_None)
+#define HPy_RETURN_TRUE(ctx) return HPy_Dup(ctx, (ctx)->h_True)
+#define HPy_RETURN_FALSE(ctx) return HPy_Dup(ctx, (ctx)->h_False)
+#define HPy_RETURN_BOOL(ctx, x)                                         \
+    return HPy_Dup(ctx, (x) ? (ctx)->h_True : (ctx)->h_False)
+#define HPy_RETURN_NOTIMPLEMENTED(ctx)                                  \
+    return HPy_Dup(ctx, (ctx)->h_NotImplemented)
+
 /* Rich comparison opcodes */
 typedef enum {
     HPy_LT = 0,
@@ -34,6 +50,11 @@ typedef enum {
     HPy_GE = 5,
 } HPy_RichCmpOp;
 
+/* Special return value for HPy_tp_richcompare_bool, which means that the
+   comparison is not implemented for the given operands: it is the equivalent
+   of returning NotImplemented from HPy_tp_richcompare */
+#define HPy_RICHCMP_NOTIMPLEMENTED (-2)
+
 // this needs to be a macro because val1 and val2 can be of arbitrary types
 #define HPy_RETURN_RICHCOMPARE(ctx, val1, val2, op)                     \
     do {                                                                \
@@ -53,6 +74,21 @@ typedef enum {
         return HPy_Dup(ctx, ctx->h_False);                              \
     } while (0)
 
+// same as above, but to be used inside HPy_tp_richcompare_bool
+#define HPy_RETURN_RICHCOMPARE_BOOL(ctx, val1, val2, op)                \
+    do {                                                                \
+        switch (op) {                                                   \
+        case HPy_EQ: return ((val1) == (val2));                         \
+        case HPy_NE: return ((val1) != (val2));                         \
+        case HPy_LT: return ((val1) <  (val2));                         \
+        case HPy_GT: return ((val1) >  (val2));                         \
+        case HPy_LE: return ((val1) <= (val2));                         \
+        case HPy_GE: return ((val1) >= (val2));                         \
+        default:                                                        \
+            HPy_FatalError(ctx, "Invalid value for HPy_RichCmpOp");     \
+        }                                                               \
+    } while (0)
+
 
 #if !defined(SIZEOF_PID_T) || SIZEOF_PID_T == SIZEOF_INT
     #define _HPy_PARSE_PID "i"
@@ -13,6 +13,10 @@ HPyAPI_HELPER int
 HPyArg_ParseKeywords(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nargs, HPy kw,
                      const char *fmt, const char *keywords[], ...);
 
+HPyAPI_HELPER int
+HPyArg_ParseKeywordsArray(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nargs,
+                          HPy kwnames, const char *fmt, const char *keywords[], ...);
+
 
 #ifdef __cplusplus
 }
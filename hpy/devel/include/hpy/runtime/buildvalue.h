@@ -6,4 +6,18 @@
 HPyAPI_HELPER HPy
 HPy_BuildValue(HPyContext *ctx, const char *fmt, ...);
 
+HPyAPI_HELPER HPy
+HPy_BuildValueV(HPyContext *ctx, const char *fmt, va_list values);
+
+HPyAPI_HELPER HPy_ssize_t
+HPyTupleBuilder_BuildValue(HPyContext *ctx, HPyTupleBuilder builder,
+                           HPy_ssize_t offset, const char *fmt, ...);
+
+HPyAPI_HELPER HPy_ssize_t
+HPyListBuilder_BuildValue(HPyContext *ctx, HPyListBuilder builder,
+                          HPy_ssize_t offset, const char *fmt, ...);
+
+HPyAPI_HELPER HPy_ssize_t
+HPyList_AppendBuildValue(HPyContext *ctx, HPy h_list, const char *fmt, ...);
+
 #endif /* HPY_COMMON_RUNTIME_BUILDVALUE_H */
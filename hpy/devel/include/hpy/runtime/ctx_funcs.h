@@ -6,6 +6,12 @@
 
 #include "hpy.h"
 
+// ctx_attrcache.c
+_HPy_HIDDEN HPy ctx_GetAttrCached(HPyContext *ctx, HPy h_obj, HPyAttrCache *cache);
+_HPy_HIDDEN HPy ctx_CallMethodCached(HPyContext *ctx, HPy h_obj,
+                                     HPyAttrCache *cache, HPy *args,
+                                     HPy_ssize_t nargs);
+
 // ctx_bytes.c
 _HPy_HIDDEN HPy ctx_Bytes_FromStringAndSize(HPyContext *ctx, const char *v,
                                             HPy_ssize_t len);
@@ -16,25 +22,109 @@ _HPy_HIDDEN HPy ctx_CallTupleDict(HPyContext *ctx, HPy callable, HPy args, HPy k
 // ctx_err.c
 _HPy_HIDDEN int ctx_Err_Occurred(HPyContext *ctx);
 
+// ctx_list.c
+_HPy_HIDDEN int ctx_List_AppendSteal(HPyContext *ctx, HPy h_list, HPy h_item);
+
 // ctx_listbuilder.c
 _HPy_HIDDEN HPyListBuilder ctx_ListBuilder_New(HPyContext *ctx,
                                                HPy_ssize_t initial_size);
 _HPy_HIDDEN void ctx_ListBuilder_Set(HPyContext *ctx, HPyListBuilder builder,
                                      HPy_ssize_t index, HPy h_item);
+_HPy_HIDDEN void ctx_ListBuilder_SetSteal(HPyContext *ctx, HPyListBuilder builder,
+                                          HPy_ssize_t index, HPy h_item);
 _HPy_HIDDEN HPy ctx_ListBuilder_Build(HPyContext *ctx, HPyListBuilder builder);
 _HPy_HIDDEN void ctx_ListBuilder_Cancel(HPyContext *ctx, HPyListBuilder builder);
 
+// ctx_mem.c
+_HPy_HIDDEN void *ctx_Mem_Malloc(HPyContext *ctx, size_t size);
+_HPy_HIDDEN void *ctx_Mem_Calloc(HPyContext *ctx, size_t nelem, size_t elsize);
+_HPy_HIDDEN void *ctx_Mem_Realloc(HPyContext *ctx, void *ptr, size_t size);
+_HPy_HIDDEN void ctx_Mem_Free(HPyContext *ctx, void *ptr);
+_HPy_HIDDEN void *ctx_Mem_ScratchAlloc(HPyContext *ctx, size_t size);
+_HPy_HIDDEN void *_HPyMem_ScratchTop(void);
+_HPy_HIDDEN void _HPyMem_ScratchRelease(void *mark);
+_HPy_HIDDEN extern int _hpy_scratch_used;
+
+/* Every call into the extension is wrapped by these two: everything which
+   is allocated by HPyMem_ScratchAlloc in between is released by
+   _HPyMem_ScratchLeave. Until the first scratch allocation, they only
+   check a flag. */
+static inline void *_HPyMem_ScratchEnter(void)
+{
+    return _hpy_scratch_used ? _HPyMem_ScratchTop() : NULL;
+}
+
+static inline void _HPyMem_ScratchLeave(void *mark)
+{
+    if (_hpy_scratch_used)
+        _HPyMem_ScratchRelease(mark);
+}
+
 // ctx_module.c
 _HPy_HIDDEN HPy ctx_Module_Create(HPyContext *ctx, HPyModuleDef *hpydef);
 
+// ctx_number.c
+_HPy_HIDDEN HPy ctx_Long_FromString(HPyContext *ctx, const char *str,
+                                    HPy_ssize_t size, int base);
+_HPy_HIDDEN HPy ctx_Float_FromString(HPyContext *ctx, const char *str,
+                                     HPy_ssize_t size);
+_HPy_HIDDEN HPy_ssize_t ctx_Long_Format(HPyContext *ctx, HPy h, char *buf,
+                                        HPy_ssize_t size);
+_HPy_HIDDEN HPy_ssize_t ctx_Float_Format(HPyContext *ctx, HPy h, char *buf,
+                                         HPy_ssize_t size);
+_HPy_HIDDEN HPy ctx_Long_FromByteArray(HPyContext *ctx,
+                                       const unsigned char *bytes, size_t n,
+                                       int little_endian, int is_signed);
+_HPy_HIDDEN int ctx_Long_AsByteArray(HPyContext *ctx, HPy h,
+                                     unsigned char *bytes, size_t n,
+                                     int little_endian, int is_signed);
+_HPy_HIDDEN HPy ctx_Long_FromLimbs(HPyContext *ctx, const uint64_t *limbs,
+                                   size_t n, int is_signed);
+_HPy_HIDDEN int ctx_Long_AsLimbs(HPyContext *ctx, HPy h, uint64_t *limbs,
+                                 size_t n, int is_signed);
+_HPy_HIDDEN HPy_ssize_t ctx_Long_NumBits(HPyContext *ctx, HPy h);
+
 // ctx_object.c
 _HPy_HIDDEN void ctx_Dump(HPyContext *ctx, HPy h);
 _HPy_HIDDEN int ctx_TypeCheck(HPyContext *ctx, HPy h_obj, HPy h_type);
 _HPy_HIDDEN int ctx_Is(HPyContext *ctx, HPy h_obj, HPy h_other);
+_HPy_HIDDEN int ctx_RichCompareBool(HPyContext *ctx, HPy v, HPy w, int op);
+_HPy_HIDDEN int ctx_SetAttrs(HPyContext *ctx, HPy h_obj, HPyAttrDef *defs);
 _HPy_HIDDEN HPy ctx_GetItem_i(HPyContext *ctx, HPy obj, HPy_ssize_t idx);
 _HPy_HIDDEN HPy ctx_GetItem_s(HPyContext *ctx, HPy obj, const char *key);
 _HPy_HIDDEN int ctx_SetItem_i(HPyContext *ctx, HPy obj, HPy_ssize_t idx, HPy value);
 _HPy_HIDDEN int ctx_SetItem_s(HPyContext *ctx, HPy obj, const char *key, HPy value);
+#ifdef Py_GIL_DISABLED
+_HPy_HIDDEN PyMutex *_HPyField_GetLock(const void *addr);
+#endif
+
+// ctx_set.c
+_HPy_HIDDEN HPy ctx_Set_New(HPyContext *ctx, HPy_ssize_t size_hint);
+_HPy_HIDDEN int ctx_Set_AddArray(HPyContext *ctx, HPy h_set, HPy items[],
+                                 HPy_ssize_t n);
+
+// ctx_frozensetbuilder.c
+_HPy_HIDDEN HPyFrozenSetBuilder ctx_FrozenSetBuilder_New(HPyContext *ctx,
+                                                         HPy_ssize_t size_hint);
+_HPy_HIDDEN int ctx_FrozenSetBuilder_Add(HPyContext *ctx,
+                                         HPyFrozenSetBuilder builder,
+                                         HPy h_item);
+_HPy_HIDDEN HPy ctx_FrozenSetBuilder_Build(HPyContext *ctx,
+                                           HPyFrozenSetBuilder builder);
+_HPy_HIDDEN void ctx_FrozenSetBuilder_Cancel(HPyContext *ctx,
+                                             HPyFrozenSetBuilder builder);
+
+// ctx_slice.c
+_HPy_HIDDEN HPy ctx_GetSliceView(HPyContext *ctx, HPy obj, HPy_ssize_t start,
+                                 HPy_ssize_t end);
+_HPy_HIDDEN HPy ctx_List_GetSlice(HPyContext *ctx, HPy h_list,
+                                  HPy_ssize_t start, HPy_ssize_t end);
+_HPy_HIDDEN HPy ctx_Tuple_GetSlice(HPyContext *ctx, HPy h_tuple,
+                                   HPy_ssize_t start, HPy_ssize_t end);
+_HPy_HIDDEN HPy ctx_Bytes_GetSlice(HPyContext *ctx, HPy h, HPy_ssize_t start,
+                                   HPy_ssize_t end);
+_HPy_HIDDEN HPy ctx_Unicode_Substring(HPyContext *ctx, HPy h,
+                                      HPy_ssize_t start, HPy_ssize_t end);
 
 // ctx_tracker.c
 _HPy_HIDDEN HPyTracker ctx_Tracker_New(HPyContext *ctx, HPy_ssize_t size);
@@ -47,6 +137,8 @@ _HPy_HIDDEN HPyTupleBuilder ctx_TupleBuilder_New(HPyContext *ctx,
                                                  HPy_ssize_t initial_size);
 _HPy_HIDDEN void ctx_TupleBuilder_Set(HPyContext *ctx, HPyTupleBuilder builder,
                                       HPy_ssize_t index, HPy h_item);
+_HPy_HIDDEN void ctx_TupleBuilder_SetSteal(HPyContext *ctx, HPyTupleBuilder builder,
+                                           HPy_ssize_t index, HPy h_item);
 _HPy_HIDDEN HPy ctx_TupleBuilder_Build(HPyContext *ctx, HPyTupleBuilder builder);
 _HPy_HIDDEN void ctx_TupleBuilder_Cancel(HPyContext *ctx,
                                          HPyTupleBuilder builder);
@@ -60,7 +152,25 @@ _HPy_HIDDEN void* ctx_AsStructLegacy(HPyContext *ctx, HPy h);
 _HPy_HIDDEN HPy ctx_Type_FromSpec(HPyContext *ctx, HPyType_Spec *hpyspec,
                                   HPyType_SpecParam *params);
 _HPy_HIDDEN HPy ctx_New(HPyContext *ctx, HPy h_type, void **data);
+_HPy_HIDDEN void *ctx_Type_GetData(HPyContext *ctx, HPy h_type);
 _HPy_HIDDEN HPy ctx_Type_GenericNew(HPyContext *ctx, HPy h_type, HPy *args,
                                     HPy_ssize_t nargs, HPy kw);
+_HPy_HIDDEN HPy_ssize_t ctx_SetDeallocBudget(HPyContext *ctx, HPy_ssize_t budget);
+_HPy_HIDDEN int ctx_DrainDeallocs(HPyContext *ctx);
+
+// points to a flag shared by all the HPy extensions of the process, which is
+// set once an object has been deferred: see ctx_type.c
+_HPy_HIDDEN extern int *_hpy_dealloc_used;
+_HPy_HIDDEN void _HPyDealloc_DrainSome(void);
+
+/* Called at the exit of every call into the extension, after
+   _HPyMem_ScratchLeave, and by HPy_New: continue the destruction of the
+   objects deferred by hpytype_dealloc. Until the first object is deferred,
+   it only checks a flag. */
+static inline void _HPyDealloc_SafePoint(void)
+{
+    if (_hpy_dealloc_used != NULL && *_hpy_dealloc_used)
+        _HPyDealloc_DrainSome();
+}
 
 #endif /* HPY_RUNTIME_CTX_FUNCS_H */
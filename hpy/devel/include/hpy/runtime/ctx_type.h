@@ -8,6 +8,22 @@
 _HPy_HIDDEN PyMethodDef *create_method_defs(HPyDef *hpydefs[],
                                             PyMethodDef *legacy_methods);
 
+_HPy_HIDDEN PyObject *richcmpbool_result_to_py(int result);
+
+/* Return the impl of HPy_tp_richcompare_bool of tp if it can be called with
+   ctx, i.e. if tp was created with it, else NULL. *is_tp_richcompare is set
+   to true if the impl is also what tp_richcompare calls. */
+_HPy_HIDDEN HPyFunc_richcmpboolfunc
+get_richcompare_bool_impl(PyTypeObject *tp, HPyContext *ctx, bool *is_tp_richcompare);
+
+/* Finish HPy_RichCompareBool like CPython does when tp_richcompare returns
+   NotImplemented for both operands. */
+_HPy_HIDDEN int richcmpbool_notimplemented(PyObject *v, PyObject *w, int op);
+
+/* Record that the impls of tp expect ctx, e.g. the debug ctx for the types
+   created by a module loaded in debug mode. */
+_HPy_HIDDEN void set_type_impl_context(PyTypeObject *tp, HPyContext *ctx);
+
 _HPy_HIDDEN int call_traverseproc_from_trampoline(HPyFunc_traverseproc tp_traverse,
                                                   PyObject *self,
                                                   cpy_visitproc cpy_visit,
@@ -47,5 +63,24 @@ static inline void *_HPy_PyObject_Payload(PyObject *obj)
     return (void *) ((char *) obj + _HPy_PyObject_HEAD_SIZE);
 }
 
+/* Used by HPyDef_SLOT_TYPED_BINOP. If 'a' and 'b' are instances of exactly
+   the same HPy type, store the pointers to their structs in *a_data and
+   *b_data and return 1. Else, return 0. */
+static inline int _HPy_GetStructsIfSameType(PyObject *a, PyObject *b,
+                                            void **a_data, void **b_data)
+{
+    PyTypeObject *tp = Py_TYPE(a);
+    if (tp != Py_TYPE(b) || !(tp->tp_flags & HPy_TPFLAGS_INTERNAL_IS_HPY_TYPE))
+        return 0;
+    if (tp->tp_flags & HPy_TPFLAGS_INTERNAL_PURE) {
+        *a_data = _HPy_PyObject_Payload(a);
+        *b_data = _HPy_PyObject_Payload(b);
+    }
+    else {
+        *a_data = a;
+        *b_data = b;
+    }
+    return 1;
+}
 
 #endif /* HPY_COMMON_RUNTIME_CTX_TYPE_H */
@@ -0,0 +1,43 @@
+#ifndef HPY_COMMON_RUNTIME_HPYMAP_H
+#define HPY_COMMON_RUNTIME_HPYMAP_H
+
+#include "hpy.h"
+
+typedef struct {
+    HPy_hash_t hash;
+    HPyField key;       /* HPyField_NULL for the free slots */
+    HPyField value;
+} HPyMap_Entry;
+
+/* A hash map which is stored inside an object: all the fields must be
+   zero-initialized, which is what HPy_New does. */
+typedef struct {
+    HPy_ssize_t size;       /* number of items */
+    HPy_ssize_t fill;       /* number of items + deleted slots */
+    HPy_ssize_t mask;       /* number of slots - 1 */
+    HPyMap_Entry *entries;  /* NULL if no item has ever been stored */
+} HPyMap;
+
+HPyAPI_HELPER int
+HPyMap_Lookup(HPyContext *ctx, HPy owner, HPyMap *map, HPy key, HPy *value);
+
+HPyAPI_HELPER int
+HPyMap_Store(HPyContext *ctx, HPy owner, HPyMap *map, HPy key, HPy value);
+
+HPyAPI_HELPER int
+HPyMap_Delete(HPyContext *ctx, HPy owner, HPyMap *map, HPy key);
+
+HPyAPI_HELPER int
+HPyMap_Next(HPyContext *ctx, HPy owner, HPyMap *map, HPy_ssize_t *pos,
+            HPy *key, HPy *value);
+
+HPyAPI_HELPER void
+HPyMap_Clear(HPyContext *ctx, HPy owner, HPyMap *map);
+
+HPyAPI_HELPER int
+HPyMap_Traverse(HPyMap *map, HPyFunc_visitproc visit, void *arg);
+
+HPyAPI_HELPER void
+HPyMap_Free(HPyMap *map);
+
+#endif /* HPY_COMMON_RUNTIME_HPYMAP_H */
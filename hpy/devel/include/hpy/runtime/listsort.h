@@ -0,0 +1,27 @@
+#ifndef HPY_COMMON_RUNTIME_LISTSORT_H
+#define HPY_COMMON_RUNTIME_LISTSORT_H
+
+#include <stdint.h>
+#include "hpy.h"
+
+/* Return 1 if a < b, 0 otherwise, -1 in case of error */
+typedef int (*HPyList_LessThanFunc)(HPyContext *ctx, HPy a, HPy b, void *arg);
+
+/* Store the sort key of item in *key, return -1 in case of error */
+typedef int (*HPyList_DoubleKeyFunc)(HPyContext *ctx, HPy item, double *key,
+                                     void *arg);
+typedef int (*HPyList_Int64KeyFunc)(HPyContext *ctx, HPy item, int64_t *key,
+                                    void *arg);
+
+HPyAPI_HELPER int
+HPyList_Sort(HPyContext *ctx, HPy h_list, HPyList_LessThanFunc lt, void *arg);
+
+HPyAPI_HELPER int
+HPyList_SortByDoubleKey(HPyContext *ctx, HPy h_list,
+                        HPyList_DoubleKeyFunc key, void *arg, int reverse);
+
+HPyAPI_HELPER int
+HPyList_SortByInt64Key(HPyContext *ctx, HPy h_list,
+                       HPyList_Int64KeyFunc key, void *arg, int reverse);
+
+#endif /* HPY_COMMON_RUNTIME_LISTSORT_H */
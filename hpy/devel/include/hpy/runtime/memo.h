@@ -0,0 +1,9 @@
+#ifndef HPY_COMMON_RUNTIME_MEMO_H
+#define HPY_COMMON_RUNTIME_MEMO_H
+
+#include "hpy.h"
+
+HPyAPI_HELPER HPy
+HPyMemo_New(HPyContext *ctx, HPy self, HPyDef *def, HPy_ssize_t maxsize);
+
+#endif /* HPY_COMMON_RUNTIME_MEMO_H */
@@ -0,0 +1,45 @@
+#ifndef HPY_COMMON_RUNTIME_STRPOOL_H
+#define HPY_COMMON_RUNTIME_STRPOOL_H
+
+#include "hpy.h"
+
+/* the default maximum number of strings in a pool */
+#define HPYSTRPOOL_DEFAULT_MAXSIZE 1024
+
+/* longer strings are decoded but never stored in the pool */
+#define HPYSTRPOOL_MAX_LENGTH 256
+
+typedef struct {
+    size_t hash;
+    HPy_ssize_t offset;     /* of the bytes in HPyStrPool.chars */
+    HPy_ssize_t length;
+    HPyField value;         /* HPyField_NULL for the free slots */
+} HPyStrPool_Entry;
+
+/* A pool of canonical unicode objects which is stored inside an object:
+   all the fields must be zero-initialized, which is what HPy_New does.
+   max_size can be set afterwards, 0 means HPYSTRPOOL_DEFAULT_MAXSIZE. */
+typedef struct {
+    HPy_ssize_t max_size;
+    HPy_ssize_t size;               /* number of strings */
+    HPy_ssize_t mask;               /* number of slots - 1 */
+    HPyStrPool_Entry *entries;      /* NULL if no string has been stored */
+    char *chars;                    /* the UTF-8 bytes of all the strings */
+    HPy_ssize_t chars_used;
+    HPy_ssize_t chars_allocated;
+} HPyStrPool;
+
+HPyAPI_HELPER HPy
+HPyStrPool_Get(HPyContext *ctx, HPy owner, HPyStrPool *pool,
+               const char *utf8, HPy_ssize_t size);
+
+HPyAPI_HELPER void
+HPyStrPool_Clear(HPyContext *ctx, HPy owner, HPyStrPool *pool);
+
+HPyAPI_HELPER int
+HPyStrPool_Traverse(HPyStrPool *pool, HPyFunc_visitproc visit, void *arg);
+
+HPyAPI_HELPER void
+HPyStrPool_Free(HPyStrPool *pool);
+
+#endif /* HPY_COMMON_RUNTIME_STRPOOL_H */
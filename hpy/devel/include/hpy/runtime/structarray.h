@@ -0,0 +1,33 @@
+#ifndef HPY_COMMON_RUNTIME_STRUCTARRAY_H
+#define HPY_COMMON_RUNTIME_STRUCTARRAY_H
+
+#include "hpy.h"
+#include "hpy/hpydef.h"
+
+typedef struct {
+    const char *name;           /* field name, the array is terminated by name == NULL */
+    HPyMember_FieldType type;   /* only numeric types are supported */
+    HPy_ssize_t offset;         /* offsetof() the field inside the record */
+    const char *doc;            /* field docstring, or NULL */
+} HPyStructArray_Field;
+
+typedef struct {
+    const char *name;           /* "module.TypeName", like HPyType_Spec.name */
+    const char *doc;            /* type docstring, or NULL */
+    HPy_ssize_t itemsize;       /* sizeof() the record */
+    HPyStructArray_Field *fields;
+} HPyStructArray_Desc;
+
+HPyAPI_HELPER HPy
+HPyStructArray_NewType(HPyContext *ctx, HPyStructArray_Desc *desc);
+
+HPyAPI_HELPER HPy
+HPyStructArray_New(HPyContext *ctx, HPy type, HPy_ssize_t length);
+
+HPyAPI_HELPER HPy_ssize_t
+HPyStructArray_Length(HPyContext *ctx, HPy h);
+
+HPyAPI_HELPER void *
+HPyStructArray_Data(HPyContext *ctx, HPy h);
+
+#endif /* HPY_COMMON_RUNTIME_STRUCTARRAY_H */
@@ -0,0 +1,44 @@
+#ifndef HPY_COMMON_RUNTIME_STRUCTSEQ_H
+#define HPY_COMMON_RUNTIME_STRUCTSEQ_H
+
+#include "hpy.h"
+#include "hpy/hpytype.h"
+
+typedef struct {
+    const char *name;   /* field name, the array is terminated by name == NULL */
+    const char *doc;    /* field docstring, or NULL */
+} HPyStructSequence_Field;
+
+typedef struct {
+    const char *name;   /* "module.TypeName", like HPyType_Spec.name */
+    const char *doc;    /* type docstring, or NULL */
+    HPyStructSequence_Field *fields;
+} HPyStructSequence_Desc;
+
+typedef struct {
+    HPy _obj;           /* the instance being built, or HPy_NULL */
+} HPyStructSequenceBuilder;
+
+HPyAPI_HELPER HPy
+HPyStructSequence_NewType(HPyContext *ctx, HPyStructSequence_Desc *desc);
+
+HPyAPI_HELPER HPy
+HPyStructSequence_New(HPyContext *ctx, HPy type, HPy_ssize_t nargs, HPy *args);
+
+HPyAPI_HELPER HPy
+HPyStructSequence_GetItem(HPyContext *ctx, HPy self, HPy_ssize_t i);
+
+HPyAPI_HELPER HPyStructSequenceBuilder
+HPyStructSequenceBuilder_New(HPyContext *ctx, HPy type);
+
+HPyAPI_HELPER int
+HPyStructSequenceBuilder_Set(HPyContext *ctx, HPyStructSequenceBuilder builder,
+                             HPy_ssize_t i, HPy h);
+
+HPyAPI_HELPER HPy
+HPyStructSequenceBuilder_Build(HPyContext *ctx, HPyStructSequenceBuilder builder);
+
+HPyAPI_HELPER void
+HPyStructSequenceBuilder_Cancel(HPyContext *ctx, HPyStructSequenceBuilder builder);
+
+#endif /* HPY_COMMON_RUNTIME_STRUCTSEQ_H */
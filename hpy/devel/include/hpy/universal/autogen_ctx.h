@@ -14,6 +14,7 @@ struct _HPyContext_s {
     const char *name; // used just to make debugging and testing easier
     void *_private;   // used by implementations to store custom data
     int ctx_version;
+    intptr_t immortal_handle_mask; // see HPy_Dup() and HPy_Close()
     HPy h_None;
     HPy h_True;
     HPy h_False;
@@ -110,6 +111,15 @@ struct _HPyContext_s {
     HPy_ssize_t (*ctx_Long_AsSsize_t)(HPyContext *ctx, HPy h);
     HPy (*ctx_Float_FromDouble)(HPyContext *ctx, double v);
     double (*ctx_Float_AsDouble)(HPyContext *ctx, HPy h);
+    HPy (*ctx_Long_FromString)(HPyContext *ctx, const char *str, HPy_ssize_t size, int base);
+    HPy (*ctx_Float_FromString)(HPyContext *ctx, const char *str, HPy_ssize_t size);
+    HPy_ssize_t (*ctx_Long_Format)(HPyContext *ctx, HPy h, char *buf, HPy_ssize_t size);
+    HPy_ssize_t (*ctx_Float_Format)(HPyContext *ctx, HPy h, char *buf, HPy_ssize_t size);
+    HPy (*ctx_Long_FromByteArray)(HPyContext *ctx, const unsigned char *bytes, size_t n, int little_endian, int is_signed);
+    int (*ctx_Long_AsByteArray)(HPyContext *ctx, HPy h, unsigned char *bytes, size_t n, int little_endian, int is_signed);
+    HPy (*ctx_Long_FromLimbs)(HPyContext *ctx, const uint64_t *limbs, size_t n, int is_signed);
+    int (*ctx_Long_AsLimbs)(HPyContext *ctx, HPy h, uint64_t *limbs, size_t n, int is_signed);
+    HPy_ssize_t (*ctx_Long_NumBits)(HPyContext *ctx, HPy h);
     HPy (*ctx_Bool_FromLong)(HPyContext *ctx, long v);
     HPy_ssize_t (*ctx_Length)(HPyContext *ctx, HPy h);
     int (*ctx_Number_Check)(HPyContext *ctx, HPy h);
@@ -149,6 +159,7 @@ struct _HPyContext_s {
     HPy (*ctx_InPlaceOr)(HPyContext *ctx, HPy h1, HPy h2);
     int (*ctx_Callable_Check)(HPyContext *ctx, HPy h);
     HPy (*ctx_CallTupleDict)(HPyContext *ctx, HPy callable, HPy args, HPy kw);
+    HPy (*ctx_CallMethodCached)(HPyContext *ctx, HPy obj, HPyAttrCache *cache, HPy *args, HPy_ssize_t nargs);
     void (*ctx_FatalError)(HPyContext *ctx, const char *message);
     void (*ctx_Err_SetString)(HPyContext *ctx, HPy h_type, const char *message);
     void (*ctx_Err_SetObject)(HPyContext *ctx, HPy h_type, HPy h_value);
@@ -166,10 +177,12 @@ struct _HPyContext_s {
     HPy (*ctx_Type_GenericNew)(HPyContext *ctx, HPy type, HPy *args, HPy_ssize_t nargs, HPy kw);
     HPy (*ctx_GetAttr)(HPyContext *ctx, HPy obj, HPy name);
     HPy (*ctx_GetAttr_s)(HPyContext *ctx, HPy obj, const char *name);
+    HPy (*ctx_GetAttrCached)(HPyContext *ctx, HPy obj, HPyAttrCache *cache);
     int (*ctx_HasAttr)(HPyContext *ctx, HPy obj, HPy name);
     int (*ctx_HasAttr_s)(HPyContext *ctx, HPy obj, const char *name);
     int (*ctx_SetAttr)(HPyContext *ctx, HPy obj, HPy name, HPy value);
     int (*ctx_SetAttr_s)(HPyContext *ctx, HPy obj, const char *name, HPy value);
+    int (*ctx_SetAttrs)(HPyContext *ctx, HPy obj, HPyAttrDef *defs);
     HPy (*ctx_GetItem)(HPyContext *ctx, HPy obj, HPy key);
     HPy (*ctx_GetItem_i)(HPyContext *ctx, HPy obj, HPy_ssize_t idx);
     HPy (*ctx_GetItem_s)(HPyContext *ctx, HPy obj, const char *key);
@@ -177,12 +190,19 @@ struct _HPyContext_s {
     int (*ctx_SetItem)(HPyContext *ctx, HPy obj, HPy key, HPy value);
     int (*ctx_SetItem_i)(HPyContext *ctx, HPy obj, HPy_ssize_t idx, HPy value);
     int (*ctx_SetItem_s)(HPyContext *ctx, HPy obj, const char *key, HPy value);
+    HPy (*ctx_GetSlice)(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end);
+    int (*ctx_SetSlice)(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end, HPy value);
+    int (*ctx_DelSlice)(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end);
+    HPy (*ctx_GetSliceView)(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end);
     HPy (*ctx_Type)(HPyContext *ctx, HPy obj);
     int (*ctx_TypeCheck)(HPyContext *ctx, HPy obj, HPy type);
     int (*ctx_Is)(HPyContext *ctx, HPy obj, HPy other);
     void *(*ctx_AsStruct)(HPyContext *ctx, HPy h);
     void *(*ctx_AsStructLegacy)(HPyContext *ctx, HPy h);
     HPy (*ctx_New)(HPyContext *ctx, HPy h_type, void **data);
+    void *(*ctx_Type_GetData)(HPyContext *ctx, HPy type);
+    HPy_ssize_t (*ctx_SetDeallocBudget)(HPyContext *ctx, HPy_ssize_t budget);
+    int (*ctx_DrainDeallocs)(HPyContext *ctx);
     HPy (*ctx_Repr)(HPyContext *ctx, HPy obj);
     HPy (*ctx_Str)(HPyContext *ctx, HPy obj);
     HPy (*ctx_ASCII)(HPyContext *ctx, HPy obj);
@@ -197,37 +217,64 @@ struct _HPyContext_s {
     char *(*ctx_Bytes_AS_STRING)(HPyContext *ctx, HPy h);
     HPy (*ctx_Bytes_FromString)(HPyContext *ctx, const char *v);
     HPy (*ctx_Bytes_FromStringAndSize)(HPyContext *ctx, const char *v, HPy_ssize_t len);
+    HPy (*ctx_Bytes_GetSlice)(HPyContext *ctx, HPy h, HPy_ssize_t start, HPy_ssize_t end);
     HPy (*ctx_Unicode_FromString)(HPyContext *ctx, const char *utf8);
+    HPy (*ctx_Unicode_FromStringAndSize)(HPyContext *ctx, const char *utf8, HPy_ssize_t size);
     int (*ctx_Unicode_Check)(HPyContext *ctx, HPy h);
     HPy (*ctx_Unicode_AsUTF8String)(HPyContext *ctx, HPy h);
     const char *(*ctx_Unicode_AsUTF8AndSize)(HPyContext *ctx, HPy h, HPy_ssize_t *size);
     HPy (*ctx_Unicode_FromWideChar)(HPyContext *ctx, const wchar_t *w, HPy_ssize_t size);
     HPy (*ctx_Unicode_DecodeFSDefault)(HPyContext *ctx, const char *v);
     HPy (*ctx_Unicode_DecodeFSDefaultAndSize)(HPyContext *ctx, const char *v, HPy_ssize_t size);
+    HPy (*ctx_Unicode_Substring)(HPyContext *ctx, HPy h, HPy_ssize_t start, HPy_ssize_t end);
     int (*ctx_List_Check)(HPyContext *ctx, HPy h);
     HPy (*ctx_List_New)(HPyContext *ctx, HPy_ssize_t len);
     int (*ctx_List_Append)(HPyContext *ctx, HPy h_list, HPy h_item);
+    int (*ctx_List_AppendSteal)(HPyContext *ctx, HPy h_list, HPy h_item);
+    HPy (*ctx_List_GetSlice)(HPyContext *ctx, HPy h_list, HPy_ssize_t start, HPy_ssize_t end);
     int (*ctx_Dict_Check)(HPyContext *ctx, HPy h);
     HPy (*ctx_Dict_New)(HPyContext *ctx);
+    int (*ctx_Set_Check)(HPyContext *ctx, HPy h);
+    int (*ctx_FrozenSet_Check)(HPyContext *ctx, HPy h);
+    HPy (*ctx_Set_New)(HPyContext *ctx, HPy_ssize_t size_hint);
+    int (*ctx_Set_Add)(HPyContext *ctx, HPy h_set, HPy h_item);
+    int (*ctx_Set_AddArray)(HPyContext *ctx, HPy h_set, HPy items[], HPy_ssize_t n);
+    int (*ctx_Set_Contains)(HPyContext *ctx, HPy h_set, HPy h_item);
     int (*ctx_Tuple_Check)(HPyContext *ctx, HPy h);
     HPy (*ctx_Tuple_FromArray)(HPyContext *ctx, HPy items[], HPy_ssize_t n);
+    HPy (*ctx_Tuple_GetSlice)(HPyContext *ctx, HPy h_tuple, HPy_ssize_t start, HPy_ssize_t end);
     HPy (*ctx_Import_ImportModule)(HPyContext *ctx, const char *name);
     HPy (*ctx_FromPyObject)(HPyContext *ctx, cpy_PyObject *obj);
     cpy_PyObject *(*ctx_AsPyObject)(HPyContext *ctx, HPy h);
     void (*ctx_CallRealFunctionFromTrampoline)(HPyContext *ctx, HPyFunc_Signature sig, HPyCFunction func, void *args);
     HPyListBuilder (*ctx_ListBuilder_New)(HPyContext *ctx, HPy_ssize_t initial_size);
     void (*ctx_ListBuilder_Set)(HPyContext *ctx, HPyListBuilder builder, HPy_ssize_t index, HPy h_item);
+    void (*ctx_ListBuilder_SetSteal)(HPyContext *ctx, HPyListBuilder builder, HPy_ssize_t index, HPy h_item);
     HPy (*ctx_ListBuilder_Build)(HPyContext *ctx, HPyListBuilder builder);
     void (*ctx_ListBuilder_Cancel)(HPyContext *ctx, HPyListBuilder builder);
     HPyTupleBuilder (*ctx_TupleBuilder_New)(HPyContext *ctx, HPy_ssize_t initial_size);
     void (*ctx_TupleBuilder_Set)(HPyContext *ctx, HPyTupleBuilder builder, HPy_ssize_t index, HPy h_item);
+    void (*ctx_TupleBuilder_SetSteal)(HPyContext *ctx, HPyTupleBuilder builder, HPy_ssize_t index, HPy h_item);
     HPy (*ctx_TupleBuilder_Build)(HPyContext *ctx, HPyTupleBuilder builder);
     void (*ctx_TupleBuilder_Cancel)(HPyContext *ctx, HPyTupleBuilder builder);
+    HPyFrozenSetBuilder (*ctx_FrozenSetBuilder_New)(HPyContext *ctx, HPy_ssize_t size_hint);
+    int (*ctx_FrozenSetBuilder_Add)(HPyContext *ctx, HPyFrozenSetBuilder builder, HPy h_item);
+    HPy (*ctx_FrozenSetBuilder_Build)(HPyContext *ctx, HPyFrozenSetBuilder builder);
+    void (*ctx_FrozenSetBuilder_Cancel)(HPyContext *ctx, HPyFrozenSetBuilder builder);
     HPyTracker (*ctx_Tracker_New)(HPyContext *ctx, HPy_ssize_t size);
     int (*ctx_Tracker_Add)(HPyContext *ctx, HPyTracker ht, HPy h);
     void (*ctx_Tracker_ForgetAll)(HPyContext *ctx, HPyTracker ht);
     void (*ctx_Tracker_Close)(HPyContext *ctx, HPyTracker ht);
+    void *(*ctx_Mem_Malloc)(HPyContext *ctx, size_t size);
+    void *(*ctx_Mem_Calloc)(HPyContext *ctx, size_t nelem, size_t elsize);
+    void *(*ctx_Mem_Realloc)(HPyContext *ctx, void *ptr, size_t size);
+    void (*ctx_Mem_Free)(HPyContext *ctx, void *ptr);
+    void *(*ctx_Mem_ScratchAlloc)(HPyContext *ctx, size_t size);
     void (*ctx_Field_Store)(HPyContext *ctx, HPy target_object, HPyField *target_field, HPy h);
     HPy (*ctx_Field_Load)(HPyContext *ctx, HPy source_object, HPyField source_field);
+    HPy (*ctx_Field_LoadAt)(HPyContext *ctx, HPy source_object, HPyField *source_field);
+    void (*ctx_Global_Store)(HPyContext *ctx, HPyGlobal *global, HPy h);
+    HPy (*ctx_Global_Load)(HPyContext *ctx, HPyGlobal global);
+    HPy (*ctx_Global_LoadAt)(HPyContext *ctx, HPyGlobal *global);
     void (*ctx_Dump)(HPyContext *ctx, HPy h);
 };
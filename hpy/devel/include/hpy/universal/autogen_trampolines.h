@@ -14,14 +14,6 @@ HPyAPI_FUNC HPy HPyModule_Create(HPyContext *ctx, HPyModuleDef *def) {
      return ctx->ctx_Module_Create ( ctx, def ); 
 }
 
-HPyAPI_FUNC HPy HPy_Dup(HPyContext *ctx, HPy h) {
-     return ctx->ctx_Dup ( ctx, h ); 
-}
-
-HPyAPI_FUNC void HPy_Close(HPyContext *ctx, HPy h) {
-     ctx->ctx_Close ( ctx, h ); 
-}
-
 HPyAPI_FUNC HPy HPyLong_FromLong(HPyContext *ctx, long value) {
      return ctx->ctx_Long_FromLong ( ctx, value ); 
 }
@@ -86,6 +78,42 @@ HPyAPI_FUNC double HPyFloat_AsDouble(HPyContext *ctx, HPy h) {
      return ctx->ctx_Float_AsDouble ( ctx, h ); 
 }
 
+HPyAPI_FUNC HPy HPyLong_FromString(HPyContext *ctx, const char *str, HPy_ssize_t size, int base) {
+     return ctx->ctx_Long_FromString ( ctx, str, size, base ); 
+}
+
+HPyAPI_FUNC HPy HPyFloat_FromString(HPyContext *ctx, const char *str, HPy_ssize_t size) {
+     return ctx->ctx_Float_FromString ( ctx, str, size ); 
+}
+
+HPyAPI_FUNC HPy_ssize_t HPyLong_Format(HPyContext *ctx, HPy h, char *buf, HPy_ssize_t size) {
+     return ctx->ctx_Long_Format ( ctx, h, buf, size ); 
+}
+
+HPyAPI_FUNC HPy_ssize_t HPyFloat_Format(HPyContext *ctx, HPy h, char *buf, HPy_ssize_t size) {
+     return ctx->ctx_Float_Format ( ctx, h, buf, size ); 
+}
+
+HPyAPI_FUNC HPy HPyLong_FromByteArray(HPyContext *ctx, const unsigned char *bytes, size_t n, int little_endian, int is_signed) {
+     return ctx->ctx_Long_FromByteArray ( ctx, bytes, n, little_endian, is_signed ); 
+}
+
+HPyAPI_FUNC int HPyLong_AsByteArray(HPyContext *ctx, HPy h, unsigned char *bytes, size_t n, int little_endian, int is_signed) {
+     return ctx->ctx_Long_AsByteArray ( ctx, h, bytes, n, little_endian, is_signed ); 
+}
+
+HPyAPI_FUNC HPy HPyLong_FromLimbs(HPyContext *ctx, const uint64_t *limbs, size_t n, int is_signed) {
+     return ctx->ctx_Long_FromLimbs ( ctx, limbs, n, is_signed ); 
+}
+
+HPyAPI_FUNC int HPyLong_AsLimbs(HPyContext *ctx, HPy h, uint64_t *limbs, size_t n, int is_signed) {
+     return ctx->ctx_Long_AsLimbs ( ctx, h, limbs, n, is_signed ); 
+}
+
+HPyAPI_FUNC HPy_ssize_t HPyLong_NumBits(HPyContext *ctx, HPy h) {
+     return ctx->ctx_Long_NumBits ( ctx, h ); 
+}
+
 HPyAPI_FUNC HPy HPyBool_FromLong(HPyContext *ctx, long v) {
      return ctx->ctx_Bool_FromLong ( ctx, v ); 
 }
@@ -242,6 +270,10 @@ HPyAPI_FUNC HPy HPy_CallTupleDict(HPyContext *ctx, HPy callable, HPy args, HPy k
      return ctx->ctx_CallTupleDict ( ctx, callable, args, kw ); 
 }
 
+HPyAPI_FUNC HPy HPy_CallMethodCached(HPyContext *ctx, HPy obj, HPyAttrCache *cache, HPy *args, HPy_ssize_t nargs) {
+     return ctx->ctx_CallMethodCached ( ctx, obj, cache, args, nargs ); 
+}
+
 HPyAPI_FUNC void HPyErr_SetString(HPyContext *ctx, HPy h_type, const char *message) {
      ctx->ctx_Err_SetString ( ctx, h_type, message ); 
 }
@@ -306,6 +338,10 @@ HPyAPI_FUNC HPy HPy_GetAttr_s(HPyContext *ctx, HPy obj, const char *name) {
      return ctx->ctx_GetAttr_s ( ctx, obj, name ); 
 }
 
+HPyAPI_FUNC HPy HPy_GetAttrCached(HPyContext *ctx, HPy obj, HPyAttrCache *cache) {
+     return ctx->ctx_GetAttrCached ( ctx, obj, cache ); 
+}
+
 HPyAPI_FUNC int HPy_HasAttr(HPyContext *ctx, HPy obj, HPy name) {
      return ctx->ctx_HasAttr ( ctx, obj, name ); 
 }
@@ -322,6 +358,10 @@ HPyAPI_FUNC int HPy_SetAttr_s(HPyContext *ctx, HPy obj, const char *name, HPy va
      return ctx->ctx_SetAttr_s ( ctx, obj, name, value ); 
 }
 
+HPyAPI_FUNC int HPy_SetAttrs(HPyContext *ctx, HPy obj, HPyAttrDef *defs) {
+     return ctx->ctx_SetAttrs ( ctx, obj, defs ); 
+}
+
 HPyAPI_FUNC HPy HPy_GetItem(HPyContext *ctx, HPy obj, HPy key) {
      return ctx->ctx_GetItem ( ctx, obj, key ); 
 }
@@ -350,6 +390,22 @@ HPyAPI_FUNC int HPy_SetItem_s(HPyContext *ctx, HPy obj, const char *key, HPy val
      return ctx->ctx_SetItem_s ( ctx, obj, key, value ); 
 }
 
+HPyAPI_FUNC HPy HPy_GetSlice(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end) {
+     return ctx->ctx_GetSlice ( ctx, obj, start, end ); 
+}
+
+HPyAPI_FUNC int HPy_SetSlice(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end, HPy value) {
+     return ctx->ctx_SetSlice ( ctx, obj, start, end, value ); 
+}
+
+HPyAPI_FUNC int HPy_DelSlice(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end) {
+     return ctx->ctx_DelSlice ( ctx, obj, start, end ); 
+}
+
+HPyAPI_FUNC HPy HPy_GetSliceView(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end) {
+     return ctx->ctx_GetSliceView ( ctx, obj, start, end ); 
+}
+
 HPyAPI_FUNC HPy HPy_Type(HPyContext *ctx, HPy obj) {
      return ctx->ctx_Type ( ctx, obj ); 
 }
@@ -370,6 +426,18 @@ HPyAPI_FUNC void *HPy_AsStructLegacy(HPyContext *ctx, HPy h) {
      return ctx->ctx_AsStructLegacy ( ctx, h ); 
 }
 
+HPyAPI_FUNC void *HPyType_GetData(HPyContext *ctx, HPy type) {
+     return ctx->ctx_Type_GetData ( ctx, type ); 
+}
+
+HPyAPI_FUNC HPy_ssize_t HPy_SetDeallocBudget(HPyContext *ctx, HPy_ssize_t budget) {
+     return ctx->ctx_SetDeallocBudget ( ctx, budget ); 
+}
+
+HPyAPI_FUNC int HPy_DrainDeallocs(HPyContext *ctx) {
+     return ctx->ctx_DrainDeallocs ( ctx ); 
+}
+
 HPyAPI_FUNC HPy HPy_Repr(HPyContext *ctx, HPy obj) {
      return ctx->ctx_Repr ( ctx, obj ); 
 }
@@ -426,10 +494,18 @@ HPyAPI_FUNC HPy HPyBytes_FromStringAndSize(HPyContext *ctx, const char *v, HPy_s
      return ctx->ctx_Bytes_FromStringAndSize ( ctx, v, len ); 
 }
 
+HPyAPI_FUNC HPy HPyBytes_GetSlice(HPyContext *ctx, HPy h, HPy_ssize_t start, HPy_ssize_t end) {
+     return ctx->ctx_Bytes_GetSlice ( ctx, h, start, end ); 
+}
+
 HPyAPI_FUNC HPy HPyUnicode_FromString(HPyContext *ctx, const char *utf8) {
      return ctx->ctx_Unicode_FromString ( ctx, utf8 ); 
 }
 
+HPyAPI_FUNC HPy HPyUnicode_FromStringAndSize(HPyContext *ctx, const char *utf8, HPy_ssize_t size) {
+     return ctx->ctx_Unicode_FromStringAndSize ( ctx, utf8, size ); 
+}
+
 HPyAPI_FUNC int HPyUnicode_Check(HPyContext *ctx, HPy h) {
      return ctx->ctx_Unicode_Check ( ctx, h ); 
 }
@@ -454,6 +530,10 @@ HPyAPI_FUNC HPy HPyUnicode_DecodeFSDefaultAndSize(HPyContext *ctx, const char *v
      return ctx->ctx_Unicode_DecodeFSDefaultAndSize ( ctx, v, size ); 
 }
 
+HPyAPI_FUNC HPy HPyUnicode_Substring(HPyContext *ctx, HPy h, HPy_ssize_t start, HPy_ssize_t end) {
+     return ctx->ctx_Unicode_Substring ( ctx, h, start, end ); 
+}
+
 HPyAPI_FUNC int HPyList_Check(HPyContext *ctx, HPy h) {
      return ctx->ctx_List_Check ( ctx, h ); 
 }
@@ -466,6 +546,14 @@ HPyAPI_FUNC int HPyList_Append(HPyContext *ctx, HPy h_list, HPy h_item) {
      return ctx->ctx_List_Append ( ctx, h_list, h_item ); 
 }
 
+HPyAPI_FUNC int HPyList_AppendSteal(HPyContext *ctx, HPy h_list, HPy h_item) {
+     return ctx->ctx_List_AppendSteal ( ctx, h_list, h_item ); 
+}
+
+HPyAPI_FUNC HPy HPyList_GetSlice(HPyContext *ctx, HPy h_list, HPy_ssize_t start, HPy_ssize_t end) {
+     return ctx->ctx_List_GetSlice ( ctx, h_list, start, end ); 
+}
+
 HPyAPI_FUNC int HPyDict_Check(HPyContext *ctx, HPy h) {
      return ctx->ctx_Dict_Check ( ctx, h ); 
 }
@@ -474,6 +562,30 @@ HPyAPI_FUNC HPy HPyDict_New(HPyContext *ctx) {
      return ctx->ctx_Dict_New ( ctx ); 
 }
 
+HPyAPI_FUNC int HPySet_Check(HPyContext *ctx, HPy h) {
+     return ctx->ctx_Set_Check ( ctx, h ); 
+}
+
+HPyAPI_FUNC int HPyFrozenSet_Check(HPyContext *ctx, HPy h) {
+     return ctx->ctx_FrozenSet_Check ( ctx, h ); 
+}
+
+HPyAPI_FUNC HPy HPySet_New(HPyContext *ctx, HPy_ssize_t size_hint) {
+     return ctx->ctx_Set_New ( ctx, size_hint ); 
+}
+
+HPyAPI_FUNC int HPySet_Add(HPyContext *ctx, HPy h_set, HPy h_item) {
+     return ctx->ctx_Set_Add ( ctx, h_set, h_item ); 
+}
+
+HPyAPI_FUNC int HPySet_AddArray(HPyContext *ctx, HPy h_set, HPy items[], HPy_ssize_t n) {
+     return ctx->ctx_Set_AddArray ( ctx, h_set, items, n ); 
+}
+
+HPyAPI_FUNC int HPySet_Contains(HPyContext *ctx, HPy h_set, HPy h_item) {
+     return ctx->ctx_Set_Contains ( ctx, h_set, h_item ); 
+}
+
 HPyAPI_FUNC int HPyTuple_Check(HPyContext *ctx, HPy h) {
      return ctx->ctx_Tuple_Check ( ctx, h ); 
 }
@@ -482,6 +594,10 @@ HPyAPI_FUNC HPy HPyTuple_FromArray(HPyContext *ctx, HPy items[], HPy_ssize_t n)
      return ctx->ctx_Tuple_FromArray ( ctx, items, n ); 
 }
 
+HPyAPI_FUNC HPy HPyTuple_GetSlice(HPyContext *ctx, HPy h_tuple, HPy_ssize_t start, HPy_ssize_t end) {
+     return ctx->ctx_Tuple_GetSlice ( ctx, h_tuple, start, end ); 
+}
+
 HPyAPI_FUNC HPy HPyImport_ImportModule(HPyContext *ctx, const char *name) {
      return ctx->ctx_Import_ImportModule ( ctx, name ); 
 }
@@ -506,6 +622,10 @@ HPyAPI_FUNC void HPyListBuilder_Set(HPyContext *ctx, HPyListBuilder builder, HPy
      ctx->ctx_ListBuilder_Set ( ctx, builder, index, h_item ); 
 }
 
+HPyAPI_FUNC void HPyListBuilder_SetSteal(HPyContext *ctx, HPyListBuilder builder, HPy_ssize_t index, HPy h_item) {
+     ctx->ctx_ListBuilder_SetSteal ( ctx, builder, index, h_item ); 
+}
+
 HPyAPI_FUNC HPy HPyListBuilder_Build(HPyContext *ctx, HPyListBuilder builder) {
      return ctx->ctx_ListBuilder_Build ( ctx, builder ); 
 }
@@ -522,6 +642,10 @@ HPyAPI_FUNC void HPyTupleBuilder_Set(HPyContext *ctx, HPyTupleBuilder builder, H
      ctx->ctx_TupleBuilder_Set ( ctx, builder, index, h_item ); 
 }
 
+HPyAPI_FUNC void HPyTupleBuilder_SetSteal(HPyContext *ctx, HPyTupleBuilder builder, HPy_ssize_t index, HPy h_item) {
+     ctx->ctx_TupleBuilder_SetSteal ( ctx, builder, index, h_item ); 
+}
+
 HPyAPI_FUNC HPy HPyTupleBuilder_Build(HPyContext *ctx, HPyTupleBuilder builder) {
      return ctx->ctx_TupleBuilder_Build ( ctx, builder ); 
 }
@@ -530,6 +654,22 @@ HPyAPI_FUNC void HPyTupleBuilder_Cancel(HPyContext *ctx, HPyTupleBuilder builder
      ctx->ctx_TupleBuilder_Cancel ( ctx, builder ); 
 }
 
+HPyAPI_FUNC HPyFrozenSetBuilder HPyFrozenSetBuilder_New(HPyContext *ctx, HPy_ssize_t size_hint) {
+     return ctx->ctx_FrozenSetBuilder_New ( ctx, size_hint ); 
+}
+
+HPyAPI_FUNC int HPyFrozenSetBuilder_Add(HPyContext *ctx, HPyFrozenSetBuilder builder, HPy h_item) {
+     return ctx->ctx_FrozenSetBuilder_Add ( ctx, builder, h_item ); 
+}
+
+HPyAPI_FUNC HPy HPyFrozenSetBuilder_Build(HPyContext *ctx, HPyFrozenSetBuilder builder) {
+     return ctx->ctx_FrozenSetBuilder_Build ( ctx, builder ); 
+}
+
+HPyAPI_FUNC void HPyFrozenSetBuilder_Cancel(HPyContext *ctx, HPyFrozenSetBuilder builder) {
+     ctx->ctx_FrozenSetBuilder_Cancel ( ctx, builder ); 
+}
+
 HPyAPI_FUNC HPyTracker HPyTracker_New(HPyContext *ctx, HPy_ssize_t size) {
      return ctx->ctx_Tracker_New ( ctx, size ); 
 }
@@ -546,6 +686,26 @@ HPyAPI_FUNC void HPyTracker_Close(HPyContext *ctx, HPyTracker ht) {
      ctx->ctx_Tracker_Close ( ctx, ht ); 
 }
 
+HPyAPI_FUNC void *HPyMem_Malloc(HPyContext *ctx, size_t size) {
+     return ctx->ctx_Mem_Malloc ( ctx, size ); 
+}
+
+HPyAPI_FUNC void *HPyMem_Calloc(HPyContext *ctx, size_t nelem, size_t elsize) {
+     return ctx->ctx_Mem_Calloc ( ctx, nelem, elsize ); 
+}
+
+HPyAPI_FUNC void *HPyMem_Realloc(HPyContext *ctx, void *ptr, size_t size) {
+     return ctx->ctx_Mem_Realloc ( ctx, ptr, size ); 
+}
+
+HPyAPI_FUNC void HPyMem_Free(HPyContext *ctx, void *ptr) {
+     ctx->ctx_Mem_Free ( ctx, ptr ); 
+}
+
+HPyAPI_FUNC void *HPyMem_ScratchAlloc(HPyContext *ctx, size_t size) {
+     return ctx->ctx_Mem_ScratchAlloc ( ctx, size ); 
+}
+
 HPyAPI_FUNC void HPyField_Store(HPyContext *ctx, HPy target_object, HPyField *target_field, HPy h) {
      ctx->ctx_Field_Store ( ctx, target_object, target_field, h ); 
 }
@@ -554,6 +714,22 @@ HPyAPI_FUNC HPy HPyField_Load(HPyContext *ctx, HPy source_object, HPyField sourc
      return ctx->ctx_Field_Load ( ctx, source_object, source_field ); 
 }
 
+HPyAPI_FUNC HPy _HPyField_LoadAt(HPyContext *ctx, HPy source_object, HPyField *source_field) {
+     return ctx->ctx_Field_LoadAt ( ctx, source_object, source_field ); 
+}
+
+HPyAPI_FUNC void HPyGlobal_Store(HPyContext *ctx, HPyGlobal *global, HPy h) {
+     ctx->ctx_Global_Store ( ctx, global, h ); 
+}
+
+HPyAPI_FUNC HPy HPyGlobal_Load(HPyContext *ctx, HPyGlobal global) {
+     return ctx->ctx_Global_Load ( ctx, global ); 
+}
+
+HPyAPI_FUNC HPy _HPyGlobal_LoadAt(HPyContext *ctx, HPyGlobal *global) {
+     return ctx->ctx_Global_LoadAt ( ctx, global ); 
+}
+
 HPyAPI_FUNC void _HPy_Dump(HPyContext *ctx, HPy h) {
      ctx->ctx_Dump ( ctx, h ); 
 }
@@ -113,6 +113,47 @@ typedef struct {
         return a.result;                                                \
     }
 
+/* the impl of HPy_tp_richcompare_bool returns an int, but the CPython slot
+   needs an object: the conversion is done by
+   _HPy_CallRealFunctionFromTrampoline, see richcmpbool_result_to_py() */
+typedef struct {
+    cpy_PyObject *arg0;
+    cpy_PyObject *arg1;
+    HPy_RichCmpOp arg2;
+    cpy_PyObject * result;
+} _HPyFunc_args_RICHCMPBOOLFUNC;
+
+#define _HPyFunc_TRAMPOLINE_HPyFunc_RICHCMPBOOLFUNC(SYM, IMPL)          \
+    static cpy_PyObject *                                               \
+    SYM(cpy_PyObject *self, cpy_PyObject *obj, int op)                  \
+    {                                                                   \
+        _HPyFunc_args_RICHCMPBOOLFUNC a = { self, obj, (HPy_RichCmpOp)op };            \
+        _HPy_CallRealFunctionFromTrampoline(                            \
+           _ctx_for_trampolines, HPyFunc_RICHCMPBOOLFUNC, (HPyCFunction)IMPL, &a);    \
+        return a.result;                                                \
+    }
+
+/* used by HPyDef_SLOT_TYPED_BINOP: IMPL is passed as the function to call,
+   but _HPy_CallRealFunctionFromTrampoline calls typed_impl instead if both
+   operands have the same HPy type */
+typedef struct {
+    cpy_PyObject *arg0;
+    cpy_PyObject *arg1;
+    HPyFunc_typedbinaryfunc typed_impl;
+    cpy_PyObject *result;
+} _HPyFunc_args_TYPEDBINARYFUNC;
+
+#define _HPyFunc_TYPED_BINOP_TRAMPOLINE(SYM, TYPED_IMPL, IMPL)          \
+    static cpy_PyObject *                                               \
+    SYM(cpy_PyObject *arg0, cpy_PyObject *arg1)                         \
+    {                                                                   \
+        _HPyFunc_args_TYPEDBINARYFUNC a = { arg0, arg1,                 \
+                                 (HPyFunc_typedbinaryfunc)TYPED_IMPL }; \
+        _HPy_CallRealFunctionFromTrampoline(                            \
+           _ctx_for_trampolines, HPyFunc_TYPEDBINARYFUNC, (HPyCFunction)IMPL, &a);    \
+        return a.result;                                                \
+    }
+
 typedef struct {
     cpy_PyObject *self;
     cpy_Py_buffer *view;
@@ -23,6 +23,24 @@ static inline HPy _HPy_New(HPyContext *ctx, HPy h_type, void **data) {
     return h;
 }
 
+/* HPy_Dup and HPy_Close are so common that it is worth inlining a fast path
+   for them: if the handle has one of the bits of ctx->immortal_handle_mask
+   set, it refers to an object which is never deallocated (e.g. None or
+   True) and there is no need to call into the ctx at all. The
+   implementations which don't use this feature set the mask to 0.
+*/
+static inline HPy HPy_Dup(HPyContext *ctx, HPy h) {
+    if (h._i & ctx->immortal_handle_mask)
+        return h;
+    return ctx->ctx_Dup(ctx, h);
+}
+
+static inline void HPy_Close(HPyContext *ctx, HPy h) {
+    if (h._i & ctx->immortal_handle_mask)
+        return;
+    ctx->ctx_Close(ctx, h);
+}
+
 static inline _HPy_NO_RETURN void
 HPy_FatalError(HPyContext *ctx, const char *message) {
     ctx->ctx_FatalError(ctx, message);
@@ -0,0 +1,4 @@
+
+// automatically generated by setup.py:get_scm_config()
+#define HPY_VERSION "0.0.4.dev0"
+#define HPY_GIT_REVISION "b3339ba"
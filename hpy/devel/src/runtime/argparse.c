@@ -1,13 +1,16 @@
 /**
- * Implementation of HPyArg_Parse and HPyArg_ParseKeywords.
+ * Implementation of HPyArg_Parse, HPyArg_ParseKeywords and
+ * HPyArg_ParseKeywordsArray.
  *
  * HPyArg_Parse parses positional arguments and replaces PyArg_ParseTuple.
  * HPyArg_ParseKeywords parses positional and keyword arguments and
- * replaces PyArg_ParseTupleAndKeywords.
+ * replaces PyArg_ParseTupleAndKeywords. HPyArg_ParseKeywordsArray does the
+ * same, but takes the values of the keyword arguments in an array, together
+ * with a tuple of their names, as in the vectorcall protocol.
  *
  * HPy intends to only support the simpler format string types (numbers, bools)
- * and handles. More complex types (e.g. buffers) should be retrieved as
- * handles and then processed further as needed.
+ * and handles. More complex types (e.g. generic buffers) should be retrieved
+ * as handles and then processed further as needed.
  *
  * Supported Formatting Strings
  * ----------------------------
@@ -77,6 +80,26 @@
  * Note: This format does not accept bytes-like objects and is therefore
  * not suitable for filesystem paths.
  *
+ * ``s# (unicode, bytes) [const char *, HPy_ssize_t]``
+ *
+ * Like ``s``, but stores the pointer and the length of the data into two C
+ * variables, and embedded null characters are allowed. A bytes object is
+ * also accepted, in which case a pointer to its internal buffer is stored.
+ * No copy is made in either case.
+ *
+ * ``y# (bytes) [const char *, HPy_ssize_t]``
+ *
+ * Stores a pointer to the internal buffer of a bytes object and its length
+ * into two C variables. Embedded null bytes are allowed.
+ *
+ * ``y* (bytes) [HPy_buffer]``
+ *
+ * Fills the ``HPy_buffer`` whose address you pass with a one-dimensional,
+ * read-only view of the internal buffer of a bytes object. Contrarily to
+ * CPython, only bytes objects are accepted, and the buffer does not need to
+ * be released: its ``obj`` field is set to ``HPy_NULL`` and the data is valid
+ * as long as the argument handle is.
+ *
  * Handles (Python Objects)
  * ~~~~~~~~~~~~~~~~~~~~~~~~
  *
@@ -90,6 +113,11 @@
  *     created during argument parsing. There is no need to call
  *     `HPyTracker_Close` on failure -- the argument parser does this for you.
  *
+ * ``O! (object) [HPy type, HPy]``
+ *     Like ``O``, but takes two C arguments: the first is a handle to a
+ *     type, the second the address of the HPy variable. If the Python object
+ *     is not an instance of the type, `TypeError` is raised.
+ *
  * Miscellaneous
  * ~~~~~~~~~~~~~
  *
@@ -134,9 +162,11 @@
 #include "hpy.h"
 #include <limits.h>
 #include <stdio.h>
+#include <string.h>
 
 #define _BREAK_IF_OPTIONAL(current_arg) if (HPy_IsNull(current_arg)) break;
 #define _ERR_STRING_MAX_LENGTH 512
+#define _KWNAMES_STACK_SIZE 16
 
 
 static const char *
@@ -170,6 +200,36 @@ set_error(HPyContext *ctx, HPy exc, const char *err_fmt, const char *msg) {
 }
 
 
+/* Implements 's#' (if accept_unicode) and 'y#': no copy of the data is
+   made, we return a pointer to the internal buffer of the object */
+static int
+parse_pointer_and_size(HPyContext *ctx, HPy current_arg, va_list *vl,
+                       const char *err_fmt, int accept_unicode)
+{
+    const char **output = va_arg(*vl, const char **);
+    HPy_ssize_t *output_size = va_arg(*vl, HPy_ssize_t *);
+    if (HPy_IsNull(current_arg))
+        return 1;   /* optional argument */
+    if (HPyBytes_Check(ctx, current_arg)) {
+        *output = HPyBytes_AS_STRING(ctx, current_arg);
+        *output_size = HPyBytes_GET_SIZE(ctx, current_arg);
+        return 1;
+    }
+    if (accept_unicode && HPyUnicode_Check(ctx, current_arg)) {
+        HPy_ssize_t size;
+        const char *data = HPyUnicode_AsUTF8AndSize(ctx, current_arg, &size);
+        if (data == NULL)
+            return 0;
+        *output = data;
+        *output_size = size;
+        return 1;
+    }
+    set_error(ctx, ctx->h_TypeError, err_fmt, accept_unicode ?
+        "a str or bytes object is required" : "a bytes object is required");
+    return 0;
+}
+
+
 static int
 parse_item(HPyContext *ctx, HPyTracker *ht, HPy current_arg, int current_arg_tmp, const char **fmt, va_list *vl, const char *err_fmt)
 {
@@ -339,8 +399,18 @@ parse_item(HPyContext *ctx, HPyTracker *ht, HPy current_arg, int current_arg_tmp
     }
 
     case 'O': {
+        HPy type = HPy_NULL;
+        if (**fmt == '!') {
+            (*fmt)++;
+            type = va_arg(*vl, HPy);
+        }
         HPy *output = va_arg(*vl, HPy *);
         _BREAK_IF_OPTIONAL(current_arg);
+        if (!HPy_IsNull(type) && !HPy_TypeCheck(ctx, current_arg, type)) {
+            set_error(ctx, ctx->h_TypeError, err_fmt,
+                "argument has the wrong type");
+            return 0;
+        }
         if (current_arg_tmp) {
             *output = HPy_Dup(ctx, current_arg);
             HPyTracker_Add(ctx, *ht, *output);
@@ -361,6 +431,10 @@ parse_item(HPyContext *ctx, HPyTracker *ht, HPy current_arg, int current_arg_tmp
     }
 
     case 's': {
+        if (**fmt == '#') {
+            (*fmt)++;
+            return parse_pointer_and_size(ctx, current_arg, vl, err_fmt, 1);
+        }
         const char **output = va_arg(*vl, const char **);
         if (!HPyUnicode_Check(ctx, current_arg)) {
             set_error(ctx, ctx->h_TypeError, err_fmt, "a str is required");
@@ -388,6 +462,36 @@ parse_item(HPyContext *ctx, HPyTracker *ht, HPy current_arg, int current_arg_tmp
         break;
     }
 
+    case 'y': {
+        if (**fmt == '#') {
+            (*fmt)++;
+            return parse_pointer_and_size(ctx, current_arg, vl, err_fmt, 0);
+        }
+        if (**fmt != '*') {
+            set_error(ctx, ctx->h_SystemError, err_fmt, "unknown arg format code");
+            return 0;
+        }
+        (*fmt)++;
+        HPy_buffer *output = va_arg(*vl, HPy_buffer *);
+        _BREAK_IF_OPTIONAL(current_arg);
+        if (!HPyBytes_Check(ctx, current_arg)) {
+            set_error(ctx, ctx->h_TypeError, err_fmt, "a bytes object is required");
+            return 0;
+        }
+        output->buf = HPyBytes_AS_STRING(ctx, current_arg);
+        output->obj = HPy_NULL;
+        output->len = HPyBytes_GET_SIZE(ctx, current_arg);
+        output->itemsize = 1;
+        output->readonly = 1;
+        output->ndim = 1;
+        output->format = NULL;
+        output->shape = NULL;
+        output->strides = NULL;
+        output->suboffsets = NULL;
+        output->internal = NULL;
+        break;
+    }
+
     default: {
         set_error(ctx, ctx->h_SystemError, err_fmt, "unknown arg format code");
         return 0;
@@ -521,75 +625,15 @@ HPyArg_Parse(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nargs, cons
 }
 
 
-/**
- * Parse positional and keyword arguments.
- *
- * :param ctx:
- *     The execution context.
- * :param ht:
- *     An optional pointer to an HPyTracker. If the format string never
- *     results in new handles being created, `ht` may be `NULL`. Currently
- *     only the `O` formatting option to this function requires an HPyTracker.
- * :param args:
- *     The array of positional arguments to parse.
- * :param nargs:
- *     The number of elements in args.
- * :param kw:
- *     A handle to the dictionary of keyword arguments.
- * :param fmt:
- *     The format string to use to parse the arguments.
- * :param keywords:
- *     An `NULL` terminated array of argument names. The number of names
- *     should match the format string provided. Positional only arguments
- *     should have the name `""` (i.e. the null-terminated empty string).
- *     Positional only arguments must preceded all other arguments.
- * :param ...:
- *     A va_list of references to variables in which to store the parsed
- *     arguments. The number and types of the arguments should match the
- *     the format strint, `fmt`.
- *
- * :returns: 0 on failure, 1 on success.
- *
- * If a `NULL` pointer is passed to `ht` and an `HPyTracker` is required by
- * the format string, an exception will be raised.
- *
- * If a pointer is provided to `ht`, the `HPyTracker` will always be created
- * and must be closed with `HPyTracker_Close` if parsing succeeds (after all
- * handles returned are no longer needed). If parsing fails, this function
- * will close the `HPyTracker` automatically.
- *
- * Examples:
- *
- * Using `HPyArg_ParseKeywords` without an `HPyTracker`:
- *
- * .. code-block:: c
- *
- *     long a, b;
- *     if (!HPyArg_ParseKeywords(ctx, NULL, args, nargs, kw, "ll", &a, &b))
- *         return HPy_NULL;
- *     ...
- *
- * Using `HPyArg_ParseKeywords` with an `HPyTracker`:
- *
- * .. code-block:: c
- *
- *     HPy a, b;
- *     HPyTracker ht;
- *     if (!HPyArg_ParseKeywords(ctx, &ht, args, nargs, kw, "OO", &a, &b))
- *         return HPy_NULL;
- *     ...
- *     HPyTracker_Close(ctx, ht);
- *     ...
- *
- * .. note::
- *
- *     Currently `HPyArg_ParseKeywords` only requires the use of an `HPyTracker`
- *     when the `O` format is used. In future other new format string codes
- *     (e.g. for character strings) may also require it.
- */
-HPyAPI_HELPER int
-HPyArg_ParseKeywords(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nargs, HPy kw,
-                     const char *fmt, const char *keywords[], ...)
+/* Common implementation of HPyArg_ParseKeywords and
+   HPyArg_ParseKeywordsArray. In the first case, the keyword arguments are
+   looked up in the dict 'kw'. In the second case (array_mode), their names
+   are in 'kwnames_s' and their values follow the positional ones in 'args'.
+*/
+static int
+parse_keywords(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nargs, HPy kw,
+               const char **kwnames_s, HPy_ssize_t nkwargs, int array_mode,
+               const char *fmt, const char *keywords[], va_list *vl)
 {
     const char *fmt1 = fmt;
     const char *err_fmt = NULL;
@@ -599,6 +643,7 @@ HPyArg_ParseKeywords(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nar
     int keyword_only = 0;
     HPy_ssize_t i = 0;
     HPy_ssize_t nkw = 0;
+    HPy_ssize_t nkwargs_found = 0;
     HPy current_arg;
     int current_arg_needs_closing = 0;
 
@@ -625,9 +670,6 @@ HPyArg_ParseKeywords(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nar
         }
     }
 
-    va_list vl;
-    va_start(vl, keywords);
-
     while (fmt1 != fmt_end) {
         if (*fmt1 == '|') {
             optional = 1;
@@ -640,7 +682,7 @@ HPyArg_ParseKeywords(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nar
             fmt1++;
             continue;
         }
-        if (*fmt1 == 'O' && ht == NULL) {
+        if (*fmt1 == 'O' && ht == NULL && !array_mode) {
             set_error(ctx, ctx->h_SystemError, err_fmt,
                 "HPyArg_ParseKeywords cannot use the format character 'O' unless"
                 " an HPyTracker is provided. Please supply an HPyTracker.");
@@ -660,6 +702,15 @@ HPyArg_ParseKeywords(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nar
             }
             current_arg = args[i];
         }
+        else if (array_mode) {
+            for (HPy_ssize_t j = 0; j < nkwargs && *keywords[i]; j++) {
+                if (strcmp(kwnames_s[j], keywords[i]) == 0) {
+                    current_arg = args[nargs + j];
+                    nkwargs_found++;
+                    break;
+                }
+            }
+        }
         else if (!HPy_IsNull(kw) && *keywords[i]) {
             current_arg = HPy_GetItem_s(ctx, kw, keywords[i]);
             // Track the handle or lear any KeyError that was raised. If an
@@ -674,7 +725,7 @@ HPyArg_ParseKeywords(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nar
             }
         }
         if (!HPy_IsNull(current_arg) || optional) {
-            if (!parse_item(ctx, ht, current_arg, 1, &fmt1, &vl, err_fmt)) {
+            if (!parse_item(ctx, ht, current_arg, !array_mode, &fmt1, vl, err_fmt)) {
                 goto error;
             }
         }
@@ -694,12 +745,16 @@ HPyArg_ParseKeywords(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nar
             "mismatched args (too many keywords for fmt)");
         goto error;
     }
+    if (nkwargs_found != nkwargs) {
+        set_error(ctx, ctx->h_TypeError, err_fmt,
+            "got an unexpected keyword argument or an argument given "
+            "both by position and by name");
+        goto error;
+    }
 
-    va_end(vl);
     return 1;
 
     error:
-        va_end(vl);
         if (ht != NULL) {
             HPyTracker_Close(ctx, *ht);
         }
@@ -708,3 +763,169 @@ HPyArg_ParseKeywords(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nar
         }
         return 0;
 }
+
+
+/**
+ * Parse positional and keyword arguments.
+ *
+ * :param ctx:
+ *     The execution context.
+ * :param ht:
+ *     An optional pointer to an HPyTracker. If the format string never
+ *     results in new handles being created, `ht` may be `NULL`. Currently
+ *     only the `O` formatting option to this function requires an HPyTracker.
+ * :param args:
+ *     The array of positional arguments to parse.
+ * :param nargs:
+ *     The number of elements in args.
+ * :param kw:
+ *     A handle to the dictionary of keyword arguments.
+ * :param fmt:
+ *     The format string to use to parse the arguments.
+ * :param keywords:
+ *     An `NULL` terminated array of argument names. The number of names
+ *     should match the format string provided. Positional only arguments
+ *     should have the name `""` (i.e. the null-terminated empty string).
+ *     Positional only arguments must preceded all other arguments.
+ * :param ...:
+ *     A va_list of references to variables in which to store the parsed
+ *     arguments. The number and types of the arguments should match the
+ *     the format strint, `fmt`.
+ *
+ * :returns: 0 on failure, 1 on success.
+ *
+ * If a `NULL` pointer is passed to `ht` and an `HPyTracker` is required by
+ * the format string, an exception will be raised.
+ *
+ * If a pointer is provided to `ht`, the `HPyTracker` will always be created
+ * and must be closed with `HPyTracker_Close` if parsing succeeds (after all
+ * handles returned are no longer needed). If parsing fails, this function
+ * will close the `HPyTracker` automatically.
+ *
+ * Examples:
+ *
+ * Using `HPyArg_ParseKeywords` without an `HPyTracker`:
+ *
+ * .. code-block:: c
+ *
+ *     long a, b;
+ *     if (!HPyArg_ParseKeywords(ctx, NULL, args, nargs, kw, "ll", &a, &b))
+ *         return HPy_NULL;
+ *     ...
+ *
+ * Using `HPyArg_ParseKeywords` with an `HPyTracker`:
+ *
+ * .. code-block:: c
+ *
+ *     HPy a, b;
+ *     HPyTracker ht;
+ *     if (!HPyArg_ParseKeywords(ctx, &ht, args, nargs, kw, "OO", &a, &b))
+ *         return HPy_NULL;
+ *     ...
+ *     HPyTracker_Close(ctx, ht);
+ *     ...
+ *
+ * .. note::
+ *
+ *     Currently `HPyArg_ParseKeywords` only requires the use of an `HPyTracker`
+ *     when the `O` format is used. In future other new format string codes
+ *     (e.g. for character strings) may also require it.
+ */
+HPyAPI_HELPER int
+HPyArg_ParseKeywords(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nargs, HPy kw,
+                     const char *fmt, const char *keywords[], ...)
+{
+    va_list vl;
+    va_start(vl, keywords);
+    int res = parse_keywords(ctx, ht, args, nargs, kw, NULL, 0, 0,
+                             fmt, keywords, &vl);
+    va_end(vl);
+    return res;
+}
+
+
+/**
+ * Parse positional and keyword arguments, passed as in the vectorcall
+ * protocol.
+ *
+ * This is the same as `HPyArg_ParseKeywords`, except for how the keyword
+ * arguments are passed: ``args`` contains ``nargs`` positional arguments,
+ * followed by the values of the keyword arguments, whose names are in the
+ * tuple ``kwnames``. No dictionary needs to be created by the caller, and if
+ * ``kwnames`` is ``HPy_NULL`` or empty, no keyword lookup is done at all.
+ *
+ * The handles stored by the ``O`` format are the ones contained in ``args``,
+ * so they are valid for as long as ``args`` is and ``ht`` can be ``NULL``.
+ *
+ * Unlike `HPyArg_ParseKeywords`, a `TypeError` is raised if a keyword
+ * argument does not match any name in ``keywords``, or if an argument is
+ * given both by position and by name.
+ *
+ * Examples:
+ *
+ * .. code-block:: c
+ *
+ *     long a, b = 0;
+ *     static const char *kwlist[] = { "a", "b", NULL };
+ *     if (!HPyArg_ParseKeywordsArray(ctx, NULL, args, nargs, kwnames,
+ *                                    "l|l", kwlist, &a, &b))
+ *         return HPy_NULL;
+ *     ...
+ */
+HPyAPI_HELPER int
+HPyArg_ParseKeywordsArray(HPyContext *ctx, HPyTracker *ht, HPy *args, HPy_ssize_t nargs,
+                          HPy kwnames, const char *fmt, const char *keywords[], ...)
+{
+    HPy_ssize_t nkwargs = 0;
+    const char *kwnames_s_buf[_KWNAMES_STACK_SIZE];
+    HPy kwnames_h_buf[_KWNAMES_STACK_SIZE];
+    const char **kwnames_s = kwnames_s_buf;
+    HPy *kwnames_h = kwnames_h_buf;
+    HPy_ssize_t j;
+    int res = 0;
+
+    if (!HPy_IsNull(kwnames)) {
+        nkwargs = HPy_Length(ctx, kwnames);
+        if (nkwargs < 0)
+            return 0;
+    }
+    if (nkwargs > _KWNAMES_STACK_SIZE) {
+        kwnames_s = (const char **)malloc(nkwargs * sizeof(const char *));
+        kwnames_h = (HPy *)malloc(nkwargs * sizeof(HPy));
+        if (kwnames_s == NULL || kwnames_h == NULL) {
+            free(kwnames_s);
+            free(kwnames_h);
+            HPyErr_NoMemory(ctx);
+            return 0;
+        }
+    }
+    // we keep the handles to the names open while parsing: the UTF-8 data
+    // is guaranteed to be valid only as long as they are
+    for (j = 0; j < nkwargs; j++) {
+        HPy_ssize_t size;
+        kwnames_h[j] = HPy_GetItem_i(ctx, kwnames, j);
+        if (HPy_IsNull(kwnames_h[j]))
+            goto done;
+        kwnames_s[j] = HPyUnicode_AsUTF8AndSize(ctx, kwnames_h[j], &size);
+        if (kwnames_s[j] == NULL) {
+            j++;
+            goto done;
+        }
+    }
+
+    va_list vl;
+    va_start(vl, keywords);
+    res = parse_keywords(ctx, ht, args, nargs, HPy_NULL, kwnames_s, nkwargs, 1,
+                         fmt, keywords, &vl);
+    va_end(vl);
+
+ done:
+    // here, j is the number of handles which have been opened
+    while (j > 0)
+        HPy_Close(ctx, kwnames_h[--j]);
+    if (kwnames_s != kwnames_s_buf) {
+        free(kwnames_s);
+        free(kwnames_h);
+    }
+    return res;
+}
@@ -18,7 +18,8 @@
  *
  * HPy_BuildValue always returns a new handle that will be owned by the caller. Even
  * an artificial example 'HPy_BuildValue(ctx, "O", h)' does not simply forward
- * the value stored in 'h' but duplicates the handle.
+ * the value stored in 'h' but duplicates the handle. The only exception is
+ * the 'N' formatting unit, see below.
  *
  * Supported Formatting Strings
  * ----------------------------
@@ -77,6 +78,29 @@
  * ``S (Python object) [HPy]``
  *      Alias for 'O'.
  *
+ * ``N (Python object) [HPy]``
+ *      Same as 'O', but the ownership of the handle is transferred to
+ *      HPy_BuildValue: the caller must not use nor close it afterwards. This
+ *      is convenient for objects which are created only to be stored in the
+ *      result, e.g. 'HPy_BuildValue(ctx, "(NN)", HPyLong_FromLong(ctx, 1),
+ *      HPyLong_FromLong(ctx, 2))', and it saves a duplicate and a close per
+ *      item.
+ *
+ *      The handle is consumed also if HPy_BuildValue fails, including the
+ *      handles passed for 'N' units after the point of the failure. If an
+ *      'N' handle is HPy_NULL, it behaves as described for 'O'.
+ *
+ * Building into existing containers
+ * ---------------------------------
+ *
+ * ``HPyTupleBuilder_BuildValue``, ``HPyListBuilder_BuildValue`` and
+ * ``HPyList_AppendBuildValue`` use the same format strings, but instead of
+ * returning a new object, they store the value described by each top-level
+ * format unit into a caller-supplied container: e.g. the format ``"isO"``
+ * produces three items. This makes it possible to fill a large preallocated
+ * tuple or list incrementally, without building and copying an intermediate
+ * tuple for every chunk of values.
+ *
  * API
  * ---
  *
@@ -88,10 +112,19 @@
 
 #define MESSAGE_BUF_SIZE 128
 
+/* Stores 'item' at position 'index' of some container. If 'steal' is true,
+   the ownership of 'item' is transferred to the container, also in case of
+   error; otherwise, 'item' is borrowed. Returns -1 in case of error. */
+typedef int (*set_item_func)(HPyContext *ctx, void *target, HPy_ssize_t index,
+                             HPy item, int steal);
+
 static HPy_ssize_t count_items(HPyContext *ctx, const char *fmt, char end);
 static HPy build_tuple(HPyContext *ctx, const char **fmt, va_list *values, HPy_ssize_t size, char expected_end);
 static HPy build_list(HPyContext *ctx, const char **fmt, va_list *values, HPy_ssize_t size);
 static HPy build_single(HPyContext *ctx, const char **fmt, va_list *values, int *needs_close);
+static int build_items(HPyContext *ctx, const char **fmt, va_list *values, HPy_ssize_t size,
+                       set_item_func set_item, void *target, HPy_ssize_t offset);
+static void close_remaining_N(HPyContext *ctx, const char *fmt, va_list *values);
 
 HPyAPI_HELPER
 HPy HPy_BuildValue(HPyContext *ctx, const char *fmt, ...)
@@ -99,6 +132,24 @@ HPy HPy_BuildValue(HPyContext *ctx, const char *fmt, ...)
     va_list values;
     HPy result;
     va_start(values, fmt);
+    result = HPy_BuildValueV(ctx, fmt, values);
+    va_end(values);
+    return result;
+}
+
+/**
+ * Same as ``HPy_BuildValue`` but takes a ``va_list`` instead of a variable
+ * number of arguments. This is useful to write wrapper functions which take
+ * a format string and variadic arguments themselves.
+ */
+HPyAPI_HELPER
+HPy HPy_BuildValueV(HPyContext *ctx, const char *fmt, va_list vl)
+{
+    va_list values;
+    HPy result;
+    /* we cannot take the address of 'vl' portably: on some platforms
+       va_list is an array type and the parameter is actually a pointer */
+    va_copy(values, vl);
     HPy_ssize_t size = count_items(ctx, fmt, '\0');
     if (size < 0) {
         result = HPy_NULL;
@@ -113,6 +164,105 @@ HPy HPy_BuildValue(HPyContext *ctx, const char *fmt, ...)
     } else {
         result = build_tuple(ctx, &fmt, &values, size, '\0');
     }
+    if (HPy_IsNull(result)) {
+        close_remaining_N(ctx, fmt, &values);
+    }
+    va_end(values);
+    return result;
+}
+
+static int set_tuplebuilder_item(HPyContext *ctx, void *target, HPy_ssize_t index,
+                                 HPy item, int steal)
+{
+    if (steal) {
+        HPyTupleBuilder_SetSteal(ctx, *(HPyTupleBuilder *)target, index, item);
+    } else {
+        HPyTupleBuilder_Set(ctx, *(HPyTupleBuilder *)target, index, item);
+    }
+    return 0;
+}
+
+static int set_listbuilder_item(HPyContext *ctx, void *target, HPy_ssize_t index,
+                                HPy item, int steal)
+{
+    if (steal) {
+        HPyListBuilder_SetSteal(ctx, *(HPyListBuilder *)target, index, item);
+    } else {
+        HPyListBuilder_Set(ctx, *(HPyListBuilder *)target, index, item);
+    }
+    return 0;
+}
+
+static int append_list_item(HPyContext *ctx, void *target, HPy_ssize_t index,
+                            HPy item, int steal)
+{
+    if (steal) {
+        return HPyList_AppendSteal(ctx, *(HPy *)target, item);
+    }
+    return HPyList_Append(ctx, *(HPy *)target, item);
+}
+
+static HPy_ssize_t build_into(HPyContext *ctx, const char *fmt, va_list *values,
+                              set_item_func set_item, void *target, HPy_ssize_t offset)
+{
+    HPy_ssize_t size = count_items(ctx, fmt, '\0');
+    if (size < 0 ||
+        build_items(ctx, &fmt, values, size, set_item, target, offset) < 0) {
+        close_remaining_N(ctx, fmt, values);
+        return -1;
+    }
+    return size;
+}
+
+/**
+ * Build one item for every top-level format unit of ``fmt`` and store them in
+ * ``builder`` at the indexes ``offset``, ``offset + 1``, and so on.
+ *
+ * :returns: the number of items stored, or -1 in case of error. In case of
+ *     error, some items might have already been stored; the builder is not
+ *     cancelled, that is left to the caller.
+ */
+HPyAPI_HELPER
+HPy_ssize_t HPyTupleBuilder_BuildValue(HPyContext *ctx, HPyTupleBuilder builder,
+                                       HPy_ssize_t offset, const char *fmt, ...)
+{
+    va_list values;
+    va_start(values, fmt);
+    HPy_ssize_t result = build_into(ctx, fmt, &values, set_tuplebuilder_item,
+                                    &builder, offset);
+    va_end(values);
+    return result;
+}
+
+/**
+ * Same as ``HPyTupleBuilder_BuildValue``, but for a ``HPyListBuilder``.
+ */
+HPyAPI_HELPER
+HPy_ssize_t HPyListBuilder_BuildValue(HPyContext *ctx, HPyListBuilder builder,
+                                      HPy_ssize_t offset, const char *fmt, ...)
+{
+    va_list values;
+    va_start(values, fmt);
+    HPy_ssize_t result = build_into(ctx, fmt, &values, set_listbuilder_item,
+                                    &builder, offset);
+    va_end(values);
+    return result;
+}
+
+/**
+ * Build one item for every top-level format unit of ``fmt`` and append them
+ * to the existing list ``h_list``.
+ *
+ * :returns: the number of items appended, or -1 in case of error. In case of
+ *     error, some items might have already been appended.
+ */
+HPyAPI_HELPER
+HPy_ssize_t HPyList_AppendBuildValue(HPyContext *ctx, HPy h_list, const char *fmt, ...)
+{
+    va_list values;
+    va_start(values, fmt);
+    HPy_ssize_t result = build_into(ctx, fmt, &values, append_list_item,
+                                    &h_list, 0);
     va_end(values);
     return result;
 }
@@ -229,14 +379,12 @@ static HPy build_single(HPyContext *ctx, const char **fmt, va_list *values, int
         }
 
         case 'N': {
-            HPyErr_SetString(ctx, ctx->h_SystemError,
-                             "HPy_BuildValue does not support the 'N' formatting unit. "
-                             "Instead, use the 'O' formatting unit and manually close "
-                             "the handle in the caller if necessary. HPy API functions "
-                             "never 'steal' handles and always make a duplicate handle if "
-                             "needed, the 'ownership' of the original handle is never "
-                             "'transferred'. ");
-            return HPy_NULL;
+            HPy handle = va_arg(*values, HPy);
+            if (HPy_IsNull(handle) && !HPyErr_Occurred(ctx)) {
+                HPyErr_SetString(ctx, ctx->h_SystemError, "HPy_NULL object passed to HPy_BuildValue");
+            }
+            // the ownership is transferred to us: *needs_close stays 1
+            return handle;
         }
 
         case 'f': // Note: floats are promoted to doubles when passed in "..."
@@ -252,21 +400,30 @@ static HPy build_single(HPyContext *ctx, const char **fmt, va_list *values, int
     } // switch
 }
 
-static HPy build_list(HPyContext *ctx, const char **fmt, va_list *values, HPy_ssize_t size)
+static int build_items(HPyContext *ctx, const char **fmt, va_list *values, HPy_ssize_t size,
+                       set_item_func set_item, void *target, HPy_ssize_t offset)
 {
-    HPyListBuilder builder = HPyListBuilder_New(ctx, size);
     for (HPy_ssize_t i = 0; i < size; ++i) {
         int needs_close;
         HPy item = build_single(ctx, fmt, values, &needs_close);
         if (HPy_IsNull(item)) {
-            HPyListBuilder_Cancel(ctx, builder);
-            return HPy_NULL;
+            return -1;
         }
-        HPyListBuilder_Set(ctx, builder, i, item);
-        if (needs_close) {
-            HPy_Close(ctx, item);
+        // items which we own are moved into the container
+        if (set_item(ctx, target, offset + i, item, needs_close) < 0) {
+            return -1;
         }
     }
+    return 0;
+}
+
+static HPy build_list(HPyContext *ctx, const char **fmt, va_list *values, HPy_ssize_t size)
+{
+    HPyListBuilder builder = HPyListBuilder_New(ctx, size);
+    if (build_items(ctx, fmt, values, size, set_listbuilder_item, &builder, 0) < 0) {
+        HPyListBuilder_Cancel(ctx, builder);
+        return HPy_NULL;
+    }
     if (**fmt != ']') {
         // count_items does not check the type of the matching paren, that's what we do here
         HPyListBuilder_Cancel(ctx, builder);
@@ -281,17 +438,9 @@ static HPy build_list(HPyContext *ctx, const char **fmt, va_list *values, HPy_ss
 static HPy build_tuple(HPyContext *ctx, const char **fmt, va_list *values, HPy_ssize_t size, char expected_end)
 {
     HPyTupleBuilder builder = HPyTupleBuilder_New(ctx, size);
-    for (HPy_ssize_t i = 0; i < size; ++i) {
-        int needs_close;
-        HPy item = build_single(ctx, fmt, values, &needs_close);
-        if (HPy_IsNull(item)) {
-            HPyTupleBuilder_Cancel(ctx, builder);
-            return HPy_NULL;
-        }
-        HPyTupleBuilder_Set(ctx, builder, i, item);
-        if (needs_close) {
-            HPy_Close(ctx, item);
-        }
+    if (build_items(ctx, fmt, values, size, set_tuplebuilder_item, &builder, 0) < 0) {
+        HPyTupleBuilder_Cancel(ctx, builder);
+        return HPy_NULL;
     }
     if (**fmt != expected_end) {
         // count_items does not check the type of the matching paren, that's what we do here
@@ -310,3 +459,42 @@ static HPy build_tuple(HPyContext *ctx, const char **fmt, va_list *values, HPy_s
     }
     return HPyTupleBuilder_Build(ctx, builder);
 }
+
+/* Called after a failure: consume the remaining arguments and close the
+   handles passed for 'N', since their ownership was transferred to us. The
+   arguments of the item which failed have already been consumed. We stop at
+   the first unknown format char, since we cannot know how many arguments
+   follow it.
+*/
+static void close_remaining_N(HPyContext *ctx, const char *fmt, va_list *values)
+{
+    for (; *fmt != '\0'; fmt++) {
+        switch (*fmt) {
+            case '(': case ')': case '[': case ']': case ' ':
+                break;
+            case 'i': case 'I':
+                (void)va_arg(*values, int);
+                break;
+            case 'k': case 'l':
+                (void)va_arg(*values, long);
+                break;
+            case 'L': case 'K':
+                (void)va_arg(*values, long long);
+                break;
+            case 's':
+                (void)va_arg(*values, const char *);
+                break;
+            case 'f': case 'd':
+                (void)va_arg(*values, double);
+                break;
+            case 'O': case 'S':
+                (void)va_arg(*values, HPy);
+                break;
+            case 'N':
+                HPy_Close(ctx, va_arg(*values, HPy));
+                break;
+            default:
+                return;
+        }
+    }
+}
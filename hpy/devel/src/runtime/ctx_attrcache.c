@@ -0,0 +1,228 @@
+#include <Python.h>
+#include "hpy.h"
+
+#ifdef HPY_UNIVERSAL_ABI
+   // for _h2py and _py2h
+#  include "handles.h"
+#endif
+
+/* The possible values of HPyAttrCache._kind. Every kind except
+   ATTRCACHE_GENERIC is valid only as long as the version tag of the type
+   does not change. */
+#define ATTRCACHE_EMPTY    0    /* never filled */
+#define ATTRCACHE_GENERIC  1    /* use PyObject_GetAttr */
+#define ATTRCACHE_DATA     2    /* a data descriptor: call its tp_descr_get */
+#define ATTRCACHE_METHOD   3    /* a method descriptor, e.g. a function */
+#define ATTRCACHE_PLAIN    4    /* any other class attribute */
+
+/* Method calls with up to this number of arguments don't allocate */
+#define ATTRCACHE_SMALL_ARGS 8
+
+static unsigned int
+type_version(PyTypeObject *tp)
+{
+#if PY_VERSION_HEX < 0x030C0000
+    // before 3.12, a version tag is invalidated by clearing the flag
+    if (!PyType_HasFeature(tp, Py_TPFLAGS_VALID_VERSION_TAG))
+        return 0;
+#endif
+    return tp->tp_version_tag;
+}
+
+/* Classify the attribute which the type-level lookup finds, following the
+   logic of PyObject_GenericGetAttr. */
+static int
+attrcache_classify(PyTypeObject *tp, PyObject *descr)
+{
+    if (tp->tp_getattro != PyObject_GenericGetAttr || descr == NULL)
+        return ATTRCACHE_GENERIC;
+    PyTypeObject *descr_tp = Py_TYPE(descr);
+    if (descr_tp->tp_descr_get != NULL && descr_tp->tp_descr_set != NULL)
+        return ATTRCACHE_DATA;
+#ifdef Py_TPFLAGS_MANAGED_DICT
+    // we cannot look into a managed __dict__ without materializing it
+    if (PyType_HasFeature(tp, Py_TPFLAGS_MANAGED_DICT))
+        return ATTRCACHE_GENERIC;
+#endif
+#ifdef Py_TPFLAGS_METHOD_DESCRIPTOR
+    if (PyType_HasFeature(descr_tp, Py_TPFLAGS_METHOD_DESCRIPTOR))
+        return ATTRCACHE_METHOD;
+#endif
+    return ATTRCACHE_PLAIN;
+}
+
+/* Make sure that the cache is up to date for the given type, and return its
+   kind, or -1 in case of error. */
+static int
+attrcache_refresh(PyTypeObject *tp, HPyAttrCache *cache)
+{
+    if (cache->_name_obj == NULL) {
+        // the name is interned, so even if two threads race here they
+        // store the same object, and it is never released
+        PyObject *name = PyUnicode_InternFromString(cache->name);
+        if (name == NULL)
+            return -1;
+        cache->_name_obj = name;
+    }
+#ifdef Py_GIL_DISABLED
+    // the other fields cannot be updated atomically: do a full lookup
+    (void)tp;
+    return ATTRCACHE_GENERIC;
+#else
+    if (cache->_type == (void *)tp && cache->_version != 0 &&
+            cache->_version == type_version(tp))
+        return cache->_kind;
+
+    // _PyType_Lookup assigns a version tag to the type if it doesn't have
+    // one, so we must read it afterwards. The descriptor is borrowed: the
+    // type keeps it alive as long as the version tag does not change.
+    PyObject *descr = _PyType_Lookup(tp, (PyObject *)cache->_name_obj);
+    int kind = attrcache_classify(tp, descr);
+    unsigned int version = type_version(tp);
+    if (version == 0)
+        kind = ATTRCACHE_GENERIC;
+    cache->_type = tp;
+    cache->_version = version;
+    cache->_descr = descr;
+    cache->_kind = kind;
+    return kind;
+#endif
+}
+
+/* Return a new reference to the attribute, for any kind except
+   ATTRCACHE_GENERIC. If p_self is not NULL and the attribute is a method,
+   return the unbound method and store obj in *p_self instead of creating a
+   bound method. */
+static PyObject *
+attrcache_get(PyObject *obj, HPyAttrCache *cache, int kind, PyObject **p_self)
+{
+    PyObject *descr = (PyObject *)cache->_descr;
+    PyObject *type = (PyObject *)Py_TYPE(obj);
+    descrgetfunc f = Py_TYPE(descr)->tp_descr_get;
+    PyObject *res;
+
+    if (kind == ATTRCACHE_DATA) {
+        Py_INCREF(descr);
+        res = f(descr, obj, type);
+        Py_DECREF(descr);
+        return res;
+    }
+
+    // non-data descriptors and plain class attributes are shadowed by the
+    // instance __dict__
+    if (Py_TYPE(obj)->tp_dictoffset != 0) {
+        PyObject **dictptr = _PyObject_GetDictPtr(obj);
+        if (dictptr != NULL && *dictptr != NULL) {
+            PyObject *dict = *dictptr;
+            Py_INCREF(dict);
+            res = PyDict_GetItemWithError(dict, (PyObject *)cache->_name_obj);
+            Py_XINCREF(res);
+            Py_DECREF(dict);
+            if (res != NULL || PyErr_Occurred())
+                return res;
+        }
+    }
+
+    if (kind == ATTRCACHE_METHOD && p_self != NULL) {
+        *p_self = obj;
+        Py_INCREF(descr);
+        return descr;
+    }
+    if (f != NULL) {
+        Py_INCREF(descr);
+        res = f(descr, obj, type);
+        Py_DECREF(descr);
+        return res;
+    }
+    Py_INCREF(descr);
+    return descr;
+}
+
+_HPy_HIDDEN HPy
+ctx_GetAttrCached(HPyContext *ctx, HPy h_obj, HPyAttrCache *cache)
+{
+    PyObject *obj = _h2py(h_obj);
+    int kind = attrcache_refresh(Py_TYPE(obj), cache);
+    if (kind < 0)
+        return HPy_NULL;
+    if (kind == ATTRCACHE_GENERIC)
+        return _py2h(PyObject_GetAttr(obj, (PyObject *)cache->_name_obj));
+    return _py2h(attrcache_get(obj, cache, kind, NULL));
+}
+
+/* Call 'callable' with the arguments 'self' (if not NULL) and 'args'. If
+   'name' is not NULL, call the method 'name' of 'self' instead. */
+static PyObject *
+attrcache_call(PyObject *callable, PyObject *name, PyObject *self,
+               HPy *args, HPy_ssize_t nargs)
+{
+    PyObject *small_stack[ATTRCACHE_SMALL_ARGS + 2];
+    PyObject **stack = small_stack;
+    if (nargs > ATTRCACHE_SMALL_ARGS) {
+        stack = (PyObject **)PyMem_Malloc((nargs + 2) * sizeof(PyObject *));
+        if (stack == NULL)
+            return PyErr_NoMemory();
+    }
+    // stack[0] is left free, so that we can pass
+    // PY_VECTORCALL_ARGUMENTS_OFFSET
+    PyObject **argv = stack + 1;
+    Py_ssize_t n = 0;
+    if (self != NULL)
+        argv[n++] = self;
+    for (HPy_ssize_t i = 0; i < nargs; i++)
+        argv[n++] = _h2py(args[i]);
+
+    PyObject *res;
+#if PY_VERSION_HEX >= 0x03090000
+    size_t nargsf = (size_t)n | PY_VECTORCALL_ARGUMENTS_OFFSET;
+    if (name != NULL)
+        res = PyObject_VectorcallMethod(name, argv, nargsf, NULL);
+    else
+        res = PyObject_Vectorcall(callable, argv, nargsf, NULL);
+#else
+    PyObject *tuple = NULL;
+    res = NULL;
+    if (name != NULL) {
+        callable = PyObject_GetAttr(self, name);
+        argv++;
+        n--;
+    }
+    else {
+        Py_XINCREF(callable);
+    }
+    if (callable != NULL)
+        tuple = PyTuple_New(n);
+    if (tuple != NULL) {
+        for (Py_ssize_t i = 0; i < n; i++) {
+            Py_INCREF(argv[i]);
+            PyTuple_SET_ITEM(tuple, i, argv[i]);
+        }
+        res = PyObject_Call(callable, tuple, NULL);
+        Py_DECREF(tuple);
+    }
+    Py_XDECREF(callable);
+#endif
+    if (stack != small_stack)
+        PyMem_Free(stack);
+    return res;
+}
+
+_HPy_HIDDEN HPy
+ctx_CallMethodCached(HPyContext *ctx, HPy h_obj, HPyAttrCache *cache,
+                     HPy *args, HPy_ssize_t nargs)
+{
+    PyObject *obj = _h2py(h_obj);
+    int kind = attrcache_refresh(Py_TYPE(obj), cache);
+    if (kind < 0)
+        return HPy_NULL;
+    if (kind == ATTRCACHE_GENERIC)
+        return _py2h(attrcache_call(NULL, (PyObject *)cache->_name_obj, obj,
+                                    args, nargs));
+    PyObject *self = NULL;
+    PyObject *callable = attrcache_get(obj, cache, kind, &self);
+    if (callable == NULL)
+        return HPy_NULL;
+    PyObject *res = attrcache_call(callable, NULL, self, args, nargs);
+    Py_DECREF(callable);
+    return _py2h(res);
+}
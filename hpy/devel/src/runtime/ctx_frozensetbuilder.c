@@ -0,0 +1,57 @@
+#include <Python.h>
+#include "hpy.h"
+
+#ifdef HPY_UNIVERSAL_ABI
+   // for _h2py and _py2h
+#  include "handles.h"
+#endif
+
+
+/* The builder owns the only reference to a brand new frozenset, which
+   PySet_Add allows to fill in before it is exposed to other code. */
+_HPy_HIDDEN HPyFrozenSetBuilder
+ctx_FrozenSetBuilder_New(HPyContext *ctx, HPy_ssize_t size_hint)
+{
+    (void)size_hint;
+    PyObject *set = PyFrozenSet_New(NULL);
+    if (set == NULL)
+        PyErr_Clear();   /* delay the MemoryError */
+    return (HPyFrozenSetBuilder){(intptr_t)set};
+}
+
+_HPy_HIDDEN int
+ctx_FrozenSetBuilder_Add(HPyContext *ctx, HPyFrozenSetBuilder builder,
+                         HPy h_item)
+{
+    PyObject *set = (PyObject *)builder._set;
+    if (set == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    assert(Py_REFCNT(set) == 1);
+    return PySet_Add(set, _h2py(h_item));
+}
+
+_HPy_HIDDEN HPy
+ctx_FrozenSetBuilder_Build(HPyContext *ctx, HPyFrozenSetBuilder builder)
+{
+    PyObject *set = (PyObject *)builder._set;
+    if (set == NULL) {
+        PyErr_NoMemory();
+        return HPy_NULL;
+    }
+    builder._set = 0;
+    return _py2h(set);
+}
+
+_HPy_HIDDEN void
+ctx_FrozenSetBuilder_Cancel(HPyContext *ctx, HPyFrozenSetBuilder builder)
+{
+    PyObject *set = (PyObject *)builder._set;
+    if (set == NULL) {
+        // as for HPyListBuilder_Cancel, the memory error is not reported
+        return;
+    }
+    builder._set = 0;
+    Py_DECREF(set);
+}
@@ -0,0 +1,18 @@
+#include <Python.h>
+#include "hpy.h"
+
+#ifdef HPY_UNIVERSAL_ABI
+   // for _h2py and _py2h
+#  include "handles.h"
+#endif
+
+
+/* Like HPyList_Append, but h_item is consumed, also in case of error */
+_HPy_HIDDEN int
+ctx_List_AppendSteal(HPyContext *ctx, HPy h_list, HPy h_item)
+{
+    PyObject *item = _h2py_steal(h_item);
+    int res = PyList_Append(_h2py(h_list), item);
+    Py_DECREF(item);
+    return res;
+}
@@ -31,6 +31,24 @@ ctx_ListBuilder_Set(HPyContext *ctx, HPyListBuilder builder,
     }
 }
 
+/* Like ctx_ListBuilder_Set, but h_item is consumed, also if the builder
+   is in the failed state */
+_HPy_HIDDEN void
+ctx_ListBuilder_SetSteal(HPyContext *ctx, HPyListBuilder builder,
+                         HPy_ssize_t index, HPy h_item)
+{
+    PyObject *lst = (PyObject *)builder._lst;
+    PyObject *item = _h2py_steal(h_item);
+    if (lst != NULL) {
+        assert(index >= 0 && index < PyList_GET_SIZE(lst));
+        assert(PyList_GET_ITEM(lst, index) == NULL);
+        PyList_SET_ITEM(lst, index, item);
+    }
+    else {
+        Py_DECREF(item);
+    }
+}
+
 _HPy_HIDDEN HPy
 ctx_ListBuilder_Build(HPyContext *ctx, HPyListBuilder builder)
 {
@@ -0,0 +1,252 @@
+/**
+ * Memory allocation.
+ *
+ * ``HPyMem_Malloc``, ``HPyMem_Calloc``, ``HPyMem_Realloc`` and
+ * ``HPyMem_Free`` allocate memory with the allocator of the implementation,
+ * which on CPython is the one of ``PyMem_Malloc``: it is usually much faster
+ * than ``malloc`` for small blocks. Contrarily to ``PyMem_Malloc``, they
+ * raise ``MemoryError`` when they fail.
+ *
+ * ``HPyMem_ScratchAlloc`` allocates memory from a per-thread arena. This
+ * memory is released in bulk when the call into the extension during which
+ * it was allocated returns, so it must not be freed and it must not be used
+ * after returning. The arena is reused by the following calls, so that
+ * small temporary buffers never hit the system allocator; every thread also
+ * keeps one spare chunk, so that the calls which need a few more KB do not
+ * hit it either:
+ *
+ * .. code-block:: c
+ *
+ *     HPyDef_METH(tokenize, "tokenize", tokenize_impl, HPyFunc_O)
+ *     static HPy tokenize_impl(HPyContext *ctx, HPy self, HPy arg)
+ *     {
+ *         HPy_ssize_t size;
+ *         const char *s = HPyUnicode_AsUTF8AndSize(ctx, arg, &size);
+ *         if (s == NULL)
+ *             return HPy_NULL;
+ *         // no need to free it, even on the error paths
+ *         Token *tokens = HPyMem_ScratchAlloc(ctx, size * sizeof(Token));
+ *         if (tokens == NULL)
+ *             return HPy_NULL;
+ *         ...
+ *     }
+ *
+ * Memory API
+ * ----------
+ *
+ */
+
+#include <Python.h>
+#include "hpy.h"
+#include "hpy/runtime/ctx_funcs.h"
+
+#ifdef _MSC_VER
+#  define SCRATCH_THREAD_LOCAL __declspec(thread)
+#else
+#  define SCRATCH_THREAD_LOCAL __thread
+#endif
+
+/* All the scratch allocations are aligned to this */
+#define SCRATCH_ALIGN 16
+/* The first block of every thread is not allocated on the heap */
+#define SCRATCH_INLINE_SIZE 4096
+/* The minimum size of the blocks allocated on the heap */
+#define SCRATCH_CHUNK_SIZE 32768
+
+#define SCRATCH_ROUND_UP(n) (((n) + (SCRATCH_ALIGN - 1)) & ~(size_t)(SCRATCH_ALIGN - 1))
+
+typedef struct _scratch_chunk_s {
+    struct _scratch_chunk_s *prev;
+    char *end;
+    /* the data starts at SCRATCH_CHUNK_HEADER bytes from the start */
+} scratch_chunk;
+
+#define SCRATCH_CHUNK_HEADER SCRATCH_ROUND_UP(sizeof(scratch_chunk))
+
+/* The arena of the current thread: the free space is between ptr and end
+   of the current chunk, or of the inline block if chunk is NULL. ptr is NULL
+   until the first allocation.
+
+   The first chunk of SCRATCH_CHUNK_SIZE bytes which the thread allocates is
+   not freed when it is released, but kept as the spare: it is owned by a
+   capsule in the dict of the thread state, which frees it when the thread
+   exits. spare_in_use is set while it is one of the chunks of the arena. */
+typedef struct {
+    char *ptr;
+    char *end;
+    scratch_chunk *chunk;
+    scratch_chunk *spare;
+    int spare_in_use;
+} scratch_arena;
+
+static SCRATCH_THREAD_LOCAL scratch_arena arena;
+static SCRATCH_THREAD_LOCAL union {
+    char data[SCRATCH_INLINE_SIZE];
+    // never accessed: it is there only to align data
+    long double _m_align;
+} arena_inline;
+
+_HPy_HIDDEN int _hpy_scratch_used = 0;
+
+#define SCRATCH_SPARE_NAME "hpy.scratch_spare"
+
+static void
+scratch_spare_destructor(PyObject *capsule)
+{
+    scratch_chunk *chunk = (scratch_chunk *)PyCapsule_GetPointer(
+                                                capsule, SCRATCH_SPARE_NAME);
+    if (chunk == NULL) {
+        PyErr_Clear();
+        return;
+    }
+    // the thread state of a daemon thread is cleared by another thread,
+    // whose spare is different
+    if (arena.spare == chunk) {
+        arena.spare = NULL;
+        arena.spare_in_use = 0;
+    }
+    PyMem_Free(chunk);
+}
+
+/* Try to make chunk the spare of the current thread. In the CPython ABI
+   every extension has its own arena, so the key of the capsule is made
+   unique by the address of the arena. */
+static void
+scratch_keep_spare(scratch_chunk *chunk)
+{
+    PyObject *exc_type, *exc_value, *exc_tb;
+    PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+    PyObject *dict = PyThreadState_GetDict();
+    PyObject *key = NULL, *capsule = NULL;
+    if (dict == NULL)
+        goto exit;
+    key = PyUnicode_FromFormat(SCRATCH_SPARE_NAME ".%p", (void *)&arena);
+    if (key == NULL)
+        goto exit;
+    capsule = PyCapsule_New(chunk, SCRATCH_SPARE_NAME, scratch_spare_destructor);
+    if (capsule == NULL)
+        goto exit;
+    if (PyDict_SetItem(dict, key, capsule) < 0) {
+        // don't let the destructor free chunk, which is still in use
+        PyCapsule_SetDestructor(capsule, NULL);
+        goto exit;
+    }
+    arena.spare = chunk;
+    arena.spare_in_use = 1;
+ exit:
+    Py_XDECREF(capsule);
+    Py_XDECREF(key);
+    // if the chunk cannot be kept, it is an ordinary chunk
+    PyErr_Clear();
+    PyErr_Restore(exc_type, exc_value, exc_tb);
+}
+
+_HPy_HIDDEN void *
+ctx_Mem_Malloc(HPyContext *ctx, size_t size)
+{
+    void *res = PyMem_Malloc(size);
+    if (res == NULL)
+        PyErr_NoMemory();
+    return res;
+}
+
+_HPy_HIDDEN void *
+ctx_Mem_Calloc(HPyContext *ctx, size_t nelem, size_t elsize)
+{
+    void *res = PyMem_Calloc(nelem, elsize);
+    if (res == NULL)
+        PyErr_NoMemory();
+    return res;
+}
+
+_HPy_HIDDEN void *
+ctx_Mem_Realloc(HPyContext *ctx, void *ptr, size_t size)
+{
+    void *res = PyMem_Realloc(ptr, size);
+    if (res == NULL)
+        PyErr_NoMemory();
+    return res;
+}
+
+_HPy_HIDDEN void
+ctx_Mem_Free(HPyContext *ctx, void *ptr)
+{
+    PyMem_Free(ptr);
+}
+
+_HPy_HIDDEN void *
+ctx_Mem_ScratchAlloc(HPyContext *ctx, size_t size)
+{
+    if (size > (size_t)PY_SSIZE_T_MAX - SCRATCH_CHUNK_SIZE) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    // never return the same pointer twice, even for size == 0
+    size = size == 0 ? SCRATCH_ALIGN : SCRATCH_ROUND_UP(size);
+    _hpy_scratch_used = 1;
+    if (arena.ptr == NULL) {
+        arena.ptr = arena_inline.data;
+        arena.end = arena_inline.data + SCRATCH_INLINE_SIZE;
+    }
+    if ((size_t)(arena.end - arena.ptr) < size) {
+        // the rest of the current block is wasted until it is released
+        size_t chunk_size = SCRATCH_CHUNK_HEADER + size;
+        if (chunk_size < SCRATCH_CHUNK_SIZE)
+            chunk_size = SCRATCH_CHUNK_SIZE;
+        scratch_chunk *chunk;
+        if (chunk_size == SCRATCH_CHUNK_SIZE && arena.spare != NULL &&
+                !arena.spare_in_use) {
+            chunk = arena.spare;
+            arena.spare_in_use = 1;
+        }
+        else {
+            chunk = (scratch_chunk *)PyMem_Malloc(chunk_size);
+            if (chunk == NULL) {
+                PyErr_NoMemory();
+                return NULL;
+            }
+            if (chunk_size == SCRATCH_CHUNK_SIZE && arena.spare == NULL)
+                scratch_keep_spare(chunk);
+        }
+        chunk->prev = arena.chunk;
+        chunk->end = (char *)chunk + chunk_size;
+        arena.chunk = chunk;
+        arena.ptr = (char *)chunk + SCRATCH_CHUNK_HEADER;
+        arena.end = chunk->end;
+    }
+    void *res = arena.ptr;
+    arena.ptr += size;
+    return res;
+}
+
+_HPy_HIDDEN void *
+_HPyMem_ScratchTop(void)
+{
+    return arena.ptr;
+}
+
+/* Release everything which was allocated after 'mark' was returned by
+   _HPyMem_ScratchTop(). A NULL mark releases everything. */
+_HPy_HIDDEN void
+_HPyMem_ScratchRelease(void *mark)
+{
+    char *p = (char *)mark;
+    if (arena.ptr == p)
+        return;
+    // free the chunks which were allocated after the mark
+    while (arena.chunk != NULL &&
+           !(p >= (char *)arena.chunk + SCRATCH_CHUNK_HEADER &&
+             p <= arena.chunk->end)) {
+        scratch_chunk *prev = arena.chunk->prev;
+        if (arena.chunk == arena.spare)
+            arena.spare_in_use = 0;
+        else
+            PyMem_Free(arena.chunk);
+        arena.chunk = prev;
+    }
+    if (p == NULL)
+        p = arena_inline.data;
+    arena.ptr = p;
+    arena.end = arena.chunk ? arena.chunk->end :
+                              arena_inline.data + SCRATCH_INLINE_SIZE;
+}
@@ -34,5 +34,12 @@ ctx_Module_Create(HPyContext *ctx, HPyModuleDef *hpydef)
         return HPy_NULL;
     }
     PyObject *result = PyModule_Create(def);
+#ifdef Py_GIL_DISABLED
+    if (result != NULL && hpydef->gil_not_used &&
+            PyUnstable_Module_SetGIL(result, Py_MOD_GIL_NOT_USED) < 0) {
+        Py_DECREF(result);
+        return HPy_NULL;
+    }
+#endif
     return _py2h(result);
 }
@@ -0,0 +1,432 @@
+#include <Python.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include "hpy.h"
+#include "hpy/runtime/ctx_funcs.h"
+
+#ifdef HPY_UNIVERSAL_ABI
+   // for _h2py and _py2h
+#  include "handles.h"
+#endif
+
+/* Buffers up to this size are copied on the stack to NUL-terminate them */
+#define SMALL_TEXT 128
+
+/* ------------------------------------------------------------------ */
+/* Parsing                                                             */
+/* ------------------------------------------------------------------ */
+
+/* Parse a plain decimal integer of at most 18 digits, which always fits in
+   a long long: no whitespace, no underscores, no prefix. Return 0 if the
+   text is not of this form, and let the generic path deal with it (and
+   with the errors). */
+static int
+parse_small_int(const char *s, HPy_ssize_t size, int base, long long *result)
+{
+    if (base != 10 && base != 0)
+        return 0;
+    HPy_ssize_t i = 0;
+    int negative = 0;
+    if (size > 0 && (s[0] == '-' || s[0] == '+')) {
+        negative = (s[0] == '-');
+        i = 1;
+    }
+    HPy_ssize_t ndigits = size - i;
+    if (ndigits < 1 || ndigits > 18)
+        return 0;
+    // with base 0, leading zeros are allowed only for zero
+    if (base == 0 && s[i] == '0' && ndigits > 1)
+        return 0;
+    long long value = 0;
+    for (; i < size; i++) {
+        unsigned int digit = (unsigned int)(unsigned char)s[i] - '0';
+        if (digit > 9)
+            return 0;
+        value = value * 10 + digit;
+    }
+    *result = negative ? -value : value;
+    return 1;
+}
+
+_HPy_HIDDEN HPy
+ctx_Long_FromString(HPyContext *ctx, const char *str, HPy_ssize_t size,
+                    int base)
+{
+    if (size < 0)
+        size = (HPy_ssize_t)strlen(str);
+    long long value;
+    if (parse_small_int(str, size, base, &value))
+        return _py2h(PyLong_FromLongLong(value));
+
+    if (memchr(str, '\0', (size_t)size) != NULL) {
+        PyErr_Format(PyExc_ValueError,
+                     "invalid literal for int() with base %d: "
+                     "embedded null character", base);
+        return HPy_NULL;
+    }
+    char small[SMALL_TEXT];
+    char *buf = small;
+    if (size >= SMALL_TEXT) {
+        buf = (char *)PyMem_Malloc((size_t)size + 1);
+        if (buf == NULL) {
+            PyErr_NoMemory();
+            return HPy_NULL;
+        }
+    }
+    memcpy(buf, str, (size_t)size);
+    buf[size] = '\0';
+    // PyLong_FromString raises ValueError if there is anything after the
+    // number, apart from whitespace
+    PyObject *result = PyLong_FromString(buf, NULL, base);
+    if (buf != small)
+        PyMem_Free(buf);
+    return _py2h(result);
+}
+
+/* The powers of ten which are exactly representable as doubles */
+static const double exact_powers_of_10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+#define FLOAT_GENERIC -1    /* not a plain float: use float() */
+#define FLOAT_PLAIN 0       /* a plain float, which needs dtoa */
+#define FLOAT_EXACT 1       /* *result is correctly rounded */
+
+/* Scan a plain decimal float: [sign] digits [. digits] [e [sign] digits],
+   with at least one digit in the mantissa. If the mantissa has at most 19
+   significant digits, its value is at most 2**53 and the exponent is
+   small, the result is the product or the quotient of two doubles which
+   are represented exactly, and it is correctly rounded by IEEE 754
+   (Clinger's fast path). The other plain floats need the full algorithm
+   of PyOS_string_to_double. */
+static int
+scan_float(const char *s, HPy_ssize_t size, double *result)
+{
+    HPy_ssize_t i = 0;
+    int negative = 0;
+    if (size > 0 && (s[0] == '-' || s[0] == '+')) {
+        negative = (s[0] == '-');
+        i = 1;
+    }
+    unsigned long long mantissa = 0;
+    int significant = 0;        /* number of digits in mantissa */
+    int truncated = 0;          /* some non-zero digits did not fit */
+    long exponent = 0;
+    int ndigits = 0;
+    for (; i < size && (unsigned char)(s[i] - '0') <= 9; i++, ndigits++) {
+        int digit = s[i] - '0';
+        if (significant < 19) {
+            mantissa = mantissa * 10 + digit;
+            if (mantissa != 0)
+                significant++;
+        }
+        else {
+            exponent++;
+            truncated |= (digit != 0);
+        }
+    }
+    if (i < size && s[i] == '.') {
+        i++;
+        for (; i < size && (unsigned char)(s[i] - '0') <= 9; i++, ndigits++) {
+            int digit = s[i] - '0';
+            if (significant < 19) {
+                mantissa = mantissa * 10 + digit;
+                if (mantissa != 0)
+                    significant++;
+                exponent--;
+            }
+            else {
+                truncated |= (digit != 0);
+            }
+        }
+    }
+    if (ndigits == 0)
+        return FLOAT_GENERIC;
+    if (i < size && (s[i] == 'e' || s[i] == 'E')) {
+        i++;
+        int exp_negative = 0;
+        if (i < size && (s[i] == '-' || s[i] == '+')) {
+            exp_negative = (s[i] == '-');
+            i++;
+        }
+        if (i == size)
+            return FLOAT_GENERIC;
+        long exp_value = 0;
+        for (; i < size && (unsigned char)(s[i] - '0') <= 9; i++) {
+            if (exp_value < 100000)
+                exp_value = exp_value * 10 + (s[i] - '0');
+        }
+        exponent += exp_negative ? -exp_value : exp_value;
+    }
+    if (i != size)
+        return FLOAT_GENERIC;
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    // with x87 extended precision the operations below would be rounded
+    // twice, so the fast path is used only with strict double arithmetic
+    if (!truncated && mantissa <= (1ULL << 53) &&
+            exponent >= -22 && exponent <= 22) {
+        double value = (double)mantissa;
+        if (exponent >= 0)
+            value *= exact_powers_of_10[exponent];
+        else
+            value /= exact_powers_of_10[-exponent];
+        *result = negative ? -value : value;
+        return FLOAT_EXACT;
+    }
+#else
+    (void)exact_powers_of_10;
+    (void)truncated;
+#endif
+    return FLOAT_PLAIN;
+}
+
+_HPy_HIDDEN HPy
+ctx_Float_FromString(HPyContext *ctx, const char *str, HPy_ssize_t size)
+{
+    if (size < 0)
+        size = (HPy_ssize_t)strlen(str);
+    double value;
+    int kind = scan_float(str, size, &value);
+    if (kind == FLOAT_EXACT)
+        return _py2h(PyFloat_FromDouble(value));
+
+    if (kind == FLOAT_GENERIC) {
+        // whitespace, underscores, 'inf', 'nan' and all the errors
+        PyObject *bytes = PyBytes_FromStringAndSize(str, size);
+        if (bytes == NULL)
+            return HPy_NULL;
+        PyObject *result = PyFloat_FromString(bytes);
+        Py_DECREF(bytes);
+        return _py2h(result);
+    }
+
+    char small[SMALL_TEXT];
+    char *buf = small;
+    if (size >= SMALL_TEXT) {
+        buf = (char *)PyMem_Malloc((size_t)size + 1);
+        if (buf == NULL) {
+            PyErr_NoMemory();
+            return HPy_NULL;
+        }
+    }
+    memcpy(buf, str, (size_t)size);
+    buf[size] = '\0';
+    // the text has already been validated, so it is parsed entirely; the
+    // overflows give an infinity, as in float()
+    value = PyOS_string_to_double(buf, NULL, NULL);
+    if (buf != small)
+        PyMem_Free(buf);
+    if (value == -1.0 && PyErr_Occurred())
+        return HPy_NULL;
+    return _py2h(PyFloat_FromDouble(value));
+}
+
+/* ------------------------------------------------------------------ */
+/* Formatting                                                          */
+/* ------------------------------------------------------------------ */
+
+static HPy_ssize_t
+copy_text(const char *text, HPy_ssize_t len, char *buf, HPy_ssize_t size)
+{
+    if (len < size) {
+        memcpy(buf, text, (size_t)len);
+        buf[len] = '\0';
+    }
+    return len;
+}
+
+/* Write the decimal digits of value at the end of the buffer which ends at
+   end, and return a pointer to the first one. */
+static char *
+format_long_long(long long value, char *end)
+{
+    unsigned long long u = value < 0 ? 0ULL - (unsigned long long)value :
+                                       (unsigned long long)value;
+    char *p = end;
+    do {
+        *--p = (char)('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (value < 0)
+        *--p = '-';
+    return p;
+}
+
+_HPy_HIDDEN HPy_ssize_t
+ctx_Long_Format(HPyContext *ctx, HPy h, char *buf, HPy_ssize_t size)
+{
+    PyObject *obj = _h2py(h);
+    if (!PyLong_Check(obj)) {
+        PyErr_Format(PyExc_TypeError, "expected an int, got '%.200s'",
+                     Py_TYPE(obj)->tp_name);
+        return -1;
+    }
+    int overflow;
+    long long value = PyLong_AsLongLongAndOverflow(obj, &overflow);
+    if (!overflow) {
+        char tmp[24];
+        char *end = tmp + sizeof(tmp);
+        char *start = format_long_long(value, end);
+        return copy_text(start, end - start, buf, size);
+    }
+
+    PyObject *text = PyNumber_ToBase(obj, 10);
+    if (text == NULL)
+        return -1;
+    Py_ssize_t len;
+    const char *utf8 = PyUnicode_AsUTF8AndSize(text, &len);
+    HPy_ssize_t result = utf8 == NULL ? -1 : copy_text(utf8, len, buf, size);
+    Py_DECREF(text);
+    return result;
+}
+
+_HPy_HIDDEN HPy_ssize_t
+ctx_Float_Format(HPyContext *ctx, HPy h, char *buf, HPy_ssize_t size)
+{
+    PyObject *obj = _h2py(h);
+    double value;
+    if (PyFloat_Check(obj)) {
+        value = PyFloat_AS_DOUBLE(obj);
+    }
+    else {
+        value = PyFloat_AsDouble(obj);
+        if (value == -1.0 && PyErr_Occurred())
+            return -1;
+    }
+
+    // repr() writes the integral values below 1e16 as "<digits>.0"
+    if (value == floor(value) && fabs(value) <= 9007199254740992.0) {
+        char tmp[32];
+        char *end = tmp + sizeof(tmp) - 2;
+        char *start = format_long_long((long long)value, end);
+        if (value == 0.0 && signbit(value))
+            *--start = '-';
+        end[0] = '.';
+        end[1] = '0';
+        return copy_text(start, end + 2 - start, buf, size);
+    }
+
+    char *text = PyOS_double_to_string(value, 'r', 0, Py_DTSF_ADD_DOT_0, NULL);
+    if (text == NULL)
+        return -1;
+    HPy_ssize_t result = copy_text(text, (HPy_ssize_t)strlen(text), buf, size);
+    PyMem_Free(text);
+    return result;
+}
+
+/* ------------------------------------------------------------------ */
+/* Byte arrays                                                         */
+/* ------------------------------------------------------------------ */
+
+#if PY_VERSION_HEX >= 0x030D0000
+#  define LONG_AS_BYTE_ARRAY(v, bytes, n, little_endian, is_signed)     \
+       _PyLong_AsByteArray(v, bytes, n, little_endian, is_signed, 1)
+#else
+#  define LONG_AS_BYTE_ARRAY(v, bytes, n, little_endian, is_signed)     \
+       _PyLong_AsByteArray(v, bytes, n, little_endian, is_signed)
+#endif
+
+_HPy_HIDDEN HPy
+ctx_Long_FromByteArray(HPyContext *ctx, const unsigned char *bytes, size_t n,
+                       int little_endian, int is_signed)
+{
+    return _py2h(_PyLong_FromByteArray(bytes, n, little_endian, is_signed));
+}
+
+_HPy_HIDDEN int
+ctx_Long_AsByteArray(HPyContext *ctx, HPy h, unsigned char *bytes, size_t n,
+                     int little_endian, int is_signed)
+{
+    // like HPyLong_AsLongLong & co., accept the objects with __index__
+    PyObject *v = PyNumber_Index(_h2py(h));
+    if (v == NULL)
+        return -1;
+    int res = LONG_AS_BYTE_ARRAY((PyLongObject *)v, bytes, n,
+                                 little_endian, is_signed);
+    Py_DECREF(v);
+    return res;
+}
+
+static int
+check_n_limbs(size_t n)
+{
+    if (n > (size_t)PY_SSIZE_T_MAX / 8) {
+        PyErr_SetString(PyExc_OverflowError, "too many limbs");
+        return -1;
+    }
+    return 0;
+}
+
+_HPy_HIDDEN HPy
+ctx_Long_FromLimbs(HPyContext *ctx, const uint64_t *limbs, size_t n,
+                   int is_signed)
+{
+    if (check_n_limbs(n) < 0)
+        return HPy_NULL;
+#if PY_LITTLE_ENDIAN
+    // the limbs are already a little-endian array of bytes
+    return _py2h(_PyLong_FromByteArray((const unsigned char *)limbs, n * 8,
+                                       1, is_signed));
+#else
+    unsigned char *buf = (unsigned char *)PyMem_Malloc(n > 0 ? n * 8 : 1);
+    if (buf == NULL) {
+        PyErr_NoMemory();
+        return HPy_NULL;
+    }
+    for (size_t i = 0; i < n; i++)
+        for (int j = 0; j < 8; j++)
+            buf[i * 8 + j] = (unsigned char)(limbs[i] >> (8 * j));
+    PyObject *result = _PyLong_FromByteArray(buf, n * 8, 1, is_signed);
+    PyMem_Free(buf);
+    return _py2h(result);
+#endif
+}
+
+_HPy_HIDDEN int
+ctx_Long_AsLimbs(HPyContext *ctx, HPy h, uint64_t *limbs, size_t n,
+                 int is_signed)
+{
+    if (check_n_limbs(n) < 0)
+        return -1;
+#if PY_LITTLE_ENDIAN
+    return ctx_Long_AsByteArray(ctx, h, (unsigned char *)limbs, n * 8,
+                                1, is_signed);
+#else
+    unsigned char *buf = (unsigned char *)PyMem_Malloc(n > 0 ? n * 8 : 1);
+    if (buf == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    int res = ctx_Long_AsByteArray(ctx, h, buf, n * 8, 1, is_signed);
+    if (res == 0) {
+        for (size_t i = 0; i < n; i++) {
+            uint64_t limb = 0;
+            for (int j = 7; j >= 0; j--)
+                limb = (limb << 8) | buf[i * 8 + j];
+            limbs[i] = limb;
+        }
+    }
+    PyMem_Free(buf);
+    return res;
+#endif
+}
+
+_HPy_HIDDEN HPy_ssize_t
+ctx_Long_NumBits(HPyContext *ctx, HPy h)
+{
+    PyObject *v = PyNumber_Index(_h2py(h));
+    if (v == NULL)
+        return -1;
+    size_t nbits = _PyLong_NumBits(v);
+    Py_DECREF(v);
+    if (nbits == (size_t)-1 && PyErr_Occurred())
+        return -1;
+    if (nbits > (size_t)PY_SSIZE_T_MAX) {
+        PyErr_SetString(PyExc_OverflowError, "int has too many bits");
+        return -1;
+    }
+    return (HPy_ssize_t)nbits;
+}
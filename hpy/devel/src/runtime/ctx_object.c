@@ -1,11 +1,28 @@
 #include <Python.h>
 #include "hpy.h"
+#include "hpy/runtime/ctx_funcs.h"
+#include "hpy/runtime/ctx_type.h"
 
 #ifdef HPY_UNIVERSAL_ABI
    // for _h2py and _py2h
 #  include "handles.h"
 #endif
 
+#ifdef Py_GIL_DISABLED
+/* On free-threaded builds, HPyField_Store and HPyGlobal_Store must not
+   decref the old object while another thread is between reading it and
+   incref'ing it in HPyField_Load or HPyGlobal_Load. The stores and the loads
+   of the same location are serialized by one of these mutexes, picked by
+   address so that fields and globals don't need any extra memory. */
+#define HPY_FIELD_LOCKS 64
+static PyMutex field_locks[HPY_FIELD_LOCKS];
+
+_HPy_HIDDEN PyMutex *
+_HPyField_GetLock(const void *addr)
+{
+    return &field_locks[((uintptr_t)addr / sizeof(void *)) % HPY_FIELD_LOCKS];
+}
+#endif
 
 _HPy_HIDDEN void
 ctx_Dump(HPyContext *ctx, HPy h)
@@ -45,6 +62,112 @@ ctx_Is(HPyContext *ctx, HPy h_obj, HPy h_other)
     return _h2py(h_obj) == _h2py(h_other);
 }
 
+/* Like PyObject_RichCompareBool, but with a fast path for HPy types which
+   define HPy_tp_richcompare_bool: in that case, we call the impl directly,
+   without going through the tp_richcompare trampoline and without
+   materializing a bool object.
+
+   The fast path is taken only if both operands have exactly the same type,
+   so that we don't need to care about reflected operations of subclasses,
+   and only if the type was created with the same ctx, since the impl
+   expects the handles of its own ABI (e.g. debug handles). If the impl
+   returns HPy_RICHCMP_NOTIMPLEMENTED, we finish like CPython does when
+   tp_richcompare returns NotImplemented for both operands, unless
+   tp_richcompare is a different function: we never call the impl twice.
+*/
+_HPy_HIDDEN int
+ctx_RichCompareBool(HPyContext *ctx, HPy v, HPy w, int op)
+{
+    PyObject *v_obj = _h2py(v);
+    PyObject *w_obj = _h2py(w);
+    /* Quick result when objects are the same. Guarantees that identity
+       implies equality, like PyObject_RichCompareBool */
+    if (v_obj == w_obj) {
+        if (op == Py_EQ)
+            return 1;
+        else if (op == Py_NE)
+            return 0;
+    }
+    PyTypeObject *tp = Py_TYPE(v_obj);
+    if (tp == Py_TYPE(w_obj)) {
+        bool is_tp_richcompare = false;
+        HPyFunc_richcmpboolfunc f = get_richcompare_bool_impl(tp, ctx,
+                                                        &is_tp_richcompare);
+        if (f != NULL) {
+            int res = f(ctx, v, w, (HPy_RichCmpOp)op);
+            if (res != HPy_RICHCMP_NOTIMPLEMENTED)
+                return res;
+            if (is_tp_richcompare)
+                return richcmpbool_notimplemented(v_obj, w_obj, op);
+        }
+    }
+    return PyObject_RichCompareBool(v_obj, w_obj, op);
+}
+
+static PyObject *
+attrdef_value(HPyContext *ctx, HPyAttrDef *def)
+{
+    switch (def->kind) {
+    case HPyAttr_Kind_Object: {
+        PyObject *value = _h2py(def->object);
+        Py_INCREF(value);
+        return value;
+    }
+    case HPyAttr_Kind_Long:
+        return PyLong_FromLong(def->l);
+    case HPyAttr_Kind_Double:
+        return PyFloat_FromDouble(def->d);
+    case HPyAttr_Kind_String:
+        return PyUnicode_InternFromString(def->s);
+    case HPyAttr_Kind_Type:
+        return _h2py(ctx_Type_FromSpec(ctx, def->type.spec, def->type.params));
+    default:
+        PyErr_Format(PyExc_SystemError,
+                     "unknown HPyAttrDef kind %d for attribute '%s'",
+                     (int)def->kind, def->name);
+        return NULL;
+    }
+}
+
+/* Set all the attributes described by 'defs', stopping at the first error.
+   The keys are interned, so that later lookups of e.g. module globals can
+   compare them by identity, and cached in def->_name_obj like in
+   HPyAttrCache, so that they are interned only once per table. If obj is exactly a module, we store the values
+   directly into its dict, like PyModule_AddObject does, instead of going
+   through the generic setattr machinery for every entry.
+*/
+_HPy_HIDDEN int
+ctx_SetAttrs(HPyContext *ctx, HPy h_obj, HPyAttrDef *defs)
+{
+    PyObject *obj = _h2py(h_obj);
+    PyObject *dict = PyModule_CheckExact(obj) ? PyModule_GetDict(obj) : NULL;
+    for (HPyAttrDef *def = defs; def->kind != 0; def++) {
+        PyObject *value = attrdef_value(ctx, def);
+        if (value == NULL)
+            return -1;
+        if (def->_name_obj == NULL) {
+            // the name is interned, so even if two threads race here they
+            // store the same object, and it is never released
+            PyObject *name = PyUnicode_InternFromString(def->name);
+            if (name == NULL) {
+                Py_DECREF(value);
+                return -1;
+            }
+            def->_name_obj = name;
+        }
+        PyObject *key = (PyObject *)def->_name_obj;
+        int res;
+        if (dict != NULL)
+            res = PyDict_SetItem(dict, key, value);
+        else
+            res = PyObject_SetAttr(obj, key, value);
+        Py_DECREF(value);
+        if (res < 0)
+            return -1;
+    }
+    return 0;
+}
+
 _HPy_HIDDEN HPy
 ctx_GetItem_i(HPyContext *ctx, HPy obj, HPy_ssize_t idx) {
     PyObject* key = PyLong_FromSsize_t(idx);
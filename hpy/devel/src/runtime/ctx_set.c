@@ -0,0 +1,29 @@
+#include <Python.h>
+#include "hpy.h"
+#include "hpy/runtime/ctx_funcs.h"
+
+#ifdef HPY_UNIVERSAL_ABI
+   // for _h2py and _py2h
+#  include "handles.h"
+#endif
+
+
+_HPy_HIDDEN HPy
+ctx_Set_New(HPyContext *ctx, HPy_ssize_t size_hint)
+{
+    // CPython has no public API to presize a set: its table grows
+    // geometrically, so the hint would save only a few resizes anyway
+    (void)size_hint;
+    return _py2h(PySet_New(NULL));
+}
+
+_HPy_HIDDEN int
+ctx_Set_AddArray(HPyContext *ctx, HPy h_set, HPy items[], HPy_ssize_t n)
+{
+    PyObject *set = _h2py(h_set);
+    for (HPy_ssize_t i = 0; i < n; i++) {
+        if (PySet_Add(set, _h2py(items[i])) < 0)
+            return -1;
+    }
+    return 0;
+}
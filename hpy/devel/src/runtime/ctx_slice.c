@@ -0,0 +1,105 @@
+#include <Python.h>
+#include "hpy.h"
+#include "hpy/runtime/ctx_funcs.h"
+
+#ifdef HPY_UNIVERSAL_ABI
+   // for _h2py and _py2h
+#  include "handles.h"
+#endif
+
+
+/* Check the type of obj and turn start and end into indices in the range
+   [0, length], with start <= end */
+static int
+adjust_indices(PyObject *obj, int ok, const char *expected,
+               HPy_ssize_t length, HPy_ssize_t *start, HPy_ssize_t *end)
+{
+    if (!ok) {
+        PyErr_Format(PyExc_TypeError, "expected %s, got '%.200s'",
+                     expected, Py_TYPE(obj)->tp_name);
+        return -1;
+    }
+    Py_ssize_t n = PySlice_AdjustIndices(length, start, end, 1);
+    *end = *start + n;
+    return 0;
+}
+
+_HPy_HIDDEN HPy
+ctx_List_GetSlice(HPyContext *ctx, HPy h_list, HPy_ssize_t start,
+                  HPy_ssize_t end)
+{
+    PyObject *obj = _h2py(h_list);
+    int ok = PyList_Check(obj);
+    if (adjust_indices(obj, ok, "a list", ok ? PyList_GET_SIZE(obj) : 0,
+                       &start, &end) < 0)
+        return HPy_NULL;
+    return _py2h(PyList_GetSlice(obj, start, end));
+}
+
+_HPy_HIDDEN HPy
+ctx_Tuple_GetSlice(HPyContext *ctx, HPy h_tuple, HPy_ssize_t start,
+                   HPy_ssize_t end)
+{
+    PyObject *obj = _h2py(h_tuple);
+    int ok = PyTuple_Check(obj);
+    if (adjust_indices(obj, ok, "a tuple", ok ? PyTuple_GET_SIZE(obj) : 0,
+                       &start, &end) < 0)
+        return HPy_NULL;
+    // the whole of an exact tuple is the tuple itself
+    return _py2h(PyTuple_GetSlice(obj, start, end));
+}
+
+_HPy_HIDDEN HPy
+ctx_Bytes_GetSlice(HPyContext *ctx, HPy h, HPy_ssize_t start, HPy_ssize_t end)
+{
+    PyObject *obj = _h2py(h);
+    int ok = PyBytes_Check(obj);
+    if (adjust_indices(obj, ok, "a bytes object",
+                       ok ? PyBytes_GET_SIZE(obj) : 0, &start, &end) < 0)
+        return HPy_NULL;
+    if (start == 0 && end == PyBytes_GET_SIZE(obj) && PyBytes_CheckExact(obj)) {
+        Py_INCREF(obj);
+        return _py2h(obj);
+    }
+    return _py2h(PyBytes_FromStringAndSize(PyBytes_AS_STRING(obj) + start,
+                                           end - start));
+}
+
+_HPy_HIDDEN HPy
+ctx_Unicode_Substring(HPyContext *ctx, HPy h, HPy_ssize_t start,
+                      HPy_ssize_t end)
+{
+    PyObject *obj = _h2py(h);
+    int ok = PyUnicode_Check(obj);
+    HPy_ssize_t length = 0;
+    if (ok && (length = PyUnicode_GetLength(obj)) < 0)
+        return HPy_NULL;
+    if (adjust_indices(obj, ok, "a str", length, &start, &end) < 0)
+        return HPy_NULL;
+    return _py2h(PyUnicode_Substring(obj, start, end));
+}
+
+/* memoryviews can be sliced without copying: the slice is a new view of
+   the same buffer */
+_HPy_HIDDEN HPy
+ctx_GetSliceView(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end)
+{
+    PyObject *view = PyMemoryView_FromObject(_h2py(obj));
+    if (view == NULL)
+        return HPy_NULL;
+    PyObject *py_start = PyLong_FromSsize_t(start);
+    PyObject *py_end = PyLong_FromSsize_t(end);
+    PyObject *slice = NULL;
+    if (py_start != NULL && py_end != NULL)
+        slice = PySlice_New(py_start, py_end, NULL);
+    Py_XDECREF(py_start);
+    Py_XDECREF(py_end);
+    if (slice == NULL) {
+        Py_DECREF(view);
+        return HPy_NULL;
+    }
+    PyObject *result = PyObject_GetItem(view, slice);
+    Py_DECREF(slice);
+    Py_DECREF(view);
+    return _py2h(result);
+}
@@ -85,15 +85,13 @@ ctx_Tracker_New(HPyContext *ctx, HPy_ssize_t capacity)
     }
     capacity++; // always reserve space for an extra handle, see the docs
 
-    hp = malloc(sizeof(_HPyTracker_s));
+    hp = HPyMem_Malloc(ctx, sizeof(_HPyTracker_s));
     if (hp == NULL) {
-        HPyErr_NoMemory(ctx);
         return _hp2ht(0);
     }
-    hp->handles = calloc(capacity, sizeof(HPy));
+    hp->handles = HPyMem_Calloc(ctx, capacity, sizeof(HPy));
     if (hp->handles == NULL) {
-        free(hp);
-        HPyErr_NoMemory(ctx);
+        HPyMem_Free(ctx, hp);
         return _hp2ht(0);
     }
     hp->capacity = capacity;
@@ -118,9 +116,8 @@ tracker_resize(HPyContext *ctx, _HPyTracker_s *hp, HPy_ssize_t capacity)
         HPyErr_SetString(ctx, ctx->h_ValueError, "HPyTracker resize would lose handles");
         return -1;
     }
-    new_handles = realloc(hp->handles, capacity * sizeof(HPy));
+    new_handles = HPyMem_Realloc(ctx, hp->handles, capacity * sizeof(HPy));
     if (new_handles == NULL) {
-        HPyErr_NoMemory(ctx);
         return -1;
     }
     hp->capacity = capacity;
@@ -155,6 +152,6 @@ ctx_Tracker_Close(HPyContext *ctx, HPyTracker ht)
     for (i=0; i<hp->length; i++) {
         HPy_Close(ctx, hp->handles[i]);
     }
-    free(hp->handles);
-    free(hp);
+    HPyMem_Free(ctx, hp->handles);
+    HPyMem_Free(ctx, hp);
 }
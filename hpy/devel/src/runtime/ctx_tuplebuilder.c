@@ -38,6 +38,24 @@ ctx_TupleBuilder_Set(HPyContext *ctx, HPyTupleBuilder builder,
     }
 }
 
+/* Like ctx_TupleBuilder_Set, but h_item is consumed, also if the builder
+   is in the failed state */
+_HPy_HIDDEN void
+ctx_TupleBuilder_SetSteal(HPyContext *ctx, HPyTupleBuilder builder,
+                          HPy_ssize_t index, HPy h_item)
+{
+    PyObject *tup = (PyObject *)builder._tup;
+    PyObject *item = _h2py_steal(h_item);
+    if (tup != NULL) {
+        assert(index >= 0 && index < PyTuple_GET_SIZE(tup));
+        assert(PyTuple_GET_ITEM(tup, index) == NULL);
+        PyTuple_SET_ITEM(tup, index, item);
+    }
+    else {
+        Py_DECREF(item);
+    }
+}
+
 _HPy_HIDDEN HPy
 ctx_TupleBuilder_Build(HPyContext *ctx, HPyTupleBuilder builder)
 {
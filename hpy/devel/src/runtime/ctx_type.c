@@ -1,7 +1,9 @@
 #include <stddef.h>
 #include <Python.h>
 #include "structmember.h" // for PyMemberDef
+#include "pythread.h" // for the thread-specific storage
 #include "hpy.h"
+#include "hpy/runtime/ctx_funcs.h"
 #include "hpy/runtime/ctx_type.h"
 
 #ifdef HPY_UNIVERSAL_ABI
@@ -10,6 +12,8 @@
 #endif
 
 static bool has_tp_traverse(HPyType_Spec *hpyspec);
+static bool has_tp_richcompare(HPyType_Spec *hpyspec);
+static bool has_tp_richcompare_bool(HPyType_Spec *hpyspec);
 static bool needs_hpytype_dealloc(HPyType_Spec *hpyspec);
 
 
@@ -20,6 +24,10 @@ static bool needs_hpytype_dealloc(HPyType_Spec *hpyspec);
 typedef struct {
     HPyFunc_traverseproc tp_traverse_impl;
     HPyFunc_destroyfunc tp_destroy_impl;
+    HPyFunc_richcmpboolfunc tp_richcompare_bool_impl;
+    bool tp_richcompare_is_bool;    // Py_tp_richcompare calls the bool impl
+    HPyContext *ctx;    // the ctx which the impls expect
+    void *data;     // HPyType_Spec.data
     char name[];
 } HPyType_Extra_t;
 
@@ -53,8 +61,16 @@ static void *_pyobj_as_struct(PyObject *obj)
 
 static int _decref_visitor(HPyField *pf, void *arg)
 {
+#ifdef Py_GIL_DISABLED
+    // tp_clear can run concurrently with an HPyField_Store from another
+    // thread, e.g. if the object is reachable from a cycle that the GC is
+    // breaking: swap atomically like ctx_Field_Store does
+    PyObject *old_object = _hf2py((HPyField){ ._i = _Py_atomic_exchange_ssize(
+                                      (Py_ssize_t *)&pf->_i, HPyField_NULL._i) });
+#else
     PyObject *old_object = _hf2py(*pf);
     *pf = HPyField_NULL;
+#endif
     Py_XDECREF(old_object);
     return 0;
 }
@@ -76,6 +92,345 @@ static void hpytype_clear(PyObject *self)
     }
 }
 
+/* ~~~ deferred deallocation ~~~
+
+   Destroying an object decrefs the objects in its HPyFields, which can be
+   destroyed in turn: for long chains of HPy objects, e.g. a linked list or a
+   deep tree, a naive tp_dealloc recurses once per object and can overflow
+   the C stack. Like CPython's trashcan, hpytype_dealloc counts how deeply
+   the deallocations of the current thread are nested: beyond
+   DEALLOC_MAX_DEPTH, the objects are pushed to a stack of pending objects,
+   which is emptied iteratively by the outermost hpytype_dealloc.
+
+   If a budget is set with HPy_SetDeallocBudget, an outermost hpytype_dealloc
+   destroys at most 'budget' objects, counting the nested ones: all the
+   others are deferred too, whatever their depth. The pending objects are
+   then destroyed, 'budget' at a time, at the next safe points: HPy_New, the
+   exit of the outermost call into an extension (see _HPyDealloc_SafePoint)
+   and HPy_DrainDeallocs, which destroys all of them.
+
+   In the CPython ABI every extension contains its own copy of this file,
+   but the pending objects and the budget must be the same for all of them,
+   as they are in the universal ABI: they live in a dealloc_shared which
+   is created by the first copy which needs it and stored in the dict of the
+   interpreter (PyInterpreterState_GetDict). The per-thread state is found
+   through the thread-specific key of the dealloc_shared, and it is owned by a
+   capsule in the dict of the thread state: when the thread exits, the
+   capsule destroys the objects which are still pending and frees it. The
+   main thread does the same earlier, in an atexit hook. Each pending
+   object is stored with the hpytype_destroy of the copy which deferred it.
+
+   The dealloc_shared itself is never freed: objects can be deallocated
+   until the very end of the finalization, and every copy caches it.
+*/
+
+#define DEALLOC_MAX_DEPTH 50
+
+/* bump the version whenever dealloc_shared or dealloc_state change */
+#define DEALLOC_SHARED_NAME "hpy.dealloc_shared_v2"
+#define DEALLOC_STATE_NAME "hpy.dealloc_state_v2"
+
+#if PY_VERSION_HEX >= 0x030D0000
+#  define dealloc_is_finalizing() Py_IsFinalizing()
+#elif PY_VERSION_HEX >= 0x03070000
+#  define dealloc_is_finalizing() _Py_IsFinalizing()
+#else
+#  define dealloc_is_finalizing() (_Py_Finalizing != NULL)
+#endif
+
+/* the thread-specific storage API (PEP 539) is new in 3.7 */
+#if PY_VERSION_HEX >= 0x03070000
+typedef Py_tss_t dealloc_key;
+#  define DEALLOC_KEY_INIT Py_tss_NEEDS_INIT
+#  define dealloc_key_create(key) PyThread_tss_create(key)
+#  define dealloc_key_is_created(key) PyThread_tss_is_created(key)
+#  define dealloc_key_delete(key) PyThread_tss_delete(key)
+#  define dealloc_key_get(key) PyThread_tss_get(key)
+#  define dealloc_key_set(key, value) PyThread_tss_set((key), (value))
+#else
+typedef int dealloc_key;
+#  define DEALLOC_KEY_INIT (-1)
+static int dealloc_key_create(dealloc_key *key)
+{
+    *key = PyThread_create_key();
+    return *key == -1 ? -1 : 0;
+}
+#  define dealloc_key_is_created(key) (*(key) != -1)
+#  define dealloc_key_delete(key) PyThread_delete_key(*(key))
+#  define dealloc_key_get(key) PyThread_get_key_value(*(key))
+static int dealloc_key_set(dealloc_key *key, void *value)
+{
+    if (value == NULL) {
+        PyThread_delete_key_value(*key);
+        return 0;
+    }
+    return PyThread_set_key_value(*key, value);
+}
+#endif
+
+typedef struct {
+    int used;               // set once an object has been deferred
+    Py_ssize_t budget;      // 0 means no budget
+    dealloc_key tss;        // the dealloc_state of each thread
+} dealloc_shared;
+
+typedef struct {
+    PyObject *obj;
+    void (*destroy)(PyObject *obj);
+} dealloc_pending;
+
+typedef struct {
+    int depth;              // nesting of hpytype_dealloc
+    Py_ssize_t destroyed;   // objects destroyed by the outermost dealloc
+    dealloc_pending *pending;   // objects whose destruction is deferred
+    Py_ssize_t n_pending;
+    Py_ssize_t allocated;
+    unsigned long thread_id;    // the thread which owns this state
+} dealloc_state;
+
+static dealloc_shared *dshared = NULL;
+_HPy_HIDDEN int *_hpy_dealloc_used = NULL;
+
+static void hpytype_destroy(PyObject *self);
+static void dealloc_drain(dealloc_state *ds, bool all);
+
+// Return a borrowed reference to the dict which holds the dealloc_shared
+static PyObject *dealloc_get_storage(void)
+{
+#if PY_VERSION_HEX >= 0x03080000
+#  if PY_VERSION_HEX >= 0x03090000
+    PyInterpreterState *interp = PyInterpreterState_Get();
+#  else
+    PyInterpreterState *interp = _PyInterpreterState_Get();
+#  endif
+    PyObject *dict = PyInterpreterState_GetDict(interp);
+    if (dict == NULL && !PyErr_Occurred())
+        PyErr_SetString(PyExc_SystemError, "no interpreter dict");
+    return dict;
+#else
+    // there is no PyInterpreterState_GetDict before 3.8: fall back to the
+    // dict of the sys module, which also lives as long as the interpreter
+    PyObject *sys = PyImport_AddModule("sys");
+    return sys == NULL ? NULL : PyModule_GetDict(sys);
+#endif
+}
+
+// Destroy all the pending objects of the main thread before the
+// finalization of the interpreter starts
+static PyObject *dealloc_atexit(PyObject *self, PyObject *unused)
+{
+    dealloc_state *ds = (dealloc_state *)dealloc_key_get(&dshared->tss);
+    if (ds != NULL && ds->depth == 0 && ds->n_pending > 0)
+        dealloc_drain(ds, true);
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef dealloc_atexit_def = {
+    "_hpy_drain_deallocs", dealloc_atexit, METH_NOARGS, NULL
+};
+
+static int dealloc_register_atexit(void)
+{
+    PyObject *atexit = PyImport_ImportModule("atexit");
+    if (atexit == NULL)
+        return -1;
+    PyObject *func = PyCFunction_New(&dealloc_atexit_def, NULL);
+    PyObject *res = NULL;
+    if (func != NULL)
+        res = PyObject_CallMethod(atexit, "register", "O", func);
+    Py_XDECREF(func);
+    Py_DECREF(atexit);
+    if (res == NULL)
+        return -1;
+    Py_DECREF(res);
+    return 0;
+}
+
+// Find or create the dealloc_shared. Return -1 with an exception set in
+// case of error.
+static int dealloc_init_shared(void)
+{
+    if (dshared != NULL)
+        return 0;
+    PyObject *storage = dealloc_get_storage();
+    if (storage == NULL)
+        return -1;
+    PyObject *name = PyUnicode_FromString(DEALLOC_SHARED_NAME);
+    dealloc_shared *shared = PyMem_RawCalloc(1, sizeof(dealloc_shared));
+    if (name == NULL || shared == NULL) {
+        Py_XDECREF(name);
+        PyMem_RawFree(shared);
+        if (!PyErr_Occurred())
+            PyErr_NoMemory();
+        return -1;
+    }
+    dealloc_key key = DEALLOC_KEY_INIT;
+    shared->tss = key;
+    // the capsule has no destructor, see above. If another copy is quicker
+    // to store its dealloc_shared, our atexit hook is redundant but harmless
+    PyObject *capsule = NULL;
+    PyObject *found = NULL;
+    if (dealloc_key_create(&shared->tss) != 0)
+        PyErr_NoMemory();
+    else if (dealloc_register_atexit() == 0 &&
+             (capsule = PyCapsule_New(shared, DEALLOC_SHARED_NAME, NULL)) != NULL)
+        // atomic: if another copy was quicker, use its dealloc_shared
+        found = PyDict_SetDefault(storage, name, capsule);
+    Py_DECREF(name);
+    if (found != capsule) {
+        if (dealloc_key_is_created(&shared->tss))
+            dealloc_key_delete(&shared->tss);
+        PyMem_RawFree(shared);
+    }
+    Py_XDECREF(capsule);
+    if (found == NULL)
+        return -1;
+    shared = PyCapsule_GetPointer(found, DEALLOC_SHARED_NAME);
+    if (shared == NULL)
+        return -1;
+    dshared = shared;
+    _hpy_dealloc_used = &shared->used;
+    return 0;
+}
+
+// The destructor of the capsule which owns a dealloc_state, called when the
+// thread state is cleared: destroy the objects which are still pending and
+// free the state
+static void dealloc_state_destructor(PyObject *capsule)
+{
+    dealloc_state *ds = (dealloc_state *)PyCapsule_GetPointer(capsule,
+                                                             DEALLOC_STATE_NAME);
+    if (ds == NULL) {
+        PyErr_Clear();
+        return;
+    }
+    if (ds->depth > 0) {
+        // the thread is in the middle of a deallocation, which is still
+        // using the state (e.g. a daemon thread at finalization): leak it
+        return;
+    }
+    if (ds->n_pending > 0)
+        dealloc_drain(ds, true);
+    // the thread states of the daemon threads are cleared by the main
+    // thread, whose own dealloc_state must stay
+    if (ds->thread_id == PyThread_get_thread_ident())
+        dealloc_key_set(&dshared->tss, NULL);
+    PyMem_RawFree(ds->pending);
+    PyMem_RawFree(ds);
+}
+
+// Return the dealloc_state of the current thread, creating it if needed, or
+// NULL if it cannot be created. The caller must have called
+// dealloc_init_shared(). It never leaves an exception set, since it is used
+// by hpytype_dealloc.
+static dealloc_state *dealloc_get_state(void)
+{
+    assert(dshared != NULL);
+    dealloc_key *tss = &dshared->tss;
+    dealloc_state *ds = (dealloc_state *)dealloc_key_get(tss);
+    if (ds != NULL)
+        return ds;
+    if (dealloc_is_finalizing()) {
+        // the state might have been freed already: destroy the objects
+        // recursively from now on
+        return NULL;
+    }
+    PyObject *exc_type, *exc_value, *exc_tb;
+    PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+    PyObject *capsule = NULL;
+    PyObject *dict = PyThreadState_GetDict();
+    ds = PyMem_RawCalloc(1, sizeof(dealloc_state));
+    if (dict == NULL || ds == NULL)
+        goto error;
+    ds->thread_id = PyThread_get_thread_ident();
+    capsule = PyCapsule_New(ds, DEALLOC_STATE_NAME, dealloc_state_destructor);
+    if (capsule == NULL)
+        goto error;
+    if (dealloc_key_set(tss, ds) != 0)
+        goto error;
+    if (PyDict_SetItemString(dict, DEALLOC_STATE_NAME, capsule) < 0) {
+        dealloc_key_set(tss, NULL);
+        goto error;
+    }
+    // now the capsule owns ds
+    Py_DECREF(capsule);
+    PyErr_Restore(exc_type, exc_value, exc_tb);
+    return ds;
+ error:
+    if (capsule != NULL) {
+        // don't let the destructor free ds
+        PyCapsule_SetDestructor(capsule, NULL);
+        Py_DECREF(capsule);
+    }
+    PyMem_RawFree(ds);
+    PyErr_Clear();
+    PyErr_Restore(exc_type, exc_value, exc_tb);
+    return NULL;
+}
+
+static inline Py_ssize_t dealloc_get_budget(void)
+{
+#ifdef Py_GIL_DISABLED
+    return _Py_atomic_load_ssize_relaxed(&dshared->budget);
+#else
+    return dshared->budget;
+#endif
+}
+
+static inline bool dealloc_over_budget(dealloc_state *ds)
+{
+    Py_ssize_t budget = dealloc_get_budget();
+    return budget > 0 && ds->destroyed >= budget;
+}
+
+// Return -1 if there is no memory to defer the destruction of self
+static int dealloc_defer(dealloc_state *ds, PyObject *self)
+{
+    if (ds->n_pending == ds->allocated) {
+        Py_ssize_t allocated = ds->allocated ? ds->allocated * 2 : 64;
+        dealloc_pending *pending = (dealloc_pending *)PyMem_RawRealloc(
+                           ds->pending, allocated * sizeof(dealloc_pending));
+        if (pending == NULL)
+            return -1;
+        ds->pending = pending;
+        ds->allocated = allocated;
+    }
+    ds->pending[ds->n_pending].obj = self;
+    ds->pending[ds->n_pending].destroy = hpytype_destroy;
+    ds->n_pending++;
+    dshared->used = 1;
+    return 0;
+}
+
+// Destroy the pending objects: all of them if 'all', else until the budget
+// of the current outermost deallocation is exhausted
+static void dealloc_drain(dealloc_state *ds, bool all)
+{
+    assert(ds->depth == 0);
+    ds->depth++;
+    while (ds->n_pending > 0 && (all || !dealloc_over_budget(ds))) {
+        dealloc_pending p = ds->pending[--ds->n_pending];
+        ds->destroyed++;
+        p.destroy(p.obj);
+    }
+    ds->depth--;
+    if (ds->n_pending == 0) {
+        PyMem_RawFree(ds->pending);
+        ds->pending = NULL;
+        ds->allocated = 0;
+    }
+}
+
+_HPy_HIDDEN void _HPyDealloc_DrainSome(void)
+{
+    // there is nothing to drain if the current thread has no state yet
+    dealloc_state *ds = (dealloc_state *)dealloc_key_get(&dshared->tss);
+    if (ds != NULL && ds->depth == 0 && ds->n_pending > 0) {
+        ds->destroyed = 0;
+        dealloc_drain(ds, false);
+    }
+}
+
 /* this is a generic tp_dealloc which we use for all the user-defined HPy
    types created by HPyType_FromSpec */
 static void hpytype_dealloc(PyObject *self)
@@ -91,6 +446,35 @@ static void hpytype_dealloc(PyObject *self)
     if (PyType_IS_GC(tp))
         PyObject_GC_UnTrack(self);
 
+    dealloc_state *ds = dealloc_get_state();
+    if (ds == NULL) {
+        // no memory to track the nesting: recurse
+        hpytype_destroy(self);
+        return;
+    }
+    if (ds->depth == 0) {
+        // self starts a new outermost deallocation
+        ds->destroyed = 0;
+    }
+    else if ((ds->depth >= DEALLOC_MAX_DEPTH || dealloc_over_budget(ds)) &&
+             dealloc_defer(ds, self) == 0) {
+        // let the outermost hpytype_dealloc or a later safe point destroy
+        // self. Recursing is the only option if we cannot allocate the
+        // memory for that.
+        return;
+    }
+    ds->destroyed++;
+    ds->depth++;
+    hpytype_destroy(self);
+    ds->depth--;
+    if (ds->depth == 0 && ds->n_pending > 0)
+        dealloc_drain(ds, false);
+}
+
+static void hpytype_destroy(PyObject *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+
     // decref and clear all the HPyFields
     hpytype_clear(self);
 
@@ -147,6 +531,12 @@ is_destroy_slot(HPyDef *def)
     return def->kind == HPyDef_Kind_Slot && def->slot.slot == HPy_tp_destroy;
 }
 
+static inline bool
+is_richcompare_bool_slot(HPyDef *def)
+{
+    return def->kind == HPyDef_Kind_Slot && def->slot.slot == HPy_tp_richcompare_bool;
+}
+
 static HPy_ssize_t
 HPyDef_count(HPyDef *defs[], HPyDef_Kind kind)
 {
@@ -192,6 +582,7 @@ hpy_slot_to_cpy_slot(HPySlot_Slot src)
 {
     switch (src) {
         case HPy_tp_destroy: return Py_tp_dealloc;
+        case HPy_tp_richcompare_bool: return Py_tp_richcompare;
         default: return src;   /* same numeric value by default */
     }
 }
@@ -368,6 +759,8 @@ create_slot_defs(HPyType_Spec *hpyspec, HPy_ssize_t base_member_offset,
         hpyslot_count++;        // Py_tp_dealloc
     if (has_tp_traverse(hpyspec))
         hpyslot_count++;    // Py_tp_clear
+    if (has_tp_richcompare_bool(hpyspec) && has_tp_richcompare(hpyspec))
+        hpyslot_count--;    // HPy_tp_richcompare_bool has no Py_tp_richcompare
 
     // allocate the result PyType_Slot array
     HPy_ssize_t total_slot_count = hpyslot_count + legacy_slot_count;
@@ -388,6 +781,14 @@ create_slot_defs(HPyType_Spec *hpyspec, HPy_ssize_t base_member_offset,
                 extra->tp_destroy_impl = (HPyFunc_destroyfunc)src->slot.impl;
                 continue;   /* we don't have a trampoline for tp_destroy */
             }
+            if (is_richcompare_bool_slot(src)) {
+                extra->tp_richcompare_bool_impl = (HPyFunc_richcmpboolfunc)src->slot.impl;
+                /* if the user also provided HPy_tp_richcompare, it wins: the
+                   bool variant is used only by HPy_RichCompareBool */
+                if (has_tp_richcompare(hpyspec))
+                    continue;
+                extra->tp_richcompare_is_bool = true;
+            }
             if (is_traverse_slot(src)) {
                 extra->tp_traverse_impl = (HPyFunc_traverseproc)src->slot.impl;
                 /* no 'continue' here: we have a trampoline too */
@@ -576,6 +977,27 @@ static bool has_tp_traverse(HPyType_Spec *hpyspec)
     return false;
 }
 
+static bool has_slot(HPyType_Spec *hpyspec, HPySlot_Slot slot)
+{
+    if (hpyspec->defines != NULL)
+        for (int i = 0; hpyspec->defines[i] != NULL; i++) {
+            HPyDef *def = hpyspec->defines[i];
+            if (def->kind == HPyDef_Kind_Slot && def->slot.slot == slot)
+                return true;
+        }
+    return false;
+}
+
+static bool has_tp_richcompare(HPyType_Spec *hpyspec)
+{
+    return has_slot(hpyspec, HPy_tp_richcompare);
+}
+
+static bool has_tp_richcompare_bool(HPyType_Spec *hpyspec)
+{
+    return has_slot(hpyspec, HPy_tp_richcompare_bool);
+}
+
 static bool needs_hpytype_dealloc(HPyType_Spec *hpyspec)
 {
     if (hpyspec->defines != NULL)
@@ -682,6 +1104,9 @@ ctx_Type_FromSpec(HPyContext *ctx, HPyType_Spec *hpyspec,
     if (check_have_gc_and_tp_traverse(ctx, hpyspec) < 0) {
         return HPy_NULL;
     }
+    if (dealloc_init_shared() < 0) {
+        return HPy_NULL;
+    }
 
     PyType_Spec *spec = PyMem_Calloc(1, sizeof(PyType_Spec));
     if (spec == NULL) {
@@ -719,6 +1144,8 @@ ctx_Type_FromSpec(HPyContext *ctx, HPyType_Spec *hpyspec,
         return HPy_NULL;
     }
     spec->name = extra->name;
+    extra->data = hpyspec->data;
+    extra->ctx = ctx;
     spec->basicsize = basicsize;
     spec->flags = flags | HPy_TPFLAGS_INTERNAL_IS_HPY_TYPE;
     spec->itemsize = hpyspec->itemsize;
@@ -773,6 +1200,8 @@ ctx_New(HPyContext *ctx, HPy h_type, void **data)
         PyErr_SetString(PyExc_TypeError, "HPy_New arg 1 must be a type");
         return HPy_NULL;
     }
+    // continue the destruction of the objects left by hpytype_dealloc
+    _HPyDealloc_SafePoint();
 
     PyObject *result;
     if (PyType_IS_GC(tp))
@@ -824,12 +1253,59 @@ ctx_Type_GenericNew(HPyContext *ctx, HPy h_type, HPy *args, HPy_ssize_t nargs, H
     return _py2h(res);
 }
 
+_HPy_HIDDEN HPy_ssize_t
+ctx_SetDeallocBudget(HPyContext *ctx, HPy_ssize_t budget)
+{
+    if (budget < 0) {
+        PyErr_SetString(PyExc_ValueError, "the dealloc budget must be >= 0");
+        return -1;
+    }
+    if (dealloc_init_shared() < 0)
+        return -1;
+#ifdef Py_GIL_DISABLED
+    HPy_ssize_t old_budget = _Py_atomic_exchange_ssize(
+                                  &dshared->budget, budget);
+#else
+    HPy_ssize_t old_budget = dshared->budget;
+    dshared->budget = budget;
+#endif
+    if (budget == 0)
+        _HPyDealloc_DrainSome();
+    return old_budget;
+}
+
+_HPy_HIDDEN int
+ctx_DrainDeallocs(HPyContext *ctx)
+{
+    if (dealloc_init_shared() < 0)
+        return -1;
+    dealloc_state *ds = (dealloc_state *)dealloc_key_get(&dshared->tss);
+    if (ds != NULL && ds->depth == 0 && ds->n_pending > 0)
+        dealloc_drain(ds, true);
+    return 0;
+}
+
 _HPy_HIDDEN void*
 ctx_AsStruct(HPyContext *ctx, HPy h)
 {
     return _HPy_PyObject_Payload(_h2py(h));
 }
 
+_HPy_HIDDEN void *
+ctx_Type_GetData(HPyContext *ctx, HPy h_type)
+{
+    PyTypeObject *base = (PyTypeObject *)_h2py(h_type);
+    if (!PyType_Check(base))
+        return NULL;
+    while (base) {
+        if ((base->tp_flags & HPy_TPFLAGS_INTERNAL_IS_HPY_TYPE) &&
+                _HPyType_EXTRA(base)->data != NULL)
+            return _HPyType_EXTRA(base)->data;
+        base = base->tp_base;
+    }
+    return NULL;
+}
+
 _HPy_HIDDEN void*
 ctx_AsStructLegacy(HPyContext *ctx, HPy h)
 {
@@ -904,3 +1380,65 @@ _HPy_HIDDEN int call_traverseproc_from_trampoline(HPyFunc_traverseproc tp_traver
     hpy2cpy_visit_args_t args = { cpy_visit, cpy_arg };
     return tp_traverse(_pyobj_as_struct(self), hpy2cpy_visit, &args);
 }
+
+
+/* ~~~ HPy_tp_richcompare_bool ~~~
+
+   The impl of HPy_tp_richcompare_bool returns 1, 0, -1 in case of error or
+   HPy_RICHCMP_NOTIMPLEMENTED. When it is called by CPython through the
+   Py_tp_richcompare slot (e.g. by list.sort()), the result is converted to a
+   PyObject* here. This never allocates, since we return only singletons.
+
+   HPy_RichCompareBool() calls the impl directly, without any conversion: see
+   ctx_RichCompareBool.
+*/
+_HPy_HIDDEN PyObject *richcmpbool_result_to_py(int result)
+{
+    switch (result) {
+    case 0:
+        Py_RETURN_FALSE;
+    case 1:
+        Py_RETURN_TRUE;
+    case HPy_RICHCMP_NOTIMPLEMENTED:
+        Py_RETURN_NOTIMPLEMENTED;
+    default:
+        assert(PyErr_Occurred());
+        return NULL;
+    }
+}
+
+_HPy_HIDDEN HPyFunc_richcmpboolfunc
+get_richcompare_bool_impl(PyTypeObject *tp, HPyContext *ctx, bool *is_tp_richcompare)
+{
+    if (!(tp->tp_flags & HPy_TPFLAGS_INTERNAL_IS_HPY_TYPE))
+        return NULL;
+    HPyType_Extra_t *extra = _HPyType_EXTRA(tp);
+    // the impl expects the handles of the ABI which created the type
+    if (extra->ctx != ctx)
+        return NULL;
+    *is_tp_richcompare = extra->tp_richcompare_is_bool;
+    return extra->tp_richcompare_bool_impl;
+}
+
+_HPy_HIDDEN int richcmpbool_notimplemented(PyObject *v, PyObject *w, int op)
+{
+    static const char * const opstrings[] = {"<", "<=", "==", "!=", ">", ">="};
+    switch (op) {
+    case Py_EQ:
+        return v == w;
+    case Py_NE:
+        return v != w;
+    default:
+        PyErr_Format(PyExc_TypeError,
+                     "'%s' not supported between instances of "
+                     "'%.100s' and '%.100s'",
+                     opstrings[op], Py_TYPE(v)->tp_name, Py_TYPE(w)->tp_name);
+        return -1;
+    }
+}
+
+_HPy_HIDDEN void set_type_impl_context(PyTypeObject *tp, HPyContext *ctx)
+{
+    assert(tp->tp_flags & HPy_TPFLAGS_INTERNAL_IS_HPY_TYPE);
+    _HPyType_EXTRA(tp)->ctx = ctx;
+}
@@ -14,7 +14,8 @@
 /**
  * Create a type and add it as an attribute on the given object. The type is
  * created using `HPyType_FromSpec`. The object is often a module that the type
- * is being added to.
+ * is being added to. This is a shortcut for calling `HPy_SetAttrs` with a
+ * single `HPyAttr_TYPE` entry.
  *
  * :param ctx:
  *     The execution context.
@@ -56,14 +57,9 @@ HPyAPI_HELPER int
 HPyHelpers_AddType(HPyContext *ctx, HPy obj, const char *name,
                   HPyType_Spec *hpyspec, HPyType_SpecParam *params)
 {
-    HPy h_type = HPyType_FromSpec(ctx, hpyspec, params);
-    if (HPy_IsNull(h_type)) {
-        return 0;
-    }
-    if (HPy_SetAttr_s(ctx, obj, name, h_type) != 0) {
-        HPy_Close(ctx, h_type);
-        return 0;
-    }
-    HPy_Close(ctx, h_type);
-    return 1;
+    HPyAttrDef attrs[] = {
+        HPyAttr_TYPE(name, hpyspec, params),
+        {0}
+    };
+    return HPy_SetAttrs(ctx, obj, attrs) == 0;
 }
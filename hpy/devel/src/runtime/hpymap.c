@@ -0,0 +1,378 @@
+/**
+ * Hash maps stored inside objects.
+ *
+ * ``HPyMap`` is a hash map from objects to objects which can be embedded in
+ * the struct of a custom type, e.g. to implement an internal cache. Keys
+ * and values are stored as ``HPyField`` s, so it works on every ABI without
+ * the overhead of a dict and of the generic ``HPy_GetItem``/``HPy_SetItem``.
+ *
+ * The map uses open addressing and caches the hash of every key: the keys
+ * are compared with ``HPy_RichCompareBool`` only when the hashes are equal,
+ * so a lookup usually costs one ``HPy_Hash`` plus, if the key is found, a
+ * single comparison. As for dicts, keys must be hashable and are compared
+ * by equality.
+ *
+ * Since the map contains ``HPyField`` s, the owner type must:
+ *
+ *   - call ``HPyMap_Traverse`` in its ``tp_traverse``;
+ *
+ *   - call ``HPyMap_Free`` in its ``tp_destroy``: the items have already
+ *     been released at that point, ``HPyMap_Free`` releases the memory of
+ *     the map itself.
+ *
+ * All the functions which take an ``owner`` argument need the handle of the
+ * object which contains the map, for the same reason as
+ * ``HPyField_Store``.
+ *
+ * Example:
+ *
+ * .. code-block:: c
+ *
+ *     typedef struct {
+ *         HPyMap cache;
+ *     } CacheObject;
+ *
+ *     HPyType_HELPERS(CacheObject)
+ *
+ *     HPyDef_SLOT(Cache_traverse, Cache_traverse_impl, HPy_tp_traverse)
+ *     static int Cache_traverse_impl(void *self, HPyFunc_visitproc visit,
+ *                                    void *arg)
+ *     {
+ *         return HPyMap_Traverse(&((CacheObject *)self)->cache, visit, arg);
+ *     }
+ *
+ *     HPyDef_SLOT(Cache_destroy, Cache_destroy_impl, HPy_tp_destroy)
+ *     static void Cache_destroy_impl(void *self)
+ *     {
+ *         HPyMap_Free(&((CacheObject *)self)->cache);
+ *     }
+ *
+ *     ...
+ *     HPy value;
+ *     int found = HPyMap_Lookup(ctx, h_self, &CacheObject_AsStruct(ctx, h_self)->cache,
+ *                               h_key, &value);
+ *
+ * HPyMap API
+ * ----------
+ *
+ */
+
+#include "hpy.h"
+#include <stdlib.h>
+
+#define HPYMAP_MINSIZE 8
+
+/* the hash of the deleted slots: HPy_Hash never returns -1 on success */
+#define HPYMAP_DELETED ((HPy_hash_t)-1)
+
+#define ENTRY_IS_FREE(e) (HPyField_IsNull((e)->key))
+#define ENTRY_IS_EMPTY(e) (ENTRY_IS_FREE(e) && (e)->hash != HPYMAP_DELETED)
+
+/* The probe sequence is the same as for CPython's dicts: it visits all the
+   slots, and the higher bits of the hash soon contribute to it. */
+#define PROBE_START(hash, mask, i, perturb)                             \
+    size_t perturb = (size_t)(hash);                                    \
+    size_t i = (size_t)(hash) & (mask)
+#define PROBE_NEXT(mask, i, perturb)                                    \
+    perturb >>= 5;                                                      \
+    i = (i * 5 + perturb + 1) & (mask)
+
+/* true if one more item would leave less than one third of the slots
+   empty, which keeps the probe sequences short */
+#define MAP_NEEDS_RESIZE(map)                                           \
+    ((map)->entries == NULL || ((map)->fill + 1) * 3 > ((map)->mask + 1) * 2)
+
+/* Return the index of the slot which contains key and set *found to 1, or
+   return the index of the slot where it should be inserted and set *found
+   to 0. Return -1 in case of error. The map must be allocated, but __eq__
+   can clear it: then *found is set to 0 and 0 is returned, which is not a
+   valid index, so the callers which insert must check map->entries. */
+static HPy_ssize_t
+map_find(HPyContext *ctx, HPy owner, HPyMap *map, HPy key, HPy_hash_t hash,
+         int *found)
+{
+ restart: ;
+    HPyMap_Entry *entries = map->entries;
+    if (entries == NULL) {
+        *found = 0;
+        return 0;
+    }
+    size_t mask = (size_t)map->mask;
+    HPy_ssize_t free_slot = -1;
+    PROBE_START(hash, mask, i, perturb);
+    for (;;) {
+        HPyMap_Entry *e = &entries[i];
+        if (ENTRY_IS_FREE(e)) {
+            if (e->hash != HPYMAP_DELETED) {
+                *found = 0;
+                return free_slot >= 0 ? free_slot : (HPy_ssize_t)i;
+            }
+            if (free_slot < 0)
+                free_slot = (HPy_ssize_t)i;
+        }
+        else if (e->hash == hash) {
+            HPy h_key = HPyField_Load(ctx, owner, e->key);
+            int eq = HPy_RichCompareBool(ctx, h_key, key, HPy_EQ);
+            HPy_Close(ctx, h_key);
+            if (eq < 0)
+                return -1;
+            // __eq__ can run arbitrary code, which might have modified the
+            // map under our feet
+            if (map->entries != entries || ENTRY_IS_FREE(e))
+                goto restart;
+            if (eq) {
+                *found = 1;
+                return (HPy_ssize_t)i;
+            }
+        }
+        PROBE_NEXT(mask, i, perturb);
+    }
+}
+
+typedef struct {
+    HPy_hash_t hash;
+    HPy key;
+    HPy value;
+} map_item;
+
+/* Move all the items into a new table which is big enough for one more
+   item. The items are held by handles while they are moved, so that they
+   are never out of sight of the GC. */
+static int
+map_resize(HPyContext *ctx, HPy owner, HPyMap *map)
+{
+    HPy_ssize_t new_size = HPYMAP_MINSIZE;
+    while (new_size <= (map->size + 1) * 3)
+        new_size <<= 1;
+    HPyMap_Entry *new_entries =
+        (HPyMap_Entry *)calloc(new_size, sizeof(HPyMap_Entry));
+    map_item *items =
+        (map_item *)malloc((map->size > 0 ? map->size : 1) * sizeof(map_item));
+    if (new_entries == NULL || items == NULL) {
+        free(new_entries);
+        free(items);
+        HPyErr_NoMemory(ctx);
+        return -1;
+    }
+
+    HPyMap_Entry *old_entries = map->entries;
+    HPy_ssize_t n = 0;
+    if (old_entries != NULL) {
+        for (HPy_ssize_t j = 0; j <= map->mask; j++) {
+            HPyMap_Entry *e = &old_entries[j];
+            if (ENTRY_IS_FREE(e))
+                continue;
+            items[n].hash = e->hash;
+            items[n].key = HPyField_Load(ctx, owner, e->key);
+            items[n].value = HPyField_Load(ctx, owner, e->value);
+            HPyField_Store(ctx, owner, &e->key, HPy_NULL);
+            HPyField_Store(ctx, owner, &e->value, HPy_NULL);
+            n++;
+        }
+    }
+    free(old_entries);
+    map->entries = new_entries;
+    map->mask = new_size - 1;
+    map->size = n;
+    map->fill = n;
+
+    size_t mask = (size_t)map->mask;
+    for (HPy_ssize_t j = 0; j < n; j++) {
+        PROBE_START(items[j].hash, mask, i, perturb);
+        while (!ENTRY_IS_EMPTY(&new_entries[i])) {
+            PROBE_NEXT(mask, i, perturb);
+        }
+        HPyMap_Entry *e = &new_entries[i];
+        e->hash = items[j].hash;
+        HPyField_Store(ctx, owner, &e->key, items[j].key);
+        HPyField_Store(ctx, owner, &e->value, items[j].value);
+        HPy_Close(ctx, items[j].key);
+        HPy_Close(ctx, items[j].value);
+    }
+    free(items);
+    return 0;
+}
+
+/**
+ * Look up a key.
+ *
+ * :param ctx:
+ *     The execution context.
+ * :param owner:
+ *     The object which contains the map.
+ * :param map:
+ *     The map.
+ * :param key:
+ *     The key to look up.
+ * :param value:
+ *     If the key is found, ``*value`` is set to a new handle to the
+ *     corresponding value, which must be closed.
+ *
+ * :returns: ``1`` if the key was found, ``0`` if not, ``-1`` in case of
+ *     error (e.g. if the key is not hashable).
+ */
+HPyAPI_HELPER int
+HPyMap_Lookup(HPyContext *ctx, HPy owner, HPyMap *map, HPy key, HPy *value)
+{
+    HPy_hash_t hash = HPy_Hash(ctx, key);
+    if (hash == -1)
+        return -1;
+    if (map->size == 0)
+        return 0;
+    int found;
+    HPy_ssize_t i = map_find(ctx, owner, map, key, hash, &found);
+    if (i < 0)
+        return -1;
+    if (found)
+        *value = HPyField_Load(ctx, owner, map->entries[i].value);
+    return found;
+}
+
+/**
+ * Map ``key`` to ``value``, replacing the previous value if the key is
+ * already present. The handles are not closed.
+ *
+ * :returns: ``0`` on success, ``-1`` in case of error.
+ */
+HPyAPI_HELPER int
+HPyMap_Store(HPyContext *ctx, HPy owner, HPyMap *map, HPy key, HPy value)
+{
+    HPy_hash_t hash = HPy_Hash(ctx, key);
+    if (hash == -1)
+        return -1;
+    int found;
+    HPy_ssize_t i;
+    for (;;) {
+        if (MAP_NEEDS_RESIZE(map) && map_resize(ctx, owner, map) < 0)
+            return -1;
+        i = map_find(ctx, owner, map, key, hash, &found);
+        if (i < 0)
+            return -1;
+        // __eq__ can have cleared or filled the map: if so, make room again
+        if (found || !MAP_NEEDS_RESIZE(map))
+            break;
+    }
+    HPyMap_Entry *e = &map->entries[i];
+    if (!found) {
+        if (e->hash != HPYMAP_DELETED)
+            map->fill++;
+        map->size++;
+        e->hash = hash;
+        HPyField_Store(ctx, owner, &e->key, key);
+    }
+    HPyField_Store(ctx, owner, &e->value, value);
+    return 0;
+}
+
+/**
+ * Remove a key from the map.
+ *
+ * :returns: ``1`` if the key was removed, ``0`` if it was not present,
+ *     ``-1`` in case of error.
+ */
+HPyAPI_HELPER int
+HPyMap_Delete(HPyContext *ctx, HPy owner, HPyMap *map, HPy key)
+{
+    HPy_hash_t hash = HPy_Hash(ctx, key);
+    if (hash == -1)
+        return -1;
+    if (map->size == 0)
+        return 0;
+    int found;
+    HPy_ssize_t i = map_find(ctx, owner, map, key, hash, &found);
+    if (i < 0)
+        return -1;
+    if (!found)
+        return 0;
+    HPyMap_Entry *e = &map->entries[i];
+    // keep the old key and value alive until the map is consistent again,
+    // since their destructors can run arbitrary code
+    HPy old_key = HPyField_Load(ctx, owner, e->key);
+    HPy old_value = HPyField_Load(ctx, owner, e->value);
+    HPyField_Store(ctx, owner, &e->key, HPy_NULL);
+    HPyField_Store(ctx, owner, &e->value, HPy_NULL);
+    e->hash = HPYMAP_DELETED;
+    map->size--;
+    HPy_Close(ctx, old_key);
+    HPy_Close(ctx, old_value);
+    return 1;
+}
+
+/**
+ * Iterate over the items of the map.
+ *
+ * ``*pos`` must be initialized to ``0`` before the first call. Each call
+ * stores new handles to the next key and value in ``*key`` and ``*value``
+ * (either of them can be ``NULL`` if it is not needed), and returns ``1``;
+ * it returns ``0`` when there are no more items. The map must not be
+ * modified during the iteration.
+ */
+HPyAPI_HELPER int
+HPyMap_Next(HPyContext *ctx, HPy owner, HPyMap *map, HPy_ssize_t *pos,
+            HPy *key, HPy *value)
+{
+    if (map->entries == NULL)
+        return 0;
+    for (HPy_ssize_t i = *pos; i <= map->mask; i++) {
+        HPyMap_Entry *e = &map->entries[i];
+        if (ENTRY_IS_FREE(e))
+            continue;
+        if (key != NULL)
+            *key = HPyField_Load(ctx, owner, e->key);
+        if (value != NULL)
+            *value = HPyField_Load(ctx, owner, e->value);
+        *pos = i + 1;
+        return 1;
+    }
+    *pos = map->mask + 1;
+    return 0;
+}
+
+/**
+ * Remove all the items and release the memory of the map.
+ */
+HPyAPI_HELPER void
+HPyMap_Clear(HPyContext *ctx, HPy owner, HPyMap *map)
+{
+    // first empty the map, and only then release the items, since their
+    // destructors can run arbitrary code
+    HPyMap_Entry *entries = map->entries;
+    HPy_ssize_t n_slots = entries != NULL ? map->mask + 1 : 0;
+    map->entries = NULL;
+    map->size = map->fill = map->mask = 0;
+    for (HPy_ssize_t i = 0; i < n_slots; i++) {
+        HPyField_Store(ctx, owner, &entries[i].key, HPy_NULL);
+        HPyField_Store(ctx, owner, &entries[i].value, HPy_NULL);
+    }
+    free(entries);
+}
+
+/**
+ * Visit all the keys and values, to be called by the ``tp_traverse`` of the
+ * owner.
+ */
+HPyAPI_HELPER int
+HPyMap_Traverse(HPyMap *map, HPyFunc_visitproc visit, void *arg)
+{
+    if (map->entries == NULL)
+        return 0;
+    for (HPy_ssize_t i = 0; i <= map->mask; i++) {
+        HPy_VISIT(&map->entries[i].key);
+        HPy_VISIT(&map->entries[i].value);
+    }
+    return 0;
+}
+
+/**
+ * Release the memory of the map, to be called by the ``tp_destroy`` of the
+ * owner. Since ``tp_destroy`` cannot use the context, it does not release
+ * the items: this is done automatically before ``tp_destroy`` is called,
+ * because ``HPyMap_Traverse`` reports them to HPy.
+ */
+HPyAPI_HELPER void
+HPyMap_Free(HPyMap *map)
+{
+    free(map->entries);
+    map->entries = NULL;
+    map->size = map->fill = map->mask = 0;
+}
@@ -0,0 +1,356 @@
+/**
+ * Sorting lists with native comparators and keys.
+ *
+ * Sorting a list of objects by a property which is known only to the
+ * extension usually means calling ``list.sort(key=...)`` with a Python
+ * callable, which calls back into the extension for every item. These
+ * functions sort a list in place by calling a C function instead:
+ *
+ *   - ``HPyList_Sort`` takes a "less than" function over handles and does a
+ *     merge sort;
+ *
+ *   - ``HPyList_SortByDoubleKey`` and ``HPyList_SortByInt64Key`` call a C
+ *     function once per item to extract a numeric key, and then sort the
+ *     keys with a radix sort, without calling anything else.
+ *
+ * Like ``list.sort()``, all of them are stable. If a callback fails, the
+ * list is left unchanged.
+ *
+ * Example:
+ *
+ * .. code-block:: c
+ *
+ *     static int get_score(HPyContext *ctx, HPy item, double *key, void *arg)
+ *     {
+ *         *key = ResultObject_AsStruct(ctx, item)->score;
+ *         return 0;
+ *     }
+ *
+ *     ...
+ *     // highest score first
+ *     if (HPyList_SortByDoubleKey(ctx, h_results, get_score, NULL, 1) < 0)
+ *         return HPy_NULL;
+ *
+ * List Sort API
+ * -------------
+ *
+ */
+
+#include "hpy.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* below this size, insertion sort is faster than both merge and radix sort */
+#define LISTSORT_SMALL 16
+
+#define KEY_SIGN_BIT ((uint64_t)1 << 63)
+
+/* Return a malloc()ed array with new handles to all the items of the list,
+   or NULL in case of error */
+static HPy *
+list_get_items(HPyContext *ctx, HPy h_list, HPy_ssize_t *pn)
+{
+    if (!HPyList_Check(ctx, h_list)) {
+        HPyErr_SetString(ctx, ctx->h_TypeError, "expected a list");
+        return NULL;
+    }
+    HPy_ssize_t n = HPy_Length(ctx, h_list);
+    if (n < 0)
+        return NULL;
+    HPy *items = (HPy *)malloc((n > 0 ? n : 1) * sizeof(HPy));
+    if (items == NULL) {
+        HPyErr_NoMemory(ctx);
+        return NULL;
+    }
+    for (HPy_ssize_t i = 0; i < n; i++) {
+        items[i] = HPy_GetItem_i(ctx, h_list, i);
+        if (HPy_IsNull(items[i])) {
+            while (i > 0)
+                HPy_Close(ctx, items[--i]);
+            free(items);
+            return NULL;
+        }
+    }
+    *pn = n;
+    return items;
+}
+
+static void
+close_items(HPyContext *ctx, HPy *items, HPy_ssize_t n)
+{
+    for (HPy_ssize_t i = 0; i < n; i++)
+        HPy_Close(ctx, items[i]);
+}
+
+static int
+list_set_items(HPyContext *ctx, HPy h_list, HPy *items, HPy_ssize_t n)
+{
+    if (HPy_Length(ctx, h_list) != n) {
+        HPyErr_SetString(ctx, ctx->h_ValueError, "list modified during sort");
+        return -1;
+    }
+    for (HPy_ssize_t i = 0; i < n; i++) {
+        if (HPy_SetItem_i(ctx, h_list, i, items[i]) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+/* ~~~ merge sort ~~~ */
+
+/* Sort items[0:n] using tmp[0:n/2] as scratch space. In case of error,
+   items is still a permutation of the original handles, so that they can
+   all be closed. */
+static int
+merge_sort(HPyContext *ctx, HPy *items, HPy *tmp, HPy_ssize_t n,
+           HPyList_LessThanFunc lt, void *arg)
+{
+    if (n <= LISTSORT_SMALL) {
+        for (HPy_ssize_t i = 1; i < n; i++) {
+            HPy x = items[i];
+            HPy_ssize_t j = i;
+            while (j > 0) {
+                int r = lt(ctx, x, items[j - 1], arg);
+                if (r < 0) {
+                    items[j] = x;
+                    return -1;
+                }
+                if (!r)
+                    break;
+                items[j] = items[j - 1];
+                j--;
+            }
+            items[j] = x;
+        }
+        return 0;
+    }
+
+    HPy_ssize_t mid = n / 2;
+    if (merge_sort(ctx, items, tmp, mid, lt, arg) < 0 ||
+        merge_sort(ctx, items + mid, tmp, n - mid, lt, arg) < 0)
+        return -1;
+
+    // nothing to do if the two halves are already in order
+    int r = lt(ctx, items[mid], items[mid - 1], arg);
+    if (r <= 0)
+        return r;
+
+    // merge: the left half is moved to tmp, and the output is written from
+    // the start of items. Since the output never overtakes the right half,
+    // the free slots are always exactly as many as the items left in tmp.
+    memcpy(tmp, items, mid * sizeof(HPy));
+    HPy_ssize_t i = 0, j = mid, k = 0;
+    while (i < mid && j < n) {
+        r = lt(ctx, items[j], tmp[i], arg);
+        if (r < 0) {
+            memcpy(items + k, tmp + i, (mid - i) * sizeof(HPy));
+            return -1;
+        }
+        items[k++] = r ? items[j++] : tmp[i++];
+    }
+    memcpy(items + k, tmp + i, (mid - i) * sizeof(HPy));
+    return 0;
+}
+
+/**
+ * Sort a list in place, using a C "less than" function.
+ *
+ * :param ctx:
+ *     The execution context.
+ * :param h_list:
+ *     The list to sort.
+ * :param lt:
+ *     A function which returns ``1`` if its first argument must come
+ *     before the second one, ``0`` if not, and ``-1`` in case of error. The
+ *     handles passed to it are borrowed. For a descending sort which keeps
+ *     equal items in their original order, like ``reverse=True``, swap the
+ *     arguments.
+ * :param arg:
+ *     Passed as is to ``lt``.
+ *
+ * :returns: ``0`` on success, ``-1`` in case of error.
+ */
+HPyAPI_HELPER int
+HPyList_Sort(HPyContext *ctx, HPy h_list, HPyList_LessThanFunc lt, void *arg)
+{
+    HPy_ssize_t n;
+    HPy *items = list_get_items(ctx, h_list, &n);
+    if (items == NULL)
+        return -1;
+    int res = -1;
+    HPy *tmp = (HPy *)malloc((n / 2 + 1) * sizeof(HPy));
+    if (tmp == NULL)
+        HPyErr_NoMemory(ctx);
+    else if (merge_sort(ctx, items, tmp, n, lt, arg) == 0)
+        res = list_set_items(ctx, h_list, items, n);
+    free(tmp);
+    close_items(ctx, items, n);
+    free(items);
+    return res;
+}
+
+/* ~~~ radix sort ~~~ */
+
+typedef struct {
+    uint64_t key;
+    HPy_ssize_t index;
+} listsort_key;
+
+/* Stable LSD radix sort of keys[0:n] on 8-bit digits, using tmp[0:n] as
+   scratch space. The passes in which all the keys have the same digit are
+   skipped, so e.g. small non-negative int64 keys need only one or two. */
+static void
+radix_sort(listsort_key *keys, listsort_key *tmp, HPy_ssize_t n)
+{
+    if (n <= LISTSORT_SMALL) {
+        for (HPy_ssize_t i = 1; i < n; i++) {
+            listsort_key x = keys[i];
+            HPy_ssize_t j = i;
+            for (; j > 0 && x.key < keys[j - 1].key; j--)
+                keys[j] = keys[j - 1];
+            keys[j] = x;
+        }
+        return;
+    }
+
+    static const int n_passes = 8;
+    HPy_ssize_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+    for (HPy_ssize_t i = 0; i < n; i++) {
+        uint64_t k = keys[i].key;
+        for (int pass = 0; pass < n_passes; pass++)
+            counts[pass][(k >> (8 * pass)) & 0xff]++;
+    }
+
+    listsort_key *src = keys, *dst = tmp;
+    for (int pass = 0; pass < n_passes; pass++) {
+        HPy_ssize_t *count = counts[pass];
+        int shift = 8 * pass;
+        if (count[(src[0].key >> shift) & 0xff] == n)
+            continue;
+        HPy_ssize_t offset = 0;
+        for (int d = 0; d < 256; d++) {
+            HPy_ssize_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (HPy_ssize_t i = 0; i < n; i++)
+            dst[count[(src[i].key >> shift) & 0xff]++] = src[i];
+        listsort_key *t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != keys)
+        memcpy(keys, src, n * sizeof(listsort_key));
+}
+
+/* Map a double to an uint64_t with the same order. -0.0 is mapped like
+   0.0, since they compare equal, and NaNs after +inf. */
+static uint64_t
+double_to_key(double d)
+{
+    uint64_t u;
+    if (d == 0.0)
+        d = 0.0;
+    if (d != d)
+        u = 0x7ff8000000000000ULL;
+    else
+        memcpy(&u, &d, sizeof(u));
+    return (u & KEY_SIGN_BIT) ? ~u : (u | KEY_SIGN_BIT);
+}
+
+static int
+list_sort_by_key(HPyContext *ctx, HPy h_list, HPyList_DoubleKeyFunc double_key,
+                 HPyList_Int64KeyFunc int64_key, void *arg, int reverse)
+{
+    HPy_ssize_t n;
+    HPy *items = list_get_items(ctx, h_list, &n);
+    if (items == NULL)
+        return -1;
+    int res = -1;
+    HPy *sorted = NULL;
+    listsort_key *keys = (listsort_key *)malloc(
+        (n > 0 ? 2 * n : 1) * sizeof(listsort_key));
+    if (keys == NULL) {
+        HPyErr_NoMemory(ctx);
+        goto exit;
+    }
+    for (HPy_ssize_t i = 0; i < n; i++) {
+        uint64_t k;
+        int is_nan = 0;
+        if (double_key != NULL) {
+            double d;
+            if (double_key(ctx, items[i], &d, arg) < 0)
+                goto exit;
+            is_nan = (d != d);
+            k = double_to_key(d);
+        }
+        else {
+            int64_t v;
+            if (int64_key(ctx, items[i], &v, arg) < 0)
+                goto exit;
+            k = (uint64_t)v ^ KEY_SIGN_BIT;
+        }
+        // complementing the keys reverses the order without changing the
+        // relative order of equal keys, like reverse=True. The NaNs are not
+        // complemented, so that they stay last.
+        keys[i].key = (reverse && !is_nan) ? ~k : k;
+        keys[i].index = i;
+    }
+    radix_sort(keys, keys + n, n);
+
+    sorted = (HPy *)malloc((n > 0 ? n : 1) * sizeof(HPy));
+    if (sorted == NULL) {
+        HPyErr_NoMemory(ctx);
+        goto exit;
+    }
+    for (HPy_ssize_t i = 0; i < n; i++)
+        sorted[i] = items[keys[i].index];
+    res = list_set_items(ctx, h_list, sorted, n);
+
+ exit:
+    free(sorted);
+    free(keys);
+    close_items(ctx, items, n);
+    free(items);
+    return res;
+}
+
+/**
+ * Sort a list in place, by a ``double`` key computed by a C function.
+ *
+ * :param ctx:
+ *     The execution context.
+ * :param h_list:
+ *     The list to sort.
+ * :param key:
+ *     A function which stores the key of the given item in ``*key`` and
+ *     returns ``0``, or returns ``-1`` in case of error. It is called
+ *     exactly once for every item, in order. NaNs are sorted after all the
+ *     other values, also if ``reverse`` is true.
+ * :param arg:
+ *     Passed as is to ``key``.
+ * :param reverse:
+ *     If true, sort in descending order, keeping the items with equal keys
+ *     in their original order like ``list.sort(reverse=True)``.
+ *
+ * :returns: ``0`` on success, ``-1`` in case of error.
+ */
+HPyAPI_HELPER int
+HPyList_SortByDoubleKey(HPyContext *ctx, HPy h_list,
+                        HPyList_DoubleKeyFunc key, void *arg, int reverse)
+{
+    return list_sort_by_key(ctx, h_list, key, NULL, arg, reverse);
+}
+
+/**
+ * Sort a list in place, by an ``int64_t`` key computed by a C function.
+ *
+ * It is the same as ``HPyList_SortByDoubleKey``, but for integer keys.
+ */
+HPyAPI_HELPER int
+HPyList_SortByInt64Key(HPyContext *ctx, HPy h_list,
+                       HPyList_Int64KeyFunc key, void *arg, int reverse)
+{
+    return list_sort_by_key(ctx, h_list, NULL, key, arg, reverse);
+}
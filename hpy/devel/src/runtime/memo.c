@@ -0,0 +1,525 @@
+/**
+ * Memoised functions.
+ *
+ * ``HPyMemo_New`` wraps the implementation of an ``HPyDef_METH`` in a
+ * callable object which caches its results, like ``functools.lru_cache``
+ * but without a Python-level call in between: the arguments are looked up
+ * in C and, if they are found, the implementation is not called at all.
+ *
+ * The cache is keyed on the positional arguments, which must be hashable,
+ * and compares them by equality. It keeps at most ``maxsize`` results and,
+ * when it is full, discards the least recently used one. Calls with keyword
+ * arguments and calls which raise an exception are never cached. Keys and
+ * results are stored in ``HPyField`` s of the callable, so they are visible
+ * to the GC.
+ *
+ * Like ``functools.lru_cache``, the callable has a ``cache_info()`` method,
+ * which returns the tuple ``(hits, misses, maxsize, currsize)``, and a
+ * ``cache_clear()`` method.
+ *
+ * Example:
+ *
+ * .. code-block:: c
+ *
+ *     HPyDef_METH(distance, "distance", distance_impl, HPyFunc_VARARGS)
+ *     static HPy distance_impl(HPyContext *ctx, HPy self, HPy *args,
+ *                              HPy_ssize_t nargs)
+ *     {
+ *         ...
+ *     }
+ *
+ *     // in the init function, instead of listing &distance in the
+ *     // defines of the module
+ *     HPy h_distance = HPyMemo_New(ctx, h_module, &distance, 1024);
+ *     if (HPy_IsNull(h_distance) ||
+ *             HPy_SetAttr_s(ctx, h_module, "distance", h_distance) < 0)
+ *         ...
+ *
+ * Memo API
+ * --------
+ *
+ */
+
+#include "hpy.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MEMO_MINSIZE 8
+
+/* the values of the index table which are not an entry */
+#define MEMO_EMPTY (-1)
+#define MEMO_DUMMY (-2)
+
+/* the same probe sequence as HPyMap and CPython's dicts */
+#define PROBE_START(hash, mask, i, perturb)                             \
+    size_t perturb = (size_t)(hash);                                    \
+    size_t i = (size_t)(hash) & (mask)
+#define PROBE_NEXT(mask, i, perturb)                                    \
+    perturb >>= 5;                                                      \
+    i = (i * 5 + perturb + 1) & (mask)
+
+typedef struct {
+    HPy_hash_t hash;
+    HPy_ssize_t nargs;        /* the key is the argument itself if nargs is
+                                 1, None if 0, else a tuple */
+    HPy_ssize_t prev, next;   /* the LRU list, terminated by -1 */
+    HPyField key;
+    HPyField value;
+} memo_entry;
+
+typedef struct {
+    HPyField self;            /* passed as 'self' to the impl */
+    HPyDef *def;
+    HPy_ssize_t maxsize;
+    HPy_ssize_t size;         /* number of entries in use */
+    HPy_ssize_t allocated;    /* number of allocated entries */
+    memo_entry *entries;
+    HPy_ssize_t *index;       /* maps a hash to an entry or MEMO_EMPTY/DUMMY */
+    HPy_ssize_t mask;         /* number of slots in index - 1 */
+    HPy_ssize_t fill;         /* number of slots in index which are not empty */
+    HPy_ssize_t head, tail;   /* the most and least recently used entries */
+    HPy_ssize_t hits, misses;
+    size_t version;           /* incremented whenever the index changes */
+} MemoObject;
+
+HPyType_HELPERS(MemoObject)
+
+/* ~~~ LRU list ~~~ */
+
+static void
+lru_unlink(MemoObject *m, HPy_ssize_t ix)
+{
+    memo_entry *e = &m->entries[ix];
+    if (e->prev >= 0)
+        m->entries[e->prev].next = e->next;
+    else
+        m->head = e->next;
+    if (e->next >= 0)
+        m->entries[e->next].prev = e->prev;
+    else
+        m->tail = e->prev;
+}
+
+static void
+lru_push_front(MemoObject *m, HPy_ssize_t ix)
+{
+    memo_entry *e = &m->entries[ix];
+    e->prev = -1;
+    e->next = m->head;
+    if (m->head >= 0)
+        m->entries[m->head].prev = ix;
+    else
+        m->tail = ix;
+    m->head = ix;
+}
+
+/* ~~~ hash table ~~~ */
+
+/* Return the index of the entry whose key is equal to 'key', -1 if there is
+   none, or -2 in case of error */
+static HPy_ssize_t
+memo_find(HPyContext *ctx, HPy h_memo, MemoObject *m, HPy key,
+          HPy_hash_t hash, HPy_ssize_t nargs)
+{
+ restart:
+    if (m->index == NULL)
+        return -1;
+    size_t version = m->version;
+    PROBE_START(hash, m->mask, i, perturb);
+    for (;;) {
+        HPy_ssize_t ix = m->index[i];
+        if (ix == MEMO_EMPTY)
+            return -1;
+        if (ix >= 0 && m->entries[ix].hash == hash &&
+                m->entries[ix].nargs == nargs) {
+            HPy h_key = HPyField_Load(ctx, h_memo, m->entries[ix].key);
+            int eq = HPy_RichCompareBool(ctx, h_key, key, HPy_EQ);
+            HPy_Close(ctx, h_key);
+            if (eq < 0)
+                return -2;
+            // __eq__ can run arbitrary code, which can modify the cache
+            if (m->version != version)
+                goto restart;
+            if (eq)
+                return ix;
+        }
+        PROBE_NEXT(m->mask, i, perturb);
+    }
+}
+
+static void
+index_insert(MemoObject *m, HPy_ssize_t ix)
+{
+    PROBE_START(m->entries[ix].hash, m->mask, i, perturb);
+    while (m->index[i] >= 0) {
+        PROBE_NEXT(m->mask, i, perturb);
+    }
+    if (m->index[i] == MEMO_EMPTY)
+        m->fill++;
+    m->index[i] = ix;
+}
+
+static void
+index_remove(MemoObject *m, HPy_ssize_t ix)
+{
+    PROBE_START(m->entries[ix].hash, m->mask, i, perturb);
+    while (m->index[i] != ix) {
+        PROBE_NEXT(m->mask, i, perturb);
+    }
+    m->index[i] = MEMO_DUMMY;
+}
+
+/* Make sure that there is room in the index for one more entry, rebuilding
+   it without the dummy slots if needed */
+static int
+index_reserve(HPyContext *ctx, MemoObject *m)
+{
+    HPy_ssize_t n_slots = m->index != NULL ? m->mask + 1 : 0;
+    if ((m->fill + 1) * 3 < n_slots * 2)
+        return 0;
+    HPy_ssize_t new_slots = MEMO_MINSIZE;
+    while (new_slots * 2 <= (m->size + 1) * 3)
+        new_slots *= 2;
+    HPy_ssize_t *index = (HPy_ssize_t *)malloc(new_slots * sizeof(HPy_ssize_t));
+    if (index == NULL) {
+        HPyErr_NoMemory(ctx);
+        return -1;
+    }
+    for (HPy_ssize_t i = 0; i < new_slots; i++)
+        index[i] = MEMO_EMPTY;
+    free(m->index);
+    m->index = index;
+    m->mask = new_slots - 1;
+    m->fill = 0;
+    for (HPy_ssize_t ix = m->head; ix >= 0; ix = m->entries[ix].next)
+        index_insert(m, ix);
+    m->version++;
+    return 0;
+}
+
+static int
+entries_grow(HPyContext *ctx, HPy h_memo, MemoObject *m)
+{
+    HPy_ssize_t new_allocated = m->allocated * 2;
+    if (new_allocated < MEMO_MINSIZE)
+        new_allocated = MEMO_MINSIZE;
+    if (new_allocated > m->maxsize)
+        new_allocated = m->maxsize;
+    memo_entry *entries = (memo_entry *)calloc(new_allocated, sizeof(memo_entry));
+    if (entries == NULL) {
+        HPyErr_NoMemory(ctx);
+        return -1;
+    }
+    // move the fields through handles, as HPyField is opaque
+    memo_entry *old = m->entries;
+    for (HPy_ssize_t i = 0; i < m->size; i++) {
+        entries[i] = old[i];
+        entries[i].key = HPyField_NULL;
+        entries[i].value = HPyField_NULL;
+        HPy h_key = HPyField_Load(ctx, h_memo, old[i].key);
+        HPy h_value = HPyField_Load(ctx, h_memo, old[i].value);
+        HPyField_Store(ctx, h_memo, &entries[i].key, h_key);
+        HPyField_Store(ctx, h_memo, &entries[i].value, h_value);
+        HPyField_Store(ctx, h_memo, &old[i].key, HPy_NULL);
+        HPyField_Store(ctx, h_memo, &old[i].value, HPy_NULL);
+        HPy_Close(ctx, h_key);
+        HPy_Close(ctx, h_value);
+    }
+    m->entries = entries;
+    m->allocated = new_allocated;
+    free(old);
+    return 0;
+}
+
+/* Store a new entry, which must not be in the cache yet. If the cache is
+   full, the least recently used entry is discarded. */
+static int
+memo_insert(HPyContext *ctx, HPy h_memo, MemoObject *m, HPy key,
+            HPy_hash_t hash, HPy_ssize_t nargs, HPy value)
+{
+    HPy old_key = HPy_NULL, old_value = HPy_NULL;
+    HPy_ssize_t ix;
+    if (index_reserve(ctx, m) < 0)
+        return -1;
+    if (m->size < m->maxsize) {
+        if (m->size == m->allocated && entries_grow(ctx, h_memo, m) < 0)
+            return -1;
+        ix = m->size++;
+    }
+    else {
+        ix = m->tail;
+        index_remove(m, ix);
+        lru_unlink(m, ix);
+        // the old key and value are released only at the end, since their
+        // destructors can run arbitrary code
+        old_key = HPyField_Load(ctx, h_memo, m->entries[ix].key);
+        old_value = HPyField_Load(ctx, h_memo, m->entries[ix].value);
+    }
+    memo_entry *e = &m->entries[ix];
+    e->hash = hash;
+    e->nargs = nargs;
+    HPyField_Store(ctx, h_memo, &e->key, key);
+    HPyField_Store(ctx, h_memo, &e->value, value);
+    index_insert(m, ix);
+    lru_push_front(m, ix);
+    m->version++;
+    if (!HPy_IsNull(old_key)) {
+        HPy_Close(ctx, old_key);
+        HPy_Close(ctx, old_value);
+    }
+    return 0;
+}
+
+/* ~~~ the memoized function type ~~~ */
+
+static HPy
+memo_call_impl(HPyContext *ctx, HPy h_memo, MemoObject *m,
+               HPy *args, HPy_ssize_t nargs, HPy kw)
+{
+    HPyMeth *meth = &m->def->meth;
+    HPy self = HPyField_Load(ctx, h_memo, m->self);
+    HPy res;
+    switch (meth->signature) {
+    case HPyFunc_NOARGS:
+        res = ((HPyFunc_noargs)meth->impl)(ctx, self);
+        break;
+    case HPyFunc_O:
+        res = ((HPyFunc_o)meth->impl)(ctx, self, args[0]);
+        break;
+    case HPyFunc_VARARGS:
+        res = ((HPyFunc_varargs)meth->impl)(ctx, self, args, nargs);
+        break;
+    default:
+        res = ((HPyFunc_keywords)meth->impl)(ctx, self, args, nargs, kw);
+        break;
+    }
+    HPy_Close(ctx, self);
+    return res;
+}
+
+static int
+memo_check_args(HPyContext *ctx, HPyMeth *meth, HPy_ssize_t nargs)
+{
+    const char *fmt;
+    if (meth->signature == HPyFunc_NOARGS && nargs != 0)
+        fmt = "%.200s() takes no arguments (%zd given)";
+    else if (meth->signature == HPyFunc_O && nargs != 1)
+        fmt = "%.200s() takes exactly one argument (%zd given)";
+    else
+        return 0;
+    char msg[300];
+    snprintf(msg, sizeof(msg), fmt, meth->name, nargs);
+    HPyErr_SetString(ctx, ctx->h_TypeError, msg);
+    return -1;
+}
+
+HPyDef_SLOT(memo_call, memo_call_slot_impl, HPy_tp_call)
+static HPy memo_call_slot_impl(HPyContext *ctx, HPy h_memo, HPy *args,
+                               HPy_ssize_t nargs, HPy kw)
+{
+    MemoObject *m = MemoObject_AsStruct(ctx, h_memo);
+    HPyMeth *meth = &m->def->meth;
+    if (!HPy_IsNull(kw)) {
+        HPy_ssize_t n_kw = HPy_Length(ctx, kw);
+        if (n_kw < 0)
+            return HPy_NULL;
+        if (n_kw > 0) {
+            if (meth->signature != HPyFunc_KEYWORDS) {
+                char msg[300];
+                snprintf(msg, sizeof(msg),
+                         "%.200s() takes no keyword arguments", meth->name);
+                HPyErr_SetString(ctx, ctx->h_TypeError, msg);
+                return HPy_NULL;
+            }
+            return memo_call_impl(ctx, h_memo, m, args, nargs, kw);
+        }
+    }
+    if (memo_check_args(ctx, meth, nargs) < 0)
+        return HPy_NULL;
+
+    HPy key;
+    if (nargs == 1)
+        key = HPy_Dup(ctx, args[0]);
+    else if (nargs == 0)
+        key = HPy_Dup(ctx, ctx->h_None);
+    else
+        key = HPyTuple_FromArray(ctx, args, nargs);
+    if (HPy_IsNull(key))
+        return HPy_NULL;
+    HPy res = HPy_NULL;
+    HPy_hash_t hash = HPy_Hash(ctx, key);
+    if (hash == -1 && HPyErr_Occurred(ctx))
+        goto exit;
+    HPy_ssize_t ix = memo_find(ctx, h_memo, m, key, hash, nargs);
+    if (ix == -2)
+        goto exit;
+    if (ix >= 0) {
+        m->hits++;
+        if (ix != m->head) {
+            lru_unlink(m, ix);
+            lru_push_front(m, ix);
+        }
+        res = HPyField_Load(ctx, h_memo, m->entries[ix].value);
+        goto exit;
+    }
+
+    m->misses++;
+    res = memo_call_impl(ctx, h_memo, m, args, nargs, kw);
+    if (HPy_IsNull(res))
+        goto exit;
+    // the impl might have stored the same key in the meantime, e.g. if it
+    // is recursive: in that case, keep the existing entry
+    ix = memo_find(ctx, h_memo, m, key, hash, nargs);
+    if (ix == -2 ||
+            (ix == -1 && memo_insert(ctx, h_memo, m, key, hash, nargs, res) < 0)) {
+        HPy_Close(ctx, res);
+        res = HPy_NULL;
+    }
+ exit:
+    HPy_Close(ctx, key);
+    return res;
+}
+
+HPyDef_METH(memo_cache_info, "cache_info", memo_cache_info_impl, HPyFunc_NOARGS,
+            .doc = "Return the tuple (hits, misses, maxsize, currsize).")
+static HPy memo_cache_info_impl(HPyContext *ctx, HPy h_memo)
+{
+    MemoObject *m = MemoObject_AsStruct(ctx, h_memo);
+    return HPy_BuildValue(ctx, "(LLLL)", (long long)m->hits,
+                          (long long)m->misses, (long long)m->maxsize,
+                          (long long)m->size);
+}
+
+HPyDef_METH(memo_cache_clear, "cache_clear", memo_cache_clear_impl, HPyFunc_NOARGS,
+            .doc = "Clear the cache and its statistics.")
+static HPy memo_cache_clear_impl(HPyContext *ctx, HPy h_memo)
+{
+    MemoObject *m = MemoObject_AsStruct(ctx, h_memo);
+    // first empty the cache, and only then release the items, since their
+    // destructors can run arbitrary code
+    memo_entry *entries = m->entries;
+    HPy_ssize_t size = m->size;
+    free(m->index);
+    m->entries = NULL;
+    m->index = NULL;
+    m->size = m->allocated = m->mask = m->fill = 0;
+    m->head = m->tail = -1;
+    m->hits = m->misses = 0;
+    m->version++;
+    for (HPy_ssize_t i = 0; i < size; i++) {
+        HPyField_Store(ctx, h_memo, &entries[i].key, HPy_NULL);
+        HPyField_Store(ctx, h_memo, &entries[i].value, HPy_NULL);
+    }
+    free(entries);
+    return HPy_Dup(ctx, ctx->h_None);
+}
+
+HPyDef_GET(memo_name, "__name__", memo_name_get)
+static HPy memo_name_get(HPyContext *ctx, HPy h_memo, void *closure)
+{
+    return HPyUnicode_FromString(ctx, MemoObject_AsStruct(ctx, h_memo)->def->meth.name);
+}
+
+HPyDef_SLOT(memo_traverse, memo_traverse_impl, HPy_tp_traverse)
+static int memo_traverse_impl(void *self, HPyFunc_visitproc visit, void *arg)
+{
+    MemoObject *m = (MemoObject *)self;
+    HPy_VISIT(&m->self);
+    for (HPy_ssize_t i = 0; i < m->size; i++) {
+        HPy_VISIT(&m->entries[i].key);
+        HPy_VISIT(&m->entries[i].value);
+    }
+    return 0;
+}
+
+HPyDef_SLOT(memo_destroy, memo_destroy_impl, HPy_tp_destroy)
+static void memo_destroy_impl(void *self)
+{
+    MemoObject *m = (MemoObject *)self;
+    free(m->entries);
+    free(m->index);
+}
+
+static HPyDef *memo_defines[] = {
+    &memo_call,
+    &memo_cache_info,
+    &memo_cache_clear,
+    &memo_name,
+    &memo_traverse,
+    &memo_destroy,
+    NULL
+};
+
+static HPyType_Spec memo_spec = {
+    .name = "hpy.memoized_function",
+    .basicsize = sizeof(MemoObject),
+    .flags = HPy_TPFLAGS_DEFAULT | HPy_TPFLAGS_HAVE_GC,
+    .defines = memo_defines,
+};
+
+// the type of the memoized functions is created by the first call to
+// HPyMemo_New and shared by all the following ones
+static HPyGlobal memo_type;
+
+static HPy memo_get_type(HPyContext *ctx)
+{
+    HPy h_type = HPyGlobal_Load(ctx, memo_type);
+    if (!HPy_IsNull(h_type))
+        return h_type;
+    // if two threads get here at the same time, both create a type and the
+    // last one is stored: this is harmless
+    h_type = HPyType_FromSpec(ctx, &memo_spec, NULL);
+    if (!HPy_IsNull(h_type))
+        HPyGlobal_Store(ctx, &memo_type, h_type);
+    return h_type;
+}
+
+/**
+ * Create a callable which calls the implementation of ``def`` and caches
+ * its results.
+ *
+ * :param ctx:
+ *     The execution context.
+ * :param self:
+ *     The object to pass as ``self`` to the implementation, usually the
+ *     module. The callable keeps it alive.
+ * :param def:
+ *     An ``HPyDef_METH`` with signature ``HPyFunc_NOARGS``, ``HPyFunc_O``,
+ *     ``HPyFunc_VARARGS`` or ``HPyFunc_KEYWORDS``. It must stay alive as
+ *     long as the callable, so it is usually static data.
+ * :param maxsize:
+ *     The maximum number of results to keep, which must be positive.
+ *
+ * :returns: a handle to the new callable, or ``HPy_NULL`` in case of error.
+ */
+HPyAPI_HELPER HPy
+HPyMemo_New(HPyContext *ctx, HPy self, HPyDef *def, HPy_ssize_t maxsize)
+{
+    if (def->kind != HPyDef_Kind_Meth ||
+            (def->meth.signature != HPyFunc_NOARGS &&
+             def->meth.signature != HPyFunc_O &&
+             def->meth.signature != HPyFunc_VARARGS &&
+             def->meth.signature != HPyFunc_KEYWORDS)) {
+        HPyErr_SetString(ctx, ctx->h_TypeError,
+                         "HPyMemo_New requires an HPyDef_METH with signature "
+                         "NOARGS, O, VARARGS or KEYWORDS");
+        return HPy_NULL;
+    }
+    if (maxsize <= 0) {
+        HPyErr_SetString(ctx, ctx->h_ValueError, "maxsize must be positive");
+        return HPy_NULL;
+    }
+    HPy h_type = memo_get_type(ctx);
+    if (HPy_IsNull(h_type))
+        return HPy_NULL;
+    MemoObject *m;
+    HPy h_memo = HPy_New(ctx, h_type, &m);
+    HPy_Close(ctx, h_type);
+    if (HPy_IsNull(h_memo))
+        return HPy_NULL;
+    HPyField_Store(ctx, h_memo, &m->self, self);
+    m->def = def;
+    m->maxsize = maxsize;
+    m->head = m->tail = -1;
+    return h_memo;
+}
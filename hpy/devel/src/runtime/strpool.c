@@ -0,0 +1,312 @@
+/**
+ * Pools of canonical strings.
+ *
+ * Decoders which create many repeated strings (e.g. the keys of JSON
+ * objects, the headers of CSV files or the values of an enumeration) end
+ * up with many equal but distinct unicode objects if they call
+ * ``HPyUnicode_FromString`` for each occurrence. ``HPyStrPool`` maps raw
+ * UTF-8 bytes to a canonical unicode object, so that each distinct string
+ * is decoded and allocated only once.
+ *
+ * The pool is looked up with a fast non-cryptographic hash of the bytes,
+ * which are then compared with ``memcmp``: a hit does not decode anything
+ * and does not allocate any object, it only creates a new handle.
+ *
+ * The pool is bounded: it contains at most ``max_size`` strings (by default
+ * ``HPYSTRPOOL_DEFAULT_MAXSIZE``) and when it is full it is emptied before
+ * storing the next one. Strings longer than ``HPYSTRPOOL_MAX_LENGTH`` bytes
+ * are never stored. In both cases the strings are simply decoded as usual,
+ * so the result is always correct, only the sharing is lost.
+ *
+ * As for ``HPyMap``, the pool is embedded in the struct of a custom type,
+ * e.g. the decoder, and it lives as long as its owner. The strings are
+ * stored as ``HPyField`` s, so the owner type must:
+ *
+ *   - call ``HPyStrPool_Traverse`` in its ``tp_traverse``;
+ *
+ *   - call ``HPyStrPool_Free`` in its ``tp_destroy``.
+ *
+ * Example:
+ *
+ * .. code-block:: c
+ *
+ *     typedef struct {
+ *         HPyStrPool keys;
+ *     } DecoderObject;
+ *
+ *     HPyType_HELPERS(DecoderObject)
+ *
+ *     HPyDef_SLOT(Decoder_traverse, Decoder_traverse_impl, HPy_tp_traverse)
+ *     static int Decoder_traverse_impl(void *self, HPyFunc_visitproc visit,
+ *                                      void *arg)
+ *     {
+ *         return HPyStrPool_Traverse(&((DecoderObject *)self)->keys, visit, arg);
+ *     }
+ *
+ *     HPyDef_SLOT(Decoder_destroy, Decoder_destroy_impl, HPy_tp_destroy)
+ *     static void Decoder_destroy_impl(void *self)
+ *     {
+ *         HPyStrPool_Free(&((DecoderObject *)self)->keys);
+ *     }
+ *
+ *     ...
+ *     DecoderObject *d = DecoderObject_AsStruct(ctx, h_self);
+ *     HPy h_key = HPyStrPool_Get(ctx, h_self, &d->keys, start, end - start);
+ *
+ * HPyStrPool API
+ * --------------
+ *
+ */
+
+#include "hpy.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HPYSTRPOOL_MINSIZE 8
+
+#define ENTRY_IS_FREE(e) (HPyField_IsNull((e)->value))
+
+/* The same probe sequence as HPyMap */
+#define PROBE_START(hash, mask, i, perturb)                             \
+    size_t perturb = (size_t)(hash);                                    \
+    size_t i = (size_t)(hash) & (mask)
+#define PROBE_NEXT(mask, i, perturb)                                    \
+    perturb >>= 5;                                                      \
+    i = (i * 5 + perturb + 1) & (mask)
+
+/* Hash 8 bytes at a time, mixing each word with a multiplication. The
+   strings are usually short, so this matters more than the quality of the
+   distribution, which is improved anyway by the final avalanche. */
+static size_t
+strpool_hash(const char *s, HPy_ssize_t n)
+{
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ (uint64_t)n;
+    uint64_t w;
+    while (n >= 8) {
+        memcpy(&w, s, 8);
+        h = (h ^ w) * 0xff51afd7ed558ccdULL;
+        h ^= h >> 32;
+        s += 8;
+        n -= 8;
+    }
+    if (n > 0) {
+        w = 0;
+        memcpy(&w, s, (size_t)n);
+        h = (h ^ w) * 0xff51afd7ed558ccdULL;
+    }
+    h ^= h >> 29;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 32;
+    return (size_t)h;
+}
+
+/* Release all the strings but keep the memory, which is reused */
+static void
+strpool_empty(HPyContext *ctx, HPy owner, HPyStrPool *pool)
+{
+    pool->size = 0;
+    pool->chars_used = 0;
+    if (pool->entries == NULL)
+        return;
+    for (HPy_ssize_t i = 0; i <= pool->mask; i++)
+        HPyField_Store(ctx, owner, &pool->entries[i].value, HPy_NULL);
+}
+
+/* Move all the strings into a new table which is big enough for one more
+   string. As in HPyMap, they are held by handles while they are moved. */
+static int
+strpool_resize(HPyContext *ctx, HPy owner, HPyStrPool *pool)
+{
+    HPy_ssize_t new_size = HPYSTRPOOL_MINSIZE;
+    while (new_size <= (pool->size + 1) * 3 / 2)
+        new_size <<= 1;
+    HPyStrPool_Entry *new_entries =
+        (HPyStrPool_Entry *)calloc(new_size, sizeof(HPyStrPool_Entry));
+    HPy *values =
+        (HPy *)malloc((pool->size > 0 ? pool->size : 1) * sizeof(HPy));
+    if (new_entries == NULL || values == NULL) {
+        free(new_entries);
+        free(values);
+        HPyErr_NoMemory(ctx);
+        return -1;
+    }
+
+    HPyStrPool_Entry *old_entries = pool->entries;
+    HPy_ssize_t n = 0;
+    if (old_entries != NULL) {
+        for (HPy_ssize_t j = 0; j <= pool->mask; j++) {
+            HPyStrPool_Entry *e = &old_entries[j];
+            if (ENTRY_IS_FREE(e))
+                continue;
+            values[n] = HPyField_Load(ctx, owner, e->value);
+            HPyField_Store(ctx, owner, &e->value, HPy_NULL);
+            // the hash, offset and length are moved to the front of the
+            // old table, which is not used by the probing any more
+            old_entries[n].hash = e->hash;
+            old_entries[n].offset = e->offset;
+            old_entries[n].length = e->length;
+            n++;
+        }
+    }
+    pool->entries = new_entries;
+    pool->mask = new_size - 1;
+
+    size_t mask = (size_t)pool->mask;
+    for (HPy_ssize_t j = 0; j < n; j++) {
+        PROBE_START(old_entries[j].hash, mask, i, perturb);
+        while (!ENTRY_IS_FREE(&new_entries[i])) {
+            PROBE_NEXT(mask, i, perturb);
+        }
+        HPyStrPool_Entry *e = &new_entries[i];
+        e->hash = old_entries[j].hash;
+        e->offset = old_entries[j].offset;
+        e->length = old_entries[j].length;
+        HPyField_Store(ctx, owner, &e->value, values[j]);
+        HPy_Close(ctx, values[j]);
+    }
+    free(old_entries);
+    free(values);
+    return 0;
+}
+
+/* Make room for n more bytes at the end of pool->chars */
+static int
+strpool_reserve_chars(HPyContext *ctx, HPyStrPool *pool, HPy_ssize_t n)
+{
+    if (pool->chars != NULL && pool->chars_used + n <= pool->chars_allocated)
+        return 0;
+    HPy_ssize_t new_allocated = pool->chars_allocated > 0 ?
+                                pool->chars_allocated : 1024;
+    while (new_allocated < pool->chars_used + n)
+        new_allocated <<= 1;
+    char *new_chars = (char *)realloc(pool->chars, (size_t)new_allocated);
+    if (new_chars == NULL) {
+        HPyErr_NoMemory(ctx);
+        return -1;
+    }
+    pool->chars = new_chars;
+    pool->chars_allocated = new_allocated;
+    return 0;
+}
+
+/**
+ * Return the canonical unicode object for the given UTF-8 bytes, decoding
+ * and storing it in the pool if it is not there yet.
+ *
+ * :param ctx:
+ *     The execution context.
+ * :param owner:
+ *     The object which contains the pool.
+ * :param pool:
+ *     The pool.
+ * :param utf8:
+ *     The UTF-8 encoded bytes, which do not need to be NUL-terminated.
+ * :param size:
+ *     The number of bytes, or ``-1`` if ``utf8`` is NUL-terminated.
+ *
+ * :returns: a new handle to the string, or ``HPy_NULL`` in case of error:
+ *     ``UnicodeDecodeError`` if the bytes are not valid UTF-8. The bytes
+ *     can contain NUL characters, unless ``size`` is ``-1``.
+ */
+HPyAPI_HELPER HPy
+HPyStrPool_Get(HPyContext *ctx, HPy owner, HPyStrPool *pool,
+               const char *utf8, HPy_ssize_t size)
+{
+    if (size < 0)
+        size = (HPy_ssize_t)strlen(utf8);
+    if (size > HPYSTRPOOL_MAX_LENGTH)
+        return HPyUnicode_FromStringAndSize(ctx, utf8, size);
+
+    size_t hash = strpool_hash(utf8, size);
+    if (pool->entries != NULL) {
+        size_t mask = (size_t)pool->mask;
+        PROBE_START(hash, mask, i, perturb);
+        for (;;) {
+            HPyStrPool_Entry *e = &pool->entries[i];
+            if (ENTRY_IS_FREE(e))
+                break;
+            if (e->hash == hash && e->length == size &&
+                    memcmp(pool->chars + e->offset, utf8, (size_t)size) == 0)
+                return HPyField_Load(ctx, owner, e->value);
+            PROBE_NEXT(mask, i, perturb);
+        }
+    }
+
+    // not found: decode the bytes, which are copied to pool->chars only if
+    // the decoding succeeds
+    HPy h = HPyUnicode_FromStringAndSize(ctx, utf8, size);
+    if (HPy_IsNull(h))
+        return HPy_NULL;
+    HPy_ssize_t max_size = pool->max_size > 0 ? pool->max_size :
+                                                HPYSTRPOOL_DEFAULT_MAXSIZE;
+    if (pool->size >= max_size)
+        strpool_empty(ctx, owner, pool);
+    if (strpool_reserve_chars(ctx, pool, size) < 0) {
+        HPy_Close(ctx, h);
+        return HPy_NULL;
+    }
+    HPy_ssize_t offset = pool->chars_used;
+    memcpy(pool->chars + offset, utf8, (size_t)size);
+
+    // keep at least one third of the slots empty
+    if (pool->entries == NULL || (pool->size + 1) * 3 > (pool->mask + 1) * 2) {
+        if (strpool_resize(ctx, owner, pool) < 0) {
+            HPy_Close(ctx, h);
+            return HPy_NULL;
+        }
+    }
+    size_t mask = (size_t)pool->mask;
+    PROBE_START(hash, mask, i, perturb);
+    while (!ENTRY_IS_FREE(&pool->entries[i])) {
+        PROBE_NEXT(mask, i, perturb);
+    }
+    HPyStrPool_Entry *e = &pool->entries[i];
+    e->hash = hash;
+    e->offset = offset;
+    e->length = size;
+    HPyField_Store(ctx, owner, &e->value, h);
+    pool->chars_used += size;
+    pool->size++;
+    return h;
+}
+
+/**
+ * Remove all the strings and release the memory of the pool.
+ */
+HPyAPI_HELPER void
+HPyStrPool_Clear(HPyContext *ctx, HPy owner, HPyStrPool *pool)
+{
+    strpool_empty(ctx, owner, pool);
+    HPyStrPool_Free(pool);
+}
+
+/**
+ * Visit all the strings, to be called by the ``tp_traverse`` of the owner.
+ */
+HPyAPI_HELPER int
+HPyStrPool_Traverse(HPyStrPool *pool, HPyFunc_visitproc visit, void *arg)
+{
+    if (pool->entries == NULL)
+        return 0;
+    for (HPy_ssize_t i = 0; i <= pool->mask; i++) {
+        HPy_VISIT(&pool->entries[i].value);
+    }
+    return 0;
+}
+
+/**
+ * Release the memory of the pool, to be called by the ``tp_destroy`` of the
+ * owner. As for ``HPyMap_Free``, the strings have already been released
+ * at that point.
+ */
+HPyAPI_HELPER void
+HPyStrPool_Free(HPyStrPool *pool)
+{
+    free(pool->entries);
+    free(pool->chars);
+    pool->entries = NULL;
+    pool->chars = NULL;
+    pool->size = pool->mask = 0;
+    pool->chars_used = pool->chars_allocated = 0;
+}
@@ -0,0 +1,682 @@
+/**
+ * Struct arrays.
+ *
+ * A struct array stores many instances of a fixed-layout C struct (a
+ * "record") contiguously in a single memory block, instead of having one
+ * heap object per instance. This is useful when an extension needs to keep
+ * a large number of small records which must be accessible both from Python
+ * and from C code which processes them in bulk.
+ *
+ * ``HPyStructArray_NewType`` creates three types out of a
+ * ``HPyStructArray_Desc``:
+ *
+ *   - the array type itself, which supports ``len()``, indexing and
+ *     iteration. ``T(n)`` creates a new array of ``n`` zero-initialized
+ *     records;
+ *
+ *   - the item type: ``arr[i]`` returns a lightweight view on the i-th
+ *     record, which has a read-write attribute for every field. The view
+ *     keeps the array alive and does not copy the record;
+ *
+ *   - the column type: ``arr.column(name)`` returns an object which exports
+ *     the given field of all the records as a one-dimensional strided buffer,
+ *     e.g. to be consumed by ``memoryview`` or ``numpy``.
+ *
+ * The descriptor and the item and column types are kept in the C data of
+ * the array type (see ``HPyType_GetData``): the ``item_type`` and
+ * ``column_type`` class attributes are only there for introspection, and
+ * rebinding them does not affect the arrays.
+ *
+ * Only numeric fields are supported, i.e. the ``HPyMember_*`` integer,
+ * floating point and ``HPyMember_BOOL`` types: records are plain memory which
+ * is not traversed by the GC, so they cannot contain handles or fields.
+ *
+ * Example:
+ *
+ * .. code-block:: c
+ *
+ *     typedef struct {
+ *         double x;
+ *         double y;
+ *         int tag;
+ *     } Point;
+ *
+ *     static HPyStructArray_Field point_fields[] = {
+ *         { "x", HPyMember_DOUBLE, offsetof(Point, x) },
+ *         { "y", HPyMember_DOUBLE, offsetof(Point, y) },
+ *         { "tag", HPyMember_INT, offsetof(Point, tag) },
+ *         { NULL },
+ *     };
+ *
+ *     static HPyStructArray_Desc point_array_desc = {
+ *         .name = "mymod.PointArray",
+ *         .itemsize = sizeof(Point),
+ *         .fields = point_fields,
+ *     };
+ *
+ *     HPy h_type = HPyStructArray_NewType(ctx, &point_array_desc);
+ *     HPy h_arr = HPyStructArray_New(ctx, h_type, 1000000);
+ *     Point *points = (Point *)HPyStructArray_Data(ctx, h_arr);
+ *
+ * Struct Array API
+ * ----------------
+ *
+ */
+
+#include "hpy.h"
+#include <stdio.h>
+#include <string.h>
+
+#define STRUCTARRAY_SSIZE_T_MAX ((HPy_ssize_t)(((size_t)-1) >> 1))
+
+/* The C data of an array type (HPyType_Spec.data) */
+typedef struct {
+    const void *magic;          /* &structarray_magic */
+    HPyStructArray_Desc *desc;
+    HPyGlobal item_type;
+    HPyGlobal column_type;
+} StructArrayTypeData;
+
+static const char structarray_magic = 0;
+
+typedef struct {
+    HPyStructArray_Desc *desc;
+    HPy_ssize_t length;
+    char *data;
+    HPyField item_type;
+    HPyField column_type;
+} StructArrayObject;
+
+typedef struct {
+    HPyField array;
+    char *ptr;              /* points to the record inside the array */
+} StructArrayItemObject;
+
+typedef struct {
+    HPyField array;
+    HPyStructArray_Field *field;
+    char *base;             /* points to the field of the first record */
+    HPy_ssize_t shape;
+    HPy_ssize_t stride;
+    HPy_ssize_t itemsize;
+} StructArrayColumnObject;
+
+static StructArrayObject *
+structarray_struct(HPyContext *ctx, HPy h)
+{
+    return (StructArrayObject *)HPy_AsStruct(ctx, h);
+}
+
+/* Like structarray_struct, but raise TypeError and return NULL if h is not
+   a struct array: for the functions which are called with arbitrary
+   objects. */
+static StructArrayObject *
+structarray_check(HPyContext *ctx, HPy h)
+{
+    HPy h_type = HPy_Type(ctx, h);
+    if (HPy_IsNull(h_type))
+        return NULL;
+    StructArrayTypeData *type_data = (StructArrayTypeData *)HPyType_GetData(ctx, h_type);
+    HPy_Close(ctx, h_type);
+    if (type_data == NULL || type_data->magic != &structarray_magic) {
+        HPyErr_SetString(ctx, ctx->h_TypeError, "expected a struct array");
+        return NULL;
+    }
+    return structarray_struct(ctx, h);
+}
+
+/* Return the size of a field of the given type and its buffer format, or -1
+   if the type is not supported. */
+static HPy_ssize_t
+field_info(HPyMember_FieldType type, const char **format)
+{
+    switch (type) {
+    case HPyMember_BOOL:      *format = "?"; return sizeof(char);
+    case HPyMember_BYTE:      *format = "b"; return sizeof(char);
+    case HPyMember_UBYTE:     *format = "B"; return sizeof(unsigned char);
+    case HPyMember_SHORT:     *format = "h"; return sizeof(short);
+    case HPyMember_USHORT:    *format = "H"; return sizeof(unsigned short);
+    case HPyMember_INT:       *format = "i"; return sizeof(int);
+    case HPyMember_UINT:      *format = "I"; return sizeof(unsigned int);
+    case HPyMember_LONG:      *format = "l"; return sizeof(long);
+    case HPyMember_ULONG:     *format = "L"; return sizeof(unsigned long);
+    case HPyMember_LONGLONG:  *format = "q"; return sizeof(long long);
+    case HPyMember_ULONGLONG: *format = "Q"; return sizeof(unsigned long long);
+    case HPyMember_HPYSSIZET: *format = "n"; return sizeof(HPy_ssize_t);
+    case HPyMember_FLOAT:     *format = "f"; return sizeof(float);
+    case HPyMember_DOUBLE:    *format = "d"; return sizeof(double);
+    default:
+        return -1;
+    }
+}
+
+static HPy
+field_get(HPyContext *ctx, HPyStructArray_Field *field, char *ptr)
+{
+    switch (field->type) {
+    case HPyMember_BOOL:      return HPyBool_FromLong(ctx, *(char *)ptr);
+    case HPyMember_BYTE:      return HPyLong_FromLong(ctx, *(signed char *)ptr);
+    case HPyMember_UBYTE:     return HPyLong_FromLong(ctx, *(unsigned char *)ptr);
+    case HPyMember_SHORT:     return HPyLong_FromLong(ctx, *(short *)ptr);
+    case HPyMember_USHORT:    return HPyLong_FromLong(ctx, *(unsigned short *)ptr);
+    case HPyMember_INT:       return HPyLong_FromLong(ctx, *(int *)ptr);
+    case HPyMember_UINT:      return HPyLong_FromUnsignedLong(ctx, *(unsigned int *)ptr);
+    case HPyMember_LONG:      return HPyLong_FromLong(ctx, *(long *)ptr);
+    case HPyMember_ULONG:     return HPyLong_FromUnsignedLong(ctx, *(unsigned long *)ptr);
+    case HPyMember_LONGLONG:  return HPyLong_FromLongLong(ctx, *(long long *)ptr);
+    case HPyMember_ULONGLONG: return HPyLong_FromUnsignedLongLong(ctx, *(unsigned long long *)ptr);
+    case HPyMember_HPYSSIZET: return HPyLong_FromSsize_t(ctx, *(HPy_ssize_t *)ptr);
+    case HPyMember_FLOAT:     return HPyFloat_FromDouble(ctx, *(float *)ptr);
+    case HPyMember_DOUBLE:    return HPyFloat_FromDouble(ctx, *(double *)ptr);
+    default:
+        HPyErr_SetString(ctx, ctx->h_SystemError, "bad struct array field type");
+        return HPy_NULL;
+    }
+}
+
+#define SET_INTEGER(CTYPE, ASFUNC)                                  \
+    do {                                                            \
+        CTYPE v = (CTYPE)ASFUNC(ctx, value);                        \
+        if (v == (CTYPE)-1 && HPyErr_Occurred(ctx))                 \
+            return -1;                                              \
+        *(CTYPE *)ptr = v;                                          \
+        return 0;                                                   \
+    } while (0)
+
+static int
+field_set(HPyContext *ctx, HPyStructArray_Field *field, char *ptr, HPy value)
+{
+    if (HPy_IsNull(value)) {
+        HPyErr_SetString(ctx, ctx->h_TypeError,
+                         "can't delete struct array fields");
+        return -1;
+    }
+    switch (field->type) {
+    case HPyMember_BOOL: {
+        int v = HPy_IsTrue(ctx, value);
+        if (v < 0)
+            return -1;
+        *(char *)ptr = (char)v;
+        return 0;
+    }
+    case HPyMember_BYTE:      SET_INTEGER(signed char, HPyLong_AsLong);
+    case HPyMember_UBYTE:     SET_INTEGER(unsigned char, HPyLong_AsLong);
+    case HPyMember_SHORT:     SET_INTEGER(short, HPyLong_AsLong);
+    case HPyMember_USHORT:    SET_INTEGER(unsigned short, HPyLong_AsLong);
+    case HPyMember_INT:       SET_INTEGER(int, HPyLong_AsLong);
+    case HPyMember_UINT:      SET_INTEGER(unsigned int, HPyLong_AsUnsignedLong);
+    case HPyMember_LONG:      SET_INTEGER(long, HPyLong_AsLong);
+    case HPyMember_ULONG:     SET_INTEGER(unsigned long, HPyLong_AsUnsignedLong);
+    case HPyMember_LONGLONG:  SET_INTEGER(long long, HPyLong_AsLongLong);
+    case HPyMember_ULONGLONG: SET_INTEGER(unsigned long long, HPyLong_AsUnsignedLongLong);
+    case HPyMember_HPYSSIZET: SET_INTEGER(HPy_ssize_t, HPyLong_AsSsize_t);
+    case HPyMember_FLOAT: {
+        double v = HPyFloat_AsDouble(ctx, value);
+        if (v == -1.0 && HPyErr_Occurred(ctx))
+            return -1;
+        *(float *)ptr = (float)v;
+        return 0;
+    }
+    case HPyMember_DOUBLE: {
+        double v = HPyFloat_AsDouble(ctx, value);
+        if (v == -1.0 && HPyErr_Occurred(ctx))
+            return -1;
+        *(double *)ptr = v;
+        return 0;
+    }
+    default:
+        HPyErr_SetString(ctx, ctx->h_SystemError, "bad struct array field type");
+        return -1;
+    }
+}
+
+#undef SET_INTEGER
+
+/* ~~~ the item type ~~~ */
+
+HPyDef_GETSET(structarray_item_field, "_field",
+              structarray_item_field_get, structarray_item_field_set)
+static HPy structarray_item_field_get(HPyContext *ctx, HPy self, void *closure)
+{
+    HPyStructArray_Field *field = (HPyStructArray_Field *)closure;
+    StructArrayItemObject *item = (StructArrayItemObject *)HPy_AsStruct(ctx, self);
+    return field_get(ctx, field, item->ptr + field->offset);
+}
+
+static int structarray_item_field_set(HPyContext *ctx, HPy self, HPy value,
+                                      void *closure)
+{
+    HPyStructArray_Field *field = (HPyStructArray_Field *)closure;
+    StructArrayItemObject *item = (StructArrayItemObject *)HPy_AsStruct(ctx, self);
+    return field_set(ctx, field, item->ptr + field->offset, value);
+}
+
+HPyDef_SLOT(structarray_item_new, structarray_item_new_impl, HPy_tp_new)
+static HPy structarray_item_new_impl(HPyContext *ctx, HPy type, HPy *args,
+                                     HPy_ssize_t nargs, HPy kw)
+{
+    HPyErr_SetString(ctx, ctx->h_TypeError,
+                     "struct array items can only be obtained by indexing an array");
+    return HPy_NULL;
+}
+
+HPyDef_SLOT(structarray_item_traverse, structarray_item_traverse_impl, HPy_tp_traverse)
+static int structarray_item_traverse_impl(void *self, HPyFunc_visitproc visit, void *arg)
+{
+    StructArrayItemObject *item = (StructArrayItemObject *)self;
+    HPy_VISIT(&item->array);
+    return 0;
+}
+
+static HPyDef *structarray_item_slots[] = {
+    &structarray_item_new,
+    &structarray_item_traverse,
+    NULL
+};
+
+/* ~~~ the column type ~~~ */
+
+HPyDef_SLOT(structarray_column_new, structarray_column_new_impl, HPy_tp_new)
+static HPy structarray_column_new_impl(HPyContext *ctx, HPy type, HPy *args,
+                                       HPy_ssize_t nargs, HPy kw)
+{
+    HPyErr_SetString(ctx, ctx->h_TypeError,
+                     "struct array columns can only be obtained by calling column()");
+    return HPy_NULL;
+}
+
+HPyDef_SLOT(structarray_column_getbuffer, structarray_column_getbuffer_impl,
+            HPy_bf_getbuffer)
+static int structarray_column_getbuffer_impl(HPyContext *ctx, HPy self,
+                                             HPy_buffer *buf, int flags)
+{
+    StructArrayColumnObject *col = (StructArrayColumnObject *)HPy_AsStruct(ctx, self);
+    const char *format;
+    field_info(col->field->type, &format);
+    // the columns are contiguous only if the record has a single field
+    int contiguous = col->stride == col->itemsize || col->shape <= 1;
+    if (!contiguous &&
+        ((flags & HPyBUF_STRIDES) != HPyBUF_STRIDES ||
+         (flags & HPyBUF_C_CONTIGUOUS) == HPyBUF_C_CONTIGUOUS ||
+         (flags & HPyBUF_F_CONTIGUOUS) == HPyBUF_F_CONTIGUOUS ||
+         (flags & HPyBUF_ANY_CONTIGUOUS) == HPyBUF_ANY_CONTIGUOUS)) {
+        HPyErr_SetString(ctx, ctx->h_BufferError,
+                         "struct array column is not contiguous");
+        return -1;
+    }
+    buf->buf = col->base;
+    buf->len = col->shape * col->itemsize;
+    buf->itemsize = col->itemsize;
+    buf->readonly = 0;
+    buf->ndim = 1;
+    buf->format = (flags & HPyBUF_FORMAT) ? (char *)format : NULL;
+    buf->shape = (flags & HPyBUF_ND) == HPyBUF_ND ? &col->shape : NULL;
+    buf->strides = (flags & HPyBUF_STRIDES) == HPyBUF_STRIDES ? &col->stride : NULL;
+    buf->suboffsets = NULL;
+    buf->internal = NULL;
+    buf->obj = HPy_Dup(ctx, self);
+    return 0;
+}
+
+HPyDef_SLOT(structarray_column_length, structarray_column_length_impl, HPy_sq_length)
+static HPy_ssize_t structarray_column_length_impl(HPyContext *ctx, HPy self)
+{
+    return ((StructArrayColumnObject *)HPy_AsStruct(ctx, self))->shape;
+}
+
+HPyDef_SLOT(structarray_column_item, structarray_column_item_impl, HPy_sq_item)
+static HPy structarray_column_item_impl(HPyContext *ctx, HPy self, HPy_ssize_t i)
+{
+    StructArrayColumnObject *col = (StructArrayColumnObject *)HPy_AsStruct(ctx, self);
+    if (i < 0 || i >= col->shape) {
+        HPyErr_SetString(ctx, ctx->h_IndexError, "column index out of range");
+        return HPy_NULL;
+    }
+    return field_get(ctx, col->field, col->base + i * col->stride);
+}
+
+HPyDef_SLOT(structarray_column_traverse, structarray_column_traverse_impl,
+            HPy_tp_traverse)
+static int structarray_column_traverse_impl(void *self, HPyFunc_visitproc visit,
+                                            void *arg)
+{
+    StructArrayColumnObject *col = (StructArrayColumnObject *)self;
+    HPy_VISIT(&col->array);
+    return 0;
+}
+
+static HPyDef *structarray_column_slots[] = {
+    &structarray_column_new,
+    &structarray_column_getbuffer,
+    &structarray_column_length,
+    &structarray_column_item,
+    &structarray_column_traverse,
+    NULL
+};
+
+/* ~~~ the array type ~~~ */
+
+static HPy
+structarray_new(HPyContext *ctx, HPy type, HPy_ssize_t length)
+{
+    if (length < 0) {
+        HPyErr_SetString(ctx, ctx->h_ValueError,
+                         "struct array length must be non-negative");
+        return HPy_NULL;
+    }
+    StructArrayTypeData *type_data = (StructArrayTypeData *)HPyType_GetData(ctx, type);
+    if (type_data == NULL || type_data->magic != &structarray_magic) {
+        HPyErr_SetString(ctx, ctx->h_TypeError, "expected a struct array type");
+        return HPy_NULL;
+    }
+    HPyStructArray_Desc *desc = type_data->desc;
+    HPy h_item_type = HPyGlobal_Load(ctx, type_data->item_type);
+    HPy h_column_type = HPyGlobal_Load(ctx, type_data->column_type);
+    HPy h = HPy_NULL;
+    char *data = NULL;
+    if (desc->itemsize > 0 && length > STRUCTARRAY_SSIZE_T_MAX / desc->itemsize) {
+        HPyErr_NoMemory(ctx);
+        goto done;
+    }
+    data = (char *)calloc(length > 0 ? length : 1, desc->itemsize > 0 ? desc->itemsize : 1);
+    if (data == NULL) {
+        HPyErr_NoMemory(ctx);
+        goto done;
+    }
+    StructArrayObject *arr;
+    h = HPy_New(ctx, type, &arr);
+    if (HPy_IsNull(h)) {
+        free(data);
+        goto done;
+    }
+    arr->desc = desc;
+    arr->length = length;
+    arr->data = data;
+    HPyField_Store(ctx, h, &arr->item_type, h_item_type);
+    HPyField_Store(ctx, h, &arr->column_type, h_column_type);
+ done:
+    HPy_Close(ctx, h_item_type);
+    HPy_Close(ctx, h_column_type);
+    return h;
+}
+
+HPyDef_SLOT(structarray_new_slot, structarray_new_impl, HPy_tp_new)
+static HPy structarray_new_impl(HPyContext *ctx, HPy type, HPy *args,
+                                HPy_ssize_t nargs, HPy kw)
+{
+    HPy_ssize_t length;
+    if (!HPyArg_ParseKeywords(ctx, NULL, args, nargs, kw, "n",
+                              (const char *[]) { "length", NULL }, &length))
+        return HPy_NULL;
+    return structarray_new(ctx, type, length);
+}
+
+HPyDef_SLOT(structarray_destroy, structarray_destroy_impl, HPy_tp_destroy)
+static void structarray_destroy_impl(void *self)
+{
+    StructArrayObject *arr = (StructArrayObject *)self;
+    free(arr->data);
+    arr->data = NULL;
+}
+
+HPyDef_SLOT(structarray_traverse, structarray_traverse_impl, HPy_tp_traverse)
+static int structarray_traverse_impl(void *self, HPyFunc_visitproc visit, void *arg)
+{
+    StructArrayObject *arr = (StructArrayObject *)self;
+    HPy_VISIT(&arr->item_type);
+    HPy_VISIT(&arr->column_type);
+    return 0;
+}
+
+HPyDef_SLOT(structarray_length, structarray_length_impl, HPy_sq_length)
+static HPy_ssize_t structarray_length_impl(HPyContext *ctx, HPy self)
+{
+    return structarray_struct(ctx, self)->length;
+}
+
+HPyDef_SLOT(structarray_item, structarray_item_impl, HPy_sq_item)
+static HPy structarray_item_impl(HPyContext *ctx, HPy self, HPy_ssize_t i)
+{
+    StructArrayObject *arr = structarray_struct(ctx, self);
+    if (i < 0 || i >= arr->length) {
+        HPyErr_SetString(ctx, ctx->h_IndexError, "struct array index out of range");
+        return HPy_NULL;
+    }
+    HPy h_item_type = HPyField_Load(ctx, self, arr->item_type);
+    StructArrayItemObject *item;
+    HPy h = HPy_New(ctx, h_item_type, &item);
+    HPy_Close(ctx, h_item_type);
+    if (HPy_IsNull(h))
+        return HPy_NULL;
+    // HPy_New might have triggered a GC which moved 'self'
+    arr = structarray_struct(ctx, self);
+    HPyField_Store(ctx, h, &item->array, self);
+    item->ptr = arr->data + i * arr->desc->itemsize;
+    return h;
+}
+
+HPyDef_METH(structarray_column, "column", structarray_column_impl, HPyFunc_O,
+            .doc = "column(name)\n\nReturn a buffer-exporting view on the "
+                   "given field of all the records.")
+static HPy structarray_column_impl(HPyContext *ctx, HPy self, HPy name)
+{
+    StructArrayObject *arr = structarray_struct(ctx, self);
+    HPy_ssize_t size;
+    const char *s_name = HPyUnicode_AsUTF8AndSize(ctx, name, &size);
+    if (s_name == NULL)
+        return HPy_NULL;
+    HPyStructArray_Field *field = arr->desc->fields;
+    while (field->name != NULL && strcmp(field->name, s_name) != 0)
+        field++;
+    if (field->name == NULL) {
+        HPyErr_SetString(ctx, ctx->h_KeyError, s_name);
+        return HPy_NULL;
+    }
+    HPy h_column_type = HPyField_Load(ctx, self, arr->column_type);
+    StructArrayColumnObject *col;
+    HPy h = HPy_New(ctx, h_column_type, &col);
+    HPy_Close(ctx, h_column_type);
+    if (HPy_IsNull(h))
+        return HPy_NULL;
+    const char *format;
+    arr = structarray_struct(ctx, self);
+    HPyField_Store(ctx, h, &col->array, self);
+    col->field = field;
+    col->base = arr->data + field->offset;
+    col->shape = arr->length;
+    col->stride = arr->desc->itemsize;
+    col->itemsize = field_info(field->type, &format);
+    return h;
+}
+
+static HPyDef *structarray_slots[] = {
+    &structarray_new_slot,
+    &structarray_destroy,
+    &structarray_traverse,
+    &structarray_length,
+    &structarray_item,
+    &structarray_column,
+    NULL
+};
+
+/* Create a type out of the given slots plus, if field_tmpl is not NULL, a
+   copy of field_tmpl for each field of the record. The spec, the defines and
+   the name must stay alive as long as the type, which owns them; if the type
+   cannot be created they are freed here. */
+static HPy
+make_type(HPyContext *ctx, HPyStructArray_Desc *desc, const char *suffix,
+          const char *doc, HPy_ssize_t basicsize, HPyDef **slots,
+          HPyDef *field_tmpl, void *data)
+{
+    size_t nslots = 0;
+    while (slots[nslots] != NULL)
+        nslots++;
+    HPy_ssize_t nfields = 0;
+    if (field_tmpl != NULL)
+        while (desc->fields[nfields].name != NULL)
+            nfields++;
+
+    size_t name_size = strlen(desc->name) + strlen(suffix) + 1;
+    char *name = (char *)malloc(name_size);
+    HPyType_Spec *spec = (HPyType_Spec *)calloc(1, sizeof(HPyType_Spec));
+    HPyDef **defines = (HPyDef **)calloc(nslots + nfields + 1, sizeof(HPyDef *));
+    HPyDef *getsets = (HPyDef *)calloc(nfields > 0 ? nfields : 1, sizeof(HPyDef));
+    if (name == NULL || spec == NULL || defines == NULL || getsets == NULL) {
+        free(name);
+        free(spec);
+        free(defines);
+        free(getsets);
+        return HPyErr_NoMemory(ctx);
+    }
+    snprintf(name, name_size, "%s%s", desc->name, suffix);
+    for (size_t i = 0; i < nslots; i++)
+        defines[i] = slots[i];
+    for (HPy_ssize_t i = 0; i < nfields; i++) {
+        getsets[i] = *field_tmpl;
+        getsets[i].getset.name = desc->fields[i].name;
+        getsets[i].getset.doc = desc->fields[i].doc;
+        getsets[i].getset.closure = &desc->fields[i];
+        defines[nslots + i] = &getsets[i];
+    }
+    spec->name = name;
+    spec->doc = doc;
+    spec->basicsize = (int)basicsize;
+    spec->flags = HPy_TPFLAGS_DEFAULT | HPy_TPFLAGS_HAVE_GC;
+    spec->defines = defines;
+    spec->data = data;
+    HPy h_type = HPyType_FromSpec(ctx, spec, NULL);
+    if (HPy_IsNull(h_type)) {
+        free(name);
+        free(spec);
+        free(defines);
+        free(getsets);
+    }
+    return h_type;
+}
+
+/**
+ * Create a new struct array type, together with its item and column types.
+ *
+ * :param ctx:
+ *     The execution context.
+ * :param desc:
+ *     The description of the records. It must stay alive as long as the
+ *     type, so it is usually static data.
+ *
+ * :returns: a handle to the new array type, or ``HPy_NULL`` in case of
+ *           error. The item and column types are available as the
+ *           ``item_type`` and ``column_type`` attributes of the array type.
+ */
+HPyAPI_HELPER HPy
+HPyStructArray_NewType(HPyContext *ctx, HPyStructArray_Desc *desc)
+{
+    const char *format;
+    if (desc->itemsize <= 0) {
+        HPyErr_SetString(ctx, ctx->h_ValueError,
+                         "struct array itemsize must be positive");
+        return HPy_NULL;
+    }
+    for (HPyStructArray_Field *f = desc->fields; f->name != NULL; f++) {
+        HPy_ssize_t size = field_info(f->type, &format);
+        if (size < 0) {
+            HPyErr_SetString(ctx, ctx->h_TypeError,
+                             "struct array fields must have a numeric type");
+            return HPy_NULL;
+        }
+        if (f->offset < 0 || f->offset + size > desc->itemsize) {
+            HPyErr_SetString(ctx, ctx->h_ValueError,
+                             "struct array field outside of the record");
+            return HPy_NULL;
+        }
+    }
+
+    StructArrayTypeData *type_data =
+        (StructArrayTypeData *)calloc(1, sizeof(StructArrayTypeData));
+    if (type_data == NULL)
+        return HPyErr_NoMemory(ctx);
+    type_data->magic = &structarray_magic;
+    type_data->desc = desc;
+
+    HPy h_type = HPy_NULL;
+    HPy h_item_type = make_type(ctx, desc, "_item", NULL,
+                                sizeof(StructArrayItemObject),
+                                structarray_item_slots, &structarray_item_field,
+                                NULL);
+    HPy h_column_type = make_type(ctx, desc, "_column", NULL,
+                                  sizeof(StructArrayColumnObject),
+                                  structarray_column_slots, NULL, NULL);
+    if (HPy_IsNull(h_item_type) || HPy_IsNull(h_column_type)) {
+        free(type_data);
+        goto done;
+    }
+    HPyGlobal_Store(ctx, &type_data->item_type, h_item_type);
+    HPyGlobal_Store(ctx, &type_data->column_type, h_column_type);
+    h_type = make_type(ctx, desc, "", desc->doc, sizeof(StructArrayObject),
+                       structarray_slots, NULL, type_data);
+    if (HPy_IsNull(h_type)) {
+        HPyGlobal_Store(ctx, &type_data->item_type, HPy_NULL);
+        HPyGlobal_Store(ctx, &type_data->column_type, HPy_NULL);
+        free(type_data);
+        goto done;
+    }
+    // from now on type_data is owned by the array type, like its spec
+    HPyAttrDef attrs[] = {
+        HPyAttr_OBJECT("item_type", h_item_type),
+        HPyAttr_OBJECT("column_type", h_column_type),
+        {0}
+    };
+    if (HPy_SetAttrs(ctx, h_type, attrs) < 0) {
+        HPy_Close(ctx, h_type);
+        h_type = HPy_NULL;
+    }
+ done:
+    HPy_Close(ctx, h_item_type);
+    HPy_Close(ctx, h_column_type);
+    return h_type;
+}
+
+/**
+ * Create a new struct array with ``length`` zero-initialized records.
+ *
+ * :param ctx:
+ *     The execution context.
+ * :param type:
+ *     A type created by ``HPyStructArray_NewType``.
+ * :param length:
+ *     The number of records.
+ *
+ * :returns: a handle to the new array, or ``HPy_NULL`` in case of error.
+ */
+HPyAPI_HELPER HPy
+HPyStructArray_New(HPyContext *ctx, HPy type, HPy_ssize_t length)
+{
+    return structarray_new(ctx, type, length);
+}
+
+/**
+ * Return the number of records of a struct array, or -1 with a
+ * ``TypeError`` if ``h`` is not a struct array.
+ */
+HPyAPI_HELPER HPy_ssize_t
+HPyStructArray_Length(HPyContext *ctx, HPy h)
+{
+    StructArrayObject *arr = structarray_check(ctx, h);
+    if (arr == NULL)
+        return -1;
+    return arr->length;
+}
+
+/**
+ * Return a pointer to the first record of a struct array. The records are
+ * stored contiguously and the pointer stays valid as long as the array is
+ * alive. Return ``NULL`` with a ``TypeError`` if ``h`` is not a struct
+ * array.
+ */
+HPyAPI_HELPER void *
+HPyStructArray_Data(HPyContext *ctx, HPy h)
+{
+    StructArrayObject *arr = structarray_check(ctx, h);
+    if (arr == NULL)
+        return NULL;
+    return arr->data;
+}
@@ -0,0 +1,536 @@
+/**
+ * Struct sequences.
+ *
+ * A struct sequence is a record type with a fixed number of fields, which
+ * can be accessed both by index and by name, similar to the ones created by
+ * CPython's ``PyStructSequence_NewType`` or by ``collections.namedtuple``.
+ * Unlike those, they work on every ABI: the type is created with
+ * ``HPyType_FromSpec`` and the fields are stored as ``HPyField`` s inside
+ * the object.
+ *
+ * The type has the following features:
+ *
+ *   - ``T(a, b, ...)`` creates a new instance: the constructor takes exactly
+ *     one positional argument per field;
+ *
+ *   - a read-only attribute for every field;
+ *
+ *   - ``len()``, indexing and iteration, like for a tuple;
+ *
+ *   - comparison with other instances of the same type and with tuples;
+ *
+ *   - the class attributes ``n_fields`` and ``_fields``, the latter being a
+ *     tuple with the names of the fields.
+ *
+ * Example:
+ *
+ * .. code-block:: c
+ *
+ *     static HPyStructSequence_Field point_fields[] = {
+ *         { "x", "the x coordinate" },
+ *         { "y", "the y coordinate" },
+ *         { NULL },
+ *     };
+ *
+ *     static HPyStructSequence_Desc point_desc = {
+ *         .name = "mymod.Point",
+ *         .doc = "A point",
+ *         .fields = point_fields,
+ *     };
+ *
+ *     HPy h_point_type = HPyStructSequence_NewType(ctx, &point_desc);
+ *     ...
+ *     HPy items[] = { h_x, h_y };
+ *     HPy h_point = HPyStructSequence_New(ctx, h_point_type, 2, items);
+ *
+ * The number of fields and their names are stored in the C data of the type
+ * (see ``HPyType_GetData``), so rebinding ``n_fields`` or ``_fields`` from
+ * Python does not affect the instances.
+ *
+ * To fill the fields one by one, e.g. while decoding a record, use a
+ * ``HPyStructSequenceBuilder``: it stores the items directly in the new
+ * object, which is not visible to Python until it is built.
+ *
+ * .. code-block:: c
+ *
+ *     HPyStructSequenceBuilder b = HPyStructSequenceBuilder_New(ctx, h_point_type);
+ *     HPyStructSequenceBuilder_Set(ctx, b, 0, h_x);
+ *     HPyStructSequenceBuilder_Set(ctx, b, 1, h_y);
+ *     HPy h_point = HPyStructSequenceBuilder_Build(ctx, b);
+ *
+ * Struct Sequence API
+ * -------------------
+ *
+ */
+
+#include "hpy.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    HPy_ssize_t ob_size;
+    HPyField ob_item[1];
+} HPyStructSequenceObject;
+
+#define STRUCTSEQ_BASICSIZE(n) \
+    ((int)(offsetof(HPyStructSequenceObject, ob_item) + \
+           ((n) > 0 ? (n) : 1) * sizeof(HPyField)))
+
+/* The C data of a struct sequence type (HPyType_Spec.data). */
+typedef struct {
+    const void *magic;          /* &structseq_magic */
+    HPy_ssize_t n_fields;
+    HPyStructSequence_Desc *desc;
+} HPyStructSequence_TypeData;
+
+static const char structseq_magic = 0;
+
+static HPyStructSequenceObject *
+structseq_struct(HPyContext *ctx, HPy h)
+{
+    return (HPyStructSequenceObject *)HPy_AsStruct(ctx, h);
+}
+
+static HPyStructSequence_TypeData *
+get_type_data(HPyContext *ctx, HPy type)
+{
+    HPyStructSequence_TypeData *data =
+        (HPyStructSequence_TypeData *)HPyType_GetData(ctx, type);
+    if (data == NULL || data->magic != &structseq_magic) {
+        HPyErr_SetString(ctx, ctx->h_TypeError,
+                         "expected a struct sequence type");
+        return NULL;
+    }
+    return data;
+}
+
+/* Allocate a new instance with all the fields set to HPyField_NULL */
+static HPy
+structseq_alloc(HPyContext *ctx, HPy type, HPy_ssize_t n,
+                HPyStructSequenceObject **obj)
+{
+    HPy h = HPy_New(ctx, type, obj);
+    if (HPy_IsNull(h))
+        return HPy_NULL;
+    (*obj)->ob_size = n;
+    return h;
+}
+
+static HPy
+structseq_new_n(HPyContext *ctx, HPy type, HPy_ssize_t n,
+                HPy_ssize_t nargs, HPy *args)
+{
+    if (nargs != n) {
+        char msg[128];
+        snprintf(msg, sizeof(msg),
+                 "struct sequence takes exactly %zd arguments (%zd given)",
+                 n, nargs);
+        HPyErr_SetString(ctx, ctx->h_TypeError, msg);
+        return HPy_NULL;
+    }
+    HPyStructSequenceObject *obj;
+    HPy h = structseq_alloc(ctx, type, n, &obj);
+    if (HPy_IsNull(h))
+        return HPy_NULL;
+    for (HPy_ssize_t i = 0; i < n; i++)
+        HPyField_Store(ctx, h, &obj->ob_item[i], args[i]);
+    return h;
+}
+
+HPyDef_SLOT(structseq_new, structseq_new_impl, HPy_tp_new)
+static HPy structseq_new_impl(HPyContext *ctx, HPy type, HPy *args,
+                              HPy_ssize_t nargs, HPy kw)
+{
+    if (!HPy_IsNull(kw) && HPy_Length(ctx, kw) != 0) {
+        HPyErr_SetString(ctx, ctx->h_TypeError,
+                         "struct sequence does not take keyword arguments");
+        return HPy_NULL;
+    }
+    HPyStructSequence_TypeData *data = get_type_data(ctx, type);
+    if (data == NULL)
+        return HPy_NULL;
+    return structseq_new_n(ctx, type, data->n_fields, nargs, args);
+}
+
+HPyDef_SLOT(structseq_length, structseq_length_impl, HPy_sq_length)
+static HPy_ssize_t structseq_length_impl(HPyContext *ctx, HPy self)
+{
+    return structseq_struct(ctx, self)->ob_size;
+}
+
+HPyDef_SLOT(structseq_item, structseq_item_impl, HPy_sq_item)
+static HPy structseq_item_impl(HPyContext *ctx, HPy self, HPy_ssize_t i)
+{
+    return HPyStructSequence_GetItem(ctx, self, i);
+}
+
+HPyDef_GET(structseq_field, "_field", structseq_field_get)
+static HPy structseq_field_get(HPyContext *ctx, HPy self, void *closure)
+{
+    return HPyStructSequence_GetItem(ctx, self, (HPy_ssize_t)closure);
+}
+
+static HPy
+structseq_to_tuple(HPyContext *ctx, HPy self)
+{
+    HPyStructSequenceObject *obj = structseq_struct(ctx, self);
+    HPyTupleBuilder tb = HPyTupleBuilder_New(ctx, obj->ob_size);
+    for (HPy_ssize_t i = 0; i < obj->ob_size; i++) {
+        HPy item = HPyStructSequence_GetItem(ctx, self, i);
+        if (HPy_IsNull(item)) {
+            HPyTupleBuilder_Cancel(ctx, tb);
+            return HPy_NULL;
+        }
+        HPyTupleBuilder_SetSteal(ctx, tb, i, item);
+    }
+    return HPyTupleBuilder_Build(ctx, tb);
+}
+
+HPyDef_SLOT(structseq_richcompare, structseq_richcompare_impl, HPy_tp_richcompare)
+static HPy structseq_richcompare_impl(HPyContext *ctx, HPy self, HPy other,
+                                      HPy_RichCmpOp op)
+{
+    HPy type = HPy_Type(ctx, self);
+    HPy h_other;
+    if (HPy_TypeCheck(ctx, other, type))
+        h_other = structseq_to_tuple(ctx, other);
+    else if (HPy_TypeCheck(ctx, other, ctx->h_TupleType))
+        h_other = HPy_Dup(ctx, other);
+    else {
+        HPy_Close(ctx, type);
+        return HPy_Dup(ctx, ctx->h_NotImplemented);
+    }
+    HPy_Close(ctx, type);
+    if (HPy_IsNull(h_other))
+        return HPy_NULL;
+    HPy h_self = structseq_to_tuple(ctx, self);
+    if (HPy_IsNull(h_self)) {
+        HPy_Close(ctx, h_other);
+        return HPy_NULL;
+    }
+    HPy res = HPy_RichCompare(ctx, h_self, h_other, op);
+    HPy_Close(ctx, h_self);
+    HPy_Close(ctx, h_other);
+    return res;
+}
+
+/* Append the UTF-8 representation of 'h' (which must be a str) to the
+   buffer, growing it if needed. Returns -1 in case of error. */
+static int
+buf_append(HPyContext *ctx, char **buf, size_t *len, size_t *cap, HPy h)
+{
+    HPy_ssize_t size;
+    const char *data = HPyUnicode_AsUTF8AndSize(ctx, h, &size);
+    if (data == NULL)
+        return -1;
+    if (*len + size + 1 > *cap) {
+        size_t new_cap = 2 * (*cap) + size + 1;
+        char *new_buf = (char *)realloc(*buf, new_cap);
+        if (new_buf == NULL) {
+            HPyErr_NoMemory(ctx);
+            return -1;
+        }
+        *buf = new_buf;
+        *cap = new_cap;
+    }
+    memcpy(*buf + *len, data, size);
+    *len += size;
+    (*buf)[*len] = '\0';
+    return 0;
+}
+
+/* Produces e.g. "Point(x=1, y=2)" */
+HPyDef_SLOT(structseq_repr, structseq_repr_impl, HPy_tp_repr)
+static HPy structseq_repr_impl(HPyContext *ctx, HPy self)
+{
+    HPyStructSequenceObject *obj = structseq_struct(ctx, self);
+    HPy type = HPy_Type(ctx, self);
+    HPyStructSequence_TypeData *data = get_type_data(ctx, type);
+    if (data == NULL) {
+        HPy_Close(ctx, type);
+        return HPy_NULL;
+    }
+    HPy type_name = HPy_GetAttr_s(ctx, type, "__name__");
+    HPy_Close(ctx, type);
+    HPy sep = HPyUnicode_FromString(ctx, ", ");
+    HPy eq = HPyUnicode_FromString(ctx, "=");
+    HPy par = HPyUnicode_FromString(ctx, "(");
+    HPy close_par = HPyUnicode_FromString(ctx, ")");
+    HPy result = HPy_NULL;
+    char *buf = NULL;
+    size_t len = 0, cap = 0;
+    if (HPy_IsNull(type_name) || HPy_IsNull(sep) ||
+            HPy_IsNull(eq) || HPy_IsNull(par) || HPy_IsNull(close_par))
+        goto done;
+    if (buf_append(ctx, &buf, &len, &cap, type_name) < 0 ||
+            buf_append(ctx, &buf, &len, &cap, par) < 0)
+        goto done;
+    for (HPy_ssize_t i = 0; i < obj->ob_size; i++) {
+        if (i > 0 && buf_append(ctx, &buf, &len, &cap, sep) < 0)
+            goto done;
+        HPy name = HPyUnicode_FromString(ctx, data->desc->fields[i].name);
+        if (HPy_IsNull(name))
+            goto done;
+        int res = buf_append(ctx, &buf, &len, &cap, name);
+        HPy_Close(ctx, name);
+        if (res < 0 || buf_append(ctx, &buf, &len, &cap, eq) < 0)
+            goto done;
+        HPy item = HPyStructSequence_GetItem(ctx, self, i);
+        if (HPy_IsNull(item))
+            goto done;
+        HPy item_repr = HPy_Repr(ctx, item);
+        HPy_Close(ctx, item);
+        if (HPy_IsNull(item_repr))
+            goto done;
+        res = buf_append(ctx, &buf, &len, &cap, item_repr);
+        HPy_Close(ctx, item_repr);
+        if (res < 0)
+            goto done;
+    }
+    if (buf_append(ctx, &buf, &len, &cap, close_par) < 0)
+        goto done;
+    result = HPyUnicode_FromString(ctx, buf);
+ done:
+    free(buf);
+    HPy_Close(ctx, type_name);
+    HPy_Close(ctx, sep);
+    HPy_Close(ctx, eq);
+    HPy_Close(ctx, par);
+    HPy_Close(ctx, close_par);
+    return result;
+}
+
+HPyDef_SLOT(structseq_traverse, structseq_traverse_impl, HPy_tp_traverse)
+static int structseq_traverse_impl(void *self, HPyFunc_visitproc visit, void *arg)
+{
+    HPyStructSequenceObject *obj = (HPyStructSequenceObject *)self;
+    for (HPy_ssize_t i = 0; i < obj->ob_size; i++)
+        HPy_VISIT(&obj->ob_item[i]);
+    return 0;
+}
+
+static HPyDef *structseq_slot_defines[] = {
+    &structseq_new,
+    &structseq_length,
+    &structseq_item,
+    &structseq_richcompare,
+    &structseq_repr,
+    &structseq_traverse,
+    NULL
+};
+
+#define N_SLOT_DEFINES \
+    (sizeof(structseq_slot_defines) / sizeof(structseq_slot_defines[0]) - 1)
+
+/**
+ * Create a new struct sequence type.
+ *
+ * :param ctx:
+ *     The execution context.
+ * :param desc:
+ *     The description of the type. The name and the fields must stay alive
+ *     as long as the type, so they are usually static data.
+ *
+ * :returns: a handle to the new type, or ``HPy_NULL`` in case of error.
+ */
+HPyAPI_HELPER HPy
+HPyStructSequence_NewType(HPyContext *ctx, HPyStructSequence_Desc *desc)
+{
+    HPy_ssize_t n = 0;
+    while (desc->fields[n].name != NULL)
+        n++;
+
+    // The spec, the defines and the data must stay alive as long as the
+    // type, which owns them; if the type cannot be created they are freed
+    // here.
+    HPyType_Spec *spec = (HPyType_Spec *)calloc(1, sizeof(HPyType_Spec));
+    HPyDef **defines = (HPyDef **)calloc(N_SLOT_DEFINES + n + 1, sizeof(HPyDef *));
+    HPyDef *getsets = (HPyDef *)calloc(n > 0 ? n : 1, sizeof(HPyDef));
+    HPyStructSequence_TypeData *data =
+        (HPyStructSequence_TypeData *)calloc(1, sizeof(HPyStructSequence_TypeData));
+    if (spec == NULL || defines == NULL || getsets == NULL || data == NULL) {
+        free(spec);
+        free(defines);
+        free(getsets);
+        free(data);
+        return HPyErr_NoMemory(ctx);
+    }
+    data->magic = &structseq_magic;
+    data->n_fields = n;
+    data->desc = desc;
+    for (size_t i = 0; i < N_SLOT_DEFINES; i++)
+        defines[i] = structseq_slot_defines[i];
+    for (HPy_ssize_t i = 0; i < n; i++) {
+        getsets[i] = structseq_field;
+        getsets[i].getset.name = desc->fields[i].name;
+        getsets[i].getset.doc = desc->fields[i].doc;
+        getsets[i].getset.closure = (void *)i;
+        defines[N_SLOT_DEFINES + i] = &getsets[i];
+    }
+    spec->name = desc->name;
+    spec->doc = desc->doc;
+    spec->basicsize = STRUCTSEQ_BASICSIZE(n);
+    spec->flags = HPy_TPFLAGS_DEFAULT | HPy_TPFLAGS_HAVE_GC;
+    spec->defines = defines;
+    spec->data = data;
+
+    HPy h_type = HPyType_FromSpec(ctx, spec, NULL);
+    if (HPy_IsNull(h_type)) {
+        free(spec);
+        free(defines);
+        free(getsets);
+        free(data);
+        return HPy_NULL;
+    }
+
+    HPyTupleBuilder tb = HPyTupleBuilder_New(ctx, n);
+    for (HPy_ssize_t i = 0; i < n; i++)
+        HPyTupleBuilder_SetSteal(ctx, tb, i,
+                                 HPyUnicode_FromString(ctx, desc->fields[i].name));
+    HPy h_fields = HPyTupleBuilder_Build(ctx, tb);
+    if (HPy_IsNull(h_fields)) {
+        HPy_Close(ctx, h_type);
+        return HPy_NULL;
+    }
+    HPyAttrDef attrs[] = {
+        HPyAttr_LONG("n_fields", (long)n),
+        HPyAttr_OBJECT("_fields", h_fields),
+        {0}
+    };
+    int res = HPy_SetAttrs(ctx, h_type, attrs);
+    HPy_Close(ctx, h_fields);
+    if (res < 0) {
+        HPy_Close(ctx, h_type);
+        return HPy_NULL;
+    }
+    return h_type;
+}
+
+/**
+ * Create a new instance of a struct sequence type.
+ *
+ * :param ctx:
+ *     The execution context.
+ * :param type:
+ *     A type created by ``HPyStructSequence_NewType``.
+ * :param nargs:
+ *     The number of items, which must be equal to the number of fields.
+ * :param args:
+ *     The values of the fields. The handles are not closed.
+ *
+ * :returns: a handle to the new object, or ``HPy_NULL`` in case of error.
+ */
+HPyAPI_HELPER HPy
+HPyStructSequence_New(HPyContext *ctx, HPy type, HPy_ssize_t nargs, HPy *args)
+{
+    HPyStructSequence_TypeData *data = get_type_data(ctx, type);
+    if (data == NULL)
+        return HPy_NULL;
+    return structseq_new_n(ctx, type, data->n_fields, nargs, args);
+}
+
+/**
+ * Return a new handle to the i-th item of a struct sequence, or
+ * ``HPy_NULL`` and raise ``IndexError`` if ``i`` is out of range.
+ */
+HPyAPI_HELPER HPy
+HPyStructSequence_GetItem(HPyContext *ctx, HPy self, HPy_ssize_t i)
+{
+    HPyStructSequenceObject *obj = structseq_struct(ctx, self);
+    if (i < 0 || i >= obj->ob_size) {
+        HPyErr_SetString(ctx, ctx->h_IndexError,
+                         "struct sequence index out of range");
+        return HPy_NULL;
+    }
+    if (HPyField_IsNull(obj->ob_item[i])) {
+        // only possible for an object found through gc.get_objects() while
+        // it is being built
+        HPyErr_SetString(ctx, ctx->h_ValueError,
+                         "struct sequence field not initialized");
+        return HPy_NULL;
+    }
+    return HPyField_Load(ctx, self, obj->ob_item[i]);
+}
+
+/**
+ * Start building a new instance of a struct sequence type, whose fields are
+ * then set with ``HPyStructSequenceBuilder_Set``.
+ *
+ * :param ctx:
+ *     The execution context.
+ * :param type:
+ *     A type created by ``HPyStructSequence_NewType``.
+ *
+ * :returns: a new builder. In case of error, an exception is set and the
+ *     error is reported by ``HPyStructSequenceBuilder_Build``; the builder
+ *     can be used (and must be built or cancelled) anyway.
+ */
+HPyAPI_HELPER HPyStructSequenceBuilder
+HPyStructSequenceBuilder_New(HPyContext *ctx, HPy type)
+{
+    HPyStructSequenceBuilder builder = { HPy_NULL };
+    HPyStructSequence_TypeData *data = get_type_data(ctx, type);
+    if (data != NULL) {
+        HPyStructSequenceObject *obj;
+        builder._obj = structseq_alloc(ctx, type, data->n_fields, &obj);
+    }
+    return builder;
+}
+
+/**
+ * Set the i-th field of the instance being built. The handle ``h`` is not
+ * closed; setting the same field twice replaces the previous value.
+ *
+ * :returns: 0 on success, or -1 and raise ``IndexError`` if ``i`` is out of
+ *     range. Nothing is done (and 0 is returned) if the builder failed to
+ *     allocate the object.
+ */
+HPyAPI_HELPER int
+HPyStructSequenceBuilder_Set(HPyContext *ctx, HPyStructSequenceBuilder builder,
+                             HPy_ssize_t i, HPy h)
+{
+    if (HPy_IsNull(builder._obj))
+        return 0;
+    HPyStructSequenceObject *obj = structseq_struct(ctx, builder._obj);
+    if (i < 0 || i >= obj->ob_size) {
+        HPyErr_SetString(ctx, ctx->h_IndexError,
+                         "struct sequence index out of range");
+        return -1;
+    }
+    HPyField_Store(ctx, builder._obj, &obj->ob_item[i], h);
+    return 0;
+}
+
+/**
+ * Finish building the instance and return it.
+ *
+ * :returns: a handle to the new object, or ``HPy_NULL`` if the builder
+ *     failed or if some field was not set (``TypeError``).
+ */
+HPyAPI_HELPER HPy
+HPyStructSequenceBuilder_Build(HPyContext *ctx, HPyStructSequenceBuilder builder)
+{
+    if (HPy_IsNull(builder._obj))
+        return HPy_NULL;
+    HPyStructSequenceObject *obj = structseq_struct(ctx, builder._obj);
+    for (HPy_ssize_t i = 0; i < obj->ob_size; i++) {
+        if (HPyField_IsNull(obj->ob_item[i])) {
+            char msg[128];
+            snprintf(msg, sizeof(msg),
+                     "struct sequence field %zd was not set", i);
+            HPyErr_SetString(ctx, ctx->h_TypeError, msg);
+            HPy_Close(ctx, builder._obj);
+            return HPy_NULL;
+        }
+    }
+    return builder._obj;
+}
+
+/**
+ * Discard the instance being built.
+ */
+HPyAPI_HELPER void
+HPyStructSequenceBuilder_Cancel(HPyContext *ctx, HPyStructSequenceBuilder builder)
+{
+    HPy_Close(ctx, builder._obj);
+}
@@ -0,0 +1,4 @@
+
+# automatically generated by setup.py:get_scm_config()
+__version__ = "0.0.4.dev0"
+__git_revision__ = "b3339ba"
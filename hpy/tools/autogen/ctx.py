@@ -11,6 +11,7 @@ class autogen_ctx_h(AutoGenFile):
     ##     const char *name;
     ##     void *_private;
     ##     int ctx_version;
+    ##     intptr_t immortal_handle_mask;
     ##     HPy h_None;
     ##     ...
     ##     HPy (*ctx_Module_Create)(HPyContext *ctx, HPyModuleDef *def);
@@ -24,6 +25,7 @@ class autogen_ctx_h(AutoGenFile):
         w('    const char *name; // used just to make debugging and testing easier')
         w('    void *_private;   // used by implementations to store custom data')
         w('    int ctx_version;')
+        w('    intptr_t immortal_handle_mask; // see HPy_Dup() and HPy_Close()')
         for var in self.api.variables:
             w('    %s;' % self.declare_var(var))
         for func in self.api.functions:
@@ -53,6 +55,7 @@ class autogen_ctx_def_h(AutoGenFile):
     ##     .name = "...",
     ##     ._private = NULL,
     ##     .ctx_version = 1,
+    ##     .immortal_handle_mask = 0,
     ##     .h_None = {CONSTANT_H_NONE},
     ##     ...
     ##     .ctx_Module_Create = &ctx_Module_Create,
@@ -66,6 +69,7 @@ class autogen_ctx_def_h(AutoGenFile):
         w('    .name = "HPy Universal ABI (CPython backend)",')
         w('    ._private = NULL,')
         w('    .ctx_version = 1,')
+        w('    .immortal_handle_mask = 0,')
         w('    /* h_None & co. are initialized by init_universal_ctx() */')
         for func in self.api.functions:
             w('    .%s = &%s,' % (func.ctx_name(), func.ctx_name()))
@@ -23,13 +23,26 @@ def funcnode_with_new_name(node, name):
     typedecl.declname = name
     return newnode
 
-def get_debug_wrapper_node(func):
-    newnode = funcnode_with_new_name(func.node, 'debug_%s' % func.ctx_name())
+def get_debug_wrapper_node(func, prefix='debug'):
+    newnode = funcnode_with_new_name(func.node, '%s_%s' % (prefix, func.ctx_name()))
     # fix all the types
     visitor = HPy_2_DHPy_Visitor()
     visitor.visit(newnode)
     return newnode
 
+def has_leaks_wrapper(func):
+    """
+    Whether func needs a separate wrapper for HPY_DEBUG_LEVEL_LEAKS: this is
+    the case for the autogenerated wrappers which unwrap or open some handle,
+    since that level does not check that the handles are still open and has
+    its own DHPy_open_leaks.
+    """
+    if func.name in autogen_debug_wrappers.NO_WRAPPER:
+        return False
+    node = get_debug_wrapper_node(func)
+    return (toC(node.type.type) == 'DHPy' or
+            any(toC(p.type) == 'DHPy' for p in node.type.args.params))
+
 
 class autogen_debug_ctx_init_h(AutoGenFile):
     PATH = 'hpy/debug/src/autogen_debug_ctx_init.h'
@@ -41,6 +54,11 @@ class autogen_debug_ctx_init_h(AutoGenFile):
         for func in self.api.functions:
             w(toC(get_debug_wrapper_node(func)) + ';')
         w('')
+        # and the ones of the debug_leaks_ctx_* functions
+        for func in self.api.functions:
+            if has_leaks_wrapper(func):
+                w(toC(get_debug_wrapper_node(func, 'debug_leaks')) + ';')
+        w('')
         w('static inline void debug_ctx_init_fields(HPyContext *dctx, HPyContext *uctx)')
         w('{')
         for var in self.api.variables:
@@ -49,7 +67,14 @@ class autogen_debug_ctx_init_h(AutoGenFile):
         for func in self.api.functions:
             name = func.ctx_name()
             w(f'    dctx->{name} = &debug_{name};')
-
+        w('}')
+        w('')
+        w('static inline void debug_ctx_init_leaks_fields(HPyContext *dctx)')
+        w('{')
+        for func in self.api.functions:
+            if has_leaks_wrapper(func):
+                name = func.ctx_name()
+                w(f'    dctx->{name} = &debug_leaks_{name};')
         w('}')
         return '\n'.join(lines)
 
@@ -64,6 +89,13 @@ class autogen_debug_wrappers(AutoGenFile):
         'HPyTuple_FromArray',
         'HPyType_GenericNew',
         'HPyType_FromSpec',
+        'HPy_RichCompareBool',
+        'HPy_SetAttrs',
+        'HPy_CallMethodCached',
+        'HPyList_AppendSteal',
+        'HPyListBuilder_SetSteal',
+        'HPyTupleBuilder_SetSteal',
+        'HPySet_AddArray',
         'HPyTracker_New',
         'HPyTracker_Add',
         'HPyTracker_ForgetAll',
@@ -80,14 +112,26 @@ class autogen_debug_wrappers(AutoGenFile):
             if debug_wrapper:
                 w(debug_wrapper)
                 w('')
+        w('/* ~~~ wrappers for HPY_DEBUG_LEVEL_LEAKS ~~~')
+        w('')
+        w('   Like the ones above, but they do not check whether the handles')
+        w('   are still open, and they open new handles with DHPy_open_leaks.')
+        w('*/')
+        w('')
+        for func in self.api.functions:
+            if has_leaks_wrapper(func):
+                w(self.gen_debug_wrapper(func, 'debug_leaks',
+                                         'DHPy_unwrap_nocheck', 'DHPy_open_leaks'))
+                w('')
         return '\n'.join(lines)
 
-    def gen_debug_wrapper(self, func):
+    def gen_debug_wrapper(self, func, prefix='debug', unwrap='DHPy_unwrap',
+                          dhpy_open='DHPy_open'):
         if func.name in self.NO_WRAPPER:
             return
         #
         assert not func.is_varargs()
-        node = get_debug_wrapper_node(func)
+        node = get_debug_wrapper_node(func, prefix)
         signature = toC(node)
         rettype = toC(node.type.type)
         #
@@ -97,7 +141,7 @@ class autogen_debug_wrappers(AutoGenFile):
                 if p.name == 'ctx':
                     lst.append('get_info(dctx)->uctx')
                 elif toC(p.type) == 'DHPy':
-                    lst.append('DHPy_unwrap(dctx, %s)' % p.name)
+                    lst.append('%s(dctx, %s)' % (unwrap, p.name))
                 elif toC(p.type) in ('DHPy *', 'DHPy []'):
                     assert False, ('C type %s not supported, please write the wrapper '
                                    'for %s by hand' % (toC(p.type), func.name))
@@ -113,7 +157,7 @@ class autogen_debug_wrappers(AutoGenFile):
         if rettype == 'void':
             w(f'    {func.name}({params});')
         elif rettype == 'DHPy':
-            w(f'    return DHPy_open(dctx, {func.name}({params}));')
+            w(f'    return {dhpy_open}(dctx, {func.name}({params}));')
         else:
             w(f'    return {func.name}({params});')
         w('}')
@@ -150,7 +194,7 @@ class autogen_debug_ctx_call_i(AutoGenFile):
             w(f'        HPyFunc_{name} f = (HPyFunc_{name})func;')
             w(f'        _HPyFunc_args_{NAME} *a = (_HPyFunc_args_{NAME}*)args;')
             for pname in dhpys:
-                w(f'        DHPy dh_{pname} = _py2dh(dctx, a->{pname});')
+                w(f'        DHPy dh_{pname} = _py2dh(dctx, a->{pname}, leaks);')
             #
             if c_ret_type == 'void':
                 w(f'        f({args});')
@@ -160,11 +204,11 @@ class autogen_debug_ctx_call_i(AutoGenFile):
                 w(f'        a->result = f({args});')
             #
             for pname in dhpys:
-                w(f'        DHPy_close_and_check(dctx, dh_{pname});')
+                w(f'        _dh_close_arg(dctx, dh_{pname}, leaks);')
             #
             if c_ret_type == 'HPy':
-                w(f'        a->result = _dh2py(dctx, dh_result);')
-                w(f'        DHPy_close(dctx, dh_result);')
+                w(f'        a->result = _dh2py(dctx, dh_result, leaks);')
+                w(f'        _dh_close(dctx, dh_result, leaks);')
             #
             w(f'        return;')
             w(f'    }}')
@@ -4,7 +4,8 @@ from .autogenfile import AutoGenFile
 from .parse import toC, find_typedecl
 
 NO_CALL = ('NOARGS', 'O', 'VARARGS', 'KEYWORDS', 'INITPROC', 'DESTROYFUNC',
-           'GETBUFFERPROC', 'RELEASEBUFFERPROC', 'TRAVERSEPROC')
+           'GETBUFFERPROC', 'RELEASEBUFFERPROC', 'TRAVERSEPROC',
+           'RICHCMPBOOLFUNC', 'TYPEDBINARYFUNC')
 NO_TRAMPOLINE = NO_CALL + ('RICHCMPFUNC',)
 
 class autogen_hpyfunc_declare_h(AutoGenFile):
@@ -123,7 +124,7 @@ class autogen_ctx_call_i(AutoGenFile):
             if c_ret_type == 'void':
                 w(f'        f({args});')
             elif c_ret_type == 'HPy':
-                w(f'        a->result = _h2py(f({args}));')
+                w(f'        a->result = _h2py_steal(f({args}));')
             else:
                 w(f'        a->result = f({args});')
             w(f'        return;')
@@ -178,10 +179,16 @@ class autogen_cpython_hpyfunc_trampoline_h(AutoGenFile):
             w(f'    static {toC(tramp_node)} \\')
             w(f'    {{ \\')
             w(f'        _HPyCFunction_{NAME} func = (_HPyCFunction_{NAME})IMPL; \\')
+            w(f'        void *scratch_mark = _HPyMem_ScratchEnter(); \\')
             if toC(tramp_node.type) == 'void':
                 w(f'        func({args}); \\')
+                w(f'        _HPyMem_ScratchLeave(scratch_mark); \\')
+                w(f'        _HPyDealloc_SafePoint(); \\')
                 w(f'        return; \\')
             else:
-                w(f'        return {result}(func({args})); \\')
+                w(f'        {func_ptr_ret_type} res = func({args}); \\')
+                w(f'        _HPyMem_ScratchLeave(scratch_mark); \\')
+                w(f'        _HPyDealloc_SafePoint(); \\')
+                w(f'        return {result}(res); \\')
             w(f'    }}')
         return '\n'.join(lines)
@@ -140,6 +140,10 @@ SPECIAL_CASES = {
     'HPy_Close': None,
     'HPyField_Load': None,
     'HPyField_Store': None,
+    'HPyGlobal_Load': None,
+    'HPyGlobal_Store': None,
+    '_HPyField_LoadAt': None,
+    '_HPyGlobal_LoadAt': None,
     'HPyModule_Create': None,
     'HPy_GetAttr': 'PyObject_GetAttr',
     'HPy_GetAttr_s': 'PyObject_GetAttrString',
@@ -150,6 +154,14 @@ SPECIAL_CASES = {
     'HPy_GetItem': 'PyObject_GetItem',
     'HPy_GetItem_i': None,
     'HPy_GetItem_s': None,
+    'HPy_GetSlice': 'PySequence_GetSlice',
+    'HPy_SetSlice': 'PySequence_SetSlice',
+    'HPy_DelSlice': 'PySequence_DelSlice',
+    'HPy_GetSliceView': None,
+    'HPyList_GetSlice': None,
+    'HPyTuple_GetSlice': None,
+    'HPyBytes_GetSlice': None,
+    'HPyUnicode_Substring': None,
     'HPy_SetItem': 'PyObject_SetItem',
     'HPy_SetItem_i': None,
     'HPy_SetItem_s': None,
@@ -199,6 +211,18 @@ SPECIAL_CASES = {
     'HPy_InPlaceXor': 'PyNumber_InPlaceXor',
     'HPy_InPlaceOr': 'PyNumber_InPlaceOr',
     '_HPy_New': None,
+    'HPyType_GetData': None,
+    'HPyLong_FromString': None,
+    'HPyFloat_FromString': None,
+    'HPyLong_Format': None,
+    'HPyFloat_Format': None,
+    'HPyLong_FromByteArray': None,
+    'HPyLong_AsByteArray': None,
+    'HPyLong_FromLimbs': None,
+    'HPyLong_AsLimbs': None,
+    'HPyLong_NumBits': None,
+    'HPy_SetDeallocBudget': None,
+    'HPy_DrainDeallocs': None,
     'HPyType_FromSpec': None,
     'HPyType_GenericNew': None,
     'HPy_Repr': 'PyObject_Repr',
@@ -207,21 +231,38 @@ SPECIAL_CASES = {
     'HPy_Bytes': 'PyObject_Bytes',
     'HPy_IsTrue': 'PyObject_IsTrue',
     'HPy_RichCompare': 'PyObject_RichCompare',
-    'HPy_RichCompareBool': 'PyObject_RichCompareBool',
+    'HPy_RichCompareBool': None,
+    'HPy_SetAttrs': None,
+    'HPy_GetAttrCached': None,
+    'HPy_CallMethodCached': None,
     'HPy_Hash': 'PyObject_Hash',
+    'HPyList_AppendSteal': None,
     'HPyListBuilder_New': None,
     'HPyListBuilder_Set': None,
+    'HPyListBuilder_SetSteal': None,
     'HPyListBuilder_Build': None,
     'HPyListBuilder_Cancel': None,
     'HPyTuple_FromArray': None,
+    'HPySet_New': None,
+    'HPySet_AddArray': None,
+    'HPyFrozenSetBuilder_New': None,
+    'HPyFrozenSetBuilder_Add': None,
+    'HPyFrozenSetBuilder_Build': None,
+    'HPyFrozenSetBuilder_Cancel': None,
     'HPyTupleBuilder_New': None,
     'HPyTupleBuilder_Set': None,
+    'HPyTupleBuilder_SetSteal': None,
     'HPyTupleBuilder_Build': None,
     'HPyTupleBuilder_Cancel': None,
     'HPyTracker_New': None,
     'HPyTracker_Add': None,
     'HPyTracker_ForgetAll': None,
     'HPyTracker_Close': None,
+    'HPyMem_Malloc': None,
+    'HPyMem_Calloc': None,
+    'HPyMem_Realloc': None,
+    'HPyMem_Free': None,
+    'HPyMem_ScratchAlloc': None,
     '_HPy_Dump': None,
     'HPy_Type': 'PyObject_Type',
     'HPy_TypeCheck': None,
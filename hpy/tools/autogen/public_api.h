@@ -4,16 +4,21 @@ typedef int HPyContext;
 typedef int HPyModuleDef;
 typedef int HPyType_Spec;
 typedef int HPyType_SpecParam;
+typedef int HPyAttrDef;
+typedef int HPyAttrCache;
 typedef int HPyCFunction;
 typedef int HPy_ssize_t;
 typedef int HPy_hash_t;
 typedef int wchar_t;
 typedef int size_t;
+typedef int uint64_t;
 typedef int HPyFunc_Signature;
 typedef int cpy_PyObject;
 typedef int HPyField;
+typedef int HPyGlobal;
 typedef int HPyListBuilder;
 typedef int HPyTupleBuilder;
+typedef int HPyFrozenSetBuilder;
 typedef int HPyTracker;
 typedef int HPy_RichCmpOp;
 typedef int HPy_buffer;
@@ -131,6 +136,46 @@ HPy_ssize_t HPyLong_AsSsize_t(HPyContext *ctx, HPy h);
 HPy HPyFloat_FromDouble(HPyContext *ctx, double v);
 double HPyFloat_AsDouble(HPyContext *ctx, HPy h);
 
+/* Conversions between numbers and text
+
+   HPyLong_FromString and HPyFloat_FromString parse the UTF-8 bytes
+   str[0:size] (size can be -1 if str is NUL-terminated) with the same
+   syntax as int(text, base) and float(text), raising ValueError if the
+   text is not a valid number. Plain decimal integers which fit in 64 bits
+   and plain decimal floats are parsed without any temporary allocation.
+
+   HPyLong_Format and HPyFloat_Format write the same text as repr(int(h))
+   and repr(float(h)) into buf, followed by a NUL byte, if it fits into size
+   bytes: bools and the other subclasses of int are formatted as their int
+   value, e.g. True is formatted as "1". HPyLong_Format raises TypeError if
+   h is not an int. They return the length of the text, without the NUL: if
+   it is >= size nothing has been written and the call must be repeated with
+   a bigger buffer. They return -1 in case of error.
+*/
+HPy HPyLong_FromString(HPyContext *ctx, const char *str, HPy_ssize_t size, int base);
+HPy HPyFloat_FromString(HPyContext *ctx, const char *str, HPy_ssize_t size);
+HPy_ssize_t HPyLong_Format(HPyContext *ctx, HPy h, char *buf, HPy_ssize_t size);
+HPy_ssize_t HPyFloat_Format(HPyContext *ctx, HPy h, char *buf, HPy_ssize_t size);
+
+/* Conversions between ints and arrays of bytes or limbs
+
+   HPyLong_FromByteArray and HPyLong_AsByteArray work on n bytes, in
+   little-endian or big-endian order; HPyLong_FromLimbs and HPyLong_AsLimbs
+   work on n 64-bit limbs in native byte order, the least significant limb
+   first, which is the layout used by most bignum libraries. If is_signed
+   is true the bytes or limbs are a two's complement number, else they are
+   unsigned. The As* functions raise OverflowError if the int does not fit
+   in the array, and return 0 on success or -1 in case of error.
+
+   HPyLong_NumBits returns the number of bits needed to represent the
+   absolute value of an int (0 for 0), which can be used to size the array.
+*/
+HPy HPyLong_FromByteArray(HPyContext *ctx, const unsigned char *bytes, size_t n, int little_endian, int is_signed);
+int HPyLong_AsByteArray(HPyContext *ctx, HPy h, unsigned char *bytes, size_t n, int little_endian, int is_signed);
+HPy HPyLong_FromLimbs(HPyContext *ctx, const uint64_t *limbs, size_t n, int is_signed);
+int HPyLong_AsLimbs(HPyContext *ctx, HPy h, uint64_t *limbs, size_t n, int is_signed);
+HPy_ssize_t HPyLong_NumBits(HPyContext *ctx, HPy h);
+
 HPy HPyBool_FromLong(HPyContext *ctx, long v);
 
 
@@ -176,6 +221,7 @@ HPy HPy_InPlaceOr(HPyContext *ctx, HPy h1, HPy h2);
 
 int HPyCallable_Check(HPyContext *ctx, HPy h);
 HPy HPy_CallTupleDict(HPyContext *ctx, HPy callable, HPy args, HPy kw);
+HPy HPy_CallMethodCached(HPyContext *ctx, HPy obj, HPyAttrCache *cache, HPy *args, HPy_ssize_t nargs);
 
 /* pyerrors.h */
 void HPy_FatalError(HPyContext *ctx, const char *message);
@@ -201,12 +247,14 @@ HPy HPyType_GenericNew(HPyContext *ctx, HPy type, HPy *args, HPy_ssize_t nargs,
 
 HPy HPy_GetAttr(HPyContext *ctx, HPy obj, HPy name);
 HPy HPy_GetAttr_s(HPyContext *ctx, HPy obj, const char *name);
+HPy HPy_GetAttrCached(HPyContext *ctx, HPy obj, HPyAttrCache *cache);
 
 int HPy_HasAttr(HPyContext *ctx, HPy obj, HPy name);
 int HPy_HasAttr_s(HPyContext *ctx, HPy obj, const char *name);
 
 int HPy_SetAttr(HPyContext *ctx, HPy obj, HPy name, HPy value);
 int HPy_SetAttr_s(HPyContext *ctx, HPy obj, const char *name, HPy value);
+int HPy_SetAttrs(HPyContext *ctx, HPy obj, HPyAttrDef *defs);
 
 HPy HPy_GetItem(HPyContext *ctx, HPy obj, HPy key);
 HPy HPy_GetItem_i(HPyContext *ctx, HPy obj, HPy_ssize_t idx);
@@ -218,6 +266,24 @@ int HPy_SetItem(HPyContext *ctx, HPy obj, HPy key, HPy value);
 int HPy_SetItem_i(HPyContext *ctx, HPy obj, HPy_ssize_t idx, HPy value);
 int HPy_SetItem_s(HPyContext *ctx, HPy obj, const char *key, HPy value);
 
+/* Slicing
+
+   HPy_GetSlice, HPy_SetSlice and HPy_DelSlice are equivalent to
+   obj[start:end]: negative indices count from the end and out-of-range
+   ones are clamped, as in Python. The type-specific HPyList_GetSlice,
+   HPyTuple_GetSlice, HPyBytes_GetSlice and HPyUnicode_Substring have the
+   same semantics, but they avoid the creation of a slice object and the
+   generic dispatch; they raise TypeError for other types.
+
+   HPy_GetSliceView returns a memoryview of obj[start:end] for any object
+   which supports the buffer protocol, e.g. bytes or bytearray: the data is
+   not copied, and the view keeps obj alive.
+*/
+HPy HPy_GetSlice(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end);
+int HPy_SetSlice(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end, HPy value);
+int HPy_DelSlice(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end);
+HPy HPy_GetSliceView(HPyContext *ctx, HPy obj, HPy_ssize_t start, HPy_ssize_t end);
+
 HPy HPy_Type(HPyContext *ctx, HPy obj);
 // WARNING: HPy_TypeCheck could be tweaked/removed in the future, see issue #160
 int HPy_TypeCheck(HPyContext *ctx, HPy obj, HPy type);
@@ -229,6 +295,40 @@ void* HPy_AsStructLegacy(HPyContext *ctx, HPy h);
 
 HPy _HPy_New(HPyContext *ctx, HPy h_type, void **data);
 
+/* Return the 'data' of the HPyType_Spec which was used to create 'type' or,
+   if it is NULL, the one of its nearest HPy base which has it (e.g. for a
+   subclass created in Python). Unlike the
+   attributes of the type, it cannot be changed from Python, so it is where
+   the helpers keep their per-type C data. Return NULL (without setting an
+   exception) if there is none.
+*/
+void *HPyType_GetData(HPyContext *ctx, HPy type);
+
+/* Objects of HPy types are not destroyed recursively: when a deallocation
+   is nested too deeply, e.g. because the last reference to a long linked
+   list is dropped, the destruction of the rest is deferred and done
+   iteratively. By default, all the deferred objects are destroyed before
+   the outermost deallocation returns.
+
+   If budget > 0, a deallocation destroys at most 'budget' objects, counting
+   the ones it triggers at any depth, and defers the others. They are
+   destroyed later, 'budget' at a time, by HPy_New and when a call into an
+   HPy extension returns, to avoid long pauses; HPy_DrainDeallocs destroys
+   all of them. A budget of 0 removes the limit and destroys all the pending
+   objects immediately.
+
+   The budget is shared by all the HPy extensions of the process, and so are
+   the pending objects of each thread.
+
+   Return the previous budget, or -1 in case of error.
+*/
+HPy_ssize_t HPy_SetDeallocBudget(HPyContext *ctx, HPy_ssize_t budget);
+
+/* Destroy all the objects of the current thread whose deallocation was
+   deferred, ignoring the budget. It does nothing when called during a
+   deallocation. Return 0, or -1 in case of error. */
+int HPy_DrainDeallocs(HPyContext *ctx);
+
 HPy HPy_Repr(HPyContext *ctx, HPy obj);
 HPy HPy_Str(HPyContext *ctx, HPy obj);
 HPy HPy_ASCII(HPyContext *ctx, HPy obj);
@@ -247,28 +347,52 @@ char* HPyBytes_AsString(HPyContext *ctx, HPy h);
 char* HPyBytes_AS_STRING(HPyContext *ctx, HPy h);
 HPy HPyBytes_FromString(HPyContext *ctx, const char *v);
 HPy HPyBytes_FromStringAndSize(HPyContext *ctx, const char *v, HPy_ssize_t len);
+HPy HPyBytes_GetSlice(HPyContext *ctx, HPy h, HPy_ssize_t start, HPy_ssize_t end);
 
-/* unicodeobject.h */
+/* unicodeobject.h
+
+   HPyUnicode_FromStringAndSize decodes the size UTF-8 bytes at utf8, which
+   can contain NUL characters and do not need to be NUL-terminated.
+*/
 HPy HPyUnicode_FromString(HPyContext *ctx, const char *utf8);
+HPy HPyUnicode_FromStringAndSize(HPyContext *ctx, const char *utf8, HPy_ssize_t size);
 int HPyUnicode_Check(HPyContext *ctx, HPy h);
 HPy HPyUnicode_AsUTF8String(HPyContext *ctx, HPy h);
 const char* HPyUnicode_AsUTF8AndSize(HPyContext *ctx, HPy h, HPy_ssize_t *size);
 HPy HPyUnicode_FromWideChar(HPyContext *ctx, const wchar_t *w, HPy_ssize_t size);
 HPy HPyUnicode_DecodeFSDefault(HPyContext *ctx, const char* v);
 HPy HPyUnicode_DecodeFSDefaultAndSize(HPyContext *ctx, const char* v, HPy_ssize_t size);
+HPy HPyUnicode_Substring(HPyContext *ctx, HPy h, HPy_ssize_t start, HPy_ssize_t end);
 
 /* listobject.h */
 int HPyList_Check(HPyContext *ctx, HPy h);
 HPy HPyList_New(HPyContext *ctx, HPy_ssize_t len);
 int HPyList_Append(HPyContext *ctx, HPy h_list, HPy h_item);
+int HPyList_AppendSteal(HPyContext *ctx, HPy h_list, HPy h_item);
+HPy HPyList_GetSlice(HPyContext *ctx, HPy h_list, HPy_ssize_t start, HPy_ssize_t end);
 
 /* dictobject.h */
 int HPyDict_Check(HPyContext *ctx, HPy h);
 HPy HPyDict_New(HPyContext *ctx);
 
+/* setobject.h
+
+   size_hint is the number of items which are going to be added: the
+   implementation can use it to allocate the table once, but it is not a
+   limit. HPySet_Add and HPySet_AddArray require a set: frozensets are
+   created with HPyFrozenSetBuilder. HPySet_Contains works on both.
+*/
+int HPySet_Check(HPyContext *ctx, HPy h);
+int HPyFrozenSet_Check(HPyContext *ctx, HPy h);
+HPy HPySet_New(HPyContext *ctx, HPy_ssize_t size_hint);
+int HPySet_Add(HPyContext *ctx, HPy h_set, HPy h_item);
+int HPySet_AddArray(HPyContext *ctx, HPy h_set, HPy items[], HPy_ssize_t n);
+int HPySet_Contains(HPyContext *ctx, HPy h_set, HPy h_item);
+
 /* tupleobject.h */
 int HPyTuple_Check(HPyContext *ctx, HPy h);
 HPy HPyTuple_FromArray(HPyContext *ctx, HPy items[], HPy_ssize_t n);
+HPy HPyTuple_GetSlice(HPyContext *ctx, HPy h_tuple, HPy_ssize_t start, HPy_ssize_t end);
 // note: HPyTuple_Pack is implemented as a macro in common/macros.h
 
 /* import.h */
@@ -289,15 +413,27 @@ void _HPy_CallRealFunctionFromTrampoline(HPyContext *ctx,
 HPyListBuilder HPyListBuilder_New(HPyContext *ctx, HPy_ssize_t initial_size);
 void HPyListBuilder_Set(HPyContext *ctx, HPyListBuilder builder,
                         HPy_ssize_t index, HPy h_item);
+void HPyListBuilder_SetSteal(HPyContext *ctx, HPyListBuilder builder,
+                             HPy_ssize_t index, HPy h_item);
 HPy HPyListBuilder_Build(HPyContext *ctx, HPyListBuilder builder);
 void HPyListBuilder_Cancel(HPyContext *ctx, HPyListBuilder builder);
 
 HPyTupleBuilder HPyTupleBuilder_New(HPyContext *ctx, HPy_ssize_t initial_size);
 void HPyTupleBuilder_Set(HPyContext *ctx, HPyTupleBuilder builder,
                          HPy_ssize_t index, HPy h_item);
+void HPyTupleBuilder_SetSteal(HPyContext *ctx, HPyTupleBuilder builder,
+                              HPy_ssize_t index, HPy h_item);
 HPy HPyTupleBuilder_Build(HPyContext *ctx, HPyTupleBuilder builder);
 void HPyTupleBuilder_Cancel(HPyContext *ctx, HPyTupleBuilder builder);
 
+/* Unlike the other builders, HPyFrozenSetBuilder_Add can fail, e.g.
+   if the item is not hashable: it returns -1 and the builder must still be
+   cancelled. */
+HPyFrozenSetBuilder HPyFrozenSetBuilder_New(HPyContext *ctx, HPy_ssize_t size_hint);
+int HPyFrozenSetBuilder_Add(HPyContext *ctx, HPyFrozenSetBuilder builder, HPy h_item);
+HPy HPyFrozenSetBuilder_Build(HPyContext *ctx, HPyFrozenSetBuilder builder);
+void HPyFrozenSetBuilder_Cancel(HPyContext *ctx, HPyFrozenSetBuilder builder);
+
 /* Helper for correctly closing handles */
 
 HPyTracker HPyTracker_New(HPyContext *ctx, HPy_ssize_t size);
@@ -305,6 +441,20 @@ int HPyTracker_Add(HPyContext *ctx, HPyTracker ht, HPy h);
 void HPyTracker_ForgetAll(HPyContext *ctx, HPyTracker ht);
 void HPyTracker_Close(HPyContext *ctx, HPyTracker ht);
 
+/* Memory allocation
+
+   HPyMem_Malloc, HPyMem_Calloc and HPyMem_Realloc use the allocator of the
+   implementation (PyMem_Malloc & co. on CPython) and raise MemoryError if
+   they fail. The memory returned by HPyMem_ScratchAlloc must NOT be freed:
+   it is released in bulk when the call into the extension which allocated
+   it returns, so it is suitable only for temporary buffers.
+*/
+void *HPyMem_Malloc(HPyContext *ctx, size_t size);
+void *HPyMem_Calloc(HPyContext *ctx, size_t nelem, size_t elsize);
+void *HPyMem_Realloc(HPyContext *ctx, void *ptr, size_t size);
+void HPyMem_Free(HPyContext *ctx, void *ptr);
+void *HPyMem_ScratchAlloc(HPyContext *ctx, size_t size);
+
 /* HPyField
 
    HPyFields should be used ONLY in parts of memory which is known to the GC,
@@ -337,9 +487,36 @@ void HPyTracker_Close(HPyContext *ctx, HPyTracker ht);
 Note: target_object and source_object are there in case an implementation
 needs to add write and/or read barriers on the objects. They are ignored by
 CPython but e.g. PyPy needs a write barrier.
+
+HPyField_Load is a macro which passes the address of the field to
+_HPyField_LoadAt, so its third argument must be an lvalue, e.g.
+``HPyField_Load(ctx, self, obj->f)``. Reading the field in the
+implementation lets it synchronize with a concurrent HPyField_Store on
+free-threaded builds; the function taking the field by value is kept for
+extensions compiled before the macro existed, and is not safe there.
 */
 void HPyField_Store(HPyContext *ctx, HPy target_object, HPyField *target_field, HPy h);
 HPy HPyField_Load(HPyContext *ctx, HPy source_object, HPyField source_field);
+HPy _HPyField_LoadAt(HPyContext *ctx, HPy source_object, HPyField *source_field);
+
+/* HPyGlobal
+
+   An HPyGlobal is a reference to an object stored in memory which is not
+   part of an object and lives as long as the interpreter, e.g. a static
+   variable or the C data of a type (see HPyType_GetData). Unlike a handle,
+   it stays valid across calls and threads, and unlike an HPyField it does
+   not need an owner: the object is kept alive until the HPyGlobal is
+   overwritten, e.g. with HPyGlobal_Store(ctx, &g, HPy_NULL).
+
+   HPyGlobals must be zero-initialized before the first HPyGlobal_Store,
+   which is automatically the case for static variables. HPyGlobal_Load
+   returns a new handle, or HPy_NULL (without an exception) if nothing was
+   stored. Like HPyField_Load, it is a macro around _HPyGlobal_LoadAt and
+   its argument must be an lvalue.
+*/
+void HPyGlobal_Store(HPyContext *ctx, HPyGlobal *global, HPy h);
+HPy HPyGlobal_Load(HPyContext *ctx, HPyGlobal global);
+HPy _HPyGlobal_LoadAt(HPyContext *ctx, HPyGlobal *global);
 
 /* Debugging helpers */
 void _HPy_Dump(HPyContext *ctx, HPy h);
@@ -376,6 +553,8 @@ typedef int (*HPyFunc_setattrofunc)(HPyContext *ctx, HPy, HPy, HPy);
 typedef HPy (*HPyFunc_reprfunc)(HPyContext *ctx, HPy);
 typedef HPy_hash_t (*HPyFunc_hashfunc)(HPyContext *ctx, HPy);
 typedef HPy (*HPyFunc_richcmpfunc)(HPyContext *ctx, HPy, HPy, HPy_RichCmpOp);
+typedef int (*HPyFunc_richcmpboolfunc)(HPyContext *ctx, HPy, HPy, HPy_RichCmpOp);
+typedef HPy (*HPyFunc_typedbinaryfunc)(HPyContext *ctx, HPy, void *, HPy, void *);
 typedef HPy (*HPyFunc_getiterfunc)(HPyContext *ctx, HPy);
 typedef HPy (*HPyFunc_iternextfunc)(HPyContext *ctx, HPy);
 typedef HPy (*HPyFunc_descrgetfunc)(HPyContext *ctx, HPy, HPy, HPy);
@@ -457,7 +636,7 @@ typedef enum {
     //HPy_tp_alloc = SLOT(47, HPyFunc_X),      NOT SUPPORTED
     //HPy_tp_base = SLOT(48, HPyFunc_X),
     //HPy_tp_bases = SLOT(49, HPyFunc_X),
-    //HPy_tp_call = SLOT(50, HPyFunc_X),
+    HPy_tp_call = SLOT(50, HPyFunc_KEYWORDS),
     //HPy_tp_clear = SLOT(51, HPyFunc_X),      NOT SUPPORTED, use tp_traverse
     //HPy_tp_dealloc = SLOT(52, HPyFunc_X),    NOT SUPPORTED
     //HPy_tp_del = SLOT(53, HPyFunc_X),
@@ -491,5 +670,6 @@ typedef enum {
 
     /* extra HPy slots */
     HPy_tp_destroy = SLOT(1000, HPyFunc_DESTROYFUNC),
+    HPy_tp_richcompare_bool = SLOT(1001, HPyFunc_RICHCMPBOOLFUNC),
 
 } HPySlot_Slot;
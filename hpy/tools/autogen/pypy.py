@@ -11,6 +11,7 @@ class autogen_pypy_txt(AutoGenFile):
         w = lines.append
         w("typedef struct _HPyContext_s {")
         w("    int ctx_version;")
+        w("    long immortal_handle_mask;")
         for var in self.api.variables:
             w("    struct _HPy_s %s;" % var.ctx_name())
         for func in self.api.functions:
@@ -91,6 +91,7 @@ class TestAutoGen(BaseTestAutogen):
                 const char *name; // used just to make debugging and testing easier
                 void *_private;   // used by implementations to store custom data
                 int ctx_version;
+                intptr_t immortal_handle_mask; // see HPy_Dup() and HPy_Close()
                 HPy h_None;
                 HPy (*ctx_Add)(HPyContext *ctx, HPy h1, HPy h2);
             };
@@ -108,6 +109,7 @@ class TestAutoGen(BaseTestAutogen):
                 .name = "HPy Universal ABI (CPython backend)",
                 ._private = NULL,
                 .ctx_version = 1,
+                .immortal_handle_mask = 0,
                 /* h_None & co. are initialized by init_universal_ctx() */
                 .ctx_Add = &ctx_Add,
             };
@@ -126,10 +128,6 @@ class TestAutoGen(BaseTestAutogen):
                 return ctx->ctx_Add ( ctx, h1, h2 );
             }
 
-            static inline void HPy_Close(HPyContext *ctx, HPy h) {
-                ctx->ctx_Close ( ctx, h );
-            }
-
             static inline void *_HPy_AsStruct(HPyContext *ctx, HPy h) {
                 return ctx->ctx_AsStruct ( ctx, h );
             }
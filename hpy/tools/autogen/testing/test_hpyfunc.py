@@ -96,7 +96,7 @@ class TestHPyFunc(BaseTestAutogen):
             case HPyFunc_FOO: {
                 HPyFunc_foo f = (HPyFunc_foo)func;
                 _HPyFunc_args_FOO *a = (_HPyFunc_args_FOO*)args;
-                a->result = _h2py(f(ctx, _py2h(a->arg), a->xy));
+                a->result = _h2py_steal(f(ctx, _py2h(a->arg), a->xy));
                 return;
             }
             case HPyFunc_BAR: {
@@ -10,6 +10,8 @@ class autogen_trampolines_h(AutoGenFile):
     NO_TRAMPOLINES = set([
         '_HPy_New',
         'HPy_FatalError',
+        'HPy_Dup',
+        'HPy_Close',
         ])
 
     def generate(self):
@@ -13,19 +13,19 @@
     case HPyFunc_UNARYFUNC: {
         HPyFunc_unaryfunc f = (HPyFunc_unaryfunc)func;
         _HPyFunc_args_UNARYFUNC *a = (_HPyFunc_args_UNARYFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0)));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0)));
         return;
     }
     case HPyFunc_BINARYFUNC: {
         HPyFunc_binaryfunc f = (HPyFunc_binaryfunc)func;
         _HPyFunc_args_BINARYFUNC *a = (_HPyFunc_args_BINARYFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0), _py2h(a->arg1)));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0), _py2h(a->arg1)));
         return;
     }
     case HPyFunc_TERNARYFUNC: {
         HPyFunc_ternaryfunc f = (HPyFunc_ternaryfunc)func;
         _HPyFunc_args_TERNARYFUNC *a = (_HPyFunc_args_TERNARYFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0), _py2h(a->arg1), _py2h(a->arg2)));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0), _py2h(a->arg1), _py2h(a->arg2)));
         return;
     }
     case HPyFunc_INQUIRY: {
@@ -43,13 +43,13 @@
     case HPyFunc_SSIZEARGFUNC: {
         HPyFunc_ssizeargfunc f = (HPyFunc_ssizeargfunc)func;
         _HPyFunc_args_SSIZEARGFUNC *a = (_HPyFunc_args_SSIZEARGFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0), a->arg1));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0), a->arg1));
         return;
     }
     case HPyFunc_SSIZESSIZEARGFUNC: {
         HPyFunc_ssizessizeargfunc f = (HPyFunc_ssizessizeargfunc)func;
         _HPyFunc_args_SSIZESSIZEARGFUNC *a = (_HPyFunc_args_SSIZESSIZEARGFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0), a->arg1, a->arg2));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0), a->arg1, a->arg2));
         return;
     }
     case HPyFunc_SSIZEOBJARGPROC: {
@@ -79,13 +79,13 @@
     case HPyFunc_GETATTRFUNC: {
         HPyFunc_getattrfunc f = (HPyFunc_getattrfunc)func;
         _HPyFunc_args_GETATTRFUNC *a = (_HPyFunc_args_GETATTRFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0), a->arg1));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0), a->arg1));
         return;
     }
     case HPyFunc_GETATTROFUNC: {
         HPyFunc_getattrofunc f = (HPyFunc_getattrofunc)func;
         _HPyFunc_args_GETATTROFUNC *a = (_HPyFunc_args_GETATTROFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0), _py2h(a->arg1)));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0), _py2h(a->arg1)));
         return;
     }
     case HPyFunc_SETATTRFUNC: {
@@ -103,7 +103,7 @@
     case HPyFunc_REPRFUNC: {
         HPyFunc_reprfunc f = (HPyFunc_reprfunc)func;
         _HPyFunc_args_REPRFUNC *a = (_HPyFunc_args_REPRFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0)));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0)));
         return;
     }
     case HPyFunc_HASHFUNC: {
@@ -115,25 +115,25 @@
     case HPyFunc_RICHCMPFUNC: {
         HPyFunc_richcmpfunc f = (HPyFunc_richcmpfunc)func;
         _HPyFunc_args_RICHCMPFUNC *a = (_HPyFunc_args_RICHCMPFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0), _py2h(a->arg1), a->arg2));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0), _py2h(a->arg1), a->arg2));
         return;
     }
     case HPyFunc_GETITERFUNC: {
         HPyFunc_getiterfunc f = (HPyFunc_getiterfunc)func;
         _HPyFunc_args_GETITERFUNC *a = (_HPyFunc_args_GETITERFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0)));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0)));
         return;
     }
     case HPyFunc_ITERNEXTFUNC: {
         HPyFunc_iternextfunc f = (HPyFunc_iternextfunc)func;
         _HPyFunc_args_ITERNEXTFUNC *a = (_HPyFunc_args_ITERNEXTFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0)));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0)));
         return;
     }
     case HPyFunc_DESCRGETFUNC: {
         HPyFunc_descrgetfunc f = (HPyFunc_descrgetfunc)func;
         _HPyFunc_args_DESCRGETFUNC *a = (_HPyFunc_args_DESCRGETFUNC*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0), _py2h(a->arg1), _py2h(a->arg2)));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0), _py2h(a->arg1), _py2h(a->arg2)));
         return;
     }
     case HPyFunc_DESCRSETFUNC: {
@@ -145,7 +145,7 @@
     case HPyFunc_GETTER: {
         HPyFunc_getter f = (HPyFunc_getter)func;
         _HPyFunc_args_GETTER *a = (_HPyFunc_args_GETTER*)args;
-        a->result = _h2py(f(ctx, _py2h(a->arg0), a->arg1));
+        a->result = _h2py_steal(f(ctx, _py2h(a->arg0), a->arg1));
         return;
     }
     case HPyFunc_SETTER: {
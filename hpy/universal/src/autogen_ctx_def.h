@@ -14,6 +14,7 @@ struct _HPyContext_s g_universal_ctx = {
     .name = "HPy Universal ABI (CPython backend)",
     ._private = NULL,
     .ctx_version = 1,
+    .immortal_handle_mask = 0,
     /* h_None & co. are initialized by init_universal_ctx() */
     .ctx_Module_Create = &ctx_Module_Create,
     .ctx_Dup = &ctx_Dup,
@@ -34,6 +35,15 @@ struct _HPyContext_s g_universal_ctx = {
     .ctx_Long_AsSsize_t = &ctx_Long_AsSsize_t,
     .ctx_Float_FromDouble = &ctx_Float_FromDouble,
     .ctx_Float_AsDouble = &ctx_Float_AsDouble,
+    .ctx_Long_FromString = &ctx_Long_FromString,
+    .ctx_Float_FromString = &ctx_Float_FromString,
+    .ctx_Long_Format = &ctx_Long_Format,
+    .ctx_Float_Format = &ctx_Float_Format,
+    .ctx_Long_FromByteArray = &ctx_Long_FromByteArray,
+    .ctx_Long_AsByteArray = &ctx_Long_AsByteArray,
+    .ctx_Long_FromLimbs = &ctx_Long_FromLimbs,
+    .ctx_Long_AsLimbs = &ctx_Long_AsLimbs,
+    .ctx_Long_NumBits = &ctx_Long_NumBits,
     .ctx_Bool_FromLong = &ctx_Bool_FromLong,
     .ctx_Length = &ctx_Length,
     .ctx_Number_Check = &ctx_Number_Check,
@@ -73,6 +83,7 @@ struct _HPyContext_s g_universal_ctx = {
     .ctx_InPlaceOr = &ctx_InPlaceOr,
     .ctx_Callable_Check = &ctx_Callable_Check,
     .ctx_CallTupleDict = &ctx_CallTupleDict,
+    .ctx_CallMethodCached = &ctx_CallMethodCached,
     .ctx_FatalError = &ctx_FatalError,
     .ctx_Err_SetString = &ctx_Err_SetString,
     .ctx_Err_SetObject = &ctx_Err_SetObject,
@@ -90,10 +101,12 @@ struct _HPyContext_s g_universal_ctx = {
     .ctx_Type_GenericNew = &ctx_Type_GenericNew,
     .ctx_GetAttr = &ctx_GetAttr,
     .ctx_GetAttr_s = &ctx_GetAttr_s,
+    .ctx_GetAttrCached = &ctx_GetAttrCached,
     .ctx_HasAttr = &ctx_HasAttr,
     .ctx_HasAttr_s = &ctx_HasAttr_s,
     .ctx_SetAttr = &ctx_SetAttr,
     .ctx_SetAttr_s = &ctx_SetAttr_s,
+    .ctx_SetAttrs = &ctx_SetAttrs,
     .ctx_GetItem = &ctx_GetItem,
     .ctx_GetItem_i = &ctx_GetItem_i,
     .ctx_GetItem_s = &ctx_GetItem_s,
@@ -101,12 +114,19 @@ struct _HPyContext_s g_universal_ctx = {
     .ctx_SetItem = &ctx_SetItem,
     .ctx_SetItem_i = &ctx_SetItem_i,
     .ctx_SetItem_s = &ctx_SetItem_s,
+    .ctx_GetSlice = &ctx_GetSlice,
+    .ctx_SetSlice = &ctx_SetSlice,
+    .ctx_DelSlice = &ctx_DelSlice,
+    .ctx_GetSliceView = &ctx_GetSliceView,
     .ctx_Type = &ctx_Type,
     .ctx_TypeCheck = &ctx_TypeCheck,
     .ctx_Is = &ctx_Is,
     .ctx_AsStruct = &ctx_AsStruct,
     .ctx_AsStructLegacy = &ctx_AsStructLegacy,
     .ctx_New = &ctx_New,
+    .ctx_Type_GetData = &ctx_Type_GetData,
+    .ctx_SetDeallocBudget = &ctx_SetDeallocBudget,
+    .ctx_DrainDeallocs = &ctx_DrainDeallocs,
     .ctx_Repr = &ctx_Repr,
     .ctx_Str = &ctx_Str,
     .ctx_ASCII = &ctx_ASCII,
@@ -121,37 +141,64 @@ struct _HPyContext_s g_universal_ctx = {
     .ctx_Bytes_AS_STRING = &ctx_Bytes_AS_STRING,
     .ctx_Bytes_FromString = &ctx_Bytes_FromString,
     .ctx_Bytes_FromStringAndSize = &ctx_Bytes_FromStringAndSize,
+    .ctx_Bytes_GetSlice = &ctx_Bytes_GetSlice,
     .ctx_Unicode_FromString = &ctx_Unicode_FromString,
+    .ctx_Unicode_FromStringAndSize = &ctx_Unicode_FromStringAndSize,
     .ctx_Unicode_Check = &ctx_Unicode_Check,
     .ctx_Unicode_AsUTF8String = &ctx_Unicode_AsUTF8String,
     .ctx_Unicode_AsUTF8AndSize = &ctx_Unicode_AsUTF8AndSize,
     .ctx_Unicode_FromWideChar = &ctx_Unicode_FromWideChar,
     .ctx_Unicode_DecodeFSDefault = &ctx_Unicode_DecodeFSDefault,
     .ctx_Unicode_DecodeFSDefaultAndSize = &ctx_Unicode_DecodeFSDefaultAndSize,
+    .ctx_Unicode_Substring = &ctx_Unicode_Substring,
     .ctx_List_Check = &ctx_List_Check,
     .ctx_List_New = &ctx_List_New,
     .ctx_List_Append = &ctx_List_Append,
+    .ctx_List_AppendSteal = &ctx_List_AppendSteal,
+    .ctx_List_GetSlice = &ctx_List_GetSlice,
     .ctx_Dict_Check = &ctx_Dict_Check,
     .ctx_Dict_New = &ctx_Dict_New,
+    .ctx_Set_Check = &ctx_Set_Check,
+    .ctx_FrozenSet_Check = &ctx_FrozenSet_Check,
+    .ctx_Set_New = &ctx_Set_New,
+    .ctx_Set_Add = &ctx_Set_Add,
+    .ctx_Set_AddArray = &ctx_Set_AddArray,
+    .ctx_Set_Contains = &ctx_Set_Contains,
     .ctx_Tuple_Check = &ctx_Tuple_Check,
     .ctx_Tuple_FromArray = &ctx_Tuple_FromArray,
+    .ctx_Tuple_GetSlice = &ctx_Tuple_GetSlice,
     .ctx_Import_ImportModule = &ctx_Import_ImportModule,
     .ctx_FromPyObject = &ctx_FromPyObject,
     .ctx_AsPyObject = &ctx_AsPyObject,
     .ctx_CallRealFunctionFromTrampoline = &ctx_CallRealFunctionFromTrampoline,
     .ctx_ListBuilder_New = &ctx_ListBuilder_New,
     .ctx_ListBuilder_Set = &ctx_ListBuilder_Set,
+    .ctx_ListBuilder_SetSteal = &ctx_ListBuilder_SetSteal,
     .ctx_ListBuilder_Build = &ctx_ListBuilder_Build,
     .ctx_ListBuilder_Cancel = &ctx_ListBuilder_Cancel,
     .ctx_TupleBuilder_New = &ctx_TupleBuilder_New,
     .ctx_TupleBuilder_Set = &ctx_TupleBuilder_Set,
+    .ctx_TupleBuilder_SetSteal = &ctx_TupleBuilder_SetSteal,
     .ctx_TupleBuilder_Build = &ctx_TupleBuilder_Build,
     .ctx_TupleBuilder_Cancel = &ctx_TupleBuilder_Cancel,
+    .ctx_FrozenSetBuilder_New = &ctx_FrozenSetBuilder_New,
+    .ctx_FrozenSetBuilder_Add = &ctx_FrozenSetBuilder_Add,
+    .ctx_FrozenSetBuilder_Build = &ctx_FrozenSetBuilder_Build,
+    .ctx_FrozenSetBuilder_Cancel = &ctx_FrozenSetBuilder_Cancel,
     .ctx_Tracker_New = &ctx_Tracker_New,
     .ctx_Tracker_Add = &ctx_Tracker_Add,
     .ctx_Tracker_ForgetAll = &ctx_Tracker_ForgetAll,
     .ctx_Tracker_Close = &ctx_Tracker_Close,
+    .ctx_Mem_Malloc = &ctx_Mem_Malloc,
+    .ctx_Mem_Calloc = &ctx_Mem_Calloc,
+    .ctx_Mem_Realloc = &ctx_Mem_Realloc,
+    .ctx_Mem_Free = &ctx_Mem_Free,
+    .ctx_Mem_ScratchAlloc = &ctx_Mem_ScratchAlloc,
     .ctx_Field_Store = &ctx_Field_Store,
     .ctx_Field_Load = &ctx_Field_Load,
+    .ctx_Field_LoadAt = &ctx_Field_LoadAt,
+    .ctx_Global_Store = &ctx_Global_Store,
+    .ctx_Global_Load = &ctx_Global_Load,
+    .ctx_Global_LoadAt = &ctx_Global_LoadAt,
     .ctx_Dump = &ctx_Dump,
 };
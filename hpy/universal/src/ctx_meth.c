@@ -1,6 +1,7 @@
 #include <Python.h>
 #include "ctx_meth.h"
 #include "hpy/runtime/ctx_type.h"
+#include "hpy/runtime/ctx_funcs.h"
 #include "handles.h"
 
 static void _buffer_h2py(HPyContext *ctx, const HPy_buffer *src, Py_buffer *dest)
@@ -33,21 +34,21 @@ static void _buffer_py2h(HPyContext *ctx, const Py_buffer *src, HPy_buffer *dest
     dest->internal = src->internal;
 }
 
-HPyAPI_IMPL void
-ctx_CallRealFunctionFromTrampoline(HPyContext *ctx, HPyFunc_Signature sig,
-                                   void* (*func)(), void *args)
+static void
+call_real_function(HPyContext *ctx, HPyFunc_Signature sig,
+                   void* (*func)(), void *args)
 {
     switch (sig) {
     case HPyFunc_NOARGS: {
         HPyFunc_noargs f = (HPyFunc_noargs)func;
         _HPyFunc_args_NOARGS *a = (_HPyFunc_args_NOARGS*)args;
-        a->result = _h2py(f(ctx, _py2h(a->self)));
+        a->result = _h2py_steal(f(ctx, _py2h(a->self)));
         return;
     }
     case HPyFunc_O: {
         HPyFunc_o f = (HPyFunc_o)func;
         _HPyFunc_args_O *a = (_HPyFunc_args_O*)args;
-        a->result = _h2py(f(ctx, _py2h(a->self), _py2h(a->arg)));
+        a->result = _h2py_steal(f(ctx, _py2h(a->self), _py2h(a->arg)));
         return;
     }
     case HPyFunc_VARARGS: {
@@ -58,7 +59,7 @@ ctx_CallRealFunctionFromTrampoline(HPyContext *ctx, HPyFunc_Signature sig,
         for (Py_ssize_t i = 0; i < nargs; i++) {
             h_args[i] = _py2h(PyTuple_GET_ITEM(a->args, i));
         }
-        a->result = _h2py(f(ctx, _py2h(a->self), h_args, nargs));
+        a->result = _h2py_steal(f(ctx, _py2h(a->self), h_args, nargs));
         return;
     }
     case HPyFunc_KEYWORDS: {
@@ -69,7 +70,7 @@ ctx_CallRealFunctionFromTrampoline(HPyContext *ctx, HPyFunc_Signature sig,
         for (Py_ssize_t i = 0; i < nargs; i++) {
             h_args[i] = _py2h(PyTuple_GET_ITEM(a->args, i));
         }
-        a->result = _h2py(f(ctx, _py2h(a->self), h_args, nargs, _py2h(a->kw)));
+        a->result = _h2py_steal(f(ctx, _py2h(a->self), h_args, nargs, _py2h(a->kw)));
         return;
     }
     case HPyFunc_INITPROC: {
@@ -113,8 +114,38 @@ ctx_CallRealFunctionFromTrampoline(HPyContext *ctx, HPyFunc_Signature sig,
                                                       a->visit, a->arg);
         return;
     }
+    case HPyFunc_RICHCMPBOOLFUNC: {
+        HPyFunc_richcmpboolfunc f = (HPyFunc_richcmpboolfunc)func;
+        _HPyFunc_args_RICHCMPBOOLFUNC *a = (_HPyFunc_args_RICHCMPBOOLFUNC*)args;
+        a->result = richcmpbool_result_to_py(
+            f(ctx, _py2h(a->arg0), _py2h(a->arg1), a->arg2));
+        return;
+    }
+    case HPyFunc_TYPEDBINARYFUNC: {
+        HPyFunc_binaryfunc f = (HPyFunc_binaryfunc)func;
+        _HPyFunc_args_TYPEDBINARYFUNC *a = (_HPyFunc_args_TYPEDBINARYFUNC*)args;
+        void *data0, *data1;
+        if (_HPy_GetStructsIfSameType(a->arg0, a->arg1, &data0, &data1))
+            a->result = _h2py_steal(a->typed_impl(ctx, _py2h(a->arg0), data0,
+                                            _py2h(a->arg1), data1));
+        else
+            a->result = _h2py_steal(f(ctx, _py2h(a->arg0), _py2h(a->arg1)));
+        return;
+    }
 #include "autogen_ctx_call.i"
     default:
         Py_FatalError("Unsupported HPyFunc_Signature in ctx_meth.c");
     }
 }
+
+HPyAPI_IMPL void
+ctx_CallRealFunctionFromTrampoline(HPyContext *ctx, HPyFunc_Signature sig,
+                                   void* (*func)(), void *args)
+{
+    void *scratch_mark = _HPyMem_ScratchEnter();
+    call_real_function(ctx, sig, func, args);
+    _HPyMem_ScratchLeave(scratch_mark);
+    // tp_traverse runs in the middle of a GC collection: not a safe point
+    if (sig != HPyFunc_TRAVERSEPROC)
+        _HPyDealloc_SafePoint();
+}
@@ -2,6 +2,7 @@
 #include "hpy.h"
 #include "handles.h"
 #include "ctx_misc.h"
+#include "hpy/runtime/ctx_funcs.h"
 
 HPyAPI_IMPL HPy
 ctx_FromPyObject(HPyContext *ctx, cpy_PyObject *obj)
@@ -21,6 +22,8 @@ ctx_AsPyObject(HPyContext *ctx, HPy h)
 HPyAPI_IMPL void
 ctx_Close(HPyContext *ctx, HPy h)
 {
+    if (_h_is_immortal(h))
+        return;
     PyObject *obj = _h2py(h);
     Py_XDECREF(obj);
 }
@@ -28,6 +31,8 @@ ctx_Close(HPyContext *ctx, HPy h)
 HPyAPI_IMPL HPy
 ctx_Dup(HPyContext *ctx, HPy h)
 {
+    if (_h_is_immortal(h))
+        return h;
     PyObject *obj = _h2py(h);
     Py_XINCREF(obj);
     return _py2h(obj);
@@ -37,11 +42,24 @@ HPyAPI_IMPL void
 ctx_Field_Store(HPyContext *ctx, HPy target_object, HPyField *target_field, HPy h)
 {
     PyObject *obj = _h2py(h);
-    Py_XDECREF(_hf2py(*target_field));
     Py_XINCREF(obj);
+#ifdef Py_GIL_DISABLED
+    // another thread might be loading the same field: see _HPyField_GetLock
+    PyMutex *lock = _HPyField_GetLock(target_field);
+    PyMutex_Lock(lock);
+    HPyField old = *target_field;
     *target_field = _py2hf(obj);
+    PyMutex_Unlock(lock);
+#else
+    HPyField old = *target_field;
+    *target_field = _py2hf(obj);
+#endif
+    Py_XDECREF(_hf2py(old));
 }
 
+/* Used only by the extensions compiled before HPyField_Load became a macro
+   around _HPyField_LoadAt: the field has already been read by the caller,
+   so on free-threaded builds it can race with HPyField_Store. */
 HPyAPI_IMPL HPy
 ctx_Field_Load(HPyContext *ctx, HPy source_object, HPyField source_field)
 {
@@ -50,6 +68,69 @@ ctx_Field_Load(HPyContext *ctx, HPy source_object, HPyField source_field)
     return _py2h(obj);
 }
 
+HPyAPI_IMPL HPy
+ctx_Field_LoadAt(HPyContext *ctx, HPy source_object, HPyField *source_field)
+{
+#ifdef Py_GIL_DISABLED
+    PyMutex *lock = _HPyField_GetLock(source_field);
+    PyMutex_Lock(lock);
+    PyObject *obj = _hf2py(*source_field);
+    Py_INCREF(obj);
+    PyMutex_Unlock(lock);
+#else
+    PyObject *obj = _hf2py(*source_field);
+    Py_INCREF(obj);
+#endif
+    return _py2h(obj);
+}
+
+HPyAPI_IMPL void
+ctx_Global_Store(HPyContext *ctx, HPyGlobal *global, HPy h)
+{
+    PyObject *obj = _h2py(h);
+    Py_XINCREF(obj);
+#ifdef Py_GIL_DISABLED
+    PyMutex *lock = _HPyField_GetLock(global);
+    PyMutex_Lock(lock);
+    HPyGlobal old = *global;
+    global->_i = (intptr_t)obj;
+    PyMutex_Unlock(lock);
+#else
+    HPyGlobal old = *global;
+    global->_i = (intptr_t)obj;
+#endif
+    Py_XDECREF((PyObject *)old._i);
+}
+
+/* See ctx_Field_Load */
+HPyAPI_IMPL HPy
+ctx_Global_Load(HPyContext *ctx, HPyGlobal global)
+{
+    PyObject *obj = (PyObject *)global._i;
+    if (obj == NULL)
+        return HPy_NULL;
+    Py_INCREF(obj);
+    return _py2h(obj);
+}
+
+HPyAPI_IMPL HPy
+ctx_Global_LoadAt(HPyContext *ctx, HPyGlobal *global)
+{
+#ifdef Py_GIL_DISABLED
+    PyMutex *lock = _HPyField_GetLock(global);
+    PyMutex_Lock(lock);
+    PyObject *obj = (PyObject *)global->_i;
+    Py_XINCREF(obj);
+    PyMutex_Unlock(lock);
+#else
+    PyObject *obj = (PyObject *)global->_i;
+    Py_XINCREF(obj);
+#endif
+    if (obj == NULL)
+        return HPy_NULL;
+    return _py2h(obj);
+}
+
 HPyAPI_IMPL void
 ctx_FatalError(HPyContext *ctx, const char *message)
 {
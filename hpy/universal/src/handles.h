@@ -8,17 +8,50 @@
 // PyObject* directly, things explode. Moreover, with this we can easily
 // distinguish normal and debug handles in gdb, by only looking at the last
 // bit.
+//
+// Handles to immortal objects also have the _HPY_IMMORTAL_TAG bit set, which
+// is the ctx->immortal_handle_mask of the universal ctx: HPy_Dup and
+// HPy_Close do nothing on them, without even calling into the ctx. These are
+// the constants of the ctx (h_None, h_True, h_TypeError, ...), which are
+// static objects and live as long as the interpreter, and on CPython >= 3.12
+// all the objects which CPython itself considers immortal, e.g. small ints.
+//
+// Since HPy_Dup does not incref them, an immortal handle does not own a
+// reference: when a handle is converted into a new reference (e.g. when a
+// function returns it to CPython, or when it is stolen by a builder), use
+// _h2py_steal instead of _h2py.
+
+#define _HPY_IMMORTAL_TAG 2
+
+static inline HPy _py2h_immortal(PyObject *obj) {
+    return (HPy){(HPy_ssize_t)obj + 1 + _HPY_IMMORTAL_TAG};
+}
 
 static inline HPy _py2h(PyObject *obj) {
     if (obj == NULL)
         return HPy_NULL;
+#if PY_VERSION_HEX >= 0x030C0000
+    if (_Py_IsImmortal(obj))
+        return _py2h_immortal(obj);
+#endif
     return (HPy){(HPy_ssize_t)obj + 1};
 }
 
 static inline PyObject *_h2py(HPy h) {
     if HPy_IsNull(h)
         return NULL;
-    return (PyObject *)(h._i - 1);
+    return (PyObject *)(h._i & ~(HPy_ssize_t)(1 | _HPY_IMMORTAL_TAG));
+}
+
+static inline int _h_is_immortal(HPy h) {
+    return (h._i & _HPY_IMMORTAL_TAG) != 0;
+}
+
+static inline PyObject *_h2py_steal(HPy h) {
+    PyObject *obj = _h2py(h);
+    if (_h_is_immortal(h))
+        Py_INCREF(obj);
+    return obj;
 }
 
 static inline HPyField _py2hf(PyObject *obj)
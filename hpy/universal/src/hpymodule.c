@@ -12,6 +12,7 @@
 #include "handles.h"
 #include "hpy/version.h"
 #include "hpy_debug.h"
+#include "hpy/runtime/ctx_funcs.h"
 
 #ifdef PYPY_VERSION
 #  error "Cannot build hpy.univeral on top of PyPy. PyPy comes with its own version of it"
@@ -27,14 +28,39 @@ static PyObject *set_debug(PyObject *self, PyObject *args)
 
 static const char *prefix = "HPyInit";
 
+/* debug is 0 for the universal ctx, else an HPyDebugLevel */
 static HPyContext * get_context(int debug)
 {
     if (debug)
-        return hpy_debug_get_ctx(&g_universal_ctx);
+        return hpy_debug_get_ctx_level(&g_universal_ctx, (HPyDebugLevel)debug);
     else
         return &g_universal_ctx;
 }
 
+/* Convert the 'debug' argument of load(), which can be a bool or the name of
+   a debug level */
+static int get_debug_level(PyObject *obj, int *debug)
+{
+    if (PyUnicode_Check(obj)) {
+        if (PyUnicode_CompareWithASCIIString(obj, "leaks") == 0)
+            *debug = HPY_DEBUG_LEVEL_LEAKS;
+        else if (PyUnicode_CompareWithASCIIString(obj, "full") == 0)
+            *debug = HPY_DEBUG_LEVEL_FULL;
+        else {
+            PyErr_Format(PyExc_ValueError,
+                         "debug must be a bool, 'leaks' or 'full', not '%U'",
+                         obj);
+            return -1;
+        }
+        return 0;
+    }
+    int res = PyObject_IsTrue(obj);
+    if (res < 0)
+        return -1;
+    *debug = res ? HPY_DEBUG_LEVEL_FULL : 0;
+    return 0;
+}
+
 static PyObject *
 get_encoded_name(PyObject *name) {
     PyObject *tmp;
@@ -118,7 +144,10 @@ static PyObject *do_load(PyObject *name_unicode, PyObject *path, int debug)
     HPyContext *ctx = get_context(debug);
     if (ctx == NULL)
         goto error;
+    void *scratch_mark = _HPyMem_ScratchEnter();
     HPy h_mod = ((InitFuncPtr)initfn)(ctx);
+    _HPyMem_ScratchLeave(scratch_mark);
+    _HPyDealloc_SafePoint();
     if (HPy_IsNull(h_mod))
         goto error;
     PyObject *py_mod = HPy_AsPyObject(ctx, h_mod);
@@ -138,11 +167,14 @@ static PyObject *load(PyObject *self, PyObject *args, PyObject *kwargs)
     static char *kwlist[] = {"name", "path", "debug", NULL};
     PyObject *name_unicode;
     PyObject *path;
-    int debug = 0;
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|p", kwlist,
-                                     &name_unicode, &path, &debug)) {
+    PyObject *debug_obj = Py_False;
+    int debug;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|O", kwlist,
+                                     &name_unicode, &path, &debug_obj)) {
         return NULL;
     }
+    if (get_debug_level(debug_obj, &debug) < 0)
+        return NULL;
     return do_load(name_unicode, path, debug);
 }
 
@@ -161,6 +193,9 @@ static PyMethodDef HPyMethods[] = {
 static int exec_module(PyObject *mod);
 static PyModuleDef_Slot hpymodule_slots[] = {
     {Py_mod_exec, exec_module},
+#ifdef Py_GIL_DISABLED
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
     {0, NULL},
 };
 
@@ -197,87 +232,89 @@ static void init_universal_ctx(HPyContext *ctx)
 
     // XXX this code is basically the same as found in cpython/hpy.h. We
     // should probably share and/or autogenerate both versions
-    /* Constants */
-    ctx->h_None = _py2h(Py_None);
-    ctx->h_True = _py2h(Py_True);
-    ctx->h_False = _py2h(Py_False);
-    ctx->h_NotImplemented = _py2h(Py_NotImplemented);
-    ctx->h_Ellipsis = _py2h(Py_Ellipsis);
+    /* Constants: they are static objects which live as long as the
+       interpreter, so their handles are immortal (see handles.h) */
+    ctx->immortal_handle_mask = _HPY_IMMORTAL_TAG;
+    ctx->h_None = _py2h_immortal(Py_None);
+    ctx->h_True = _py2h_immortal(Py_True);
+    ctx->h_False = _py2h_immortal(Py_False);
+    ctx->h_NotImplemented = _py2h_immortal(Py_NotImplemented);
+    ctx->h_Ellipsis = _py2h_immortal(Py_Ellipsis);
     /* Exceptions */
-    ctx->h_BaseException = _py2h(PyExc_BaseException);
-    ctx->h_Exception = _py2h(PyExc_Exception);
-    ctx->h_StopAsyncIteration = _py2h(PyExc_StopAsyncIteration);
-    ctx->h_StopIteration = _py2h(PyExc_StopIteration);
-    ctx->h_GeneratorExit = _py2h(PyExc_GeneratorExit);
-    ctx->h_ArithmeticError = _py2h(PyExc_ArithmeticError);
-    ctx->h_LookupError = _py2h(PyExc_LookupError);
-    ctx->h_AssertionError = _py2h(PyExc_AssertionError);
-    ctx->h_AttributeError = _py2h(PyExc_AttributeError);
-    ctx->h_BufferError = _py2h(PyExc_BufferError);
-    ctx->h_EOFError = _py2h(PyExc_EOFError);
-    ctx->h_FloatingPointError = _py2h(PyExc_FloatingPointError);
-    ctx->h_OSError = _py2h(PyExc_OSError);
-    ctx->h_ImportError = _py2h(PyExc_ImportError);
-    ctx->h_ModuleNotFoundError = _py2h(PyExc_ModuleNotFoundError);
-    ctx->h_IndexError = _py2h(PyExc_IndexError);
-    ctx->h_KeyError = _py2h(PyExc_KeyError);
-    ctx->h_KeyboardInterrupt = _py2h(PyExc_KeyboardInterrupt);
-    ctx->h_MemoryError = _py2h(PyExc_MemoryError);
-    ctx->h_NameError = _py2h(PyExc_NameError);
-    ctx->h_OverflowError = _py2h(PyExc_OverflowError);
-    ctx->h_RuntimeError = _py2h(PyExc_RuntimeError);
-    ctx->h_RecursionError = _py2h(PyExc_RecursionError);
-    ctx->h_NotImplementedError = _py2h(PyExc_NotImplementedError);
-    ctx->h_SyntaxError = _py2h(PyExc_SyntaxError);
-    ctx->h_IndentationError = _py2h(PyExc_IndentationError);
-    ctx->h_TabError = _py2h(PyExc_TabError);
-    ctx->h_ReferenceError = _py2h(PyExc_ReferenceError);
-    ctx->h_SystemError = _py2h(PyExc_SystemError);
-    ctx->h_SystemExit = _py2h(PyExc_SystemExit);
-    ctx->h_TypeError = _py2h(PyExc_TypeError);
-    ctx->h_UnboundLocalError = _py2h(PyExc_UnboundLocalError);
-    ctx->h_UnicodeError = _py2h(PyExc_UnicodeError);
-    ctx->h_UnicodeEncodeError = _py2h(PyExc_UnicodeEncodeError);
-    ctx->h_UnicodeDecodeError = _py2h(PyExc_UnicodeDecodeError);
-    ctx->h_UnicodeTranslateError = _py2h(PyExc_UnicodeTranslateError);
-    ctx->h_ValueError = _py2h(PyExc_ValueError);
-    ctx->h_ZeroDivisionError = _py2h(PyExc_ZeroDivisionError);
-    ctx->h_BlockingIOError = _py2h(PyExc_BlockingIOError);
-    ctx->h_BrokenPipeError = _py2h(PyExc_BrokenPipeError);
-    ctx->h_ChildProcessError = _py2h(PyExc_ChildProcessError);
-    ctx->h_ConnectionError = _py2h(PyExc_ConnectionError);
-    ctx->h_ConnectionAbortedError = _py2h(PyExc_ConnectionAbortedError);
-    ctx->h_ConnectionRefusedError = _py2h(PyExc_ConnectionRefusedError);
-    ctx->h_ConnectionResetError = _py2h(PyExc_ConnectionResetError);
-    ctx->h_FileExistsError = _py2h(PyExc_FileExistsError);
-    ctx->h_FileNotFoundError = _py2h(PyExc_FileNotFoundError);
-    ctx->h_InterruptedError = _py2h(PyExc_InterruptedError);
-    ctx->h_IsADirectoryError = _py2h(PyExc_IsADirectoryError);
-    ctx->h_NotADirectoryError = _py2h(PyExc_NotADirectoryError);
-    ctx->h_PermissionError = _py2h(PyExc_PermissionError);
-    ctx->h_ProcessLookupError = _py2h(PyExc_ProcessLookupError);
-    ctx->h_TimeoutError = _py2h(PyExc_TimeoutError);
+    ctx->h_BaseException = _py2h_immortal(PyExc_BaseException);
+    ctx->h_Exception = _py2h_immortal(PyExc_Exception);
+    ctx->h_StopAsyncIteration = _py2h_immortal(PyExc_StopAsyncIteration);
+    ctx->h_StopIteration = _py2h_immortal(PyExc_StopIteration);
+    ctx->h_GeneratorExit = _py2h_immortal(PyExc_GeneratorExit);
+    ctx->h_ArithmeticError = _py2h_immortal(PyExc_ArithmeticError);
+    ctx->h_LookupError = _py2h_immortal(PyExc_LookupError);
+    ctx->h_AssertionError = _py2h_immortal(PyExc_AssertionError);
+    ctx->h_AttributeError = _py2h_immortal(PyExc_AttributeError);
+    ctx->h_BufferError = _py2h_immortal(PyExc_BufferError);
+    ctx->h_EOFError = _py2h_immortal(PyExc_EOFError);
+    ctx->h_FloatingPointError = _py2h_immortal(PyExc_FloatingPointError);
+    ctx->h_OSError = _py2h_immortal(PyExc_OSError);
+    ctx->h_ImportError = _py2h_immortal(PyExc_ImportError);
+    ctx->h_ModuleNotFoundError = _py2h_immortal(PyExc_ModuleNotFoundError);
+    ctx->h_IndexError = _py2h_immortal(PyExc_IndexError);
+    ctx->h_KeyError = _py2h_immortal(PyExc_KeyError);
+    ctx->h_KeyboardInterrupt = _py2h_immortal(PyExc_KeyboardInterrupt);
+    ctx->h_MemoryError = _py2h_immortal(PyExc_MemoryError);
+    ctx->h_NameError = _py2h_immortal(PyExc_NameError);
+    ctx->h_OverflowError = _py2h_immortal(PyExc_OverflowError);
+    ctx->h_RuntimeError = _py2h_immortal(PyExc_RuntimeError);
+    ctx->h_RecursionError = _py2h_immortal(PyExc_RecursionError);
+    ctx->h_NotImplementedError = _py2h_immortal(PyExc_NotImplementedError);
+    ctx->h_SyntaxError = _py2h_immortal(PyExc_SyntaxError);
+    ctx->h_IndentationError = _py2h_immortal(PyExc_IndentationError);
+    ctx->h_TabError = _py2h_immortal(PyExc_TabError);
+    ctx->h_ReferenceError = _py2h_immortal(PyExc_ReferenceError);
+    ctx->h_SystemError = _py2h_immortal(PyExc_SystemError);
+    ctx->h_SystemExit = _py2h_immortal(PyExc_SystemExit);
+    ctx->h_TypeError = _py2h_immortal(PyExc_TypeError);
+    ctx->h_UnboundLocalError = _py2h_immortal(PyExc_UnboundLocalError);
+    ctx->h_UnicodeError = _py2h_immortal(PyExc_UnicodeError);
+    ctx->h_UnicodeEncodeError = _py2h_immortal(PyExc_UnicodeEncodeError);
+    ctx->h_UnicodeDecodeError = _py2h_immortal(PyExc_UnicodeDecodeError);
+    ctx->h_UnicodeTranslateError = _py2h_immortal(PyExc_UnicodeTranslateError);
+    ctx->h_ValueError = _py2h_immortal(PyExc_ValueError);
+    ctx->h_ZeroDivisionError = _py2h_immortal(PyExc_ZeroDivisionError);
+    ctx->h_BlockingIOError = _py2h_immortal(PyExc_BlockingIOError);
+    ctx->h_BrokenPipeError = _py2h_immortal(PyExc_BrokenPipeError);
+    ctx->h_ChildProcessError = _py2h_immortal(PyExc_ChildProcessError);
+    ctx->h_ConnectionError = _py2h_immortal(PyExc_ConnectionError);
+    ctx->h_ConnectionAbortedError = _py2h_immortal(PyExc_ConnectionAbortedError);
+    ctx->h_ConnectionRefusedError = _py2h_immortal(PyExc_ConnectionRefusedError);
+    ctx->h_ConnectionResetError = _py2h_immortal(PyExc_ConnectionResetError);
+    ctx->h_FileExistsError = _py2h_immortal(PyExc_FileExistsError);
+    ctx->h_FileNotFoundError = _py2h_immortal(PyExc_FileNotFoundError);
+    ctx->h_InterruptedError = _py2h_immortal(PyExc_InterruptedError);
+    ctx->h_IsADirectoryError = _py2h_immortal(PyExc_IsADirectoryError);
+    ctx->h_NotADirectoryError = _py2h_immortal(PyExc_NotADirectoryError);
+    ctx->h_PermissionError = _py2h_immortal(PyExc_PermissionError);
+    ctx->h_ProcessLookupError = _py2h_immortal(PyExc_ProcessLookupError);
+    ctx->h_TimeoutError = _py2h_immortal(PyExc_TimeoutError);
     /* Warnings */
-    ctx->h_Warning = _py2h(PyExc_Warning);
-    ctx->h_UserWarning = _py2h(PyExc_UserWarning);
-    ctx->h_DeprecationWarning = _py2h(PyExc_DeprecationWarning);
-    ctx->h_PendingDeprecationWarning = _py2h(PyExc_PendingDeprecationWarning);
-    ctx->h_SyntaxWarning = _py2h(PyExc_SyntaxWarning);
-    ctx->h_RuntimeWarning = _py2h(PyExc_RuntimeWarning);
-    ctx->h_FutureWarning = _py2h(PyExc_FutureWarning);
-    ctx->h_ImportWarning = _py2h(PyExc_ImportWarning);
-    ctx->h_UnicodeWarning = _py2h(PyExc_UnicodeWarning);
-    ctx->h_BytesWarning = _py2h(PyExc_BytesWarning);
-    ctx->h_ResourceWarning = _py2h(PyExc_ResourceWarning);
+    ctx->h_Warning = _py2h_immortal(PyExc_Warning);
+    ctx->h_UserWarning = _py2h_immortal(PyExc_UserWarning);
+    ctx->h_DeprecationWarning = _py2h_immortal(PyExc_DeprecationWarning);
+    ctx->h_PendingDeprecationWarning = _py2h_immortal(PyExc_PendingDeprecationWarning);
+    ctx->h_SyntaxWarning = _py2h_immortal(PyExc_SyntaxWarning);
+    ctx->h_RuntimeWarning = _py2h_immortal(PyExc_RuntimeWarning);
+    ctx->h_FutureWarning = _py2h_immortal(PyExc_FutureWarning);
+    ctx->h_ImportWarning = _py2h_immortal(PyExc_ImportWarning);
+    ctx->h_UnicodeWarning = _py2h_immortal(PyExc_UnicodeWarning);
+    ctx->h_BytesWarning = _py2h_immortal(PyExc_BytesWarning);
+    ctx->h_ResourceWarning = _py2h_immortal(PyExc_ResourceWarning);
     /* Types */
-    ctx->h_BaseObjectType = _py2h((PyObject *)&PyBaseObject_Type);
-    ctx->h_TypeType = _py2h((PyObject *)&PyType_Type);
-    ctx->h_BoolType = _py2h((PyObject *)&PyBool_Type);
-    ctx->h_LongType = _py2h((PyObject *)&PyLong_Type);
-    ctx->h_FloatType  = _py2h((PyObject *)&PyFloat_Type);
-    ctx->h_UnicodeType = _py2h((PyObject *)&PyUnicode_Type);
-    ctx->h_TupleType = _py2h((PyObject *)&PyTuple_Type);
-    ctx->h_ListType = _py2h((PyObject *)&PyList_Type);
+    ctx->h_BaseObjectType = _py2h_immortal((PyObject *)&PyBaseObject_Type);
+    ctx->h_TypeType = _py2h_immortal((PyObject *)&PyType_Type);
+    ctx->h_BoolType = _py2h_immortal((PyObject *)&PyBool_Type);
+    ctx->h_LongType = _py2h_immortal((PyObject *)&PyLong_Type);
+    ctx->h_FloatType  = _py2h_immortal((PyObject *)&PyFloat_Type);
+    ctx->h_UnicodeType = _py2h_immortal((PyObject *)&PyUnicode_Type);
+    ctx->h_TupleType = _py2h_immortal((PyObject *)&PyTuple_Type);
+    ctx->h_ListType = _py2h_immortal((PyObject *)&PyList_Type);
 }
 
 
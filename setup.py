@@ -2,6 +2,7 @@ import textwrap
 import sys
 import os
 import os.path
+import sysconfig
 from setuptools import setup, Extension
 
 # this package is supposed to be installed ONLY on CPython. Try to bail out
@@ -55,6 +56,11 @@ else:
 if os.name == "posix" and not '_HPY_DEBUG_FORCE_DEFAULT_MEM_PROTECT' in os.environ:
     EXTRA_COMPILE_ARGS += ['-D_HPY_DEBUG_MEM_PROTECT_USEMMAP']
 
+# On free-threaded builds of CPython (PEP 703), the debug mode must protect its
+# internal data structures with a lock
+if sysconfig.get_config_var('Py_GIL_DISABLED'):
+    EXTRA_COMPILE_ARGS += ['-DHPY_DEBUG_THREAD_SAFE']
+
 
 def get_scm_config():
     """
@@ -98,14 +104,21 @@ EXT_MODULES = [
                'hpy/devel/src/runtime/argparse.c',
                'hpy/devel/src/runtime/buildvalue.c',
                'hpy/devel/src/runtime/helpers.c',
+               'hpy/devel/src/runtime/ctx_attrcache.c',
                'hpy/devel/src/runtime/ctx_bytes.c',
                'hpy/devel/src/runtime/ctx_call.c',
                'hpy/devel/src/runtime/ctx_err.c',
+               'hpy/devel/src/runtime/ctx_frozensetbuilder.c',
                'hpy/devel/src/runtime/ctx_module.c',
+               'hpy/devel/src/runtime/ctx_number.c',
                'hpy/devel/src/runtime/ctx_object.c',
+               'hpy/devel/src/runtime/ctx_set.c',
+               'hpy/devel/src/runtime/ctx_slice.c',
                'hpy/devel/src/runtime/ctx_type.c',
                'hpy/devel/src/runtime/ctx_tracker.c',
+               'hpy/devel/src/runtime/ctx_list.c',
                'hpy/devel/src/runtime/ctx_listbuilder.c',
+               'hpy/devel/src/runtime/ctx_mem.c',
                'hpy/devel/src/runtime/ctx_tuple.c',
                'hpy/devel/src/runtime/ctx_tuplebuilder.c',
                'hpy/debug/src/debug_ctx.c',
@@ -13,6 +13,10 @@ def pytest_addoption(parser):
         "--subprocess-v", action="store_true",
         help="Print to stdout the stdout and stderr of Python subprocesses"
              "executed via run_python_subprocess")
+    parser.addoption(
+        "--hpy-debug-level", choices=['leaks', 'full'], default=None,
+        help="Level of the debug mode used by the tests with hpy_abi=='debug'"
+             " (default: full)")
 
 
 @pytest.hookimpl(trylast=True)
@@ -37,17 +41,23 @@ def hpy_abi(request):
     else:
         yield abi
 
+@pytest.fixture
+def hpy_debug_level(request):
+    return request.config.getoption('--hpy-debug-level')
+
 @pytest.fixture
 def ExtensionTemplate():
     return DefaultExtensionTemplate
 
 
 @pytest.fixture
-def compiler(request, tmpdir, hpy_devel, hpy_abi, ExtensionTemplate):
+def compiler(request, tmpdir, hpy_devel, hpy_abi, hpy_debug_level,
+             ExtensionTemplate):
     compiler_verbose = request.config.getoption('--compiler-v')
     return ExtensionCompiler(tmpdir, hpy_devel, hpy_abi,
                              compiler_verbose=compiler_verbose,
-                             ExtensionTemplate=ExtensionTemplate)
+                             ExtensionTemplate=ExtensionTemplate,
+                             hpy_debug_level=hpy_debug_level)
 
 
 @pytest.fixture(scope="session")
@@ -63,9 +73,9 @@ def fatal_exit_code(request):
 
 
 @pytest.fixture
-def python_subprocess(request, hpy_abi):
+def python_subprocess(request, hpy_abi, hpy_debug_level):
     verbose = request.config.getoption('--subprocess-v')
-    yield PythonSubprocessRunner(verbose, hpy_abi)
+    yield PythonSubprocessRunner(verbose, hpy_abi, hpy_debug_level)
 
 
 @pytest.fixture()
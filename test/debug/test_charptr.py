@@ -15,6 +15,11 @@ def hpy_abi():
     with LeakDetector():
         yield "debug"
 
+# these tests check the usage of closed handles, which needs the full level
+@pytest.fixture
+def hpy_debug_level():
+    return 'full'
+
 
 @pytest.mark.skipif(not SUPPORTS_SYS_EXECUTABLE, reason="needs subprocess")
 def test_charptr_use_after_implicit_arg_handle_close(compiler, python_subprocess):
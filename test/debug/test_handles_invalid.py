@@ -8,6 +8,11 @@ def hpy_abi():
     with LeakDetector():
         yield "debug"
 
+# these tests check the usage of closed handles, which needs the full level
+@pytest.fixture
+def hpy_debug_level():
+    return 'full'
+
 
 def test_no_invalid_handle(compiler, hpy_debug_capture):
     # Basic sanity check that valid code does not trigger any error reports
@@ -153,4 +158,129 @@ def test_invalid_handle_crashes_python_if_no_hook(compiler, python_subprocess, f
         @INIT
     """)
     result = python_subprocess.run(mod, "mod.f(42);")
-    assert result.returncode == fatal_exit_code
\ No newline at end of file
+    assert result.returncode == fatal_exit_code
+
+def test_cant_use_stolen_handle(compiler, hpy_debug_capture):
+    mod = compiler.make_module("""
+        HPyDef_METH(f, "f", f_impl, HPyFunc_O, .doc="use after SetSteal")
+        static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+        {
+            HPy h = HPy_Dup(ctx, arg);
+            HPyTupleBuilder builder = HPyTupleBuilder_New(ctx, 1);
+            HPyTupleBuilder_SetSteal(ctx, builder, 0, h);
+            HPy_Close(ctx, h); // h was already consumed
+            return HPyTupleBuilder_Build(ctx, builder);
+        }
+
+        HPyDef_METH(g, "g", g_impl, HPyFunc_O, .doc="use after AppendSteal")
+        static HPy g_impl(HPyContext *ctx, HPy self, HPy arg)
+        {
+            HPy h = HPyLong_FromLong(ctx, 42);
+            HPyList_AppendSteal(ctx, arg, h);
+            return HPy_Repr(ctx, h); // h was already consumed
+        }
+
+        HPyDef_METH(n, "n", n_impl, HPyFunc_O, .doc="use after 'N'")
+        static HPy n_impl(HPyContext *ctx, HPy self, HPy arg)
+        {
+            HPy h = HPy_Dup(ctx, arg);
+            HPy res = HPy_BuildValue(ctx, "(N)", h);
+            HPy_Close(ctx, h); // h was already consumed
+            return res;
+        }
+
+        @EXPORT(f)
+        @EXPORT(g)
+        @EXPORT(n)
+        @INIT
+    """)
+    assert mod.f('foo') == ('foo',)
+    assert hpy_debug_capture.invalid_handles_count == 1
+    lst = []
+    mod.g(lst)
+    assert lst == [42]
+    assert hpy_debug_capture.invalid_handles_count == 2
+    assert mod.n('bar') == ('bar',)
+    assert hpy_debug_capture.invalid_handles_count == 3
+
+def test_richcompare_bool_across_modes(compiler, hpy_debug_capture):
+    # HPy_RichCompareBool must not call the HPy_tp_richcompare_bool impl of a
+    # type with the handles of another ABI: here the debug module expects
+    # DHPy while the universal one passes UHPy, and vice versa.
+    src = """
+        typedef struct {
+            long value;
+        } BoxObject;
+        HPyType_HELPERS(BoxObject)
+
+        static long calls;
+
+        HPyDef_SLOT(Box_new, Box_new_impl, HPy_tp_new)
+        static HPy Box_new_impl(HPyContext *ctx, HPy cls, HPy *args,
+                                HPy_ssize_t nargs, HPy kw)
+        {
+            long value;
+            if (!HPyArg_Parse(ctx, NULL, args, nargs, "l", &value))
+                return HPy_NULL;
+            BoxObject *box;
+            HPy h_box = HPy_New(ctx, cls, &box);
+            if (HPy_IsNull(h_box))
+                return HPy_NULL;
+            box->value = value;
+            return h_box;
+        }
+
+        HPyDef_SLOT(Box_cmp, Box_cmp_impl, HPy_tp_richcompare_bool)
+        static int Box_cmp_impl(HPyContext *ctx, HPy self, HPy o, HPy_RichCmpOp op)
+        {
+            calls++;
+            long a = BoxObject_AsStruct(ctx, self)->value;
+            long b = BoxObject_AsStruct(ctx, o)->value;
+            if (a < 0 || b < 0)
+                return HPy_RICHCMP_NOTIMPLEMENTED;
+            HPy_RETURN_RICHCOMPARE_BOOL(ctx, a, b, op);
+        }
+
+        static HPyDef *Box_defines[] = { &Box_new, &Box_cmp, NULL };
+        static HPyType_Spec Box_spec = {
+            .name = "mytest.Box",
+            .basicsize = sizeof(BoxObject),
+            .defines = Box_defines,
+        };
+
+        HPyDef_METH(lt, "lt", lt_impl, HPyFunc_VARARGS)
+        static HPy lt_impl(HPyContext *ctx, HPy self, HPy *args, HPy_ssize_t nargs)
+        {
+            int res = HPy_RichCompareBool(ctx, args[0], args[1], HPy_LT);
+            if (res < 0)
+                return HPy_NULL;
+            return HPyBool_FromLong(ctx, res);
+        }
+
+        HPyDef_METH(get_calls, "get_calls", get_calls_impl, HPyFunc_NOARGS)
+        static HPy get_calls_impl(HPyContext *ctx, HPy self)
+        {
+            return HPyLong_FromLong(ctx, calls);
+        }
+
+        @EXPORT_TYPE("Box", Box_spec)
+        @EXPORT(lt)
+        @EXPORT(get_calls)
+        @INIT
+    """
+    dbg_mod = compiler.compile_module(src, name='dbg_mod')
+    uni_mod = compiler.compile_module(src, name='uni_mod')
+    dbg = compiler.load_universal_module('dbg_mod', dbg_mod.so_filename,
+                                         debug=True)
+    uni = compiler.load_universal_module('uni_mod', uni_mod.so_filename,
+                                         debug=False)
+    for mod, other in [(dbg, uni), (uni, dbg)]:
+        a, b = other.Box(1), other.Box(2)
+        calls = other.get_calls()
+        assert mod.lt(a, b) is True
+        assert mod.lt(b, a) is False
+        assert other.get_calls() == calls + 2
+        # the same module can use its fast path
+        assert other.lt(a, b) is True
+        assert other.get_calls() == calls + 3
+    assert hpy_debug_capture.invalid_handles_count == 0
@@ -51,6 +51,34 @@ def test_get_open_handles(compiler):
     assert leaks1 == ['hello', 'world', 'a younger leak']
     assert leaks2 == ['a younger leak']
 
+def test_HPyGlobal_is_not_a_leak(compiler):
+    from hpy.universal import _debug
+    mod = compiler.make_module("""
+        static HPyGlobal g;
+
+        HPyDef_METH(store, "store", store_impl, HPyFunc_O)
+        static HPy store_impl(HPyContext *ctx, HPy self, HPy arg)
+        {
+            HPyGlobal_Store(ctx, &g, arg);
+            return HPy_Dup(ctx, ctx->h_None);
+        }
+
+        HPyDef_METH(load, "load", load_impl, HPyFunc_NOARGS)
+        static HPy load_impl(HPyContext *ctx, HPy self)
+        {
+            return HPyGlobal_Load(ctx, g);
+        }
+        @EXPORT(store)
+        @EXPORT(load)
+        @INIT
+    """)
+    gen = _debug.new_generation()
+    obj = object()
+    mod.store(obj)
+    # the global outlives the handle which was stored in it
+    assert mod.load() is obj
+    assert _debug.get_open_handles(gen) == []
+
 def test_leak_from_method(compiler):
     from hpy.universal import _debug
     mod = compiler.make_module("""
@@ -0,0 +1,97 @@
+import pytest
+from hpy.debug.leakdetector import LeakDetector, HPyLeakError
+
+@pytest.fixture
+def hpy_abi():
+    with LeakDetector():
+        yield "debug"
+
+
+def make_module(compiler, level):
+    compiler.hpy_debug_level = level
+    return compiler.make_module("""
+        HPyDef_METH(name, "name", name_impl, HPyFunc_NOARGS)
+        static HPy name_impl(HPyContext *ctx, HPy self)
+        {
+            return HPyUnicode_FromString(ctx, ctx->name);
+        }
+
+        HPyDef_METH(leak, "leak", leak_impl, HPyFunc_O)
+        static HPy leak_impl(HPyContext *ctx, HPy self, HPy arg)
+        {
+            HPy_Dup(ctx, arg); // leak!
+            return HPy_Dup(ctx, ctx->h_None);
+        }
+
+        HPyDef_METH(use_after_close, "use_after_close", use_after_close_impl,
+                    HPyFunc_O)
+        static HPy use_after_close_impl(HPyContext *ctx, HPy self, HPy arg)
+        {
+            HPy h = HPy_Dup(ctx, arg);
+            HPy_Close(ctx, h);
+            return HPy_Repr(ctx, h);
+        }
+
+        HPyDef_METH(utf8, "utf8", utf8_impl, HPyFunc_O)
+        static HPy utf8_impl(HPyContext *ctx, HPy self, HPy arg)
+        {
+            HPy_ssize_t size;
+            const char *s = HPyUnicode_AsUTF8AndSize(ctx, arg, &size);
+            if (s == NULL)
+                return HPy_NULL;
+            return HPyUnicode_FromString(ctx, s);
+        }
+
+        @EXPORT(name)
+        @EXPORT(leak)
+        @EXPORT(use_after_close)
+        @EXPORT(utf8)
+        @INIT
+    """)
+
+@pytest.mark.parametrize('level', ['leaks', 'full'])
+def test_levels(compiler, hpy_debug_capture, level):
+    from hpy.universal import _debug
+    mod = make_module(compiler, level)
+    if level == 'full':
+        assert mod.name() == 'HPy Debug Mode ABI'
+    else:
+        assert mod.name() == 'HPy Debug Mode ABI (%s)' % level
+    # leaks are detected at every level
+    with pytest.raises(HPyLeakError) as exc:
+        with LeakDetector():
+            mod.leak('hello')
+    assert [dh.obj for dh in exc.value.leaks] == ['hello']
+    for dh in exc.value.leaks:
+        dh._force_close()
+    # the usage of closed handles only at 'full'
+    assert mod.use_after_close('world') == "'world'"
+    expected = 0 if level == 'leaks' else 1
+    assert hpy_debug_capture.invalid_handles_count == expected
+    # the raw data of the handles is protected only at 'full'
+    gen = _debug.new_generation()
+    assert mod.utf8('foo') == 'foo'
+    sizes = sorted(h.raw_data_size for h in _debug.get_closed_handles(gen))
+    if level == 'full':
+        assert sizes == [-1, -1, 4]
+    else:
+        # at 'leaks' the closed handles are recycled immediately
+        assert sizes == []
+
+def test_levels_share_handles(compiler):
+    from hpy.universal import _debug
+    mod1 = make_module(compiler, 'leaks')
+    mod2 = make_module(compiler, 'full')
+    gen = _debug.new_generation()
+    mod1.leak('a')
+    mod2.leak('b')
+    leaks = _debug.get_open_handles(gen)
+    assert [dh.obj for dh in leaks] == ['a', 'b']
+    for dh in leaks:
+        dh._force_close()
+
+def test_invalid_level(compiler):
+    import hpy.universal
+    for level in ['nonsense', 'closed']:
+        with pytest.raises(ValueError):
+            hpy.universal.load('mytest', 'dummy.so', debug=level)
@@ -146,7 +146,7 @@ class HPyModule(object):
 class ExtensionCompiler:
     def __init__(self, tmpdir, hpy_devel, hpy_abi, compiler_verbose=False,
                  ExtensionTemplate=DefaultExtensionTemplate,
-                 extra_include_dirs=None):
+                 extra_include_dirs=None, hpy_debug_level=None):
         """
         hpy_devel is an instance of HPyDevel which specifies where to find
         include/, runtime/src, etc. Usually it will point to hpy/devel/, but
@@ -157,6 +157,10 @@ class ExtensionCompiler:
         others. By default it is empty, but it is used e.g. by PyPy to make
         sure that #include <Python.h> picks its own version, instead of the
         system-wide one.
+
+        hpy_debug_level is the level of the debug mode used when hpy_abi is
+        'debug': one of 'leaks', 'full' or None, which means the
+        default (i.e. 'full').
         """
         self.tmpdir = tmpdir
         self.hpy_devel = hpy_devel
@@ -164,6 +168,7 @@ class ExtensionCompiler:
         self.compiler_verbose = compiler_verbose
         self.ExtensionTemplate=ExtensionTemplate
         self.extra_include_dirs = extra_include_dirs
+        self.hpy_debug_level = hpy_debug_level
 
     def _expand(self, ExtensionTemplate, name, template):
         source = ExtensionTemplate(template, name).expand()
@@ -253,7 +258,8 @@ class ExtensionCompiler:
         if self.hpy_abi == 'universal':
             return self.load_universal_module(name, so_filename, debug=False)
         elif self.hpy_abi == 'debug':
-            return self.load_universal_module(name, so_filename, debug=True)
+            return self.load_universal_module(name, so_filename,
+                                              debug=self.hpy_debug_level or True)
         elif self.hpy_abi == 'cpython':
             return self.load_cpython_module(name, so_filename)
         else:
@@ -289,9 +295,10 @@ class ExtensionCompiler:
 
 
 class PythonSubprocessRunner:
-    def __init__(self, verbose, hpy_abi):
+    def __init__(self, verbose, hpy_abi, hpy_debug_level=None):
         self.verbose = verbose
         self.hpy_abi = hpy_abi
+        self.hpy_debug_level = hpy_debug_level
 
     def run(self, mod, code):
         """ Starts new subprocess that loads given module as 'mod' using the
@@ -308,10 +315,11 @@ class PythonSubprocessRunner:
             # HPy module
             load_module = "import sys;" + \
                           "import hpy.universal;" + \
-                          "mod = hpy.universal.load('{name}', '{so_filename}', debug={debug});"
+                          "mod = hpy.universal.load('{name}', '{so_filename}', debug={debug!r});"
             escaped_filename = mod.so_filename.replace("\\", "\\\\")  # Needed for Windows paths
             load_module = load_module.format(name=mod.name, so_filename=escaped_filename,
-                                             debug=self.hpy_abi == 'debug')
+                                             debug=self.hpy_abi == 'debug' and
+                                                   (self.hpy_debug_level or True))
         else:
             # CPython module
             assert self.hpy_abi == 'cpython'
@@ -442,6 +450,10 @@ def _build(tmpdir, ext, hpy_devel, hpy_abi, compiler_verbose=0, debug=None):
         outputs = cmd_obj.get_outputs()
         sonames = [x for x in outputs if
                    not x.endswith(".py") and not x.endswith(".pyc")]
+        if hpy_abi == 'fat':
+            # a fat build produces also the CPython ABI version of the
+            # module, which is loaded by the stub of the universal one
+            sonames = [x for x in sonames if x.endswith(".hpy.so")]
         assert len(sonames) == 1, 'build_ext is not supposed to return multiple DLLs'
         soname = sonames[0]
     finally:
@@ -141,6 +141,64 @@ class TestBasic(HPyTest):
         assert mod.f(4) is False
         assert mod.f(6) is True
 
+    def test_return_macros(self):
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                long x = HPyLong_AsLong(ctx, arg);
+                if (x == -1 && HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                switch (x) {
+                case 0: HPy_RETURN_NONE(ctx);
+                case 1: HPy_RETURN_TRUE(ctx);
+                case 2: HPy_RETURN_FALSE(ctx);
+                case 3: HPy_RETURN_NOTIMPLEMENTED(ctx);
+                default: HPy_RETURN_BOOL(ctx, x > 10);
+                }
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        assert mod.f(0) is None
+        assert mod.f(1) is True
+        assert mod.f(2) is False
+        assert mod.f(3) is NotImplemented
+        assert mod.f(4) is False
+        assert mod.f(11) is True
+
+    def test_dup_close_constants(self):
+        import sys
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_NOARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self)
+            {
+                HPy items[10];
+                int i;
+                for (i = 0; i < 10; i++)
+                    items[i] = HPy_Dup(ctx, ctx->h_True);
+                for (i = 0; i < 10; i++)
+                    HPy_Close(ctx, items[i]);
+                HPyTupleBuilder tb = HPyTupleBuilder_New(ctx, 10);
+                for (i = 0; i < 10; i++)
+                    HPyTupleBuilder_SetSteal(ctx, tb, i,
+                                             HPy_Dup(ctx, ctx->h_True));
+                return HPyTupleBuilder_Build(ctx, tb);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        assert mod.f() == (True,) * 10
+        if self.supports_refcounts():
+            # the tuples own a reference to their items also if the handles
+            # which were stolen were not refcounted
+            before = sys.getrefcount(True)
+            for i in range(100):
+                t = mod.f()
+                del t
+            after = sys.getrefcount(True)
+            assert abs(after - before) < 10
+
     def test_exception(self):
         import pytest
         mod = self.make_module("""
@@ -382,6 +440,29 @@ class TestBasic(HPyTest):
         assert mod.f(50) == 0
         assert mod.f(100) == -1
 
+    def test_richcomparebool_identity(self):
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                int eq = HPy_RichCompareBool(ctx, arg, arg, HPy_EQ);
+                int ne = HPy_RichCompareBool(ctx, arg, arg, HPy_NE);
+                return HPyTuple_Pack(ctx, 2, eq ? ctx->h_True : ctx->h_False,
+                                             ne ? ctx->h_True : ctx->h_False);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        # identity implies equality, even if __eq__ says otherwise
+        nan = float('nan')
+        assert mod.f(nan) == (True, False)
+        class NeverEqual:
+            def __eq__(self, other):
+                return False
+            def __ne__(self, other):
+                return True
+        assert mod.f(NeverEqual()) == (True, False)
+
     def test_hash(self):
         mod = self.make_module("""
             HPyDef_METH(f, "f", f_impl, HPyFunc_O)
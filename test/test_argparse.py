@@ -295,6 +295,99 @@ class TestParseItem(HPyTest):
         assert mod.f("0") == 1
 
 
+    def test_s_hash(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self,
+                              HPy *args, HPy_ssize_t nargs)
+            {
+                const char *s;
+                HPy_ssize_t size;
+                if (!HPyArg_Parse(ctx, NULL, args, nargs, "s#", &s, &size))
+                    return HPy_NULL;
+                return HPyBytes_FromStringAndSize(ctx, s, size);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        assert mod.f("hello HPy") == b"hello HPy"
+        assert mod.f("hello\0HPy") == b"hello\0HPy"
+        assert mod.f(b"by\0tes") == b"by\0tes"
+        with pytest.raises(TypeError) as err:
+            mod.f(42)
+        assert str(err.value) == "function a str or bytes object is required"
+
+    def test_y_hash(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self,
+                              HPy *args, HPy_ssize_t nargs)
+            {
+                const char *s;
+                HPy_ssize_t size;
+                if (!HPyArg_Parse(ctx, NULL, args, nargs, "y#", &s, &size))
+                    return HPy_NULL;
+                return HPyBytes_FromStringAndSize(ctx, s, size);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        assert mod.f(b"by\0tes") == b"by\0tes"
+        with pytest.raises(TypeError) as err:
+            mod.f("hello")
+        assert str(err.value) == "function a bytes object is required"
+
+    def test_y_star(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self,
+                              HPy *args, HPy_ssize_t nargs)
+            {
+                HPy_buffer buf;
+                if (!HPyArg_Parse(ctx, NULL, args, nargs, "y*", &buf))
+                    return HPy_NULL;
+                return HPy_BuildValue(ctx, "(Ni)",
+                    HPyBytes_FromStringAndSize(ctx, (char *)buf.buf, buf.len),
+                    buf.readonly);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        assert mod.f(b"xyz") == (b"xyz", 1)
+        with pytest.raises(TypeError):
+            mod.f(bytearray(b"xyz"))
+
+    def test_O_bang(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self,
+                              HPy *args, HPy_ssize_t nargs)
+            {
+                HPy a, b = HPy_NULL;
+                if (!HPyArg_Parse(ctx, NULL, args, nargs, "O!|O!",
+                                  ctx->h_LongType, &a, ctx->h_UnicodeType, &b))
+                    return HPy_NULL;
+                if (HPy_IsNull(b))
+                    return HPy_Dup(ctx, a);
+                return HPy_BuildValue(ctx, "(OO)", a, b);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        assert mod.f(42) == 42
+        assert mod.f(True) is True
+        assert mod.f(1, "x") == (1, "x")
+        with pytest.raises(TypeError) as err:
+            mod.f("x")
+        assert str(err.value) == "function argument has the wrong type"
+        with pytest.raises(TypeError):
+            mod.f(1, 2)
+
+
 class TestArgParse(HPyTest):
     def make_two_arg_add(self, fmt="OO"):
         mod = self.make_module("""
@@ -619,3 +712,68 @@ class TestArgParseKeywords(HPyTest):
         with pytest.raises(TypeError) as exc:
             mod.f(1, 2)
         assert str(exc.value) == "my-error-message"
+
+
+class TestArgParseKeywordsArray(HPyTest):
+    def make_module_with_kwnames(self, fmt="l|l", kwlist='"a", "b"'):
+        # f(*posargs, *kwvalues, kwnames) calls HPyArg_ParseKeywordsArray as
+        # if the keywords were passed using the vectorcall protocol
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self,
+                              HPy *args, HPy_ssize_t nargs)
+            {{
+                long a = -1, b = -1;
+                HPy kwnames = HPy_NULL;
+                HPy_ssize_t nkwargs = 0;
+                static const char *kwlist[] = {{ {kwlist}, NULL }};
+                if (!HPy_Is(ctx, args[nargs - 1], ctx->h_None)) {{
+                    kwnames = args[nargs - 1];
+                    nkwargs = HPy_Length(ctx, kwnames);
+                }}
+                if (!HPyArg_ParseKeywordsArray(ctx, NULL, args, nargs - 1 - nkwargs,
+                                               kwnames, "{fmt}", kwlist, &a, &b))
+                    return HPy_NULL;
+                return HPy_BuildValue(ctx, "(ll)", a, b);
+            }}
+            @EXPORT(f)
+            @INIT
+        """.format(fmt=fmt, kwlist=kwlist))
+
+        def call(*args, **kwargs):
+            kwnames = tuple(kwargs.keys()) if kwargs else None
+            return mod.f(*args, *kwargs.values(), kwnames)
+        return call
+
+    def test_positional(self):
+        f = self.make_module_with_kwnames()
+        assert f(1, 2) == (1, 2)
+        assert f(1) == (1, -1)
+
+    def test_keywords(self):
+        f = self.make_module_with_kwnames()
+        assert f(1, b=2) == (1, 2)
+        assert f(b=2, a=1) == (1, 2)
+        assert f(a=1) == (1, -1)
+
+    def test_keyword_only_and_positional_only(self):
+        import pytest
+        f = self.make_module_with_kwnames(fmt="l|$l", kwlist='"", "b"')
+        assert f(1, b=2) == (1, 2)
+        with pytest.raises(TypeError) as exc:
+            f(a=1)
+        assert str(exc.value) == "function no value for required argument"
+        with pytest.raises(TypeError) as exc:
+            f(1, 2)
+        assert str(exc.value) == (
+            "function keyword only argument passed as positional argument")
+
+    def test_unexpected_keyword(self):
+        import pytest
+        f = self.make_module_with_kwnames()
+        with pytest.raises(TypeError) as exc:
+            f(1, c=2)
+        assert "unexpected keyword argument" in str(exc.value)
+        with pytest.raises(TypeError) as exc:
+            f(1, a=2)
+        assert "both by position and by name" in str(exc.value)
@@ -88,6 +88,58 @@ class TestCall(HPyTest):
         with pytest.raises(TypeError):
             mod.call(f, kw=None)
 
+    def test_call_method_cached(self):
+        import pytest
+        mod = self.make_module("""
+            static HPyAttrCache visit_cache = HPyAttrCache_INIT("visit");
+
+            HPyDef_METH(visit, "visit", visit_impl, HPyFunc_VARARGS)
+            static HPy visit_impl(HPyContext *ctx, HPy self,
+                                  HPy *args, HPy_ssize_t nargs)
+            {
+                return HPy_CallMethodCached(ctx, args[0], &visit_cache,
+                                            args + 1, nargs - 1);
+            }
+            @EXPORT(visit)
+            @INIT
+        """)
+
+        class Visitor:
+            def visit(self, *args):
+                return (self, args)
+
+        class Static:
+            @staticmethod
+            def visit(*args):
+                return args
+
+        class Native(list):
+            visit = list.append
+
+        v = Visitor()
+        for i in range(3):
+            assert mod.visit(v) == (v, ())
+            assert mod.visit(v, 1, 2) == (v, (1, 2))
+        many = tuple(range(20))
+        assert mod.visit(v, *many) == (v, many)
+        assert mod.visit(Static(), 1) == (1,)
+        lst = Native()
+        mod.visit(lst, 42)
+        assert lst == [42]
+        with pytest.raises(TypeError):
+            mod.visit(lst)
+        with pytest.raises(AttributeError):
+            mod.visit(42)
+        # an instance attribute shadows the method
+        v.visit = lambda *args: ('instance', args)
+        assert mod.visit(v, 1) == ('instance', (1,))
+        del v.visit
+        assert mod.visit(v, 1) == (v, (1,))
+        # modifying the type invalidates the cache
+        Visitor.visit = lambda self, *args: ('patched', args)
+        assert mod.visit(v, 1) == ('patched', (1,))
+        assert mod.visit(Visitor(), 2) == ('patched', (2,))
+
     def test_hpycallable_check(self):
         mod = self.make_module("""
             HPyDef_METH(f, "f", f_impl, HPyFunc_O)
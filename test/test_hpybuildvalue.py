@@ -71,8 +71,6 @@ class TestBuildValue(HPyTest):
              "unmatched '(' in the format string passed to HPy_BuildValue"),
             ('return HPy_BuildValue(ctx, "[i)", 42);',
              "unmatched '[' in the format string passed to HPy_BuildValue"),
-            ('return HPy_BuildValue(ctx, "N", 42);',
-             "HPy_BuildValue does not support the 'N' formatting unit."),
         ]
         import pytest
         mod = self.make_tests_module(test_cases)
@@ -182,6 +180,44 @@ class TestBuildValue(HPyTest):
         """)
         assert mod.f(None) == (1, 2)
 
+    def test_N_steals(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                switch (HPyLong_AsLong(ctx, arg)) {
+                case 0:
+                    return HPy_BuildValue(ctx, "N", HPyLong_FromLong(ctx, 42));
+                case 1:
+                    return HPy_BuildValue(ctx, "(NiN)", HPyLong_FromLong(ctx, 1), 2,
+                                          HPyUnicode_FromString(ctx, "3"));
+                case 2:
+                    return HPy_BuildValue(ctx, "[N(N)]", HPyLong_FromLong(ctx, 1),
+                                          HPyLong_FromLong(ctx, 2));
+                case 3:
+                    // all the handles are consumed, also the ones after the error
+                    return HPy_BuildValue(ctx, "(N(q)N)", HPyLong_FromLong(ctx, 1),
+                                          HPyLong_FromLong(ctx, 2));
+                case 4:
+                    return HPy_BuildValue(ctx, "(iN)", 1, HPy_NULL);
+                default:
+                    return HPy_NULL;
+                }
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        assert mod.f(0) == 42
+        assert mod.f(1) == (1, 2, '3')
+        assert mod.f(2) == [1, (2,)]
+        with pytest.raises(SystemError) as e:
+            mod.f(3)
+        assert "bad format char 'q'" in str(e)
+        with pytest.raises(SystemError) as e:
+            mod.f(4)
+        assert 'HPy_NULL object passed to HPy_BuildValue' in str(e)
+
     def test_num_limits(self):
         test_cases = [
             ('return HPy_BuildValue(ctx, "(ii)", INT_MIN, INT_MAX);',),
@@ -196,3 +232,73 @@ class TestBuildValue(HPyTest):
             result = mod.f(i)
             assert result[0] < 0, test
             assert result[1] > 0, test
+
+    def test_BuildValueV(self):
+        mod = self.make_module("""
+            static HPy my_build(HPyContext *ctx, const char *fmt, ...)
+            {
+                va_list values;
+                va_start(values, fmt);
+                HPy result = HPy_BuildValueV(ctx, fmt, values);
+                va_end(values);
+                return result;
+            }
+
+            HPyDef_METH(f, "f", f_impl, HPyFunc_NOARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self)
+            {
+                return my_build(ctx, "(is[d])", 42, "hello", 0.25);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        assert mod.f() == (42, "hello", [0.25])
+
+    def test_build_into_builders(self):
+        mod = self.make_module("""
+            HPyDef_METH(tuple, "tuple", tuple_impl, HPyFunc_NOARGS)
+            static HPy tuple_impl(HPyContext *ctx, HPy self)
+            {
+                HPyTupleBuilder builder = HPyTupleBuilder_New(ctx, 5);
+                HPy_ssize_t n = HPyTupleBuilder_BuildValue(ctx, builder, 0, "is", 1, "a");
+                if (n != 2 ||
+                    HPyTupleBuilder_BuildValue(ctx, builder, n, "(ii)[]d", 2, 3, 0.5) != 3) {
+                    HPyTupleBuilder_Cancel(ctx, builder);
+                    return HPy_NULL;
+                }
+                return HPyTupleBuilder_Build(ctx, builder);
+            }
+
+            HPyDef_METH(list, "list", list_impl, HPyFunc_NOARGS)
+            static HPy list_impl(HPyContext *ctx, HPy self)
+            {
+                HPyListBuilder builder = HPyListBuilder_New(ctx, 3);
+                if (HPyListBuilder_BuildValue(ctx, builder, 1, "ii", 1, 2) != 2 ||
+                    HPyListBuilder_BuildValue(ctx, builder, 0, "O", ctx->h_None) != 1) {
+                    HPyListBuilder_Cancel(ctx, builder);
+                    return HPy_NULL;
+                }
+                return HPyListBuilder_Build(ctx, builder);
+            }
+
+            HPyDef_METH(append, "append", append_impl, HPyFunc_O)
+            static HPy append_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                if (HPyList_AppendBuildValue(ctx, arg, "(is)(is)", 1, "x", 2, "y") < 0)
+                    return HPy_NULL;
+                if (HPyList_AppendBuildValue(ctx, arg, "q") < 0)
+                    return HPy_NULL;
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+            @EXPORT(tuple)
+            @EXPORT(list)
+            @EXPORT(append)
+            @INIT
+        """)
+        import pytest
+        assert mod.tuple() == (1, 'a', (2, 3), [], 0.5)
+        assert mod.list() == [None, 1, 2]
+        lst = [0]
+        with pytest.raises(SystemError):
+            mod.append(lst)
+        assert lst == [0, (1, 'x'), (2, 'y')]
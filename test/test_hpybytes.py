@@ -129,3 +129,29 @@ class TestBytes(HPyTest):
                 mod.f_null(i)
             assert str(err.value) == (
                 "NULL char * passed to HPyBytes_FromStringAndSize")
+
+    def test_GetSlice(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy *args,
+                              HPy_ssize_t nargs)
+            {
+                HPy_ssize_t start = HPyLong_AsSsize_t(ctx, args[1]);
+                HPy_ssize_t end = HPyLong_AsSsize_t(ctx, args[2]);
+                return HPyBytes_GetSlice(ctx, args[0], start, end);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        class MyBytes(bytes):
+            pass
+        b = b'abcd'
+        for start, end in [(0, 4), (1, 3), (-3, -1), (2, 100), (3, 1),
+                           (-100, 2)]:
+            assert mod.f(b, start, end) == b[start:end]
+        assert mod.f(b, 0, 100) is b
+        res = mod.f(MyBytes(b), 0, 4)
+        assert res == b and type(res) is bytes
+        with pytest.raises(TypeError):
+            mod.f(bytearray(b), 0, 1)
@@ -265,6 +265,239 @@ class TestHPyField(HPyTest):
         assert sys.getrefcount(a) == a_cnt - 1
         assert sys.getrefcount(b) == b_cnt - 1
 
+    def test_deep_dealloc(self):
+        mod = self.make_module("""
+            @DEFINE_PairObject
+            @DEFINE_Pair_new
+            @DEFINE_Pair_traverse
+            @DEFINE_Pair_get_ab
+
+            @EXPORT_PAIR_TYPE(&Pair_new, &Pair_traverse, &Pair_get_a, &Pair_get_b)
+            @INIT
+        """)
+        # a long linked list is destroyed without recursing once per item,
+        # which would overflow the C stack
+        head = None
+        for i in range(10 ** 6):
+            head = mod.Pair(head, i)
+        assert head.get_b() == 10 ** 6 - 1
+        del head
+        # same with a tree which contains other objects, too
+        head = None
+        for i in range(10 ** 5):
+            head = mod.Pair([head], mod.Pair(i, None))
+        del head
+
+    def test_dealloc_budget(self):
+        mod = self.make_module("""
+            @DEFINE_PairObject
+            @DEFINE_Pair_new
+            @DEFINE_Pair_traverse
+
+            static long destroyed = 0;
+
+            HPyDef_SLOT(Pair_destroy, Pair_destroy_impl, HPy_tp_destroy)
+            static void Pair_destroy_impl(void *obj)
+            {
+                destroyed++;
+            }
+
+            HPyDef_METH(get_destroyed, "get_destroyed", get_destroyed_impl,
+                        HPyFunc_NOARGS)
+            static HPy get_destroyed_impl(HPyContext *ctx, HPy self)
+            {
+                return HPyLong_FromLong(ctx, destroyed);
+            }
+
+            HPyDef_METH(set_budget, "set_budget", set_budget_impl, HPyFunc_O)
+            static HPy set_budget_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                HPy_ssize_t budget = HPyLong_AsSsize_t(ctx, arg);
+                if (budget == -1 && HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                HPy_ssize_t old = HPy_SetDeallocBudget(ctx, budget);
+                if (old < 0)
+                    return HPy_NULL;
+                return HPyLong_FromSsize_t(ctx, old);
+            }
+
+            HPyDef_METH(drain, "drain", drain_impl, HPyFunc_NOARGS)
+            static HPy drain_impl(HPyContext *ctx, HPy self)
+            {
+                if (HPy_DrainDeallocs(ctx) < 0)
+                    return HPy_NULL;
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+
+            @EXPORT_PAIR_TYPE(&Pair_new, &Pair_traverse, &Pair_destroy)
+            @EXPORT(get_destroyed)
+            @EXPORT(set_budget)
+            @EXPORT(drain)
+            @INIT
+        """)
+        import pytest
+        N = 10000
+        def make_list():
+            head = None
+            for i in range(N):
+                head = mod.Pair(head, None)
+            return head
+        with pytest.raises(ValueError):
+            mod.set_budget(-1)
+        # without a budget, everything is destroyed immediately
+        head = make_list()
+        del head
+        assert mod.get_destroyed() == N
+        # with a budget, only a part of it
+        assert mod.set_budget(10) == 0
+        try:
+            head = make_list()
+            start = mod.get_destroyed()
+            del head
+            assert mod.get_destroyed() - start == 10
+            # the rest is destroyed, 10 at a time, when the calls into the
+            # extension return and by the following allocations
+            n1 = mod.get_destroyed() - start
+            assert 10 < n1 < N
+            p = mod.Pair(None, None)
+            n2 = mod.get_destroyed() - start
+            assert n1 < n2 < N
+            for i in range(N):
+                p = mod.Pair(None, None)
+            assert mod.get_destroyed() - start >= N
+            # the budget also applies to the objects which are not deeply
+            # nested: here they are all destroyed at depth 1
+            wide = mod.Pair([mod.Pair(None, None) for i in range(N)], None)
+            start = mod.get_destroyed()
+            del wide
+            assert mod.get_destroyed() - start == 10
+            # HPy_DrainDeallocs destroys all of them, ignoring the budget
+            mod.drain()
+            assert mod.get_destroyed() - start == N + 1
+        finally:
+            del p
+            # removing the budget destroys all the pending objects
+            assert mod.set_budget(0) == 10
+        assert mod.get_destroyed() == 2 * N + N + 1 + (N + 1)
+
+    def test_dealloc_budget_is_shared(self):
+        # the budget is the same for all the extensions, also in the CPython
+        # ABI where each one has its own copy of the runtime
+        src = """
+            HPyDef_METH(set_budget, "set_budget", set_budget_impl, HPyFunc_O)
+            static HPy set_budget_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                HPy_ssize_t budget = HPyLong_AsSsize_t(ctx, arg);
+                if (budget == -1 && HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                HPy_ssize_t old = HPy_SetDeallocBudget(ctx, budget);
+                if (old < 0)
+                    return HPy_NULL;
+                return HPyLong_FromSsize_t(ctx, old);
+            }
+
+            @EXPORT(set_budget)
+            @INIT
+        """
+        mod1 = self.make_module(src, name='mod1')
+        mod2 = self.make_module(src, name='mod2')
+        assert mod1.set_budget(5) == 0
+        try:
+            assert mod2.set_budget(7) == 5
+        finally:
+            assert mod1.set_budget(0) == 7
+
+    def make_pending_module(self, compile_only=False):
+        make = self.compile_module if compile_only else self.make_module
+        return make("""
+            #include <stdio.h>
+            #include <stdlib.h>
+
+            @DEFINE_PairObject
+            @DEFINE_Pair_new
+            @DEFINE_Pair_traverse
+
+            static long destroyed = 0;
+
+            HPyDef_SLOT(Pair_destroy, Pair_destroy_impl, HPy_tp_destroy)
+            static void Pair_destroy_impl(void *obj)
+            {
+                destroyed++;
+            }
+
+            HPyDef_METH(get_destroyed, "get_destroyed", get_destroyed_impl,
+                        HPyFunc_NOARGS)
+            static HPy get_destroyed_impl(HPyContext *ctx, HPy self)
+            {
+                return HPyLong_FromLong(ctx, destroyed);
+            }
+
+            HPyDef_METH(set_budget, "set_budget", set_budget_impl, HPyFunc_O)
+            static HPy set_budget_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                HPy_ssize_t budget = HPyLong_AsSsize_t(ctx, arg);
+                if (budget == -1 && HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                HPy_ssize_t old = HPy_SetDeallocBudget(ctx, budget);
+                if (old < 0)
+                    return HPy_NULL;
+                return HPyLong_FromSsize_t(ctx, old);
+            }
+
+            // print the number of destroyed objects when the process exits,
+            // after the finalization of the interpreter
+            static void print_destroyed(void)
+            {
+                printf("destroyed: %ld\\n", destroyed);
+                fflush(stdout);
+            }
+
+            HPyDef_METH(print_at_exit, "print_at_exit", print_at_exit_impl,
+                        HPyFunc_NOARGS)
+            static HPy print_at_exit_impl(HPyContext *ctx, HPy self)
+            {
+                atexit(print_destroyed);
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+
+            @EXPORT_PAIR_TYPE(&Pair_new, &Pair_traverse, &Pair_destroy)
+            @EXPORT(get_destroyed)
+            @EXPORT(set_budget)
+            @EXPORT(print_at_exit)
+            @INIT
+        """)
+
+    def test_dealloc_pending_at_thread_exit(self):
+        import threading
+        mod = self.make_pending_module()
+        N = 1000
+        def make_and_drop():
+            head = None
+            for i in range(N):
+                head = mod.Pair(head, None)
+            del head
+            # no call into the extension follows: the pending objects are
+            # destroyed when the thread exits
+        assert mod.set_budget(10) == 0
+        try:
+            t = threading.Thread(target=make_and_drop)
+            t.start()
+            t.join()
+            assert mod.get_destroyed() == N
+        finally:
+            mod.set_budget(0)
+
+    def test_dealloc_pending_at_exit(self, python_subprocess):
+        mod = self.make_pending_module(compile_only=True)
+        # the objects are still pending when the interpreter shuts down
+        code = ("import functools; mod.print_at_exit(); mod.set_budget(10); "
+                "head = functools.reduce(lambda h, i: mod.Pair(h, None), "
+                "range(1000), None); del head; "
+                "assert mod.get_destroyed() < 1000")
+        result = python_subprocess.run(mod, code)
+        assert result.returncode == 0, result.stderr
+        assert result.stdout.strip() == b"destroyed: 1000"
+
     @pytest.mark.syncgc
     def test_automatic_tp_clear(self):
         if not self.supports_refcounts():
@@ -308,3 +541,40 @@ class TestHPyField(HPyTest):
         #
         gc.collect()
         assert count_pairs() == 0
+
+    def test_HPyGlobal(self):
+        import sys
+        mod = self.make_module("""
+            static HPyGlobal g;
+
+            HPyDef_METH(store, "store", store_impl, HPyFunc_O)
+            static HPy store_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                HPyGlobal_Store(ctx, &g, HPy_Is(ctx, arg, ctx->h_None) ? HPy_NULL : arg);
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+
+            HPyDef_METH(load, "load", load_impl, HPyFunc_NOARGS)
+            static HPy load_impl(HPyContext *ctx, HPy self)
+            {
+                HPy h = HPyGlobal_Load(ctx, g);
+                if (HPy_IsNull(h))
+                    return HPyUnicode_FromString(ctx, "<empty>");
+                return h;
+            }
+
+            @EXPORT(store)
+            @EXPORT(load)
+            @INIT
+        """)
+        assert mod.load() == '<empty>'
+        obj = object()
+        mod.store(obj)
+        assert mod.load() is obj
+        if self.supports_refcounts():
+            rc = sys.getrefcount(obj)
+            mod.store(None)
+            assert sys.getrefcount(obj) == rc - 1
+        else:
+            mod.store(None)
+        assert mod.load() == '<empty>'
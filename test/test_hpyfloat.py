@@ -0,0 +1,93 @@
+from .support import HPyTest
+
+class TestFloat(HPyTest):
+
+    def test_Float_FromString(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                return HPyFloat_FromString(ctx, HPyBytes_AsString(ctx, arg),
+                                           HPyBytes_Size(ctx, arg));
+            }
+            HPyDef_METH(g, "g", g_impl, HPyFunc_O)
+            static HPy g_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                return HPyFloat_FromString(ctx, HPyBytes_AsString(ctx, arg), -1);
+            }
+            @EXPORT(f)
+            @EXPORT(g)
+            @INIT
+        """)
+        import math
+        import random
+        cases = ['0', '-0', '0.0', '-0.0', '1', '1.5', '-2.25', '.5', '5.',
+                 '3.14159', '1e10', '1E-10', '-1.5e+300', '1e22', '1e23',
+                 '9007199254740993', '0.1', '0.30000000000000004',
+                 '123456789012345678901234567890', '1.7976931348623157e308',
+                 '2.2250738585072014e-308', '5e-324', '1e-400', '1e400',
+                 '0.' + '0' * 200 + '1', '1' + '0' * 300, ' 1.5 ', '1_000.5',
+                 'inf', '-Infinity', '1' * 20 + '.5', '0' * 30 + '1.25',
+                 '4.35679e-8', '89255.0e-22', '8.98846567431158e+307']
+        rnd = random.Random(42)
+        for i in range(1000):
+            x = rnd.uniform(-1e6, 1e6) * 10.0 ** rnd.randint(-30, 30)
+            cases.append(repr(x))
+            cases.append('%.10g' % x)
+        for s in cases:
+            x = mod.f(s.encode())
+            assert type(x) is float
+            assert x == float(s) or (x == 0.0 and float(s) == 0.0)
+            assert math.copysign(1.0, x) == math.copysign(1.0, float(s))
+        assert math.isnan(mod.f(b'nan'))
+        assert mod.g(b'-12.5') == -12.5
+        for s in [b'', b'-', b'.', b'e5', b'1e', b'1e+', b'1.5x', b'1..5',
+                  b'1\x00', b'0x10', b'\xff', b'1 2']:
+            with pytest.raises(ValueError):
+                mod.f(s)
+
+    def test_Float_Format(self):
+        import pytest
+        mod = self.make_module("""
+            #include <string.h>
+
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy *args,
+                              HPy_ssize_t nargs)
+            {
+                char buf[64];
+                HPy_ssize_t size = HPyLong_AsSsize_t(ctx, args[1]);
+                memset(buf, 'X', sizeof(buf));
+                HPy_ssize_t n = HPyFloat_Format(ctx, args[0], buf, size);
+                if (n < 0)
+                    return HPy_NULL;
+                // return the length and the bytes which have been written
+                HPy h_n = HPyLong_FromSsize_t(ctx, n);
+                HPy h_buf = HPyBytes_FromStringAndSize(ctx, buf,
+                                                       n < size ? n + 1 : 1);
+                HPy res = HPyTuple_Pack(ctx, 2, h_n, h_buf);
+                HPy_Close(ctx, h_n);
+                HPy_Close(ctx, h_buf);
+                return res;
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        import random
+        values = [0.0, -0.0, 1.0, -1.0, 0.1, 1.5, 1e15, 1e16, -1e16,
+                  2.0**53, 2.0**53 + 2, 123456789.0, 1e-5, 1e100, 5e-324,
+                  float('inf'), float('-inf'), float('nan'), 1 / 3.]
+        rnd = random.Random(42)
+        for i in range(200):
+            values.append(rnd.uniform(-1e6, 1e6) * 10.0 ** rnd.randint(-30, 30))
+            values.append(float(rnd.randint(-2**60, 2**60)))
+        for x in values:
+            s = repr(x).encode()
+            assert mod.f(x, 64) == (len(s), s + b'\0')
+        # the argument is converted as by float()
+        assert mod.f(3, 64) == (3, b'3.0\0')
+        assert mod.f(0.5, 4) == (3, b'0.5\0')
+        assert mod.f(0.5, 3) == (3, b'X')
+        with pytest.raises(TypeError):
+            mod.f('1.0', 64)
@@ -52,6 +52,31 @@ class TestList(HPyTest):
         """)
         assert mod.f(42) == [42, 42]
 
+    def test_AppendSteal(self):
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                for (long i = 0; i < 3; i++) {
+                    HPy h_item = HPyLong_FromLong(ctx, i);
+                    if (HPy_IsNull(h_item))
+                        return HPy_NULL;
+                    // h_item is consumed, also in case of error
+                    if (HPyList_AppendSteal(ctx, arg, h_item) == -1)
+                        return HPy_NULL;
+                }
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        import pytest
+        lst = ['a']
+        mod.f(lst)
+        assert lst == ['a', 0, 1, 2]
+        with pytest.raises(SystemError):
+            mod.f(())
+
     def test_ListBuilder(self):
         mod = self.make_module("""
             HPyDef_METH(f, "f", f_impl, HPyFunc_O)
@@ -75,3 +100,185 @@ class TestList(HPyTest):
             @INIT
         """)
         assert mod.f("xy") == ["xy", True, -42]
+
+    def test_ListBuilder_SetSteal(self):
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy h_self, HPy h_arg)
+            {
+                HPyListBuilder builder = HPyListBuilder_New(ctx, 3);
+                HPyListBuilder_Set(ctx, builder, 0, h_arg);
+                HPyListBuilder_SetSteal(ctx, builder, 1, HPy_Dup(ctx, h_arg));
+                HPy h_num = HPyLong_FromLong(ctx, -42);
+                if (HPy_IsNull(h_num))
+                {
+                    HPyListBuilder_Cancel(ctx, builder);
+                    return HPy_NULL;
+                }
+                HPyListBuilder_SetSteal(ctx, builder, 2, h_num);
+                return HPyListBuilder_Build(ctx, builder);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        assert mod.f("xy") == ["xy", "xy", -42]
+
+    def test_Sort(self):
+        import pytest
+        mod = self.make_module("""
+            // compare (key, value) tuples by key only, to check stability
+            static int by_key(HPyContext *ctx, HPy a, HPy b, void *arg)
+            {
+                HPy ka = HPy_GetItem_i(ctx, a, 0);
+                HPy kb = HPy_GetItem_i(ctx, b, 0);
+                int res = -1;
+                if (!HPy_IsNull(ka) && !HPy_IsNull(kb))
+                    res = HPy_RichCompareBool(ctx, ka, kb, HPy_LT);
+                HPy_Close(ctx, ka);
+                HPy_Close(ctx, kb);
+                return res;
+            }
+
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                if (HPyList_Sort(ctx, arg, by_key, NULL) < 0)
+                    return HPy_NULL;
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        import random
+        for n in [0, 1, 2, 15, 16, 17, 100, 1000]:
+            lst = [(random.randrange(20), i) for i in range(n)]
+            exp = sorted(lst, key=lambda t: t[0])
+            mod.f(lst)
+            assert lst == exp
+        lst = [(x,) for x in reversed(range(100))]
+        mod.f(lst)
+        assert lst == [(x,) for x in range(100)]
+        #
+        # in case of error, the list is unchanged
+        lst = [(3,), (2,), (1,), ('a',), (0,)] * 10
+        orig = lst[:]
+        with pytest.raises(TypeError):
+            mod.f(lst)
+        assert lst == orig
+        with pytest.raises(TypeError):
+            mod.f((1, 2))
+
+    def test_SortByKey(self):
+        import pytest
+        mod = self.make_module("""
+            static int double_key(HPyContext *ctx, HPy item, double *key,
+                                  void *arg)
+            {
+                HPy h = HPy_GetItem_i(ctx, item, 0);
+                if (HPy_IsNull(h))
+                    return -1;
+                *key = HPyFloat_AsDouble(ctx, h);
+                HPy_Close(ctx, h);
+                return (*key == -1.0 && HPyErr_Occurred(ctx)) ? -1 : 0;
+            }
+
+            static int int64_key(HPyContext *ctx, HPy item, int64_t *key,
+                                 void *arg)
+            {
+                HPy h = HPy_GetItem_i(ctx, item, 0);
+                if (HPy_IsNull(h))
+                    return -1;
+                *key = HPyLong_AsLongLong(ctx, h);
+                HPy_Close(ctx, h);
+                return (*key == -1 && HPyErr_Occurred(ctx)) ? -1 : 0;
+            }
+
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self,
+                              HPy *args, HPy_ssize_t nargs)
+            {
+                HPy lst;
+                int use_double, reverse, res;
+                if (!HPyArg_Parse(ctx, NULL, args, nargs, "Oii",
+                                  &lst, &use_double, &reverse))
+                    return HPy_NULL;
+                if (use_double)
+                    res = HPyList_SortByDoubleKey(ctx, lst, double_key, NULL,
+                                                  reverse);
+                else
+                    res = HPyList_SortByInt64Key(ctx, lst, int64_key, NULL,
+                                                 reverse);
+                if (res < 0)
+                    return HPy_NULL;
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        import random
+        for n in [0, 1, 2, 16, 17, 100, 1000]:
+            for reverse in [False, True]:
+                # int64 keys, including negative and huge ones
+                keys = [random.randrange(-5, 5) for i in range(n)]
+                keys[:n // 10] = [random.randrange(-2**63, 2**63)
+                                  for i in range(n // 10)]
+                lst = [(k, i) for i, k in enumerate(keys)]
+                exp = sorted(lst, key=lambda t: t[0], reverse=reverse)
+                mod.f(lst, False, reverse)
+                assert lst == exp
+                #
+                # double keys
+                keys = [random.choice([-1.5, -0.0, 0.0, 2.5, 1e300,
+                                       float('-inf'), float('inf'),
+                                       random.random()])
+                        for i in range(n)]
+                lst = [(k, i) for i, k in enumerate(keys)]
+                exp = sorted(lst, key=lambda t: t[0], reverse=reverse)
+                mod.f(lst, True, reverse)
+                assert lst == exp
+        #
+        # NaNs are sorted last, in their original order, also with reverse
+        nan = float('nan')
+        for n in [3, 100]:
+            keys = [float(i % 7) if i % 3 else nan for i in range(n)]
+            for reverse in [False, True]:
+                lst = [(k, i) for i, k in enumerate(keys)]
+                mod.f(lst, True, reverse)
+                n_nans = len([k for k in keys if k != k])
+                exp = sorted([(k, i) for i, k in enumerate(keys) if k == k],
+                             key=lambda t: t[0], reverse=reverse)
+                assert lst[:-n_nans] == exp
+                assert [i for k, i in lst[-n_nans:]] == [
+                    i for i, k in enumerate(keys) if k != k]
+        #
+        # in case of error, the list is unchanged
+        lst = [(3,), (2,), ('a',), (1,)]
+        with pytest.raises(TypeError):
+            mod.f(lst, False, False)
+        assert lst == [(3,), (2,), ('a',), (1,)]
+
+    def test_GetSlice(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy *args,
+                              HPy_ssize_t nargs)
+            {
+                HPy_ssize_t start = HPyLong_AsSsize_t(ctx, args[1]);
+                HPy_ssize_t end = HPyLong_AsSsize_t(ctx, args[2]);
+                return HPyList_GetSlice(ctx, args[0], start, end);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        class MyList(list):
+            pass
+        lst = [1, 2, 3, 4]
+        for start, end in [(0, 4), (1, 3), (-3, -1), (2, 100), (3, 1),
+                           (-100, 2)]:
+            assert mod.f(lst, start, end) == lst[start:end]
+        res = mod.f(lst, 0, 4)
+        assert res == lst and res is not lst
+        assert type(mod.f(MyList(lst), 0, 2)) is list
+        with pytest.raises(TypeError):
+            mod.f((1, 2), 0, 1)
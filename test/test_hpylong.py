@@ -296,3 +296,226 @@ class TestLong(HPyTest):
             mod.f(self.magic_int(2))
         with pytest.raises(TypeError):
             mod.f(self.magic_index(2))
+
+    def test_Long_FromString(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy *args,
+                              HPy_ssize_t nargs)
+            {
+                long base = HPyLong_AsLong(ctx, args[1]);
+                const char *s = HPyBytes_AsString(ctx, args[0]);
+                HPy_ssize_t size = HPyBytes_Size(ctx, args[0]);
+                return HPyLong_FromString(ctx, s, size, (int)base);
+            }
+            HPyDef_METH(g, "g", g_impl, HPyFunc_O)
+            static HPy g_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                // parse only the first 3 bytes
+                return HPyLong_FromString(ctx, HPyBytes_AsString(ctx, arg),
+                                          3, 10);
+            }
+            HPyDef_METH(h, "h", h_impl, HPyFunc_O)
+            static HPy h_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                return HPyLong_FromString(ctx, HPyBytes_AsString(ctx, arg),
+                                          -1, 10);
+            }
+            @EXPORT(f)
+            @EXPORT(g)
+            @EXPORT(h)
+            @INIT
+        """)
+        for s in ['0', '-0', '+7', '42', '-42', '999999999999999999',
+                  '-999999999999999999', '1000000000000000000',
+                  '9223372036854775808', '-' + '9' * 100, ' 12 ', '1_000',
+                  '007']:
+            assert mod.f(s.encode(), 10) == int(s, 10)
+        assert mod.f(b'ff', 16) == 255
+        assert mod.f(b'0x1F', 0) == 31
+        assert mod.f(b'0', 0) == 0
+        assert mod.f(b'12', 0) == 12
+        assert mod.f(b'z' * 200, 36) == int('z' * 200, 36)
+        assert mod.g(b'123456') == 123
+        assert mod.h(b'-5678') == -5678
+        for s in [b'', b'-', b'12a', b'1.5', b'0x10', b'1\x002', b'1 2',
+                  b'\xff', b'1' * 200 + b'x']:
+            with pytest.raises(ValueError):
+                mod.f(s, 10)
+        with pytest.raises(ValueError):
+            mod.f(b'007', 0)
+        with pytest.raises(ValueError):
+            mod.f(b'12', 1)
+
+    def test_Long_Format(self):
+        import pytest
+        mod = self.make_module("""
+            #include <string.h>
+
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy *args,
+                              HPy_ssize_t nargs)
+            {
+                char buf[64];
+                HPy_ssize_t size = HPyLong_AsSsize_t(ctx, args[1]);
+                memset(buf, 'X', sizeof(buf));
+                HPy_ssize_t n = HPyLong_Format(ctx, args[0], buf, size);
+                if (n < 0)
+                    return HPy_NULL;
+                // return the length and the bytes which have been written
+                HPy h_n = HPyLong_FromSsize_t(ctx, n);
+                HPy h_buf = HPyBytes_FromStringAndSize(ctx, buf,
+                                                       n < size ? n + 1 : 1);
+                HPy res = HPyTuple_Pack(ctx, 2, h_n, h_buf);
+                HPy_Close(ctx, h_n);
+                HPy_Close(ctx, h_buf);
+                return res;
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        for x in [0, 1, -1, 42, -1234567890, 2**63 - 1, -2**63, 2**63,
+                  -2**63 - 1, 10**40]:
+            s = str(x).encode()
+            assert mod.f(x, 64) == (len(s), s + b'\0')
+        # bools and subclasses of int are formatted as their int value, not
+        # as their repr()
+        class MyInt(int):
+            def __repr__(self):
+                return 'MyInt'
+        assert mod.f(True, 64) == (1, b'1\0')
+        assert mod.f(False, 64) == (1, b'0\0')
+        assert mod.f(MyInt(-7), 64) == (2, b'-7\0')
+        assert mod.f(MyInt(10**40), 64) == (41, b'1' + b'0' * 40 + b'\0')
+        assert mod.f(12345, 6) == (5, b'12345\0')
+        assert mod.f(12345, 5) == (5, b'X')
+        assert mod.f(-10**40, 10) == (42, b'X')
+        assert mod.f(12345, 0) == (5, b'X')
+        with pytest.raises(TypeError):
+            mod.f(1.0, 64)
+        with pytest.raises(TypeError):
+            mod.f('1', 64)
+
+    def test_Long_ByteArray(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(frombytes, "frombytes", frombytes_impl, HPyFunc_VARARGS)
+            static HPy frombytes_impl(HPyContext *ctx, HPy self, HPy *args,
+                                      HPy_ssize_t nargs)
+            {
+                const char *s = HPyBytes_AsString(ctx, args[0]);
+                HPy_ssize_t n = HPyBytes_Size(ctx, args[0]);
+                return HPyLong_FromByteArray(ctx, (const unsigned char *)s,
+                                             (size_t)n,
+                                             HPy_IsTrue(ctx, args[1]),
+                                             HPy_IsTrue(ctx, args[2]));
+            }
+            HPyDef_METH(tobytes, "tobytes", tobytes_impl, HPyFunc_VARARGS)
+            static HPy tobytes_impl(HPyContext *ctx, HPy self, HPy *args,
+                                    HPy_ssize_t nargs)
+            {
+                unsigned char buf[64];
+                HPy_ssize_t n = HPyLong_AsSsize_t(ctx, args[1]);
+                if (HPyLong_AsByteArray(ctx, args[0], buf, (size_t)n,
+                                        HPy_IsTrue(ctx, args[2]),
+                                        HPy_IsTrue(ctx, args[3])) < 0)
+                    return HPy_NULL;
+                return HPyBytes_FromStringAndSize(ctx, (const char *)buf, n);
+            }
+            HPyDef_METH(numbits, "numbits", numbits_impl, HPyFunc_O)
+            static HPy numbits_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                HPy_ssize_t n = HPyLong_NumBits(ctx, arg);
+                if (n < 0)
+                    return HPy_NULL;
+                return HPyLong_FromSsize_t(ctx, n);
+            }
+            @EXPORT(frombytes)
+            @EXPORT(tobytes)
+            @EXPORT(numbits)
+            @INIT
+        """)
+        values = [0, 1, -1, 255, 256, -256, 2**63, -2**63, 2**255 - 19,
+                  -(2**255 - 19), 3**300]
+        for x in values:
+            for n, order, signed in [(1, 'little', True), (32, 'big', True),
+                                     (32, 'little', False), (64, 'big', False)]:
+                le = (order == 'little')
+                try:
+                    b = x.to_bytes(n, order, signed=signed)
+                except OverflowError:
+                    with pytest.raises(OverflowError):
+                        mod.tobytes(x, n, le, signed)
+                    continue
+                assert mod.tobytes(x, n, le, signed) == b
+                assert mod.frombytes(b, le, signed) == x
+            assert mod.numbits(x) == x.bit_length()
+        assert mod.frombytes(b'', True, True) == 0
+        assert mod.frombytes(b'\xff\xff', True, False) == 0xffff
+        assert mod.frombytes(b'\xff\xfe', True, True) == -257
+        assert mod.frombytes(b'\xff\xfe', False, True) == -2
+        with pytest.raises(OverflowError):
+            mod.tobytes(-1, 8, True, False)
+        with pytest.raises(OverflowError):
+            mod.tobytes(128, 1, True, True)
+        assert mod.tobytes(self.magic_index(258), 2, False, False) == b'\x01\x02'
+        with pytest.raises(TypeError):
+            mod.tobytes(1.5, 8, True, True)
+        with pytest.raises(TypeError):
+            mod.numbits('x')
+
+    def test_Long_Limbs(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(fromlimbs, "fromlimbs", fromlimbs_impl, HPyFunc_VARARGS)
+            static HPy fromlimbs_impl(HPyContext *ctx, HPy self, HPy *args,
+                                      HPy_ssize_t nargs)
+            {
+                uint64_t limbs[8];
+                HPy_ssize_t n = HPy_Length(ctx, args[0]);
+                for (HPy_ssize_t i = 0; i < n; i++) {
+                    HPy item = HPy_GetItem_i(ctx, args[0], i);
+                    limbs[i] = HPyLong_AsUnsignedLongLongMask(ctx, item);
+                    HPy_Close(ctx, item);
+                }
+                return HPyLong_FromLimbs(ctx, limbs, (size_t)n,
+                                         HPy_IsTrue(ctx, args[1]));
+            }
+            HPyDef_METH(tolimbs, "tolimbs", tolimbs_impl, HPyFunc_VARARGS)
+            static HPy tolimbs_impl(HPyContext *ctx, HPy self, HPy *args,
+                                    HPy_ssize_t nargs)
+            {
+                uint64_t limbs[8];
+                HPy_ssize_t n = HPyLong_AsSsize_t(ctx, args[1]);
+                if (HPyLong_AsLimbs(ctx, args[0], limbs, (size_t)n,
+                                    HPy_IsTrue(ctx, args[2])) < 0)
+                    return HPy_NULL;
+                HPyListBuilder lb = HPyListBuilder_New(ctx, n);
+                for (HPy_ssize_t i = 0; i < n; i++)
+                    HPyListBuilder_SetSteal(ctx, lb, i,
+                        HPyLong_FromUnsignedLongLong(ctx, limbs[i]));
+                return HPyListBuilder_Build(ctx, lb);
+            }
+            @EXPORT(fromlimbs)
+            @EXPORT(tolimbs)
+            @INIT
+        """)
+        def split(x, n):
+            x &= 2**(64 * n) - 1
+            return [(x >> (64 * i)) & (2**64 - 1) for i in range(n)]
+
+        for x in [0, 1, 2**64 - 1, 2**64, 2**255 - 19, 5**100]:
+            assert mod.tolimbs(x, 4, False) == split(x, 4)
+            assert mod.fromlimbs(split(x, 4), False) == x
+            assert mod.tolimbs(-x, 4, True) == split(-x, 4)
+            assert mod.fromlimbs(split(-x, 4), True) == -x
+        assert mod.fromlimbs([], False) == 0
+        assert mod.fromlimbs([2**64 - 1] * 2, True) == -1
+        assert mod.fromlimbs([2**64 - 1] * 2, False) == 2**128 - 1
+        with pytest.raises(OverflowError):
+            mod.tolimbs(2**128, 2, False)
+        with pytest.raises(OverflowError):
+            mod.tolimbs(2**127, 2, True)
+        with pytest.raises(OverflowError):
+            mod.tolimbs(-1, 2, False)
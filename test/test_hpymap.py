@@ -0,0 +1,272 @@
+"""
+NOTE: this tests are also meant to be run as PyPy "applevel" tests.
+
+This means that global imports will NOT be visible inside the test
+functions. In particular, you have to "import pytest" inside the test in order
+to be able to use e.g. pytest.raises (which on PyPy will be implemented by a
+"fake pytest module")
+"""
+from .support import HPyTest
+
+
+class TestHPyMap(HPyTest):
+
+    def make_cache_module(self):
+        return self.make_module("""
+            typedef struct {
+                HPyMap map;
+            } CacheObject;
+
+            HPyType_HELPERS(CacheObject)
+
+            HPyDef_SLOT(Cache_new, Cache_new_impl, HPy_tp_new)
+            static HPy Cache_new_impl(HPyContext *ctx, HPy cls, HPy *args,
+                                      HPy_ssize_t nargs, HPy kw)
+            {
+                CacheObject *c;
+                return HPy_New(ctx, cls, &c);
+            }
+
+            HPyDef_SLOT(Cache_traverse, Cache_traverse_impl, HPy_tp_traverse)
+            static int Cache_traverse_impl(void *self, HPyFunc_visitproc visit,
+                                           void *arg)
+            {
+                return HPyMap_Traverse(&((CacheObject *)self)->map, visit, arg);
+            }
+
+            HPyDef_SLOT(Cache_destroy, Cache_destroy_impl, HPy_tp_destroy)
+            static void Cache_destroy_impl(void *self)
+            {
+                HPyMap_Free(&((CacheObject *)self)->map);
+            }
+
+            HPyDef_METH(Cache_size, "size", Cache_size_impl, HPyFunc_NOARGS)
+            static HPy Cache_size_impl(HPyContext *ctx, HPy self)
+            {
+                CacheObject *c = CacheObject_AsStruct(ctx, self);
+                return HPyLong_FromSsize_t(ctx, c->map.size);
+            }
+
+            HPyDef_METH(Cache_get, "get", Cache_get_impl, HPyFunc_O)
+            static HPy Cache_get_impl(HPyContext *ctx, HPy self, HPy key)
+            {
+                HPy value;
+                CacheObject *c = CacheObject_AsStruct(ctx, self);
+                int found = HPyMap_Lookup(ctx, self, &c->map, key, &value);
+                if (found < 0)
+                    return HPy_NULL;
+                if (!found) {
+                    HPyErr_SetObject(ctx, ctx->h_KeyError, key);
+                    return HPy_NULL;
+                }
+                return value;
+            }
+
+            HPyDef_METH(Cache_set, "set", Cache_set_impl, HPyFunc_VARARGS)
+            static HPy Cache_set_impl(HPyContext *ctx, HPy self,
+                                      HPy *args, HPy_ssize_t nargs)
+            {
+                CacheObject *c = CacheObject_AsStruct(ctx, self);
+                if (HPyMap_Store(ctx, self, &c->map, args[0], args[1]) < 0)
+                    return HPy_NULL;
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+
+            HPyDef_METH(Cache_delete, "delete", Cache_delete_impl, HPyFunc_O)
+            static HPy Cache_delete_impl(HPyContext *ctx, HPy self, HPy key)
+            {
+                CacheObject *c = CacheObject_AsStruct(ctx, self);
+                int res = HPyMap_Delete(ctx, self, &c->map, key);
+                if (res < 0)
+                    return HPy_NULL;
+                return HPyBool_FromLong(ctx, res);
+            }
+
+            HPyDef_METH(Cache_items, "items", Cache_items_impl, HPyFunc_NOARGS)
+            static HPy Cache_items_impl(HPyContext *ctx, HPy self)
+            {
+                CacheObject *c = CacheObject_AsStruct(ctx, self);
+                HPy lst = HPyList_New(ctx, 0);
+                if (HPy_IsNull(lst))
+                    return HPy_NULL;
+                HPy_ssize_t pos = 0;
+                HPy key, value;
+                while (HPyMap_Next(ctx, self, &c->map, &pos, &key, &value)) {
+                    HPy item = HPyTuple_Pack(ctx, 2, key, value);
+                    HPy_Close(ctx, key);
+                    HPy_Close(ctx, value);
+                    if (HPy_IsNull(item) ||
+                            HPyList_AppendSteal(ctx, lst, item) < 0) {
+                        HPy_Close(ctx, lst);
+                        return HPy_NULL;
+                    }
+                }
+                return lst;
+            }
+
+            HPyDef_METH(Cache_clear, "clear", Cache_clear_impl, HPyFunc_NOARGS)
+            static HPy Cache_clear_impl(HPyContext *ctx, HPy self)
+            {
+                HPyMap_Clear(ctx, self, &CacheObject_AsStruct(ctx, self)->map);
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+
+            static HPyDef *Cache_defines[] = {
+                &Cache_new, &Cache_traverse, &Cache_destroy, &Cache_size,
+                &Cache_get, &Cache_set, &Cache_delete, &Cache_items,
+                &Cache_clear,
+                NULL
+            };
+            static HPyType_Spec Cache_spec = {
+                .name = "mytest.Cache",
+                .basicsize = sizeof(CacheObject),
+                .flags = HPy_TPFLAGS_DEFAULT | HPy_TPFLAGS_HAVE_GC,
+                .defines = Cache_defines
+            };
+
+            @EXPORT_TYPE("Cache", Cache_spec)
+            @INIT
+        """)
+
+    def test_store_lookup_delete(self):
+        import pytest
+        mod = self.make_cache_module()
+        c = mod.Cache()
+        assert c.size() == 0
+        with pytest.raises(KeyError):
+            c.get('a')
+        c.set('a', 1)
+        c.set('b', 2)
+        assert c.size() == 2
+        assert c.get('a') == 1
+        assert c.get('b') == 2
+        c.set('a', 3)
+        assert c.size() == 2
+        assert c.get('a') == 3
+        assert c.delete('a') is True
+        assert c.size() == 1
+        with pytest.raises(KeyError):
+            c.get('a')
+        assert c.delete('a') is False
+        c.set('a', 4)
+        assert sorted(c.items()) == [('a', 4), ('b', 2)]
+        # equal keys are the same key, like in a dict
+        c.set(1, 'one')
+        assert c.get(1.0) == 'one'
+        assert c.get(True) == 'one'
+        with pytest.raises(TypeError):
+            c.set([], 1)
+        with pytest.raises(TypeError):
+            c.get([])
+        with pytest.raises(TypeError):
+            c.delete([])
+
+    def test_many_items(self):
+        mod = self.make_cache_module()
+        c = mod.Cache()
+        d = {}
+        for i in range(2000):
+            key = 'key%d' % i
+            c.set(key, i)
+            d[key] = i
+            if i % 3 == 0:
+                assert c.delete('key%d' % (i // 2))
+                del d['key%d' % (i // 2)]
+        assert c.size() == len(d)
+        for key, value in d.items():
+            assert c.get(key) == value
+        assert sorted(c.items()) == sorted(d.items())
+        c.clear()
+        assert c.size() == 0
+        assert c.items() == []
+        c.set('x', 1)
+        assert c.items() == [('x', 1)]
+
+    def test_hash_collisions(self):
+        mod = self.make_cache_module()
+
+        class Key:
+            def __init__(self, x):
+                self.x = x
+            def __hash__(self):
+                return 42
+            def __eq__(self, other):
+                return self.x == other.x
+
+        c = mod.Cache()
+        for i in range(50):
+            c.set(Key(i), i)
+        for i in range(0, 50, 2):
+            assert c.delete(Key(i))
+        assert c.size() == 25
+        for i in range(1, 50, 2):
+            assert c.get(Key(i)) == i
+
+    def test_eq_clears_the_map(self):
+        mod = self.make_cache_module()
+        c = mod.Cache()
+
+        class Key:
+            def __init__(self, x):
+                self.x = x
+            def __hash__(self):
+                return 42
+            def __eq__(self, other):
+                c.clear()
+                return self.x == other.x
+
+        c.set(Key(0), 0)
+        # __eq__ is called while looking for the key, and empties the map
+        # under our feet
+        import pytest
+        with pytest.raises(KeyError):
+            c.get(Key(0))
+        assert c.size() == 0
+        c.set(Key(1), 1)
+        assert c.delete(Key(1)) is False
+        c.set(Key(2), 2)
+        c.set(Key(3), 3)
+        assert c.size() == 1
+        assert [v for k, v in c.items()] == [3]
+
+    def test_gc(self):
+        import gc
+        mod = self.make_cache_module()
+
+        def count_caches():
+            return len([obj for obj in gc.get_objects()
+                        if type(obj) is mod.Cache])
+        gc.collect()
+        n = count_caches()
+        c1 = mod.Cache()
+        c2 = mod.Cache()
+        c1.set('other', c2)
+        c2.set(c1, 'self')
+        assert count_caches() == n + 2
+        del c1, c2
+        gc.collect()
+        assert count_caches() == n
+
+    def test_refcounts(self):
+        import sys
+        if not self.supports_refcounts():
+            import pytest
+            pytest.skip("CPython only")
+        mod = self.make_cache_module()
+        key = object()
+        value = object()
+        key_refcnt = sys.getrefcount(key)
+        value_refcnt = sys.getrefcount(value)
+        c = mod.Cache()
+        c.set(key, value)
+        for i in range(100):
+            c.set(i, i)
+        assert sys.getrefcount(key) == key_refcnt + 1
+        assert sys.getrefcount(value) == value_refcnt + 1
+        assert c.delete(key)
+        assert sys.getrefcount(key) == key_refcnt
+        assert sys.getrefcount(value) == value_refcnt
+        c.set(key, value)
+        del c
+        assert sys.getrefcount(key) == key_refcnt
+        assert sys.getrefcount(value) == value_refcnt
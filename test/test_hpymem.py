@@ -0,0 +1,206 @@
+"""
+NOTE: this tests are also meant to be run as PyPy "applevel" tests.
+
+This means that global imports will NOT be visible inside the test
+functions. In particular, you have to "import pytest" inside the test in order
+to be able to use e.g. pytest.raises (which on PyPy will be implemented by a
+"fake pytest module")
+"""
+from .support import HPyTest
+
+
+class TestHPyMem(HPyTest):
+
+    def test_malloc_realloc_free(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                long n = HPyLong_AsLong(ctx, arg);
+                if (n == -1 && HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                long *a = (long *)HPyMem_Malloc(ctx, n * sizeof(long));
+                if (a == NULL)
+                    return HPy_NULL;
+                for (long i = 0; i < n; i++)
+                    a[i] = i;
+                long *b = (long *)HPyMem_Realloc(ctx, a, 2 * n * sizeof(long));
+                if (b == NULL) {
+                    HPyMem_Free(ctx, a);
+                    return HPy_NULL;
+                }
+                for (long i = n; i < 2 * n; i++)
+                    b[i] = i;
+                long total = 0;
+                for (long i = 0; i < 2 * n; i++)
+                    total += b[i];
+                HPyMem_Free(ctx, b);
+                return HPyLong_FromLong(ctx, total);
+            }
+
+            HPyDef_METH(g, "g", g_impl, HPyFunc_O)
+            static HPy g_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                HPy_ssize_t n = HPyLong_AsSsize_t(ctx, arg);
+                if (n == -1 && HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                char *p = (char *)HPyMem_Calloc(ctx, n, 1);
+                if (p == NULL)
+                    return HPy_NULL;
+                HPy res = HPyBytes_FromStringAndSize(ctx, p, n);
+                HPyMem_Free(ctx, p);
+                return res;
+            }
+
+            HPyDef_METH(huge, "huge", huge_impl, HPyFunc_NOARGS)
+            static HPy huge_impl(HPyContext *ctx, HPy self)
+            {
+                void *p = HPyMem_Malloc(ctx, (size_t)-1 / 2);
+                if (p == NULL)
+                    return HPy_NULL;
+                HPyMem_Free(ctx, p);
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+            @EXPORT(f)
+            @EXPORT(g)
+            @EXPORT(huge)
+            @INIT
+        """)
+        assert mod.f(10) == sum(range(20))
+        assert mod.f(10000) == sum(range(20000))
+        assert mod.g(5) == b'\0' * 5
+        assert mod.g(0) == b''
+        with pytest.raises(MemoryError):
+            mod.huge()
+
+    def make_scratch_module(self):
+        return self.make_module("""
+            #include <string.h>
+
+            /* Allocate n bytes of scratch memory, fill them with c and
+               return their address */
+            static HPy scratch_fill(HPyContext *ctx, HPy_ssize_t n, char c,
+                                    char **p)
+            {
+                *p = (char *)HPyMem_ScratchAlloc(ctx, n);
+                if (*p == NULL)
+                    return HPy_NULL;
+                memset(*p, c, n);
+                return HPyLong_FromSize_t(ctx, (size_t)*p);
+            }
+
+            HPyDef_METH(alloc, "alloc", alloc_impl, HPyFunc_O)
+            static HPy alloc_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                char *p;
+                HPy_ssize_t n = HPyLong_AsSsize_t(ctx, arg);
+                if (n == -1 && HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                return scratch_fill(ctx, n, 'x', &p);
+            }
+
+            HPyDef_METH(many, "many", many_impl, HPyFunc_VARARGS)
+            static HPy many_impl(HPyContext *ctx, HPy self,
+                                 HPy *args, HPy_ssize_t nargs)
+            {
+                // allocate 'count' blocks of 'size' bytes each, and check
+                // that they are all still intact at the end
+                HPy_ssize_t count = HPyLong_AsSsize_t(ctx, args[0]);
+                HPy_ssize_t size = HPyLong_AsSsize_t(ctx, args[1]);
+                if (HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                char **blocks = (char **)HPyMem_ScratchAlloc(ctx,
+                                                   count * sizeof(char *));
+                if (blocks == NULL)
+                    return HPy_NULL;
+                for (HPy_ssize_t i = 0; i < count; i++) {
+                    HPy h = scratch_fill(ctx, size, (char)i, &blocks[i]);
+                    if (HPy_IsNull(h))
+                        return HPy_NULL;
+                    HPy_Close(ctx, h);
+                }
+                for (HPy_ssize_t i = 0; i < count; i++)
+                    for (HPy_ssize_t j = 0; j < size; j++)
+                        if (blocks[i][j] != (char)i)
+                            return HPy_Dup(ctx, ctx->h_False);
+                return HPy_Dup(ctx, ctx->h_True);
+            }
+
+            HPyDef_METH(nested, "nested", nested_impl, HPyFunc_O)
+            static HPy nested_impl(HPyContext *ctx, HPy self, HPy callback)
+            {
+                char *p;
+                HPy h = scratch_fill(ctx, 64, 'A', &p);
+                if (HPy_IsNull(h))
+                    return HPy_NULL;
+                HPy_Close(ctx, h);
+                HPy res = HPy_CallTupleDict(ctx, callback, HPy_NULL, HPy_NULL);
+                if (HPy_IsNull(res))
+                    return HPy_NULL;
+                HPy_Close(ctx, res);
+                for (int i = 0; i < 64; i++)
+                    if (p[i] != 'A')
+                        return HPy_Dup(ctx, ctx->h_False);
+                return HPy_Dup(ctx, ctx->h_True);
+            }
+            @EXPORT(alloc)
+            @EXPORT(many)
+            @EXPORT(nested)
+            @INIT
+        """)
+
+    def test_scratch_is_released(self):
+        mod = self.make_scratch_module()
+        # the memory is released when the call returns, and reused by the
+        # next one
+        addr = mod.alloc(100)
+        assert mod.alloc(100) == addr
+        assert mod.alloc(16) == addr
+        assert mod.alloc(0) == addr
+        assert addr % 16 == 0
+        mod.alloc(10 ** 6)
+        assert mod.alloc(100) == addr
+
+    def test_scratch_spare_chunk(self):
+        import threading
+        mod = self.make_scratch_module()
+        # the allocations which don't fit in the inline block use a chunk,
+        # which is kept for the next calls
+        addr = mod.alloc(8000)
+        assert mod.alloc(8000) == addr
+        assert mod.alloc(10 ** 6) != addr
+        assert mod.alloc(8000) == addr
+        # every thread has its own spare, which is freed when it exits
+        addrs = []
+        def run():
+            addrs.append(mod.alloc(8000))
+            addrs.append(mod.alloc(8000))
+        for i in range(3):
+            t = threading.Thread(target=run)
+            t.start()
+            t.join()
+        assert addrs[0] == addrs[1]
+        assert addr not in addrs
+        assert mod.alloc(8000) == addr
+
+    def test_scratch_many(self):
+        import pytest
+        mod = self.make_scratch_module()
+        assert mod.many(10, 10)
+        assert mod.many(1000, 100)
+        assert mod.many(10, 100000)
+        with pytest.raises(MemoryError):
+            mod.alloc(2 ** 62)
+
+    def test_scratch_nested_calls(self):
+        mod = self.make_scratch_module()
+        addrs = []
+        def callback():
+            addrs.append(mod.alloc(64))
+            assert mod.nested(lambda: mod.many(100, 1000))
+        assert mod.nested(callback)
+        assert mod.nested(callback)
+        # the inner calls allocate after the memory of the outer one
+        assert addrs[0] == addrs[1]
+        assert addrs[0] != mod.alloc(64)
@@ -0,0 +1,241 @@
+"""
+NOTE: this tests are also meant to be run as PyPy "applevel" tests.
+
+This means that global imports will NOT be visible inside the test
+functions. In particular, you have to "import pytest" inside the test in order
+to be able to use e.g. pytest.raises (which on PyPy will be implemented by a
+"fake pytest module")
+"""
+from .support import HPyTest
+
+
+class TestHPyMemo(HPyTest):
+
+    def make_memo_module(self, maxsize):
+        return self.make_module("""
+            #include <string.h>
+
+            static long n_calls = 0;
+
+            HPyDef_METH(add, "add", add_impl, HPyFunc_VARARGS)
+            static HPy add_impl(HPyContext *ctx, HPy self, HPy *args,
+                                HPy_ssize_t nargs)
+            {
+                n_calls++;
+                if (nargs == 0)
+                    return HPyLong_FromLong(ctx, 0);
+                HPy res = HPy_Dup(ctx, args[0]);
+                for (HPy_ssize_t i = 1; i < nargs; i++) {
+                    HPy tmp = HPy_Add(ctx, res, args[i]);
+                    HPy_Close(ctx, res);
+                    if (HPy_IsNull(tmp))
+                        return HPy_NULL;
+                    res = tmp;
+                }
+                return res;
+            }
+
+            HPyDef_METH(square, "square", square_impl, HPyFunc_O)
+            static HPy square_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                n_calls++;
+                return HPy_Multiply(ctx, arg, arg);
+            }
+
+            HPyDef_METH(kw, "kw", kw_impl, HPyFunc_KEYWORDS)
+            static HPy kw_impl(HPyContext *ctx, HPy self, HPy *args,
+                               HPy_ssize_t nargs, HPy kw)
+            {
+                n_calls++;
+                HPy h_nargs = HPyLong_FromSsize_t(ctx, nargs);
+                HPy res = HPyTuple_Pack(ctx, 2, h_nargs,
+                                        HPy_IsNull(kw) ? ctx->h_None : kw);
+                HPy_Close(ctx, h_nargs);
+                return res;
+            }
+
+            HPyDef_METH(get_calls, "get_calls", get_calls_impl, HPyFunc_NOARGS)
+            static HPy get_calls_impl(HPyContext *ctx, HPy self)
+            {
+                return HPyLong_FromLong(ctx, n_calls);
+            }
+
+            HPyDef_METH(make_memo, "make_memo", make_memo_impl, HPyFunc_VARARGS)
+            static HPy make_memo_impl(HPyContext *ctx, HPy self, HPy *args,
+                                      HPy_ssize_t nargs)
+            {
+                HPy_ssize_t maxsize = HPyLong_AsSsize_t(ctx, args[1]);
+                if (maxsize == -1 && HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                HPy_ssize_t size;
+                const char *name = HPyUnicode_AsUTF8AndSize(ctx, args[0], &size);
+                if (name == NULL)
+                    return HPy_NULL;
+                HPyDef *def;
+                if (strcmp(name, "add") == 0)
+                    def = &add;
+                else if (strcmp(name, "square") == 0)
+                    def = &square;
+                else if (strcmp(name, "kw") == 0)
+                    def = &kw;
+                else
+                    def = &get_calls;
+                return HPyMemo_New(ctx, self, def, maxsize);
+            }
+
+            static void make_memos(HPyContext *ctx, HPy module)
+            {
+                HPy h = HPyMemo_New(ctx, module, &add, %d);
+                if (HPy_IsNull(h))
+                    return;
+                HPy_SetAttr_s(ctx, module, "add", h);
+                HPy_Close(ctx, h);
+            }
+            @EXPORT(get_calls)
+            @EXPORT(make_memo)
+            @EXTRA_INIT_FUNC(make_memos)
+            @INIT
+        """ % maxsize)
+
+    def test_cache(self):
+        mod = self.make_memo_module(16)
+        assert mod.add.__name__ == 'add'
+        assert mod.add(1, 2) == 3
+        assert mod.add(1, 2) == 3
+        assert mod.add(1.0, 2) == 3
+        assert mod.get_calls() == 1
+        assert mod.add.cache_info() == (2, 1, 16, 1)
+        assert mod.add() == 0
+        assert mod.add(5) == 5
+        assert mod.add((5,)) == (5,)
+        assert mod.add('a', 'b', 'c') == 'abc'
+        assert mod.get_calls() == 5
+        # the arguments are distinguished by their number, e.g. a single
+        # tuple argument is not the same as the items of the tuple
+        assert mod.add((1, 2)) == (1, 2)
+        assert mod.get_calls() == 6
+        mod.add.cache_clear()
+        assert mod.add.cache_info() == (0, 0, 16, 0)
+        assert mod.add(1, 2) == 3
+        assert mod.get_calls() == 7
+
+    def test_lru(self):
+        mod = self.make_memo_module(3)
+        for i in range(3):
+            mod.add(i)
+        assert mod.get_calls() == 3
+        mod.add(0)         # 0 is now the most recently used
+        mod.add(10)        # discards 1
+        assert mod.get_calls() == 4
+        mod.add(0)
+        mod.add(2)
+        assert mod.get_calls() == 4
+        mod.add(1)
+        assert mod.get_calls() == 5
+        assert mod.add.cache_info() == (3, 5, 3, 3)
+        # many evictions, which reuse the same entries
+        for i in range(1000):
+            assert mod.add(i, i) == 2 * i
+        assert mod.add.cache_info()[3] == 3
+        assert mod.add(999, 999) == 1998
+        assert mod.add.cache_info()[0] == 4
+
+    def test_many_entries(self):
+        mod = self.make_memo_module(1000)
+        for i in range(2000):
+            assert mod.add(i) == i
+        assert mod.add.cache_info() == (0, 2000, 1000, 1000)
+        for i in range(1000, 2000):
+            assert mod.add(i) == i
+        assert mod.add.cache_info() == (1000, 2000, 1000, 1000)
+
+    def test_errors(self):
+        import pytest
+        mod = self.make_memo_module(16)
+        with pytest.raises(TypeError):
+            mod.add([1], [2])           # unhashable
+        # exceptions are not cached
+        with pytest.raises(TypeError):
+            mod.add(1, 'a')
+        with pytest.raises(TypeError):
+            mod.add(1, 'a')
+        assert mod.get_calls() == 2
+        with pytest.raises(TypeError):
+            mod.add(1, x=2)
+        with pytest.raises(ValueError):
+            mod.make_memo('add', 0)
+
+        square = mod.make_memo('square', 4)
+        assert square(3) == 9
+        assert square(3) == 9
+        with pytest.raises(TypeError):
+            square()
+        with pytest.raises(TypeError):
+            square(1, 2)
+        noargs = mod.make_memo('get_calls', 4)
+        assert noargs() == noargs()
+        with pytest.raises(TypeError):
+            noargs(1)
+
+    def test_type_is_shared(self):
+        mod = self.make_memo_module(16)
+        square = mod.make_memo('square', 4)
+        assert type(square) is type(mod.add)
+        assert type(square).__name__ == 'memoized_function'
+
+    def test_keywords(self):
+        mod = self.make_memo_module(16)
+        kw = mod.make_memo('kw', 4)
+        assert kw(1, 2) == (2, None)
+        assert kw(1, 2) == (2, None)
+        n = mod.get_calls()
+        # calls with keywords are never cached
+        assert kw(1, a=2) == (1, {'a': 2})
+        assert kw(1, a=2) == (1, {'a': 2})
+        assert mod.get_calls() == n + 2
+
+    def test_eq_modifies_cache(self):
+        mod = self.make_memo_module(4)
+
+        class Key:
+            def __init__(self, n):
+                self.n = n
+            def __hash__(self):
+                return 0
+            def __eq__(self, other):
+                mod.add.cache_clear()
+                return isinstance(other, Key) and self.n == other.n
+            def __add__(self, other):
+                return self.n + other
+
+        assert mod.add(Key(1), 1) == 2
+        assert mod.add(Key(1), 1) == 2
+        assert mod.add(Key(2), 1) == 3
+        assert mod.add.cache_info()[3] <= 4
+
+    def test_gc(self):
+        import gc
+        import weakref
+        mod = self.make_memo_module(4)
+
+        class A:
+            def __add__(self, other):
+                return self
+        a = A()
+        assert mod.add(a, 1) is a
+        ref = weakref.ref(a)
+        del a
+        gc.collect()
+        assert ref() is not None
+        mod.add.cache_clear()
+        gc.collect()
+        assert ref() is None
+        # a cycle through the cache
+        f = mod.make_memo('add', 4)
+        b = A()
+        b.f = f
+        f(b)
+        ref = weakref.ref(b)
+        del b, f
+        gc.collect()
+        assert ref() is None
@@ -0,0 +1,128 @@
+from .support import HPyTest
+
+class TestSet(HPyTest):
+
+    def test_Check(self):
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                return HPy_BuildValue(ctx, "(ii)", HPySet_Check(ctx, arg),
+                                      HPyFrozenSet_Check(ctx, arg));
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        class MySet(set):
+            pass
+
+        assert mod.f(set()) == (1, 0)
+        assert mod.f(MySet()) == (1, 0)
+        assert mod.f(frozenset()) == (0, 1)
+        assert mod.f({}) == (0, 0)
+        assert mod.f([]) == (0, 0)
+
+    def test_New_Add_Contains(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                HPy_ssize_t n = HPy_Length(ctx, arg);
+                HPy h_set = HPySet_New(ctx, n);
+                if (HPy_IsNull(h_set))
+                    return HPy_NULL;
+                for (HPy_ssize_t i = 0; i < n; i++) {
+                    HPy item = HPy_GetItem_i(ctx, arg, i);
+                    int res = HPySet_Add(ctx, h_set, item);
+                    HPy_Close(ctx, item);
+                    if (res < 0) {
+                        HPy_Close(ctx, h_set);
+                        return HPy_NULL;
+                    }
+                }
+                return h_set;
+            }
+            HPyDef_METH(contains, "contains", contains_impl, HPyFunc_VARARGS)
+            static HPy contains_impl(HPyContext *ctx, HPy self, HPy *args,
+                                     HPy_ssize_t nargs)
+            {
+                int res = HPySet_Contains(ctx, args[0], args[1]);
+                if (res < 0)
+                    return HPy_NULL;
+                return HPyBool_FromLong(ctx, res);
+            }
+            @EXPORT(f)
+            @EXPORT(contains)
+            @INIT
+        """)
+        s = mod.f([1, 2, 2, 'a', 1.0, (1, 2)])
+        assert type(s) is set
+        assert s == {1, 2, 'a', (1, 2)}
+        assert mod.f([]) == set()
+        assert mod.f(list(range(1000)) * 2) == set(range(1000))
+        with pytest.raises(TypeError):
+            mod.f([1, []])
+        assert mod.contains(s, 'a') is True
+        assert mod.contains(s, 'b') is False
+        assert mod.contains(frozenset([1]), 1) is True
+        with pytest.raises(TypeError):
+            mod.contains(s, [])
+
+    def test_AddArray(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy *args,
+                              HPy_ssize_t nargs)
+            {
+                if (HPySet_AddArray(ctx, args[0], args + 1, nargs - 1) < 0)
+                    return HPy_NULL;
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        s = {0}
+        mod.f(s, 1, 2, 3, 2, 1)
+        assert s == {0, 1, 2, 3}
+        mod.f(s)
+        assert s == {0, 1, 2, 3}
+        items = list(range(500)) * 2
+        mod.f(s, *items)
+        assert s == set(range(500))
+        with pytest.raises(TypeError):
+            mod.f(s, 'x', [], 'y')
+        # the items before the failure have been added
+        assert 'x' in s and 'y' not in s
+
+    def test_FrozenSetBuilder(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                HPy_ssize_t n = HPy_Length(ctx, arg);
+                HPyFrozenSetBuilder builder = HPyFrozenSetBuilder_New(ctx, n);
+                for (HPy_ssize_t i = 0; i < n; i++) {
+                    HPy item = HPy_GetItem_i(ctx, arg, i);
+                    int res = HPyFrozenSetBuilder_Add(ctx, builder, item);
+                    HPy_Close(ctx, item);
+                    if (res < 0) {
+                        HPyFrozenSetBuilder_Cancel(ctx, builder);
+                        return HPy_NULL;
+                    }
+                }
+                return HPyFrozenSetBuilder_Build(ctx, builder);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        fs = mod.f(['a', 'b', 'a', 3])
+        assert type(fs) is frozenset
+        assert fs == frozenset(['a', 'b', 3])
+        assert hash(fs) == hash(frozenset(['a', 'b', 3]))
+        assert mod.f([]) == frozenset()
+        assert mod.f(list(range(1000))) == frozenset(range(1000))
+        with pytest.raises(TypeError):
+            mod.f([1, {}])
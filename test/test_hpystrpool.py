@@ -0,0 +1,190 @@
+"""
+NOTE: this tests are also meant to be run as PyPy "applevel" tests.
+
+This means that global imports will NOT be visible inside the test
+functions. In particular, you have to "import pytest" inside the test in order
+to be able to use e.g. pytest.raises (which on PyPy will be implemented by a
+"fake pytest module")
+"""
+from .support import HPyTest
+
+
+class TestHPyStrPool(HPyTest):
+
+    def make_pool_module(self):
+        return self.make_module("""
+            typedef struct {
+                HPyStrPool pool;
+            } PoolObject;
+
+            HPyType_HELPERS(PoolObject)
+
+            HPyDef_SLOT(Pool_new, Pool_new_impl, HPy_tp_new)
+            static HPy Pool_new_impl(HPyContext *ctx, HPy cls, HPy *args,
+                                     HPy_ssize_t nargs, HPy kw)
+            {
+                long max_size = 0;
+                if (!HPyArg_Parse(ctx, NULL, args, nargs, "|l", &max_size))
+                    return HPy_NULL;
+                PoolObject *p;
+                HPy h = HPy_New(ctx, cls, &p);
+                if (HPy_IsNull(h))
+                    return HPy_NULL;
+                p->pool.max_size = max_size;
+                return h;
+            }
+
+            HPyDef_SLOT(Pool_traverse, Pool_traverse_impl, HPy_tp_traverse)
+            static int Pool_traverse_impl(void *self, HPyFunc_visitproc visit,
+                                          void *arg)
+            {
+                return HPyStrPool_Traverse(&((PoolObject *)self)->pool,
+                                           visit, arg);
+            }
+
+            HPyDef_SLOT(Pool_destroy, Pool_destroy_impl, HPy_tp_destroy)
+            static void Pool_destroy_impl(void *self)
+            {
+                HPyStrPool_Free(&((PoolObject *)self)->pool);
+            }
+
+            HPyDef_METH(Pool_size, "size", Pool_size_impl, HPyFunc_NOARGS)
+            static HPy Pool_size_impl(HPyContext *ctx, HPy self)
+            {
+                PoolObject *p = PoolObject_AsStruct(ctx, self);
+                return HPyLong_FromSsize_t(ctx, p->pool.size);
+            }
+
+            HPyDef_METH(Pool_get, "get", Pool_get_impl, HPyFunc_O)
+            static HPy Pool_get_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                PoolObject *p = PoolObject_AsStruct(ctx, self);
+                const char *buf = HPyBytes_AsString(ctx, arg);
+                HPy_ssize_t size = HPyBytes_Size(ctx, arg);
+                return HPyStrPool_Get(ctx, self, &p->pool, buf, size);
+            }
+
+            HPyDef_METH(Pool_get_s, "get_s", Pool_get_s_impl, HPyFunc_O)
+            static HPy Pool_get_s_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                PoolObject *p = PoolObject_AsStruct(ctx, self);
+                const char *buf = HPyBytes_AsString(ctx, arg);
+                return HPyStrPool_Get(ctx, self, &p->pool, buf, -1);
+            }
+
+            HPyDef_METH(Pool_clear, "clear", Pool_clear_impl, HPyFunc_NOARGS)
+            static HPy Pool_clear_impl(HPyContext *ctx, HPy self)
+            {
+                PoolObject *p = PoolObject_AsStruct(ctx, self);
+                HPyStrPool_Clear(ctx, self, &p->pool);
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+
+            static HPyDef *Pool_defines[] = {
+                &Pool_new,
+                &Pool_traverse,
+                &Pool_destroy,
+                &Pool_size,
+                &Pool_get,
+                &Pool_get_s,
+                &Pool_clear,
+                NULL
+            };
+
+            static HPyType_Spec Pool_spec = {
+                .name = "mytest.Pool",
+                .basicsize = sizeof(PoolObject),
+                .flags = HPy_TPFLAGS_DEFAULT | HPy_TPFLAGS_HAVE_GC,
+                .defines = Pool_defines,
+            };
+
+            @EXPORT_TYPE("Pool", Pool_spec)
+            @INIT
+        """)
+
+    def test_get(self):
+        mod = self.make_pool_module()
+        p = mod.Pool()
+        a = p.get(b'hello')
+        assert a == 'hello'
+        assert type(a) is str
+        assert p.get(b'hello') is a
+        assert p.get(b'hello world'[:5]) is a
+        assert p.get(b'world') == 'world'
+        assert p.get(b'') == ''
+        assert p.get(b'\xc3\xa8 \xe2\x82\xac') == '\xe8 €'
+        assert p.size() == 4
+        # different lengths and the same prefixes
+        keys = [b'x' * i for i in range(40)] + [b'key%d' % i for i in range(100)]
+        strs = [p.get(k) for k in keys]
+        assert strs == [k.decode() for k in keys]
+        for k, s in zip(keys, strs):
+            assert p.get(k) is s
+        assert p.size() == 4 + len(keys) - 1
+        # NUL-terminated
+        assert p.get_s(b'hello') is a
+        assert p.get_s(b'hello\0world') is a
+
+    def test_nul(self):
+        mod = self.make_pool_module()
+        p = mod.Pool()
+        a = p.get(b'a\0b')
+        assert a == 'a\0b'
+        assert p.get(b'a\0b') is a
+        assert p.get(b'a') == 'a'
+        assert p.get(b'a\0') == 'a\0'
+        assert p.get(b'\0') == '\0'
+        assert p.size() == 4
+        # too long to be stored
+        assert p.get(b'a\0' * 1000) == 'a\0' * 1000
+        assert p.size() == 4
+
+    def test_errors(self):
+        import pytest
+        mod = self.make_pool_module()
+        p = mod.Pool()
+        with pytest.raises(UnicodeDecodeError):
+            p.get(b'\xff\xfe')
+        with pytest.raises(UnicodeDecodeError):
+            p.get(b'\xff' * 1000)
+        assert p.size() == 0
+        assert p.get(b'ok') == 'ok'
+        assert p.size() == 1
+
+    def test_bounded(self):
+        mod = self.make_pool_module()
+        p = mod.Pool(4)
+        strs = [p.get(b'%d' % i) for i in range(4)]
+        assert p.size() == 4
+        assert p.get(b'0') is strs[0]
+        # the pool is full: it is emptied before storing a new string
+        s4 = p.get(b'4')
+        assert p.size() == 1
+        assert p.get(b'4') is s4
+        assert p.get(b'0') == '0'
+        assert p.size() == 2
+        for i in range(1000):
+            assert p.get(b'%d' % i) == str(i)
+        assert 1 <= p.size() <= 4
+        # long strings are never stored
+        long = b'abc' * 1000
+        s = p.get(long)
+        assert s == long.decode()
+        assert p.get(long) is not s
+        p.clear()
+        assert p.size() == 0
+        assert p.get(b'4') == '4'
+        assert p.size() == 1
+
+    def test_gc(self):
+        import gc
+        mod = self.make_pool_module()
+        p = mod.Pool()
+        for i in range(100):
+            p.get(b'string%d' % i)
+        del p
+        gc.collect()
+        p = mod.Pool()
+        p.get(b'a')
+        p.clear()
+        p.clear()
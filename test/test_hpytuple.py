@@ -79,3 +79,46 @@ class TestTuple(HPyTest):
             @INIT
         """)
         assert mod.f("xy") == ("xy", True, -42)
+
+    def test_TupleBuilder_SetSteal(self):
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy h_self, HPy h_arg)
+            {
+                HPyTupleBuilder builder = HPyTupleBuilder_New(ctx, 3);
+                HPyTupleBuilder_Set(ctx, builder, 0, h_arg);
+                HPyTupleBuilder_SetSteal(ctx, builder, 1, HPy_Dup(ctx, h_arg));
+                HPy h_num = HPyLong_FromLong(ctx, -42);
+                if (HPy_IsNull(h_num))
+                {
+                    HPyTupleBuilder_Cancel(ctx, builder);
+                    return HPy_NULL;
+                }
+                HPyTupleBuilder_SetSteal(ctx, builder, 2, h_num);
+                return HPyTupleBuilder_Build(ctx, builder);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        assert mod.f("xy") == ("xy", "xy", -42)
+
+    def test_GetSlice(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy *args,
+                              HPy_ssize_t nargs)
+            {
+                HPy_ssize_t start = HPyLong_AsSsize_t(ctx, args[1]);
+                HPy_ssize_t end = HPyLong_AsSsize_t(ctx, args[2]);
+                return HPyTuple_GetSlice(ctx, args[0], start, end);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        tup = (1, 2, 3, 4)
+        for start, end in [(0, 4), (1, 3), (-3, -1), (2, 100), (3, 1),
+                           (-100, 2)]:
+            assert mod.f(tup, start, end) == tup[start:end]
+        with pytest.raises(TypeError):
+            mod.f([1, 2], 0, 1)
@@ -815,3 +815,104 @@ class TestType(HPyTest):
         assert str(err.value) == (
             "HPy_TPFLAGS_INTERNAL_PURE should not be used directly,"
             " set .legacy=true instead")
+
+    def test_GetData(self):
+        mod = self.make_module("""
+            static long dummy_data = 42;
+
+            static HPyType_Spec Dummy_spec = {
+                .name = "mytest.Dummy",
+                .flags = HPy_TPFLAGS_DEFAULT | HPy_TPFLAGS_BASETYPE,
+                .data = &dummy_data,
+                @IS_LEGACY
+            };
+
+            HPyDef_METH(get_data, "get_data", get_data_impl, HPyFunc_O)
+            static HPy get_data_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                long *data = (long *)HPyType_GetData(ctx, arg);
+                if (data == NULL)
+                    return HPy_Dup(ctx, ctx->h_None);
+                return HPyLong_FromLong(ctx, *data);
+            }
+
+            @EXPORT_TYPE("Dummy", Dummy_spec)
+            @EXPORT(get_data)
+            @INIT
+        """)
+        assert mod.get_data(mod.Dummy) == 42
+
+        class Sub(mod.Dummy):
+            pass
+        assert mod.get_data(Sub) == 42
+        assert mod.get_data(int) is None
+        assert mod.get_data(42) is None
+
+    def test_GetData_subtype(self):
+        mod = self.make_module("""
+            static long base_data = 1;
+            static long sub_data = 2;
+
+            static HPyType_Spec Base_spec = {
+                .name = "mytest.Base",
+                .flags = HPy_TPFLAGS_DEFAULT | HPy_TPFLAGS_BASETYPE,
+                .data = &base_data,
+                @IS_LEGACY
+            };
+
+            static HPyType_Spec Sub_spec = {
+                .name = "mytest.Sub",
+                .flags = HPy_TPFLAGS_DEFAULT | HPy_TPFLAGS_BASETYPE,
+                .data = &sub_data,
+                @IS_LEGACY
+            };
+
+            static HPyType_Spec NoData_spec = {
+                .name = "mytest.NoData",
+                .flags = HPy_TPFLAGS_DEFAULT,
+                @IS_LEGACY
+            };
+
+            static void make_types(HPyContext *ctx, HPy module)
+            {
+                HPy h_Base = HPyType_FromSpec(ctx, &Base_spec, NULL);
+                if (HPy_IsNull(h_Base))
+                    return;
+                HPyType_SpecParam param[] = {
+                    { HPyType_SpecParam_Base, h_Base },
+                    { 0 }
+                };
+                HPy h_Sub = HPyType_FromSpec(ctx, &Sub_spec, param);
+                HPy h_NoData = HPyType_FromSpec(ctx, &NoData_spec, NULL);
+                if (!HPy_IsNull(h_Sub) && !HPy_IsNull(h_NoData)) {
+                    HPy_SetAttr_s(ctx, module, "Base", h_Base);
+                    HPy_SetAttr_s(ctx, module, "Sub", h_Sub);
+                    HPy_SetAttr_s(ctx, module, "NoData", h_NoData);
+                }
+                HPy_Close(ctx, h_Base);
+                HPy_Close(ctx, h_Sub);
+                HPy_Close(ctx, h_NoData);
+            }
+
+            HPyDef_METH(get_data, "get_data", get_data_impl, HPyFunc_O)
+            static HPy get_data_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                long *data = (long *)HPyType_GetData(ctx, arg);
+                if (data == NULL)
+                    return HPy_Dup(ctx, ctx->h_None);
+                return HPyLong_FromLong(ctx, *data);
+            }
+
+            @EXPORT(get_data)
+            @EXTRA_INIT_FUNC(make_types)
+            @INIT
+        """)
+        # the data of the nearest HPy type which has it
+        assert mod.get_data(mod.Base) == 1
+        assert mod.get_data(mod.Sub) == 2
+        class PySub(mod.Sub):
+            pass
+        assert mod.get_data(PySub) == 2
+        assert mod.get_data(mod.NoData) is None
+        # the data is not reachable from Python, so it cannot be rebound
+        assert not any('data' in name for name in dir(mod.Base))
@@ -35,6 +35,26 @@ class TestUnicode(HPyTest):
         """)
         assert mod.f() == "foobar"
 
+    def test_FromStringAndSize(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                HPy_ssize_t n = HPyBytes_Size(ctx, arg);
+                return HPyUnicode_FromStringAndSize(ctx,
+                                                    HPyBytes_AsString(ctx, arg), n);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        assert mod.f(b'foobar') == 'foobar'
+        assert mod.f(b'') == ''
+        assert mod.f(b'a\0b') == 'a\0b'
+        assert mod.f('h\xe9llo'.encode('utf-8')) == 'h\xe9llo'
+        with pytest.raises(UnicodeDecodeError):
+            mod.f(b'\xff')
+
     def test_FromWideChar(self):
         mod = self.make_module("""
             HPyDef_METH(f, "f", f_impl, HPyFunc_O)
@@ -110,4 +130,25 @@ class TestUnicode(HPyTest):
             @INIT
         """)
         assert mod.f('ABC') == "ABC"
-        assert mod.g().encode('ascii') == b'ab\0c'
\ No newline at end of file
+        assert mod.g().encode('ascii') == b'ab\0c'
+
+    def test_Substring(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy *args,
+                              HPy_ssize_t nargs)
+            {
+                HPy_ssize_t start = HPyLong_AsSsize_t(ctx, args[1]);
+                HPy_ssize_t end = HPyLong_AsSsize_t(ctx, args[2]);
+                return HPyUnicode_Substring(ctx, args[0], start, end);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        for s in ['abcd', '\xe0b\u20acd', '\U0001f600bcd']:
+            for start, end in [(0, 4), (1, 3), (-3, -1), (2, 100), (3, 1),
+                               (-100, 2)]:
+                assert mod.f(s, start, end) == s[start:end]
+        with pytest.raises(TypeError):
+            mod.f(b'abc', 0, 1)
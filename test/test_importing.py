@@ -49,3 +49,42 @@ class TestImporting(HPyTest):
 
         assert repr(mod) == '<module \'mytest\' from {}>'.format(
             repr(str(tmpdir.join('mytest' + ext))))
+
+    def test_fat_build(self, hpy_abi, tmpdir):
+        import os
+        import sys
+        import pytest
+        from .support import ExtensionCompiler
+        if hpy_abi != 'universal' or not self.supports_ordinary_make_module_imports():
+            # the test does not depend on the ABI, run it only once
+            pytest.skip()
+        compiler = ExtensionCompiler(tmpdir, self.compiler.hpy_devel, 'fat',
+                                     self.compiler.compiler_verbose)
+        compiler.compile_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_NOARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self)
+            {
+                return HPyUnicode_FromString(ctx, ctx->name);
+            }
+            @EXPORT(f)
+            @INIT
+        """, name='myfat')
+        mod_file = str(tmpdir.join('myfat.py'))
+        native = [x for x in os.listdir(str(tmpdir))
+                  if x.startswith('myfat.hpy-cpython.')]
+        assert len(native) == 1
+        #
+        mod = self.full_import('myfat', mod_file)
+        if sys.implementation.name == 'cpython':
+            # the stub picks the CPython ABI version
+            assert mod.f() == 'HPy CPython ABI'
+            assert mod.__file__ == str(tmpdir.join(native[0]))
+        else:
+            assert mod.f().startswith('HPy Universal ABI')
+        #
+        # without a matching CPython ABI version, the stub falls back to the
+        # universal one
+        os.remove(str(tmpdir.join(native[0])))
+        mod = self.full_import('myfat', mod_file)
+        assert mod.f().startswith('HPy Universal ABI')
+        assert mod.__file__ == str(tmpdir.join('myfat.hpy.so'))
@@ -90,6 +90,69 @@ class TestObject(HPyTest):
         assert mod.f(ClassAttr()) == 10
         assert mod.f(PropAttr()) == 11
 
+    def test_getattr_cached(self):
+        import pytest
+        mod = self.make_module("""
+            static HPyAttrCache foo_cache = HPyAttrCache_INIT("foo");
+
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                return HPy_GetAttrCached(ctx, arg, &foo_cache);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+
+        class Attrs:
+            def __init__(self, **kw):
+                for k, v in kw.items():
+                    setattr(self, k, v)
+
+        class ClassAttr:
+            foo = 10
+
+        class PropAttr:
+            @property
+            def foo(self):
+                return 11
+
+        class Slots:
+            __slots__ = ('foo',)
+
+        class Dynamic:
+            def __getattr__(self, name):
+                return name * 2
+
+        assert mod.f(Attrs(foo=5)) == 5
+        with pytest.raises(AttributeError):
+            mod.f(Attrs())
+        with pytest.raises(AttributeError):
+            mod.f(42)
+        assert mod.f(ClassAttr) == 10
+        for i in range(3):
+            assert mod.f(ClassAttr()) == 10
+            assert mod.f(PropAttr()) == 11
+        obj = ClassAttr()
+        obj.foo = 12
+        assert mod.f(obj) == 12
+        s = Slots()
+        with pytest.raises(AttributeError):
+            mod.f(s)
+        s.foo = 13
+        assert mod.f(s) == 13
+        assert mod.f(Dynamic()) == 'foofoo'
+        # modifying the type invalidates the cache
+        obj = ClassAttr()
+        assert mod.f(obj) == 10
+        ClassAttr.foo = 14
+        assert mod.f(obj) == 14
+        del ClassAttr.foo
+        with pytest.raises(AttributeError):
+            mod.f(obj)
+        PropAttr.foo = property(lambda self: 15)
+        assert mod.f(PropAttr()) == 15
+
     def test_hasattr(self):
         mod = self.make_module("""
             HPyDef_METH(f, "f", f_impl, HPyFunc_O)
@@ -296,6 +359,99 @@ class TestObject(HPyTest):
         mod.f(b)
         assert b.foo is True
 
+    def test_setattrs(self):
+        import pytest
+        mod = self.make_module("""
+            static HPyType_Spec dummy_spec = {
+                .name = "mytest.Dummy",
+            };
+
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                HPyAttrDef attrs[] = {
+                    HPyAttr_LONG("l", 42),
+                    HPyAttr_DOUBLE("d", 1.5),
+                    HPyAttr_STRING("s", "hello"),
+                    HPyAttr_OBJECT("o", ctx->h_True),
+                    HPyAttr_TYPE("Dummy", &dummy_spec, NULL),
+                    {0}
+                };
+                if (HPy_SetAttrs(ctx, arg, attrs) < 0)
+                    return HPy_NULL;
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+
+            HPyDef_METH(g, "g", g_impl, HPyFunc_NOARGS)
+            static HPy g_impl(HPyContext *ctx, HPy self)
+            {
+                HPyAttrDef attrs[] = {
+                    HPyAttr_LONG("MY_CONSTANT", 1234),
+                    {0}
+                };
+                if (HPy_SetAttrs(ctx, self, attrs) < 0)
+                    return HPy_NULL;
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+            @EXPORT(f)
+            @EXPORT(g)
+            @INIT
+        """)
+
+        class Attrs:
+            pass
+
+        a = Attrs()
+        mod.f(a)
+        assert a.l == 42
+        assert a.d == 1.5
+        assert a.s == "hello"
+        assert a.o is True
+        assert isinstance(a.Dummy, type)
+        assert a.Dummy.__name__ == "Dummy"
+
+        mod.g()
+        assert mod.MY_CONSTANT == 1234
+
+        with pytest.raises(AttributeError):
+            mod.f(object())
+
+    def test_setattrs_static_table(self):
+        import sys
+        mod = self.make_module("""
+            // the interned names are cached in the table the first time
+            static HPyAttrDef attrs[] = {
+                HPyAttr_LONG("static_l", 42),
+                HPyAttr_STRING("static_s", "hello"),
+                {0}
+            };
+
+            HPyDef_METH(f, "f", f_impl, HPyFunc_O)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy arg)
+            {
+                if (HPy_SetAttrs(ctx, arg, attrs) < 0)
+                    return HPy_NULL;
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+
+        class Attrs:
+            pass
+
+        objs = [Attrs() for i in range(3)]
+        for a in objs:
+            mod.f(a)
+        mod.f(mod)
+        for a in objs + [mod]:
+            assert a.static_l == 42
+            assert a.static_s == "hello"
+        keys = [k for a in objs for k in vars(a)]
+        assert keys == ["static_l", "static_s"] * 3
+        for k in keys:
+            assert k is sys.intern(k)
+
     def test_getitem(self):
         import pytest
         mod = self.make_module("""
@@ -578,3 +734,109 @@ class TestObject(HPyTest):
         a = object()
         assert mod.f(a, a)
         assert not mod.f(a, None)
+
+    def test_getslice(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy *args,
+                              HPy_ssize_t nargs)
+            {
+                HPy_ssize_t start = HPyLong_AsSsize_t(ctx, args[1]);
+                HPy_ssize_t end = HPyLong_AsSsize_t(ctx, args[2]);
+                return HPy_GetSlice(ctx, args[0], start, end);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        class MySeq:
+            def __getitem__(self, item):
+                return item
+        for obj in [[1, 2, 3, 4], (1, 2, 3, 4), b'abcd', 'abcd',
+                    bytearray(b'abcd'), range(4)]:
+            for start, end in [(0, 4), (1, 3), (-3, -1), (2, 100), (3, 1),
+                               (-100, 2)]:
+                assert mod.f(obj, start, end) == obj[start:end]
+        assert mod.f(MySeq(), 1, 2) == slice(1, 2)
+        with pytest.raises(TypeError):
+            mod.f(42, 0, 1)
+
+    def test_setslice_delslice(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(set, "set", set_impl, HPyFunc_VARARGS)
+            static HPy set_impl(HPyContext *ctx, HPy self, HPy *args,
+                                HPy_ssize_t nargs)
+            {
+                HPy_ssize_t start = HPyLong_AsSsize_t(ctx, args[1]);
+                HPy_ssize_t end = HPyLong_AsSsize_t(ctx, args[2]);
+                if (HPy_SetSlice(ctx, args[0], start, end, args[3]) < 0)
+                    return HPy_NULL;
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+            HPyDef_METH(delslice, "delslice", delslice_impl, HPyFunc_VARARGS)
+            static HPy delslice_impl(HPyContext *ctx, HPy self, HPy *args,
+                                     HPy_ssize_t nargs)
+            {
+                HPy_ssize_t start = HPyLong_AsSsize_t(ctx, args[1]);
+                HPy_ssize_t end = HPyLong_AsSsize_t(ctx, args[2]);
+                if (HPy_DelSlice(ctx, args[0], start, end) < 0)
+                    return HPy_NULL;
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+            @EXPORT(set)
+            @EXPORT(delslice)
+            @INIT
+        """)
+        lst = [1, 2, 3, 4]
+        mod.set(lst, 1, 3, ['a', 'b', 'c'])
+        assert lst == [1, 'a', 'b', 'c', 4]
+        mod.set(lst, -1, 100, [])
+        assert lst == [1, 'a', 'b', 'c']
+        mod.delslice(lst, 0, 2)
+        assert lst == ['b', 'c']
+        ba = bytearray(b'hello')
+        mod.set(ba, 0, 1, b'J')
+        mod.delslice(ba, -2, 100)
+        assert ba == b'Jel'
+        with pytest.raises(TypeError):
+            mod.set((1, 2), 0, 1, [])
+        with pytest.raises(TypeError):
+            mod.delslice('abc', 0, 1)
+
+    def test_getslice_view(self):
+        import pytest
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_VARARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self, HPy *args,
+                              HPy_ssize_t nargs)
+            {
+                HPy_ssize_t start = HPyLong_AsSsize_t(ctx, args[1]);
+                HPy_ssize_t end = HPyLong_AsSsize_t(ctx, args[2]);
+                return HPy_GetSliceView(ctx, args[0], start, end);
+            }
+            @EXPORT(f)
+            @INIT
+        """)
+        import array
+        v = mod.f(b'hello world', 6, 100)
+        assert type(v) is memoryview
+        assert v == b'world'
+        assert v.readonly
+        assert bytes(mod.f(b'hello', -4, -1)) == b'ell'
+        # the view shares the memory of the object
+        ba = bytearray(b'hello world')
+        v = mod.f(ba, 0, 5)
+        v[0] = ord('J')
+        assert ba == b'Jello world'
+        ba[4] = ord('y')
+        assert v == b'Jelly'
+        v.release()
+        a = array.array('i', range(10))
+        v = mod.f(a, 2, 5)
+        assert v.tolist() == [2, 3, 4]
+        assert mod.f(memoryview(b'abcdef')[1:], 1, 3) == b'cd'
+        with pytest.raises(TypeError):
+            mod.f('abc', 0, 1)
+        with pytest.raises(TypeError):
+            mod.f([1, 2], 0, 1)
@@ -34,6 +34,35 @@ class TestSlots(HPyTest):
         assert p.x == 1
         assert p.y == 2
 
+    def test_tp_call(self):
+        mod = self.make_module("""
+            @DEFINE_PointObject
+            @DEFINE_Point_new
+            @DEFINE_Point_xy
+
+            HPyDef_SLOT(Point_call, Point_call_impl, HPy_tp_call)
+            static HPy Point_call_impl(HPyContext *ctx, HPy self, HPy *args,
+                                       HPy_ssize_t nargs, HPy kw)
+            {
+                long scale = 1;
+                static const char *kwlist[] = { "scale", NULL };
+                HPyTracker ht;
+                if (!HPyArg_ParseKeywords(ctx, &ht, args, nargs, kw, "|l",
+                                          kwlist, &scale))
+                    return HPy_NULL;
+                HPyTracker_Close(ctx, ht);
+                PointObject *p = PointObject_AsStruct(ctx, self);
+                return HPyLong_FromLong(ctx, scale * (p->x + p->y));
+            }
+
+            @EXPORT_POINT_TYPE(&Point_new, &Point_call, &Point_x, &Point_y)
+            @INIT
+        """)
+        p = mod.Point(1, 2)
+        assert p() == 3
+        assert p(10) == 30
+        assert p(scale=100) == 300
+
     @pytest.mark.syncgc
     def test_tp_destroy(self):
         import gc
@@ -200,6 +229,58 @@ class TestSlots(HPyTest):
         # we can't use '@' because we want to be importable on py27
         assert operator.matmul(p, 42) == (p, "matrix_multiply", 42)
 
+    def test_nb_typed_binop(self):
+        mod = self.make_module("""
+            @DEFINE_PointObject
+            @DEFINE_Point_new
+            @DEFINE_Point_xy
+
+            static HPy new_point(HPyContext *ctx, HPy self, long x, long y)
+            {
+                PointObject *p;
+                HPy h_type = HPy_Type(ctx, self);
+                HPy h_result = HPy_New(ctx, h_type, &p);
+                HPy_Close(ctx, h_type);
+                if (HPy_IsNull(h_result))
+                    return HPy_NULL;
+                p->x = x;
+                p->y = y;
+                return h_result;
+            }
+
+            HPyDef_SLOT_TYPED_BINOP(Point_add, Point_add_typed, Point_add_impl,
+                                    HPy_nb_add)
+            static HPy Point_add_typed(HPyContext *ctx, HPy a, void *a_data,
+                                       HPy b, void *b_data)
+            {
+                PointObject *p1 = (PointObject *)a_data;
+                PointObject *p2 = (PointObject *)b_data;
+                return new_point(ctx, a, p1->x + p2->x, p1->y + p2->y);
+            }
+
+            static HPy Point_add_impl(HPyContext *ctx, HPy a, HPy b)
+            {
+                // generic fallback: Point + int. Note that we are also
+                // called for int + Point, with 'a' being the int
+                if (!HPy_TypeCheck(ctx, b, ctx->h_LongType))
+                    return HPy_Dup(ctx, ctx->h_NotImplemented);
+                long n = HPyLong_AsLong(ctx, b);
+                PointObject *p = PointObject_AsStruct(ctx, a);
+                return new_point(ctx, a, p->x + n, p->y + n);
+            }
+
+            @EXPORT_POINT_TYPE(&Point_new, &Point_x, &Point_y, &Point_add)
+            @INIT
+        """)
+        p = mod.Point(1, 2) + mod.Point(10, 20)
+        assert (p.x, p.y) == (11, 22)
+        p = mod.Point(1, 2) + 100
+        assert (p.x, p.y) == (101, 102)
+        with pytest.raises(TypeError):
+            mod.Point(1, 2) + 'hello'
+        with pytest.raises(TypeError):
+            100 + mod.Point(1, 2)
+
     def test_nb_ops_inplace(self):
         import operator
         mod = self.make_module(r"""
@@ -423,6 +504,72 @@ class TestSlots(HPyTest):
             assert sys.getrefcount(arr) == init_refcount
         mv2 = memoryview(arr)  # doesn't raise
 
+    def test_buffer_flags(self):
+        import io
+        mod = self.make_module("""
+            @TYPE_STRUCT_BEGIN(FakeArrayObject)
+                int flags;
+            @TYPE_STRUCT_END
+
+            static char static_mem[4];
+
+            HPyDef_SLOT(FakeArray_getbuffer, _getbuffer_impl, HPy_bf_getbuffer)
+            static int _getbuffer_impl(HPyContext *ctx, HPy self, HPy_buffer* buf, int flags) {
+                FakeArrayObject_AsStruct(ctx, self)->flags = flags;
+                buf->buf = static_mem;
+                buf->len = 4;
+                buf->itemsize = 1;
+                buf->readonly = 0;
+                buf->ndim = 1;
+                buf->format = NULL;
+                buf->shape = NULL;
+                buf->strides = NULL;
+                buf->suboffsets = NULL;
+                buf->internal = NULL;
+                buf->obj = HPy_Dup(ctx, self);
+                return 0;
+            }
+
+            // the name of the request which the last call to getbuffer got
+            HPyDef_METH(FakeArray_request, "request", _request_impl, HPyFunc_NOARGS)
+            static HPy _request_impl(HPyContext *ctx, HPy self) {
+                const char *name;
+                switch (FakeArrayObject_AsStruct(ctx, self)->flags) {
+                case HPyBUF_SIMPLE: name = "SIMPLE"; break;
+                case HPyBUF_WRITABLE: name = "WRITABLE"; break;
+                case HPyBUF_INDIRECT | HPyBUF_FORMAT: name = "FULL_RO"; break;
+                case HPyBUF_STRIDES | HPyBUF_FORMAT: name = "RECORDS_RO"; break;
+                case HPyBUF_C_CONTIGUOUS: name = "C_CONTIGUOUS"; break;
+                default: name = "other";
+                }
+                return HPyUnicode_FromString(ctx, name);
+            }
+
+            static HPyDef *FakeArray_defines[] = {
+                &FakeArray_getbuffer,
+                &FakeArray_request,
+                NULL
+            };
+
+            static HPyType_Spec FakeArray_Spec = {
+                .name = "mytest.FakeArray",
+                .basicsize = sizeof(FakeArrayObject),
+                .defines = FakeArray_defines,
+                .legacy = FakeArrayObject_IS_LEGACY,
+            };
+
+            @EXPORT_TYPE("FakeArray", FakeArray_Spec)
+            @INIT
+        """)
+        # the HPyBUF_* flags have the same values as the PyBUF_* flags
+        arr = mod.FakeArray()
+        with memoryview(arr):
+            assert arr.request() == "FULL_RO"
+        assert b"".join([arr]) == b"\0" * 4
+        assert arr.request() == "SIMPLE"
+        assert io.BytesIO(b"abcd").readinto(arr) == 4
+        assert arr.request() == "WRITABLE"
+
 
 class TestSqSlots(HPyTest):
 
@@ -650,3 +797,152 @@ class TestSqSlots(HPyTest):
         #
         assert not p1 >= p2
         assert p1 >= p1
+
+    def test_tp_richcompare_bool(self):
+        import pytest
+        mod = self.make_module("""
+            @DEFINE_PointObject
+            @DEFINE_Point_new
+
+            HPyDef_SLOT(Point_cmp, Point_cmp_impl, HPy_tp_richcompare_bool);
+            static int Point_cmp_impl(HPyContext *ctx, HPy self, HPy o, HPy_RichCmpOp op)
+            {
+                HPy type = HPy_Type(ctx, self);
+                int same_type = HPy_TypeCheck(ctx, o, type);
+                HPy_Close(ctx, type);
+                if (!same_type)
+                    return HPy_RICHCMP_NOTIMPLEMENTED;
+                PointObject *p1 = PointObject_AsStruct(ctx, self);
+                PointObject *p2 = PointObject_AsStruct(ctx, o);
+                HPy_RETURN_RICHCOMPARE_BOOL(ctx, p1->x, p2->x, op);
+            }
+
+            HPyDef_METH(lt, "lt", lt_impl, HPyFunc_VARARGS)
+            static HPy lt_impl(HPyContext *ctx, HPy self, HPy *args, HPy_ssize_t nargs)
+            {
+                int res = HPy_RichCompareBool(ctx, args[0], args[1], HPy_LT);
+                if (res < 0)
+                    return HPy_NULL;
+                return HPyBool_FromLong(ctx, res);
+            }
+
+            @EXPORT_POINT_TYPE(&Point_new, &Point_cmp)
+            @EXPORT(lt)
+            @INIT
+        """)
+        p1 = mod.Point(10, 10)
+        p2 = mod.Point(20, 20)
+        assert p1 == p1
+        assert not p1 == p2
+        assert p1 != p2
+        assert p1 < p2
+        assert not p1 > p2
+        assert p1 <= p1
+        assert not p1 >= p2
+        #
+        points = [mod.Point(x, 0) for x in (5, 3, 9, 1, 7)]
+        ordered = sorted(points)
+        assert [id(p) for p in ordered] == [id(points[i]) for i in (3, 1, 0, 4, 2)]
+        #
+        assert mod.lt(p1, p2) is True
+        assert mod.lt(p2, p1) is False
+        # NotImplemented falls back to the default CPython behavior
+        assert not p1 == 10
+        assert p1 != 10
+        with pytest.raises(TypeError):
+            p1 < 10
+        with pytest.raises(TypeError):
+            mod.lt(p1, 10)
+
+    def test_tp_richcompare_bool_notimplemented(self):
+        import pytest
+        mod = self.make_module("""
+            @DEFINE_PointObject
+            @DEFINE_Point_new
+
+            static long calls;
+
+            HPyDef_SLOT(Point_cmp, Point_cmp_impl, HPy_tp_richcompare_bool);
+            static int Point_cmp_impl(HPyContext *ctx, HPy self, HPy o, HPy_RichCmpOp op)
+            {
+                calls++;
+                return HPy_RICHCMP_NOTIMPLEMENTED;
+            }
+
+            HPyDef_METH(cmp, "cmp", cmp_impl, HPyFunc_VARARGS)
+            static HPy cmp_impl(HPyContext *ctx, HPy self, HPy *args, HPy_ssize_t nargs)
+            {
+                long op = HPyLong_AsLong(ctx, args[2]);
+                if (op == -1 && HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                int res = HPy_RichCompareBool(ctx, args[0], args[1], (int)op);
+                if (res < 0)
+                    return HPy_NULL;
+                return HPyBool_FromLong(ctx, res);
+            }
+
+            HPyDef_METH(get_calls, "get_calls", get_calls_impl, HPyFunc_NOARGS)
+            static HPy get_calls_impl(HPyContext *ctx, HPy self)
+            {
+                return HPyLong_FromLong(ctx, calls);
+            }
+
+            @EXPORT_POINT_TYPE(&Point_new, &Point_cmp)
+            @EXPORT(cmp)
+            @EXPORT(get_calls)
+            @INIT
+        """)
+        HPy_LT, HPy_EQ, HPy_NE = 0, 2, 3
+        p1 = mod.Point(1, 2)
+        p2 = mod.Point(1, 2)
+        # the impl is called only once, then HPy_RichCompareBool behaves like
+        # CPython when both operands return NotImplemented
+        assert mod.cmp(p1, p2, HPy_EQ) is False
+        assert mod.get_calls() == 1
+        assert mod.cmp(p1, p2, HPy_NE) is True
+        assert mod.get_calls() == 2
+        with pytest.raises(TypeError):
+            mod.cmp(p1, p2, HPy_LT)
+        assert mod.get_calls() == 3
+
+    def test_tp_richcompare_bool_and_tp_richcompare(self):
+        mod = self.make_module("""
+            @DEFINE_PointObject
+            @DEFINE_Point_new
+
+            static long richcompare_calls;
+
+            HPyDef_SLOT(Point_cmp, Point_cmp_impl, HPy_tp_richcompare);
+            static HPy Point_cmp_impl(HPyContext *ctx, HPy self, HPy o, HPy_RichCmpOp op)
+            {
+                richcompare_calls++;
+                PointObject *p1 = PointObject_AsStruct(ctx, self);
+                PointObject *p2 = PointObject_AsStruct(ctx, o);
+                HPy_RETURN_RICHCOMPARE(ctx, p1->x, p2->x, op);
+            }
+
+            HPyDef_SLOT(Point_cmp_bool, Point_cmp_bool_impl, HPy_tp_richcompare_bool);
+            static int Point_cmp_bool_impl(HPyContext *ctx, HPy self, HPy o, HPy_RichCmpOp op)
+            {
+                PointObject *p1 = PointObject_AsStruct(ctx, self);
+                PointObject *p2 = PointObject_AsStruct(ctx, o);
+                HPy_RETURN_RICHCOMPARE_BOOL(ctx, p1->x, p2->x, op);
+            }
+
+            HPyDef_METH(get_richcompare_calls, "get_richcompare_calls",
+                        get_richcompare_calls_impl, HPyFunc_NOARGS)
+            static HPy get_richcompare_calls_impl(HPyContext *ctx, HPy self)
+            {
+                return HPyLong_FromLong(ctx, richcompare_calls);
+            }
+
+            @EXPORT_POINT_TYPE(&Point_new, &Point_cmp, &Point_cmp_bool)
+            @EXPORT(get_richcompare_calls)
+            @INIT
+        """)
+        p1 = mod.Point(10, 20)
+        p2 = mod.Point(20, 10)
+        # the Python-level comparisons use tp_richcompare
+        assert p1 < p2
+        assert not p1 > p2
+        assert mod.get_richcompare_calls() == 2
@@ -0,0 +1,217 @@
+"""
+NOTE: this tests are also meant to be run as PyPy "applevel" tests.
+
+This means that global imports will NOT be visible inside the test
+functions. In particular, you have to "import pytest" inside the test in order
+to be able to use e.g. pytest.raises (which on PyPy will be implemented by a
+"fake pytest module")
+"""
+from .support import HPyTest
+
+
+class TestHPyStructArray(HPyTest):
+
+    def make_point_module(self):
+        return self.make_module("""
+            #include <stddef.h>
+
+            typedef struct {
+                double x;
+                double y;
+                int tag;
+                char flag;
+            } Point;
+
+            static HPyStructArray_Field point_fields[] = {
+                { "x", HPyMember_DOUBLE, offsetof(Point, x), "the x coordinate" },
+                { "y", HPyMember_DOUBLE, offsetof(Point, y) },
+                { "tag", HPyMember_INT, offsetof(Point, tag) },
+                { "flag", HPyMember_BOOL, offsetof(Point, flag) },
+                { NULL },
+            };
+
+            static HPyStructArray_Desc point_desc = {
+                .name = "mytest.PointArray",
+                .doc = "An array of points",
+                .itemsize = sizeof(Point),
+                .fields = point_fields,
+            };
+
+            HPyDef_METH(make_type, "make_type", make_type_impl, HPyFunc_NOARGS)
+            static HPy make_type_impl(HPyContext *ctx, HPy self)
+            {
+                return HPyStructArray_NewType(ctx, &point_desc);
+            }
+
+            HPyDef_METH(new, "new", new_impl, HPyFunc_VARARGS)
+            static HPy new_impl(HPyContext *ctx, HPy self,
+                                HPy *args, HPy_ssize_t nargs)
+            {
+                HPy_ssize_t n = HPyLong_AsSsize_t(ctx, args[1]);
+                if (n == -1 && HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                HPy h = HPyStructArray_New(ctx, args[0], n);
+                if (HPy_IsNull(h))
+                    return HPy_NULL;
+                Point *p = (Point *)HPyStructArray_Data(ctx, h);
+                for (HPy_ssize_t i = 0; i < HPyStructArray_Length(ctx, h); i++) {
+                    p[i].x = i;
+                    p[i].y = 2.0 * i;
+                    p[i].tag = (int)i + 100;
+                }
+                return h;
+            }
+
+            HPyDef_METH(sum_x, "sum_x", sum_x_impl, HPyFunc_O)
+            static HPy sum_x_impl(HPyContext *ctx, HPy self, HPy arr)
+            {
+                Point *p = (Point *)HPyStructArray_Data(ctx, arr);
+                if (p == NULL)
+                    return HPy_NULL;
+                double res = 0;
+                for (HPy_ssize_t i = 0; i < HPyStructArray_Length(ctx, arr); i++)
+                    res += p[i].x;
+                return HPyFloat_FromDouble(ctx, res);
+            }
+
+            HPyDef_METH(length, "length", length_impl, HPyFunc_O)
+            static HPy length_impl(HPyContext *ctx, HPy self, HPy arr)
+            {
+                HPy_ssize_t n = HPyStructArray_Length(ctx, arr);
+                if (n < 0)
+                    return HPy_NULL;
+                return HPyLong_FromSsize_t(ctx, n);
+            }
+
+            @EXPORT(make_type)
+            @EXPORT(new)
+            @EXPORT(sum_x)
+            @EXPORT(length)
+            @INIT
+        """)
+
+    def test_new_type(self):
+        mod = self.make_point_module()
+        PointArray = mod.make_type()
+        assert isinstance(PointArray, type)
+        assert PointArray.__name__ == "PointArray"
+        assert PointArray.__doc__ == "An array of points"
+        assert isinstance(PointArray.item_type, type)
+        assert isinstance(PointArray.column_type, type)
+        assert PointArray.item_type.x.__doc__ == "the x coordinate"
+
+    def test_new_from_c(self):
+        mod = self.make_point_module()
+        PointArray = mod.make_type()
+        arr = mod.new(PointArray, 5)
+        assert type(arr) is PointArray
+        assert len(arr) == 5
+        assert arr[3].x == 3.0
+        assert arr[3].y == 6.0
+        assert arr[3].tag == 103
+        assert arr[3].flag is False
+        assert mod.sum_x(arr) == 10.0
+
+    def test_new_from_python(self):
+        import pytest
+        mod = self.make_point_module()
+        PointArray = mod.make_type()
+        arr = PointArray(3)
+        assert len(arr) == 3
+        assert [(p.x, p.y, p.tag) for p in arr] == [(0.0, 0.0, 0)] * 3
+        assert len(PointArray(0)) == 0
+        with pytest.raises(ValueError):
+            PointArray(-1)
+        with pytest.raises(TypeError):
+            PointArray()
+        with pytest.raises(TypeError):
+            PointArray.item_type()
+
+    def test_c_functions_check_the_type(self):
+        import pytest
+        mod = self.make_point_module()
+        PointArray = mod.make_type()
+        arr = PointArray(3)
+        assert mod.length(arr) == 3
+        for obj in [None, [1, 2, 3], arr[0], arr.column("x"), PointArray]:
+            with pytest.raises(TypeError):
+                mod.length(obj)
+            with pytest.raises(TypeError):
+                mod.sum_x(obj)
+
+    def test_item_view(self):
+        import pytest
+        mod = self.make_point_module()
+        PointArray = mod.make_type()
+        arr = PointArray(4)
+        p = arr[2]
+        p.x = 1.5
+        p.tag = 42
+        p.flag = 1
+        assert arr[2].x == 1.5
+        assert arr[2].tag == 42
+        assert arr[2].flag is True
+        assert mod.sum_x(arr) == 1.5
+        with pytest.raises(TypeError):
+            p.tag = "hello"
+        with pytest.raises(TypeError):
+            del p.x
+        with pytest.raises(IndexError):
+            arr[4]
+        assert arr[-1].x == 0.0
+        # the view keeps the array alive
+        del arr
+        assert p.x == 1.5
+
+    def test_column(self):
+        import pytest
+        mod = self.make_point_module()
+        PointArray = mod.make_type()
+        arr = mod.new(PointArray, 4)
+        col = arr.column("y")
+        assert len(col) == 4
+        assert list(col) == [0.0, 2.0, 4.0, 6.0]
+        m = memoryview(col)
+        assert m.format == "d"
+        assert m.ndim == 1
+        assert m.shape == (4,)
+        assert m.itemsize == 8
+        assert m.strides[0] >= 24
+        assert m.tolist() == [0.0, 2.0, 4.0, 6.0]
+        m[1] = 10.0
+        assert arr[1].y == 10.0
+        assert memoryview(arr.column("tag")).tolist() == [100, 101, 102, 103]
+        with pytest.raises(KeyError):
+            arr.column("z")
+
+    def test_class_attributes_are_not_trusted(self):
+        import pytest
+        mod = self.make_point_module()
+        PointArray = mod.make_type()
+        PointArray._desc = 16
+        PointArray.item_type = int
+        PointArray.column_type = int
+        arr = PointArray(3)
+        assert len(arr) == 3
+        assert arr[1].x == 0.0
+        assert list(arr.column("tag")) == [0, 0, 0]
+        with pytest.raises(TypeError):
+            mod.new(int, 3)
+
+    def test_column_buffer_flags(self):
+        import pytest
+        import hashlib
+        import struct
+        mod = self.make_point_module()
+        PointArray = mod.make_type()
+        arr = mod.new(PointArray, 4)
+        col = arr.column("tag")
+        # the column is strided: consumers which need a contiguous buffer
+        # must get an error instead of the wrong bytes
+        with pytest.raises(BufferError):
+            hashlib.md5(col)
+        # bytes() asks for a strided buffer and copies the items
+        assert bytes(col) == struct.pack('4i', 100, 101, 102, 103)
+        m = memoryview(col)
+        assert not m.readonly
+        assert m.tolist() == [100, 101, 102, 103]
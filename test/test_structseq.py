@@ -0,0 +1,196 @@
+"""
+NOTE: this tests are also meant to be run as PyPy "applevel" tests.
+
+This means that global imports will NOT be visible inside the test
+functions. In particular, you have to "import pytest" inside the test in order
+to be able to use e.g. pytest.raises (which on PyPy will be implemented by a
+"fake pytest module")
+"""
+from .support import HPyTest
+
+
+class TestHPyStructSequence(HPyTest):
+
+    def make_point_module(self):
+        return self.make_module("""
+            static HPyStructSequence_Field point_fields[] = {
+                { "x", "the x coordinate" },
+                { "y", NULL },
+                { NULL },
+            };
+
+            static HPyStructSequence_Desc point_desc = {
+                .name = "mytest.Point",
+                .doc = "A point",
+                .fields = point_fields,
+            };
+
+            HPyDef_METH(make_type, "make_type", make_type_impl, HPyFunc_NOARGS)
+            static HPy make_type_impl(HPyContext *ctx, HPy self)
+            {
+                return HPyStructSequence_NewType(ctx, &point_desc);
+            }
+
+            HPyDef_METH(new, "new", new_impl, HPyFunc_VARARGS)
+            static HPy new_impl(HPyContext *ctx, HPy self,
+                                HPy *args, HPy_ssize_t nargs)
+            {
+                return HPyStructSequence_New(ctx, args[0], nargs - 1, args + 1);
+            }
+
+            HPyDef_METH(getitem, "getitem", getitem_impl, HPyFunc_VARARGS)
+            static HPy getitem_impl(HPyContext *ctx, HPy self,
+                                    HPy *args, HPy_ssize_t nargs)
+            {
+                HPy_ssize_t i = HPyLong_AsSsize_t(ctx, args[1]);
+                if (i == -1 && HPyErr_Occurred(ctx))
+                    return HPy_NULL;
+                return HPyStructSequence_GetItem(ctx, args[0], i);
+            }
+
+            HPyDef_METH(build, "build", build_impl, HPyFunc_VARARGS)
+            static HPy build_impl(HPyContext *ctx, HPy self,
+                                  HPy *args, HPy_ssize_t nargs)
+            {
+                // build(type, i0, v0, i1, v1, ...)
+                HPyStructSequenceBuilder b = HPyStructSequenceBuilder_New(ctx, args[0]);
+                for (HPy_ssize_t j = 1; j + 1 < nargs; j += 2) {
+                    HPy_ssize_t i = HPyLong_AsSsize_t(ctx, args[j]);
+                    if (HPyStructSequenceBuilder_Set(ctx, b, i, args[j + 1]) < 0) {
+                        HPyStructSequenceBuilder_Cancel(ctx, b);
+                        return HPy_NULL;
+                    }
+                }
+                return HPyStructSequenceBuilder_Build(ctx, b);
+            }
+
+            @EXPORT(make_type)
+            @EXPORT(new)
+            @EXPORT(getitem)
+            @EXPORT(build)
+            @INIT
+        """)
+
+    def test_new_type(self):
+        mod = self.make_point_module()
+        Point = mod.make_type()
+        assert isinstance(Point, type)
+        assert Point.__name__ == "Point"
+        assert Point.__module__ == "mytest"
+        assert Point.__doc__ == "A point"
+        assert Point.n_fields == 2
+        assert Point._fields == ("x", "y")
+        assert Point.x.__doc__ == "the x coordinate"
+
+    def test_new_from_c(self):
+        mod = self.make_point_module()
+        Point = mod.make_type()
+        p = mod.new(Point, 1, "a")
+        assert type(p) is Point
+        assert p.x == 1
+        assert p.y == "a"
+        assert mod.getitem(p, 0) == 1
+        assert mod.getitem(p, 1) == "a"
+
+    def test_new_from_python(self):
+        import pytest
+        mod = self.make_point_module()
+        Point = mod.make_type()
+        p = Point(1, 2)
+        assert (p.x, p.y) == (1, 2)
+        with pytest.raises(TypeError):
+            Point(1)
+        with pytest.raises(TypeError):
+            Point(1, 2, 3)
+        with pytest.raises(TypeError):
+            Point(x=1, y=2)
+        with pytest.raises(TypeError):
+            mod.new(Point, 1, 2, 3)
+
+    def test_sequence(self):
+        import pytest
+        mod = self.make_point_module()
+        Point = mod.make_type()
+        p = Point(10, 20)
+        assert len(p) == 2
+        assert p[0] == 10
+        assert p[1] == 20
+        assert p[-1] == 20
+        assert list(p) == [10, 20]
+        x, y = p
+        assert (x, y) == (10, 20)
+        with pytest.raises(IndexError):
+            p[2]
+        with pytest.raises(IndexError):
+            mod.getitem(p, 2)
+        with pytest.raises(IndexError):
+            mod.getitem(p, -1)
+
+    def test_readonly(self):
+        import pytest
+        mod = self.make_point_module()
+        Point = mod.make_type()
+        p = Point(1, 2)
+        with pytest.raises(AttributeError):
+            p.x = 3
+
+    def test_compare(self):
+        mod = self.make_point_module()
+        Point = mod.make_type()
+        assert Point(1, 2) == Point(1, 2)
+        assert Point(1, 2) != Point(1, 3)
+        assert Point(1, 2) < Point(1, 3)
+        assert Point(1, 2) == (1, 2)
+        assert (1, 2) == Point(1, 2)
+        assert Point(1, 2) != [1, 2]
+
+    def test_repr(self):
+        mod = self.make_point_module()
+        Point = mod.make_type()
+        assert repr(Point(1, 'a')) == "Point(x=1, y='a')"
+
+    def test_gc(self):
+        import gc
+        mod = self.make_point_module()
+        Point = mod.make_type()
+        l = [1]
+        p = Point(l, None)
+        l.append(p)
+        del l, p
+        gc.collect()
+
+    def test_class_attributes_are_not_trusted(self):
+        import pytest
+        mod = self.make_point_module()
+        Point = mod.make_type()
+        Point.n_fields = 5000
+        Point._fields = ()
+        with pytest.raises(TypeError):
+            Point(*range(5000))
+        with pytest.raises(TypeError):
+            mod.new(Point, *range(5000))
+        p = Point(1, 2)
+        assert len(p) == 2
+        assert repr(p) == "Point(x=1, y=2)"
+
+    def test_not_a_struct_sequence(self):
+        import pytest
+        mod = self.make_point_module()
+        with pytest.raises(TypeError):
+            mod.new(int, 1, 2)
+        with pytest.raises(TypeError):
+            mod.build(int)
+
+    def test_builder(self):
+        import pytest
+        mod = self.make_point_module()
+        Point = mod.make_type()
+        p = mod.build(Point, 1, 'b', 0, 'a')
+        assert type(p) is Point
+        assert p == ('a', 'b')
+        p = mod.build(Point, 0, 'a', 1, 'b', 0, 'c')
+        assert p == ('c', 'b')
+        with pytest.raises(TypeError):
+            mod.build(Point, 0, 'a')
+        with pytest.raises(IndexError):
+            mod.build(Point, 2, 'a')
@@ -0,0 +1,211 @@
+"""
+NOTE: these tests are also meant to be run as PyPy "applevel" tests.
+
+This means that global imports will NOT be visible inside the test
+functions. In particular, you have to "import pytest" inside the test in order
+to be able to use e.g. pytest.raises (which on PyPy will be implemented by a
+"fake pytest module")
+
+These tests call HPy functions from many threads at the same time. With the
+GIL, they check that the threads do not interfere with each other; on
+free-threaded builds of CPython they also stress the atomic operations and
+the locks of the runtime and of the debug mode.
+
+The test suite is currently run only on builds with a GIL: the code paths
+under Py_GIL_DISABLED are compiled and reviewed, but are NOT verified by
+these tests until they run on a free-threaded interpreter.
+"""
+from .support import HPyTest
+
+
+def run_in_threads(func, nthreads=8):
+    import threading
+    barrier = threading.Barrier(nthreads)
+    errors = []
+    def target(i):
+        try:
+            barrier.wait()
+            func(i)
+        except BaseException as e:
+            errors.append(e)
+    threads = [threading.Thread(target=target, args=(i,))
+               for i in range(nthreads)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    if errors:
+        raise errors[0]
+
+
+class TestThreads(HPyTest):
+
+    def make_holder_module(self):
+        return self.make_module("""
+            typedef struct {
+                HPyField f;
+            } HolderObject;
+
+            HPyType_HELPERS(HolderObject)
+
+            HPyDef_SLOT(Holder_traverse, Holder_traverse_impl, HPy_tp_traverse)
+            static int Holder_traverse_impl(void *self, HPyFunc_visitproc visit,
+                                            void *arg)
+            {
+                HPy_VISIT(&((HolderObject *)self)->f);
+                return 0;
+            }
+
+            HPyDef_METH(Holder_get, "get", Holder_get_impl, HPyFunc_NOARGS)
+            static HPy Holder_get_impl(HPyContext *ctx, HPy self)
+            {
+                HolderObject *holder = HolderObject_AsStruct(ctx, self);
+                if (HPyField_IsNull(holder->f))
+                    return HPy_Dup(ctx, ctx->h_None);
+                return HPyField_Load(ctx, self, holder->f);
+            }
+
+            static HPyDef *Holder_defines[] = {
+                &Holder_traverse,
+                &Holder_get,
+                NULL
+            };
+
+            static HPyType_Spec Holder_spec = {
+                .name = "mytest.Holder",
+                .basicsize = sizeof(HolderObject),
+                .flags = HPy_TPFLAGS_DEFAULT | HPy_TPFLAGS_HAVE_GC,
+                .defines = Holder_defines,
+            };
+
+            // dup_close(obj, n): HPy_Dup and HPy_Close obj n times
+            HPyDef_METH(dup_close, "dup_close", dup_close_impl, HPyFunc_VARARGS)
+            static HPy dup_close_impl(HPyContext *ctx, HPy self,
+                                      HPy *args, HPy_ssize_t nargs)
+            {
+                HPy_ssize_t n = HPyLong_AsSsize_t(ctx, args[1]);
+                HPy h[8];
+                for (HPy_ssize_t i = 0; i < n; i++) {
+                    for (int j = 0; j < 8; j++)
+                        h[j] = HPy_Dup(ctx, args[0]);
+                    for (int j = 0; j < 8; j++)
+                        HPy_Close(ctx, h[j]);
+                }
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+
+            // store_many(holder, a, b, n): store a and b alternately
+            HPyDef_METH(store_many, "store_many", store_many_impl, HPyFunc_VARARGS)
+            static HPy store_many_impl(HPyContext *ctx, HPy self,
+                                       HPy *args, HPy_ssize_t nargs)
+            {
+                HolderObject *holder = HolderObject_AsStruct(ctx, args[0]);
+                HPy_ssize_t n = HPyLong_AsSsize_t(ctx, args[3]);
+                for (HPy_ssize_t i = 0; i < n; i++) {
+                    HPyField_Store(ctx, args[0], &holder->f, args[1 + (i & 1)]);
+                    HPy h = HPyField_Load(ctx, args[0], holder->f);
+                    HPy_Close(ctx, h);
+                }
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+
+            // store_fresh(holder, n): store n new objects into holder.f and
+            // into a global while loading them, so that every store frees
+            // the object which the loads of the other threads might be
+            // reading
+            static HPyGlobal fresh_global;
+
+            HPyDef_METH(store_fresh, "store_fresh", store_fresh_impl, HPyFunc_VARARGS)
+            static HPy store_fresh_impl(HPyContext *ctx, HPy self,
+                                        HPy *args, HPy_ssize_t nargs)
+            {
+                HolderObject *holder = HolderObject_AsStruct(ctx, args[0]);
+                HPy_ssize_t n = HPyLong_AsSsize_t(ctx, args[1]);
+                for (HPy_ssize_t i = 0; i < n; i++) {
+                    HPy item = HPyFloat_FromDouble(ctx, (double)i);
+                    if (HPy_IsNull(item))
+                        return HPy_NULL;
+                    HPyField_Store(ctx, args[0], &holder->f, item);
+                    HPyGlobal_Store(ctx, &fresh_global, item);
+                    HPy_Close(ctx, item);
+                    HPy h1 = HPyField_Load(ctx, args[0], holder->f);
+                    HPy h2 = HPyGlobal_Load(ctx, fresh_global);
+                    HPy_Close(ctx, h1);
+                    HPy_Close(ctx, h2);
+                }
+                return HPy_Dup(ctx, ctx->h_None);
+            }
+
+            @EXPORT(dup_close)
+            @EXPORT(store_many)
+            @EXPORT(store_fresh)
+            @EXPORT_TYPE("Holder", Holder_spec)
+            @INIT
+        """)
+
+    def test_dup_close(self):
+        import sys
+        mod = self.make_holder_module()
+        obj = object()
+        rc = sys.getrefcount(obj)
+        run_in_threads(lambda i: mod.dup_close(obj, 20000))
+        assert sys.getrefcount(obj) == rc
+
+    def test_field_store_shared(self):
+        import sys
+        mod = self.make_holder_module()
+        holder = mod.Holder()
+        a = object()
+        b = object()
+        rc_a = sys.getrefcount(a)
+        rc_b = sys.getrefcount(b)
+        run_in_threads(lambda i: mod.store_many(holder, a, b, 20000))
+        assert holder.get() in (a, b)
+        del holder
+        assert sys.getrefcount(a) == rc_a
+        assert sys.getrefcount(b) == rc_b
+
+    def test_field_load_while_storing(self):
+        mod = self.make_holder_module()
+        holder = mod.Holder()
+        run_in_threads(lambda i: mod.store_fresh(holder, 20000))
+        assert isinstance(holder.get(), float)
+
+    def test_field_store_private(self):
+        mod = self.make_holder_module()
+        def f(i):
+            holder = mod.Holder()
+            a = [i]
+            mod.store_many(holder, a, (i,), 20001)
+            assert holder.get() is a
+        run_in_threads(f)
+
+    def test_gil_not_used(self):
+        import sys
+        gil_enabled = getattr(sys, '_is_gil_enabled', lambda: True)
+        gil_before = gil_enabled()
+        mod = self.make_module("""
+            HPyDef_METH(f, "f", f_impl, HPyFunc_NOARGS)
+            static HPy f_impl(HPyContext *ctx, HPy self)
+            {
+                return HPyLong_FromLong(ctx, 42);
+            }
+
+            static HPyDef *moduledefs[] = { &f, NULL };
+            static HPyModuleDef moduledef = {
+                .name = "mytest",
+                .size = -1,
+                .defines = moduledefs,
+                .gil_not_used = 1,
+            };
+
+            HPy_MODINIT(mytest)
+            static HPy init_mytest_impl(HPyContext *ctx)
+            {
+                return HPyModule_Create(ctx, &moduledef);
+            }
+        """)
+        assert mod.f() == 42
+        # on free-threaded builds, importing the module did not re-enable
+        # the GIL
+        assert gil_enabled() == gil_before